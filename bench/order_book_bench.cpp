@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "core/benchmark.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/timer.hpp"
+#include "orderbook/order_book.hpp"
+#include "workload.hpp"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define TE_BENCH_COUNTS_BYTES 1
+#endif
+
+// Live heap bytes, for bytes/order. Counted through the global allocator so
+// every structure the book owns is included.
+namespace {
+std::atomic<int64_t> live_bytes{0};
+}
+
+#if defined(TE_BENCH_COUNTS_BYTES)
+void* operator new(size_t size) {
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    live_bytes.fetch_add(static_cast<int64_t>(malloc_usable_size(block)), std::memory_order_relaxed);
+    return block;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept {
+    if (block) {
+        live_bytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(block)), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete[](void* block) noexcept {
+    operator delete(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+// The order pool's slabs come through the aligned forms
+void* operator new(size_t size, std::align_val_t alignment) {
+    const size_t align = static_cast<size_t>(alignment);
+    void* block = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    live_bytes.fetch_add(static_cast<int64_t>(malloc_usable_size(block)), std::memory_order_relaxed);
+    return block;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* block, std::align_val_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete[](void* block, std::align_val_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete(void* block, size_t, std::align_val_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete[](void* block, size_t, std::align_val_t) noexcept {
+    operator delete(block);
+}
+#endif
+
+using namespace trading_engine;
+using orderbook::OrderBook;
+using orderbook::OrderBookConfig;
+using orderbook::OrderMatch;
+using orderbook::SymbolId;
+
+namespace {
+
+struct BookVariant {
+    const char* name;
+    OrderBookConfig config;
+};
+
+struct RunResult {
+    int64_t elapsed_ns = 0;
+    double ops_per_sec = 0.0;
+    core::HistogramSnapshot latency;
+    double bytes_per_order = 0.0;
+    size_t resting_orders = 0;
+    uint64_t fills = 0;
+    core::PerfCounterValues counters;
+};
+
+// Throughput pass: the whole stream under one timer. Latency pass: a fresh
+// book with every command timed on its own.
+RunResult run_workload(const bench::Workload& workload, SymbolId symbol_id, const OrderBookConfig& config,
+                       bool hardware_counters) {
+    RunResult result;
+    uint64_t fills = 0;
+    auto sink = orderbook::make_match_sink([&](const OrderMatch&) { ++fills; });
+
+    {
+        const int64_t bytes_before = live_bytes.load(std::memory_order_relaxed);
+        auto book = std::make_unique<OrderBook>(symbol_id, config);
+        const orderbook::Timestamp now = orderbook::current_timestamp();
+        for (const auto& command : workload.prefill) {
+            book->apply(command, now, sink);
+        }
+
+        // Footprint of the populated book; sweeps can drain it by the end
+        const size_t prefilled_orders = book->order_count();
+        const int64_t bytes = live_bytes.load(std::memory_order_relaxed) - bytes_before;
+        result.bytes_per_order = prefilled_orders > 0
+            ? static_cast<double>(bytes) / static_cast<double>(prefilled_orders) : 0.0;
+
+        std::unique_ptr<core::PerfCounters> counters;
+        if (hardware_counters) {
+            counters = std::make_unique<core::PerfCounters>();
+            counters->start();
+        }
+        core::Timer timer;
+        for (const auto& command : workload.commands) {
+            book->apply(command, now, sink);
+        }
+        const int64_t elapsed = timer.elapsed_ns();
+        if (counters) {
+            result.counters = counters->stop();
+        }
+        result.elapsed_ns = elapsed;
+
+        result.ops_per_sec = elapsed > 0
+            ? static_cast<double>(workload.commands.size()) * 1e9 / static_cast<double>(elapsed) : 0.0;
+        result.fills = fills;
+        result.resting_orders = book->order_count();
+    }
+
+    {
+        auto book = std::make_unique<OrderBook>(symbol_id, config);
+        const orderbook::Timestamp now = orderbook::current_timestamp();
+        for (const auto& command : workload.prefill) {
+            book->apply(command, now, sink);
+        }
+
+        core::LatencyHistogram histogram;
+        for (const auto& command : workload.commands) {
+            const int64_t start = core::Timer::now_ns();
+            book->apply(command, now, sink);
+            histogram.record(core::Timer::now_ns() - start);
+        }
+        result.latency = histogram.snapshot();
+    }
+
+    return result;
+}
+
+// The workload run as a BenchmarkResult, for the JSON/CSV writers
+core::BenchmarkResult to_benchmark_result(const std::string& name, size_t operations, const RunResult& run) {
+    const auto& latency = run.latency;
+    core::BenchmarkResult result{
+        name, static_cast<int64_t>(operations), std::max<int64_t>(1, run.elapsed_ns),
+        static_cast<int64_t>(latency.count == 0 ? 0 : latency.min), static_cast<int64_t>(latency.max),
+        operations == 0 ? 0.0 : static_cast<double>(run.elapsed_ns) / static_cast<double>(operations), 0.0,
+        static_cast<double>(latency.percentile(50.0)), static_cast<double>(latency.percentile(90.0)),
+        static_cast<double>(latency.percentile(99.0))};
+    result.p999_time_ns = static_cast<double>(latency.percentile(99.9));
+    result.batch_size = static_cast<int64_t>(std::max<size_t>(1, operations));
+    result.counters = run.counters;
+    return result;
+}
+
+// Sub-100 ns queries, timed in batches against a prefilled book
+void run_query_benchmarks(SymbolId symbol_id, const BookVariant& variant, const core::BenchmarkOptions& options,
+                          std::vector<core::BenchmarkResult>& results) {
+    bench::WorkloadConfig config = bench::standard_workloads(0, 42).front();
+    config.prefill_orders = 10000;
+    bench::Workload workload = bench::generate_workload(config, symbol_id);
+
+    OrderBook book(symbol_id, variant.config);
+    auto sink = orderbook::make_match_sink([](const OrderMatch&) {});
+    const orderbook::Timestamp now = orderbook::current_timestamp();
+    for (const auto& command : workload.prefill) {
+        book.apply(command, now, sink);
+    }
+
+    const std::string prefix = std::string("query/") + variant.name + "/";
+    orderbook::OrderId next_id = 1;
+    const orderbook::OrderId last_id = static_cast<orderbook::OrderId>(workload.prefill.size());
+
+    results.push_back(core::Benchmark::run(prefix + "best_bid", [&]() {
+        core::do_not_optimize(book.best_bid());
+    }, options));
+    results.push_back(core::Benchmark::run(prefix + "spread", [&]() {
+        core::do_not_optimize(book.spread());
+    }, options));
+    results.push_back(core::Benchmark::run(prefix + "get_order", [&]() {
+        core::do_not_optimize(book.get_order(next_id));
+        next_id = next_id == last_id ? 1 : next_id + 1;
+    }, options));
+    results.push_back(core::Benchmark::run(prefix + "bid_depth", [&]() {
+        core::do_not_optimize(book.bid_depth());
+    }, options));
+
+    // Cost of sweeping a few levels, and resting size near the touch
+    results.push_back(core::Benchmark::run(prefix + "sweep_cost", [&]() {
+        core::do_not_optimize(book.sweep_cost(orderbook::Side::BUY, orderbook::Quantity(500.0)));
+    }, options));
+    results.push_back(core::Benchmark::run(prefix + "depth_within", [&]() {
+        core::do_not_optimize(book.depth_within(orderbook::Side::BUY, 20));
+    }, options));
+
+    // Pre-trade check of a limit order against every limit and the price band
+    orderbook::RiskGate gate(16, symbol_id + 1);
+    orderbook::RiskLimits limits;
+    limits.max_order_quantity = orderbook::Quantity(1000000.0);
+    limits.max_position = orderbook::Quantity(1000000.0);
+    gate.set_limits(1, limits);
+    gate.set_reference_price(symbol_id, book.midpoint().value_or(orderbook::Price()));
+    orderbook::SymbolInfo banded = book.symbol_info();
+    banded.price_band_bps = 1000;
+    orderbook::Order candidate(next_id, symbol_id, orderbook::Side::BUY, orderbook::OrderType::LIMIT,
+                               orderbook::Quantity(10.0), book.best_bid().value_or(orderbook::Price()),
+                               orderbook::TimeInForce::GTC, 1, now);
+    results.push_back(core::Benchmark::run(prefix + "risk_check", [&]() {
+        core::do_not_optimize(gate.check(candidate, banded));
+    }, options));
+}
+
+void print_usage(const char* program) {
+    std::printf("Usage: %s [--ops N] [--seed S] [--filter NAME] [--tsc] [--cpu N] [--counters]\n"
+                "          [--json PATH] [--csv PATH]\n", program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t operations = 1000000;
+    uint64_t seed = 42;
+    std::string filter;
+    std::string json_path;
+    std::string csv_path;
+    int cpu = -1;
+    bool hardware_counters = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+            operations = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--counters") == 0) {
+            hardware_counters = true;
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--tsc") == 0) {
+            if (!core::set_clock_source(core::ClockSource::TSC)) {
+                std::fprintf(stderr, "TSC clock unavailable, using the system clock\n");
+            }
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    core::ScopedThreadPin pin(cpu);
+    if (cpu >= 0 && !pin.pinned()) {
+        std::fprintf(stderr, "Could not pin to CPU %d, running unpinned\n", cpu);
+    }
+
+    const SymbolId symbol_id = orderbook::SymbolRegistry::global().intern("BENCH");
+    std::vector<core::BenchmarkResult> results;
+
+    std::vector<BookVariant> variants;
+    variants.push_back({"map", OrderBookConfig{}});
+    OrderBookConfig ladder;
+    ladder.use_price_ladder = true;
+    ladder.tick_size = bench::standard_workloads(0, seed).front().flow.tick_size;
+    variants.push_back({"ladder", ladder});
+
+    std::printf("%-14s %-7s %10s %12s %8s %8s %8s %9s %9s %11s %9s\n",
+                "workload", "book", "ops", "ops/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns",
+                "bytes/order", "fills");
+
+    for (const auto& config : bench::standard_workloads(operations, seed)) {
+        if (!filter.empty() && config.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        bench::Workload workload = bench::generate_workload(config, symbol_id);
+        for (const auto& variant : variants) {
+            RunResult result = run_workload(workload, symbol_id, variant.config, hardware_counters);
+            results.push_back(to_benchmark_result(workload.name + "/" + variant.name,
+                                                  workload.commands.size(), result));
+            results.back().cpu = pin.pinned() ? cpu : -1;
+            std::printf("%-14s %-7s %10zu %12.0f %8llu %8llu %8llu %9llu %9llu %11.1f %9llu\n",
+                        workload.name.c_str(), variant.name, workload.commands.size(), result.ops_per_sec,
+                        static_cast<unsigned long long>(result.latency.percentile(50.0)),
+                        static_cast<unsigned long long>(result.latency.percentile(90.0)),
+                        static_cast<unsigned long long>(result.latency.percentile(99.0)),
+                        static_cast<unsigned long long>(result.latency.percentile(99.9)),
+                        static_cast<unsigned long long>(result.latency.max),
+                        result.bytes_per_order,
+                        static_cast<unsigned long long>(result.fills));
+        }
+    }
+
+    core::BenchmarkOptions query_options;
+    query_options.iterations = 1000000;
+    query_options.hardware_counters = hardware_counters;
+    query_options.cpu = cpu;
+    if (filter.empty() || std::string("query").find(filter) != std::string::npos) {
+        std::printf("\n%-24s %14s %10s %10s %10s %10s\n", "query", "calls", "batch", "mean ns", "p99 ns", "ovhd ns");
+        for (const auto& variant : variants) {
+            size_t first = results.size();
+            run_query_benchmarks(symbol_id, variant, query_options, results);
+            for (size_t i = first; i < results.size(); ++i) {
+                const auto& r = results[i];
+                std::printf("%-24s %14lld %10lld %10.2f %10.2f %10.1f\n", r.name.c_str(),
+                            static_cast<long long>(r.iterations), static_cast<long long>(r.batch_size),
+                            r.mean_time_ns, r.p99_time_ns, r.overhead_ns);
+            }
+        }
+    }
+
+    if (!json_path.empty() && !core::Benchmark::save_results(json_path, results)) {
+        std::fprintf(stderr, "Could not write %s\n", json_path.c_str());
+        return 1;
+    }
+    if (!csv_path.empty() && !core::Benchmark::save_results(csv_path, results)) {
+        std::fprintf(stderr, "Could not write %s\n", csv_path.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "workload.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace bench {
+
+using market::Distribution;
+using orderbook::CommandType;
+using orderbook::OrderType;
+using orderbook::Price;
+
+namespace {
+
+// One-symbol flow around a fixed mid, resting depth thinning out geometrically from the touch
+market::OrderGeneratorConfig base_flow() {
+    market::OrderGeneratorConfig flow;
+    flow.mid_price = Price(1000.0);
+    flow.tick_size = Price(int64_t{100});
+    flow.mid_walk_probability = 0.0;
+    flow.price_distribution = Distribution::GEOMETRIC;
+    flow.max_price_ticks = 100;
+    flow.price_decay = 0.94;             // Mean a little over 15 ticks behind the mid
+    flow.cross_probability = 0.0;
+    flow.min_lots = 1;
+    flow.max_lots = 100;
+    flow.cancel_probability = 0.0;
+    flow.modify_probability = 0.0;
+    flow.market_probability = 0.0;
+    flow.rate = 0.0;                     // Timestamps aren't used
+    return flow;
+}
+
+} // namespace
+
+Workload generate_workload(const WorkloadConfig& config, SymbolId symbol_id) {
+    market::OrderGeneratorConfig flow = config.flow;
+    flow.seed = config.seed;
+    flow.symbols = {symbol_id};
+    flow.warmup_orders = config.prefill_orders;
+    flow.max_live_orders = std::max(flow.max_live_orders, config.prefill_orders + config.operations);
+
+    Workload workload;
+    workload.name = config.name;
+    workload.prefill.resize(config.prefill_orders);
+    workload.commands.resize(config.operations);
+
+    market::OrderGenerator generator(flow);
+    generator.generate(workload.prefill);
+    generator.generate(workload.commands);
+    for (const OrderCommand& command : workload.commands) {
+        switch (command.type) {
+            case CommandType::NEW:
+                if (command.order_type == OrderType::MARKET) {
+                    ++workload.markets;
+                } else {
+                    ++workload.adds;
+                }
+                break;
+            case CommandType::CANCEL:
+                ++workload.cancels;
+                break;
+            case CommandType::MODIFY:
+                ++workload.modifies;
+                break;
+            default:
+                break;
+        }
+    }
+    return workload;
+}
+
+std::vector<WorkloadConfig> standard_workloads(size_t operations, uint64_t seed) {
+    std::vector<WorkloadConfig> workloads;
+
+    WorkloadConfig add_heavy;
+    add_heavy.name = "add_heavy";
+    add_heavy.flow = base_flow();
+    add_heavy.flow.cancel_probability = 0.1;
+    workloads.push_back(add_heavy);
+
+    // Roughly 95% of adds are cancelled again, as in live order flow
+    WorkloadConfig cancel_heavy;
+    cancel_heavy.name = "cancel_heavy";
+    cancel_heavy.flow = base_flow();
+    cancel_heavy.flow.price_decay = 0.89;
+    cancel_heavy.flow.cancel_probability = 0.475;
+    cancel_heavy.flow.market_probability = 0.025;
+    workloads.push_back(cancel_heavy);
+
+    // Large market orders walking many levels of a wide book
+    WorkloadConfig deep_sweep;
+    deep_sweep.name = "deep_sweep";
+    deep_sweep.prefill_orders = 50000;
+    deep_sweep.flow = base_flow();
+    deep_sweep.flow.price_distribution = Distribution::UNIFORM;
+    deep_sweep.flow.max_price_ticks = 500;
+    deep_sweep.flow.market_probability = 0.2;
+    deep_sweep.flow.market_size_multiplier = 50;
+    workloads.push_back(deep_sweep);
+
+    WorkloadConfig many_levels;
+    many_levels.name = "many_levels";
+    many_levels.prefill_orders = 50000;
+    many_levels.flow = base_flow();
+    many_levels.flow.price_distribution = Distribution::UNIFORM;
+    many_levels.flow.max_price_ticks = 5000;
+    many_levels.flow.cancel_probability = 0.45;
+    many_levels.flow.cross_probability = 0.05;
+    workloads.push_back(many_levels);
+
+    WorkloadConfig modify_storm;
+    modify_storm.name = "modify_storm";
+    modify_storm.flow = base_flow();
+    modify_storm.flow.price_decay = 0.93;
+    modify_storm.flow.cancel_probability = 0.1;
+    modify_storm.flow.modify_probability = 0.7;
+    modify_storm.flow.reprice_probability = 0.5;
+    workloads.push_back(modify_storm);
+
+    for (auto& workload : workloads) {
+        workload.operations = operations;
+        workload.seed = seed;
+    }
+    return workloads;
+}
+
+} // namespace bench
+} // namespace trading_engine
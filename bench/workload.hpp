@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "market/order_generator.hpp"
+#include "orderbook/order_command.hpp"
+
+namespace trading_engine {
+namespace bench {
+
+using orderbook::OrderCommand;
+using orderbook::SymbolId;
+
+/**
+ * WorkloadConfig - seeded description of an order-book command stream
+ *
+ * The commands come from a market::OrderGenerator on one symbol; `flow`
+ * sets their shape (its symbols, seed and warm-up are filled in by
+ * generate_workload). The prefill is the generator's warm-up: resting
+ * orders added before timing starts.
+ */
+struct WorkloadConfig {
+    std::string name;
+    uint64_t seed = 42;
+    size_t operations = 1000000;        // Timed commands
+    size_t prefill_orders = 10000;      // Passive orders added before timing starts
+    market::OrderGeneratorConfig flow;
+};
+
+/**
+ * Workload - generated commands plus how many of each kind were produced
+ */
+struct Workload {
+    std::string name;
+    std::vector<OrderCommand> prefill;
+    std::vector<OrderCommand> commands;
+    size_t adds = 0;
+    size_t cancels = 0;
+    size_t modifies = 0;
+    size_t markets = 0;
+};
+
+// Generate the prefill and timed command streams for `config`
+Workload generate_workload(const WorkloadConfig& config, SymbolId symbol_id);
+
+// The standard suite: add-heavy, cancel-heavy, deep sweeps, many levels, modify storm
+std::vector<WorkloadConfig> standard_workloads(size_t operations, uint64_t seed);
+
+} // namespace bench
+} // namespace trading_engine
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <iosfwd>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -9,10 +13,55 @@
 #include <utility>
 #include "core/timer.hpp"
 #include "core/logger.hpp"
+#include "core/perf_counters.hpp"
+#include "core/thread_affinity.hpp"
 
 namespace trading_engine {
 namespace core {
 
+// Keep `value` (and everything it depends on) from being optimized away
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+template <typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value) : : "memory");
+#else
+    volatile char* sink = reinterpret_cast<volatile char*>(&value);
+    *sink = *sink;
+#endif
+}
+
+// Force pending writes to memory and forget cached loads
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * Options controlling how Benchmark::run measures a function
+ */
+struct BenchmarkOptions {
+    int64_t iterations = 10000;        // Timed calls of the function
+    int64_t batch_size = 0;            // Calls per timed sample; 0 picks one reaching target_sample_time
+    int64_t warmup_iterations = 100;   // Untimed calls before measuring
+    std::chrono::nanoseconds target_sample_time{std::chrono::microseconds(2)};
+    bool subtract_overhead = true;     // Remove the measured cost of timing an empty sample
+    int cpu = -1;                      // Pin the calling thread here for the run (-1 leaves it)
+    bool hardware_counters = false;    // Read perf_event counters around the timed samples
+};
+
 /**
  * Benchmark result containing statistics about a benchmark run
  */
@@ -27,6 +76,13 @@ struct BenchmarkResult {
     double median_time_ns;
     double p90_time_ns;
     double p99_time_ns;
+    double p999_time_ns = 0.0;
+    
+    // How the run was measured
+    int64_t batch_size = 1;            // Calls per timed sample
+    double overhead_ns = 0.0;          // Per-sample timing overhead subtracted
+    int cpu = -1;                      // CPU the run was pinned to, -1 if not pinned
+    PerfCounterValues counters{};      // Totals over all timed calls, if requested
     
     double iterations_per_sec() const {
         return (static_cast<double>(iterations) * 1e9) / static_cast<double>(total_time_ns);
@@ -47,66 +103,70 @@ struct BenchmarkResult {
 
 /**
  * Benchmarking utility for measuring performance of functions
+ *
+ * Calls are timed in batches so the clock read is amortized over many calls,
+ * and the cost of timing an empty batch is subtracted from every sample.
+ * Statistics are per call, derived from the per-batch samples.
  */
 class Benchmark {
 public:
     // Run a benchmark for a given number of iterations
     template <typename Func>
     static BenchmarkResult run(const std::string& name, Func&& func, int64_t iterations) {
-        std::vector<int64_t> times;
-        times.reserve(iterations);
-        
-        int64_t total_time = 0;
-        
-        // Warm-up run
-        func();
+        BenchmarkOptions options;
+        options.iterations = iterations;
+        options.warmup_iterations = 1;
+        return run(name, std::forward<Func>(func), options);
+    }
+    
+    // Run a benchmark as configured by `options`
+    template <typename Func>
+    static BenchmarkResult run(const std::string& name, Func&& func, const BenchmarkOptions& options) {
+        ScopedThreadPin pin(options.cpu);
         
-        // Actual benchmark runs
-        for (int64_t i = 0; i < iterations; ++i) {
-            Timer timer;
+        // Warm-up runs
+        for (int64_t i = 0; i < options.warmup_iterations; ++i) {
             func();
-            int64_t elapsed = timer.elapsed_ns();
-            times.push_back(elapsed);
-            total_time += elapsed;
         }
         
-        // Calculate statistics
-        std::sort(times.begin(), times.end());
+        const int64_t iterations = std::max<int64_t>(1, options.iterations);
+        int64_t batch = options.batch_size > 0
+            ? options.batch_size
+            : choose_batch_size(func, options.target_sample_time.count(), iterations);
+        batch = std::clamp<int64_t>(batch, 1, iterations);
+        const int64_t samples = (iterations + batch - 1) / batch;
+        const double overhead = options.subtract_overhead ? measure_overhead(batch) : 0.0;
         
-        int64_t min_time = times.front();
-        int64_t max_time = times.back();
-        double mean_time = static_cast<double>(total_time) / iterations;
-        
-        // Calculate standard deviation
-        double variance = 0.0;
-        for (int64_t time : times) {
-            double diff = static_cast<double>(time) - mean_time;
-            variance += diff * diff;
+        std::vector<int64_t> raw(static_cast<size_t>(samples));
+        std::unique_ptr<PerfCounters> counters;
+        if (options.hardware_counters) {
+            counters = std::make_unique<PerfCounters>();
+            counters->start();
         }
-        variance /= iterations;
-        double stddev = std::sqrt(variance);
-        
-        // Calculate percentiles
-        double median = (iterations % 2 == 0) 
-            ? (times[iterations/2 - 1] + times[iterations/2]) / 2.0 
-            : times[iterations/2];
         
-        size_t p90_idx = static_cast<size_t>(iterations * 0.9);
-        size_t p99_idx = static_cast<size_t>(iterations * 0.99);
-        
-        double p90 = times[p90_idx];
-        double p99 = times[p99_idx];
+        // Actual benchmark runs
+        for (int64_t s = 0; s < samples; ++s) {
+            const int64_t start = Timer::now_ns();
+            for (int64_t b = 0; b < batch; ++b) {
+                func();
+                clobber_memory();
+            }
+            raw[static_cast<size_t>(s)] = Timer::now_ns() - start;
+        }
         
-        return {
-            name, iterations, total_time, min_time, max_time,
-            mean_time, stddev, median, p90, p99
-        };
+        BenchmarkResult result = summarize(name, raw, batch, overhead);
+        result.cpu = pin.pinned() ? options.cpu : -1;
+        if (counters) {
+            result.counters = counters->stop();
+        }
+        return result;
     }
     
     // Run a timed benchmark for a given duration
     template <typename Func>
     static BenchmarkResult run_for_duration(const std::string& name, Func&& func, 
-                                           std::chrono::milliseconds duration) {
+                                           std::chrono::milliseconds duration,
+                                           BenchmarkOptions options = {}) {
         // Estimate how many iterations we need to run
         constexpr int CALIBRATION_ITERATIONS = 10;
         int64_t calibration_time = 0;
@@ -119,20 +179,21 @@ public:
         }
         
         // Calculate iterations based on target duration
-        int64_t avg_time = calibration_time / CALIBRATION_ITERATIONS;
+        int64_t avg_time = std::max<int64_t>(1, calibration_time / CALIBRATION_ITERATIONS);
         int64_t target_ns = duration.count() * 1000000;
         int64_t estimated_iterations = target_ns / avg_time;
         
         // Run at least 10 iterations
-        int64_t iterations = std::max<int64_t>(10, estimated_iterations);
+        options.iterations = std::max<int64_t>(10, estimated_iterations);
+        options.warmup_iterations = 0; // Calibration already warmed up
         
-        return run(name, std::forward<Func>(func), iterations);
+        return run(name, std::forward<Func>(func), options);
     }
     
     // Log benchmark results
     static void log_result(const BenchmarkResult& result) {
         TE_LOG_INFO("Benchmark: %s", result.name.c_str());
-        TE_LOG_INFO("  Iterations: %ld", result.iterations);
+        TE_LOG_INFO("  Iterations: %ld (batches of %ld)", result.iterations, result.batch_size);
         TE_LOG_INFO("  Total time: %.3f ms", result.total_time_ns / 1e6);
         TE_LOG_INFO("  Throughput: %.2f ops/sec", result.iterations_per_sec());
         TE_LOG_INFO("  Time per op: %.3f us (mean)", result.time_per_op_us());
@@ -142,6 +203,49 @@ public:
         TE_LOG_INFO("  Median: %.3f us", result.median_time_ns / 1e3);
         TE_LOG_INFO("  p90: %.3f us", result.p90_time_ns / 1e3);
         TE_LOG_INFO("  p99: %.3f us", result.p99_time_ns / 1e3);
+        TE_LOG_INFO("  p99.9: %.3f us", result.p999_time_ns / 1e3);
+        TE_LOG_INFO("  Timing overhead: %.1f ns per batch (subtracted)", result.overhead_ns);
+        if (result.counters.valid) {
+            const double calls = static_cast<double>(result.iterations);
+            TE_LOG_INFO("  Cycles/op: %.1f  Instructions/op: %.1f  IPC: %.2f",
+                        result.counters.cycles / calls, result.counters.instructions / calls,
+                        result.counters.instructions_per_cycle());
+            TE_LOG_INFO("  Cache misses/op: %.3f  Branch misses/op: %.3f",
+                        result.counters.cache_misses / calls, result.counters.branch_misses / calls);
+        }
+    }
+    
+    // Machine-readable output for tracking results between builds
+    static void write_json(std::ostream& out, std::span<const BenchmarkResult> results);
+    static void write_csv(std::ostream& out, std::span<const BenchmarkResult> results);
+    
+    // Write results to `path`: CSV if it ends in ".csv", JSON otherwise
+    static bool save_results(const std::string& path, std::span<const BenchmarkResult> results);
+    
+    // Per-call statistics from raw per-batch sample times
+    static BenchmarkResult summarize(const std::string& name, const std::vector<int64_t>& batch_times_ns,
+                                     int64_t batch_size, double overhead_ns);
+    
+    // Cost of timing one empty batch of `batch_size` iterations (minimum of several tries)
+    static double measure_overhead(int64_t batch_size);
+    
+private:
+    // Double the batch until one timed batch reaches the target sample time
+    template <typename Func>
+    static int64_t choose_batch_size(Func& func, int64_t target_ns, int64_t max_batch) {
+        int64_t batch = 1;
+        while (batch < max_batch) {
+            const int64_t start = Timer::now_ns();
+            for (int64_t b = 0; b < batch; ++b) {
+                func();
+                clobber_memory();
+            }
+            if (Timer::now_ns() - start >= target_ns) {
+                break;
+            }
+            batch *= 2;
+        }
+        return std::min(batch, max_batch);
     }
 };
 
@@ -168,4 +272,4 @@ public:
             auto duration = end - TE_MEASURE_TIME_start; \
             TE_LOG_INFO("%s took %ld ns (%.3f µs)", \
                 TE_MEASURE_TIME_name, duration, duration / 1000.0); \
-        }); 
\ No newline at end of file
+        }); 
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "core/cache.hpp"
+#include "core/ring_buffer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace trading_engine {
+namespace core {
+
+/**
+ * Lock-free single-producer multi-consumer broadcast ring (disruptor style)
+ *
+ * Every published value is seen by every consumer. The producer never looks
+ * at the consumers: it always writes the next slot and advances the
+ * published sequence, so a slow consumer can never hold it up. Each consumer
+ * owns a Cursor with its own next sequence and copies values out of the
+ * ring's memory. A consumer that falls behind by more than the readable
+ * window (capacity minus a guard band) sees the gap in sequence numbers and
+ * is moved up to the oldest readable value, with the skipped values counted
+ * as lost.
+ *
+ * Each slot carries the sequence it holds, written like a seqlock around the
+ * value, so a copy that raced with the producer lapping the consumer is
+ * detected and thrown away before anyone sees it (see Cursor::poll). The
+ * fences order the value against the slot sequence on weakly ordered CPUs
+ * too (AArch64) and compile to nothing on x86; T must be trivially copyable.
+ */
+template <typename T>
+class BroadcastRing {
+    static_assert(std::is_trivially_copyable_v<T>, "BroadcastRing values are copied while being overwritten");
+    static_assert(std::is_default_constructible_v<T>, "BroadcastRing values are copied into a local first");
+
+public:
+    static constexpr uint64_t NO_SEQUENCE = std::numeric_limits<uint64_t>::max();
+
+    explicit BroadcastRing(size_t capacity)
+        : mask_(next_power_of_two(capacity < 4 ? 4 : capacity) - 1),
+          window_(mask_ + 1 - (mask_ + 1) / 4),
+          slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(NO_SEQUENCE, std::memory_order_relaxed);
+        }
+    }
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // Producer: publish a value
+    void publish(const T& value) {
+        publish_with([&](T& slot) { slot = value; });
+    }
+
+    // Producer: fill the next slot in place and publish it. Never blocks.
+    template <typename Func>
+    void publish_with(Func&& fill) {
+        const uint64_t sequence = next_;
+        Slot& slot = slots_[sequence & mask_];
+
+        // Mark the slot as being rewritten before touching the value
+        slot.sequence.store(NO_SEQUENCE, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(slot.value);
+        slot.sequence.store(sequence, std::memory_order_release);
+
+        next_ = sequence + 1;
+        published_.store(next_, std::memory_order_release);
+    }
+
+    /**
+     * Cursor - one consumer's position in the ring
+     *
+     * A cursor is used by a single thread; any number of cursors can read the
+     * same ring concurrently.
+     */
+    class Cursor {
+    public:
+        // Visit up to `limit` published values as func(const T&, uint64_t
+        // sequence), oldest first. Returns the number visited.
+        //
+        // Each value is copied out of its slot and handed to func only once
+        // the slot is known not to have been rewritten during the copy. A copy
+        // the producer lapped is discarded, counted in overruns(), and the
+        // cursor moves past it, so func never sees a torn value.
+        template <typename Func>
+        size_t poll(Func&& func, size_t limit = std::numeric_limits<size_t>::max()) {
+            size_t visited = 0;
+            uint64_t published = ring_->published_.load(std::memory_order_acquire);
+            while (visited < limit && next_ < published) {
+                skip_lapped(published);
+
+                const Slot& slot = ring_->slots_[next_ & ring_->mask_];
+                if (slot.sequence.load(std::memory_order_acquire) != next_) {
+                    // Rewritten since `published` was read: catch up and retry
+                    published = ring_->published_.load(std::memory_order_acquire);
+                    skip_lapped(published);
+                    continue;
+                }
+
+                T value;
+                std::memcpy(static_cast<void*>(&value), static_cast<const void*>(&slot.value), sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != next_) {
+                    ++overruns_;
+                    ++next_;
+                    published = ring_->published_.load(std::memory_order_acquire);
+                    continue;
+                }
+
+                func(static_cast<const T&>(value), next_);
+                ++next_;
+                ++visited;
+            }
+            return visited;
+        }
+
+        // Sequence of the next value this cursor reads
+        uint64_t sequence() const { return next_; }
+
+        // Values published but not yet read (including any about to be lost)
+        uint64_t lag() const { return ring_->published() - next_; }
+
+        // Values skipped because the cursor fell out of the readable window
+        uint64_t lost() const { return lost_; }
+
+        // Values discarded because the producer rewrote them while they were copied
+        uint64_t overruns() const { return overruns_; }
+
+    private:
+        friend class BroadcastRing;
+
+        Cursor(const BroadcastRing* ring, uint64_t next) : ring_(ring), next_(next) {}
+
+        // Move past values the producer may already be overwriting
+        void skip_lapped(uint64_t published) {
+            if (published - next_ > ring_->window_) {
+                uint64_t oldest = published - ring_->window_;
+                lost_ += oldest - next_;
+                next_ = oldest;
+            }
+        }
+
+        const BroadcastRing* ring_;
+        uint64_t next_;
+        uint64_t lost_ = 0;
+        uint64_t overruns_ = 0;
+    };
+
+    // Consumer: a cursor that starts with the next value published
+    Cursor subscribe() const { return Cursor(this, published()); }
+
+    // Consumer: a cursor that starts with the oldest value still readable
+    Cursor subscribe_from_oldest() const {
+        uint64_t published_now = published();
+        return Cursor(this, published_now > window_ ? published_now - window_ : 0);
+    }
+
+    // Number of values published so far (the sequence of the next one)
+    uint64_t published() const { return published_.load(std::memory_order_acquire); }
+
+    // Slots in the ring, and how far behind a cursor can be and still read
+    size_t capacity() const { return mask_ + 1; }
+    size_t window() const { return window_; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    const size_t window_;   // Readable values behind the head; the rest is a guard band
+    std::unique_ptr<Slot[]> slots_;
+
+    // Producer state
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published_{0};
+    uint64_t next_ = 0;
+};
+
+} // namespace core
+} // namespace trading_engine
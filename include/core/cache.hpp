@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace trading_engine {
+namespace core {
+
+// Assumed cache line size used for padding shared state
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Hint that memory at addr will be read soon
+ */
+inline void prefetch_read(const void* addr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 0, 3);
+#else
+    (void)addr;
+#endif
+}
+
+/**
+ * Hint that memory at addr will be written soon
+ */
+inline void prefetch_write(const void* addr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 1, 3);
+#else
+    (void)addr;
+#endif
+}
+
+} // namespace core
+} // namespace trading_engine
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/cache.hpp"
+#include "core/timer.hpp"
+
+// Scoped TE_LATENCY_PROBE statements are compiled in only when this is set
+// (CMake option TE_LATENCY_PROBES); the recorder classes are always available.
+#ifndef TE_LATENCY_PROBES
+#define TE_LATENCY_PROBES 0
+#endif
+
+namespace trading_engine {
+namespace core {
+
+/**
+ * HistogramSnapshot - plain copy of histogram counts for queries and merging
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    uint64_t max = 0;
+
+    HistogramSnapshot();
+
+    // Fold another snapshot into this one
+    void merge(const HistogramSnapshot& other);
+
+    // Value at percentile `p` (0-100), reported as the upper bound of its bucket
+    // clamped to the recorded range; 0 when empty
+    uint64_t percentile(double p) const;
+
+    double mean() const {
+        return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+    }
+
+    void clear();
+
+    // "count=... mean=... p50=... p99=... p99.9=... p99.99=... max=..." in ns
+    std::string to_string() const;
+};
+
+/**
+ * LatencyHistogram - fixed-memory log-linear histogram of nanosecond values
+ *
+ * Values below SUB_BUCKET_COUNT get one bucket each; above that every power
+ * of two is split into SUB_BUCKET_COUNT linear buckets, so a recorded value
+ * is known to within 1/SUB_BUCKET_COUNT (~1.6%). Values from 2^MAX_VALUE_BITS
+ * (~18 minutes) up share the last bucket.
+ *
+ * record() assumes a single writing thread; snapshot() may run concurrently
+ * from any thread. Use LatencyProbe to record from several threads.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 6;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1);
+
+    LatencyHistogram();
+
+    void record(int64_t value_ns) {
+        const uint64_t value = value_ns < 0 ? 0 : static_cast<uint64_t>(value_ns);
+        bump(counts_[bucket_index(value)]);
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        if (value < min_.load(std::memory_order_relaxed)) {
+            min_.store(value, std::memory_order_relaxed);
+        }
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    // Add this histogram's counts to `out`
+    void snapshot_into(HistogramSnapshot& out) const;
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot out;
+        snapshot_into(out);
+        return out;
+    }
+
+    // Only safe while no thread is recording
+    void reset();
+
+    // Threads that found every slot taken and share one, across all probes
+    static uint64_t shared_slots();
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        if (value >> MAX_VALUE_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+        return static_cast<size_t>(SUB_BUCKET_COUNT * (shift + 1) + ((value >> shift) - SUB_BUCKET_COUNT));
+    }
+
+    // Smallest and largest values that land in bucket `index`
+    static uint64_t bucket_lower_bound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        const uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+        return (SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+    }
+
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        if (index == BUCKET_COUNT - 1) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        const uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+        return ((SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT + 1) << shift) - 1;
+    }
+
+private:
+    // Single writer: a plain load/store keeps the increment free of locked instructions
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * LatencyProbe - named latency channel with one histogram per recording thread
+ *
+ * Each thread records into its own shard without contention; snapshot()
+ * merges the shards, so percentiles can be read while the engine runs.
+ * A shard is allocated the first time a thread records, after which memory
+ * stays fixed. Threads hold a slot from their first record until they exit,
+ * when it goes back for a new thread to reuse. Past MAX_THREADS recording
+ * threads at once, new ones share a slot and may lose counts; shared_slots()
+ * says how many did.
+ */
+class LatencyProbe {
+public:
+    static constexpr size_t MAX_THREADS = 64;
+
+    explicit LatencyProbe(std::string name);
+    ~LatencyProbe();
+
+    LatencyProbe(const LatencyProbe&) = delete;
+    LatencyProbe& operator=(const LatencyProbe&) = delete;
+
+    const std::string& name() const { return name_; }
+
+    void record(int64_t value_ns) {
+        shard().record(value_ns);
+    }
+
+    // Merged view of every thread's shard
+    HistogramSnapshot snapshot() const;
+
+    // Only safe while no thread is recording
+    void reset();
+
+    // Threads that found every slot taken and share one, across all probes
+    static uint64_t shared_slots();
+
+private:
+    LatencyHistogram& shard() {
+        const size_t slot = thread_slot();
+        LatencyHistogram* histogram = shards_[slot].load(std::memory_order_acquire);
+        return histogram ? *histogram : create_shard(slot);
+    }
+
+    static size_t thread_slot();
+    LatencyHistogram& create_shard(size_t slot);
+
+    std::string name_;
+    std::array<std::atomic<LatencyHistogram*>, MAX_THREADS> shards_{};
+};
+
+// Find or create the process-wide probe called `name`. Probes live until exit.
+LatencyProbe& latency_probe(std::string_view name);
+
+// All registered probes, in creation order
+std::vector<LatencyProbe*> latency_probes();
+
+/**
+ * ScopedLatency - records the lifetime of a scope into a probe
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyProbe& probe)
+        : probe_(probe), start_ns_(Timer::now_ns()) {}
+
+    ~ScopedLatency() {
+        probe_.record(Timer::now_ns() - start_ns_);
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyProbe& probe_;
+    int64_t start_ns_;
+};
+
+} // namespace core
+} // namespace trading_engine
+
+#define TE_LATENCY_CONCAT_INNER(a, b) a##b
+#define TE_LATENCY_CONCAT(a, b) TE_LATENCY_CONCAT_INNER(a, b)
+
+// Time the rest of the enclosing scope into the probe called `name`
+#if TE_LATENCY_PROBES
+#define TE_LATENCY_PROBE(name) \
+    static ::trading_engine::core::LatencyProbe& TE_LATENCY_CONCAT(te_latency_probe_, __LINE__) = \
+        ::trading_engine::core::latency_probe(name); \
+    ::trading_engine::core::ScopedLatency TE_LATENCY_CONCAT(te_latency_scope_, __LINE__)( \
+        TE_LATENCY_CONCAT(te_latency_probe_, __LINE__))
+#else
+#define TE_LATENCY_PROBE(name) static_cast<void>(0)
+#endif
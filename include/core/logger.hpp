@@ -8,12 +8,24 @@
 #include <array>
 #include <thread>
 #include <vector>
-#include <optional>
 #include <cstdarg>
 #include <utility>
 #include <memory>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
 #include "core/timer.hpp"
+#include "core/ring_buffer.hpp"
+
+// Lowest level compiled into TE_LOG_* statements (0 = TRACE ... 6 = OFF).
+// Set by the TE_COMPILED_LOG_LEVEL CMake option; statements below it
+// compile to nothing beyond a format check.
+#ifndef TE_COMPILED_LOG_LEVEL
+#define TE_COMPILED_LOG_LEVEL 0
+#endif
 
 namespace trading_engine {
 namespace core {
@@ -31,6 +43,9 @@ enum class LogLevel : uint8_t {
     OFF = 6
 };
 
+// Lowest level a TE_LOG_* statement can log at in this build
+constexpr LogLevel COMPILED_LOG_LEVEL = static_cast<LogLevel>(TE_COMPILED_LOG_LEVEL);
+
 /**
  * Simple string representation of LogLevel
  */
@@ -49,72 +64,198 @@ constexpr std::string_view to_string(LogLevel level) {
 
 /**
  * Lock-free ring buffer for log messages
+ *
+ * Fixed-size text entries in an MPSCRingBuffer, so any thread may log while
+ * the flush thread reads. Entries are written and read in place, and carry
+ * the time they were logged so the flush thread can merge them with the
+ * deferred entries.
  */
 class LogRingBuffer {
 public:
     static constexpr size_t LOG_ENTRY_SIZE = 1024;
-    using LogEntry = std::array<char, LOG_ENTRY_SIZE>;
+
+    struct LogEntry {
+        int64_t timestamp_ns;
+        std::array<char, LOG_ENTRY_SIZE> text;
+
+        std::string_view message() const { return std::string_view(text.data()); }
+    };
 
     explicit LogRingBuffer(size_t capacity) 
-        : buffer_(capacity), 
-          write_index_(0), 
-          read_index_(0) {}
-
-    bool try_write(std::string_view log_message) {
-        const size_t current_write = write_index_.load(std::memory_order_relaxed);
-        const size_t next_write = (current_write + 1) % buffer_.size();
-        
-        if (next_write == read_index_.load(std::memory_order_acquire)) {
-            return false; // Buffer is full
-        }
+        : ring_(capacity) {}
 
-        auto& entry = buffer_[current_write];
-        const size_t copy_size = std::min(log_message.size(), LOG_ENTRY_SIZE - 1);
-        std::memcpy(entry.data(), log_message.data(), copy_size);
-        entry[copy_size] = '\0';
-        
-        write_index_.store(next_write, std::memory_order_release);
-        return true;
+    bool try_write(int64_t timestamp_ns, std::string_view log_message) {
+        return ring_.try_push_with([&](LogEntry& entry) {
+            const size_t copy_size = std::min(log_message.size(), LOG_ENTRY_SIZE - 1);
+            entry.timestamp_ns = timestamp_ns;
+            std::memcpy(entry.text.data(), log_message.data(), copy_size);
+            entry.text[copy_size] = '\0';
+        });
     }
 
-    std::optional<std::string_view> try_read() {
-        const size_t current_read = read_index_.load(std::memory_order_relaxed);
-        
-        if (current_read == write_index_.load(std::memory_order_acquire)) {
-            return std::nullopt; // Buffer is empty
+    // Oldest entry, nullptr if none; it stays valid until pop() (reader thread only)
+    const LogEntry* front() { return ring_.front(); }
+    void pop() { ring_.pop(); }
+
+    size_t capacity() const { return ring_.capacity(); }
+    bool empty() const { return ring_.empty(); }
+
+private:
+    MPSCRingBuffer<LogEntry> ring_;
+};
+
+/**
+ * LogSite - static description of one deferred log statement
+ *
+ * Each TE_LOG_* call site owns one; its address is the format id stored in
+ * log entries, so the format string is never copied or parsed on the
+ * logging thread.
+ */
+struct LogSite {
+    LogLevel level;
+    const char* format;
+};
+
+/**
+ * DeferredLogEntry - binary record of one deferred log statement
+ *
+ * Holds the site, the raw timestamp and the raw argument values. String
+ * arguments are copied into the entry (truncated to STRING_CAPACITY in
+ * total) since they rarely outlive the call.
+ */
+struct DeferredLogEntry {
+    static constexpr size_t MAX_ARGS = 8;
+    static constexpr size_t STRING_CAPACITY = 128;
+
+    enum class ArgType : uint8_t { INT, UINT, DOUBLE, STRING, POINTER };
+
+    struct StringRef {
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    union Arg {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+        StringRef s;
+    };
+
+    const LogSite* site = nullptr;
+    int64_t timestamp_ns = 0;
+    size_t thread_id = 0;
+    uint8_t arg_count = 0;
+    uint8_t string_bytes = 0;
+    ArgType types[MAX_ARGS];
+    Arg args[MAX_ARGS];
+    char strings[STRING_CAPACITY];
+
+    // Append one argument, mapping it onto the closest ArgType
+    template <typename T>
+    void push(const T& value) {
+        using V = std::decay_t<T>;
+        Arg& arg = args[arg_count];
+        ArgType& type = types[arg_count];
+        ++arg_count;
+
+        if constexpr (std::is_enum_v<V>) {
+            push_integer(arg, type, static_cast<std::underlying_type_t<V>>(value));
+        } else if constexpr (std::is_integral_v<V>) {
+            push_integer(arg, type, value);
+        } else if constexpr (std::is_floating_point_v<V>) {
+            type = ArgType::DOUBLE;
+            arg.d = static_cast<double>(value);
+        } else if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+            type = ArgType::STRING;
+            arg.s = copy_string(as_string_view(value));
+        } else if constexpr (std::is_pointer_v<V>) {
+            type = ArgType::POINTER;
+            arg.p = static_cast<const void*>(value);
+        } else {
+            static_assert(std::is_pointer_v<V>, "unsupported deferred log argument type");
         }
-        
-        std::string_view result(buffer_[current_read].data());
-        
-        const size_t next_read = (current_read + 1) % buffer_.size();
-        read_index_.store(next_read, std::memory_order_release);
-        
-        return result;
     }
 
 private:
-    std::vector<LogEntry> buffer_;
-    std::atomic<size_t> write_index_;
-    std::atomic<size_t> read_index_;
+    template <typename I>
+    static void push_integer(Arg& arg, ArgType& type, I value) {
+        if constexpr (std::is_signed_v<I>) {
+            type = ArgType::INT;
+            arg.i = static_cast<int64_t>(value);
+        } else {
+            type = ArgType::UINT;
+            arg.u = static_cast<uint64_t>(value);
+        }
+    }
+
+    template <typename S>
+    static std::string_view as_string_view(const S& value) {
+        if constexpr (std::is_convertible_v<const S&, const char*>) {
+            const char* str = value;
+            return str ? std::string_view(str) : std::string_view("(null)");
+        } else {
+            return std::string_view(value);
+        }
+    }
+
+    StringRef copy_string(std::string_view str) {
+        size_t length = std::min(str.size(), STRING_CAPACITY - string_bytes);
+        StringRef ref{string_bytes, static_cast<uint16_t>(length)};
+        std::memcpy(strings + string_bytes, str.data(), length);
+        string_bytes = static_cast<uint8_t>(string_bytes + length);
+        return ref;
+    }
 };
 
+// Render a deferred entry as a log line (no trailing newline) into `out`.
+// Returns the length written, always less than `size`.
+size_t format_deferred_entry(const DeferredLogEntry& entry, char* out, size_t size);
+
+// Never called; lets the compiler check TE_LOG_* formats against their arguments
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((format(printf, 1, 2)))
+#endif
+inline void check_log_format(const char*, ...) {}
+
 /**
  * High-performance lock-free logger implementation
+ *
+ * Two paths feed one flush thread. The member functions (info(), warn(), ...)
+ * format text on the calling thread. log_deferred(), used by the TE_LOG_*
+ * macros, copies only the call site, a timestamp and the raw arguments, and
+ * leaves all formatting to the flush thread. Both paths stamp their entries
+ * with Timer::now_ns() and the flush thread writes whichever is older next,
+ * so one thread's lines come out in the order it logged them. The flush
+ * thread spins, then yields, then parks; writers wake it only when it is
+ * parked.
  */
 class Logger {
 public:
     static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
     
+    // Idle flush-thread schedule: busy polls, then yields, then parks
+    static constexpr size_t SPIN_ITERATIONS = 2000;
+    static constexpr size_t YIELD_ITERATIONS = 200;
+    static constexpr std::chrono::milliseconds PARK_TIMEOUT{5};
+    
     explicit Logger(LogLevel min_level = LogLevel::INFO, 
                    size_t buffer_size = DEFAULT_BUFFER_SIZE)
         : min_level_(min_level), 
           buffer_(buffer_size), 
-          is_running_(true) {
+          deferred_(buffer_size),
+          is_running_(true),
+          parked_(false),
+          dropped_(0) {
         flush_thread_ = std::thread(&Logger::flush_worker, this);
     }
 
     ~Logger() {
         is_running_.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_one();
+        }
         if (flush_thread_.joinable()) {
             flush_thread_.join();
         }
@@ -128,214 +269,164 @@ public:
         min_level_.store(level, std::memory_order_relaxed);
     }
 
+    // Check whether messages at this level would be logged (runtime level only)
+    bool is_enabled(LogLevel level) const {
+        return level >= min_level_.load(std::memory_order_relaxed);
+    }
+
+    // Queue a log statement for formatting on the flush thread
+    template <typename... Args>
+    void log_deferred(const LogSite& site, const Args&... args) {
+        static_assert(sizeof...(Args) <= DeferredLogEntry::MAX_ARGS, "too many deferred log arguments");
+        if (!is_enabled(site.level)) {
+            return;
+        }
+
+        const int64_t timestamp_ns = Timer::now_ns();
+        bool written = deferred_.try_push_with([&](DeferredLogEntry& entry) {
+            entry.site = &site;
+            entry.timestamp_ns = timestamp_ns;
+            entry.thread_id = current_thread_id();
+            entry.arg_count = 0;
+            entry.string_bytes = 0;
+            (entry.push(args), ...);
+        });
+
+        if (written) {
+            wake_if_parked();
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Number of deferred entries lost because the ring was full
+    uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
     // Log with format string
     void log(LogLevel level, const char* format, ...) {
-        if (level < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(level)) {
             return;
         }
-
-        // Format timestamp and log level
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(level).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        // Format the user message
         va_list args;
         va_start(args, format);
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(level, format, args);
         va_end(args);
-        
-        if (msg_len < 0) {
-            return; // Formatting error
-        }
-
-        // Try to write to buffer
-        if (!buffer_.try_write(std::string_view(buffer, prefix_len + msg_len))) {
-            // Buffer full - could implement fallback strategy here
-        }
     }
 
     // Convenience methods for different log levels
     void trace(const char* format, ...) {
-        if (LogLevel::TRACE < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::TRACE)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::TRACE).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::TRACE, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
     void debug(const char* format, ...) {
-        if (LogLevel::DEBUG < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::DEBUG)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::DEBUG).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::DEBUG, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
     void info(const char* format, ...) {
-        if (LogLevel::INFO < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::INFO)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::INFO).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::INFO, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
     void warn(const char* format, ...) {
-        if (LogLevel::WARN < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::WARN)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::WARN).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::WARN, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
     void error(const char* format, ...) {
-        if (LogLevel::ERROR < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::ERROR)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::ERROR).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::ERROR, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
     void fatal(const char* format, ...) {
-        if (LogLevel::FATAL < min_level_.load(std::memory_order_relaxed)) {
+        if (!is_enabled(LogLevel::FATAL)) {
             return;
         }
-        
         va_list args;
         va_start(args, format);
-        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
-        int prefix_len = std::snprintf(buffer, sizeof(buffer), 
-                                      "[%s] [%s] [%zu] ", 
-                                      Timer::timestamp().c_str(), 
-                                      to_string(LogLevel::FATAL).data(),
-                                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        
-        int msg_len = std::vsnprintf(buffer + prefix_len, 
-                                     sizeof(buffer) - prefix_len, 
-                                     format, args);
+        write_text(LogLevel::FATAL, format, args);
         va_end(args);
-        
-        if (msg_len >= 0) {
-            buffer_.try_write(std::string_view(buffer, prefix_len + msg_len));
-        }
     }
 
 private:
-    // Worker thread that flushes log entries
-    void flush_worker() {
-        while (is_running_.load(std::memory_order_relaxed)) {
-            // Process any available log entries
-            while (auto entry = buffer_.try_read()) {
-                // Write to stdout
-                std::fprintf(stdout, "%s\n", entry->data());
-                
-                // Write to file if configured
-                if (file_output_ && file_output_->is_open()) {
-                    (*file_output_) << entry->data() << std::endl;
-                }
-            }
-            
-            // Sleep briefly to avoid burning CPU
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // Hash of the calling thread's id, computed once per thread
+    static size_t current_thread_id() {
+        thread_local const size_t id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return id;
+    }
+
+    // Format one line on the calling thread and queue it on the text ring
+    void write_text(LogLevel level, const char* format, va_list args) {
+        const int64_t timestamp_ns = Timer::now_ns();
+        char timestamp[48];
+        Timer::format_timestamp(timestamp_ns, timestamp, sizeof(timestamp));
+
+        char buffer[LogRingBuffer::LOG_ENTRY_SIZE];
+        int prefix_len = std::snprintf(buffer, sizeof(buffer), "[%s] [%s] [%zu] ",
+                                       timestamp, to_string(level).data(), current_thread_id());
+        int msg_len = std::vsnprintf(buffer + prefix_len, sizeof(buffer) - prefix_len, format, args);
+        if (msg_len < 0) {
+            return; // Formatting error
         }
-        
-        // Final flush on shutdown
-        while (auto entry = buffer_.try_read()) {
-            std::fprintf(stdout, "%s\n", entry->data());
-            if (file_output_ && file_output_->is_open()) {
-                (*file_output_) << entry->data() << std::endl;
-            }
+
+        size_t length = std::min(static_cast<size_t>(prefix_len + msg_len), sizeof(buffer) - 1);
+        if (buffer_.try_write(timestamp_ns, std::string_view(buffer, length))) {
+            wake_if_parked();
         }
     }
 
+    // Wake the flush thread if it is parked (cheap relaxed check otherwise)
+    void wake_if_parked() {
+        if (parked_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_one();
+        }
+    }
+
+    // Worker thread that flushes log entries
+    void flush_worker();
+
+    // Write out everything queued, both rings merged in timestamp order;
+    // returns the number of entries written
+    size_t drain();
+
+    // Write one formatted line to stdout and the file, if configured
+    void write_line(std::string_view line);
+
     std::atomic<LogLevel> min_level_;
     LogRingBuffer buffer_;
+    MPSCRingBuffer<DeferredLogEntry> deferred_;
     std::atomic<bool> is_running_;
+    std::atomic<bool> parked_;
+    std::atomic<uint64_t> dropped_;
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
     std::thread flush_thread_;
     std::unique_ptr<std::ofstream> file_output_;
 };
@@ -349,10 +440,66 @@ inline Logger& global_logger() {
 } // namespace core
 } // namespace trading_engine
 
-// Convenience macros
-#define TE_LOG_TRACE(...) ::trading_engine::core::global_logger().trace(__VA_ARGS__)
-#define TE_LOG_DEBUG(...) ::trading_engine::core::global_logger().debug(__VA_ARGS__)
-#define TE_LOG_INFO(...)  ::trading_engine::core::global_logger().info(__VA_ARGS__)
-#define TE_LOG_WARN(...)  ::trading_engine::core::global_logger().warn(__VA_ARGS__)
-#define TE_LOG_ERROR(...) ::trading_engine::core::global_logger().error(__VA_ARGS__)
-#define TE_LOG_FATAL(...) ::trading_engine::core::global_logger().fatal(__VA_ARGS__) 
\ No newline at end of file
+// Convenience macros. Formatting is deferred to the flush thread; arguments
+// are evaluated only when the level is enabled.
+#define TE_LOG_AT(level, fmt, ...)                                                              \
+    do {                                                                                        \
+        auto& te_logger_ = ::trading_engine::core::global_logger();                             \
+        if (te_logger_.is_enabled(level)) {                                                     \
+            static constexpr ::trading_engine::core::LogSite te_log_site_{level, fmt};          \
+            if (false) {                                                                        \
+                ::trading_engine::core::check_log_format(fmt __VA_OPT__(,) __VA_ARGS__);        \
+            }                                                                                   \
+            te_logger_.log_deferred(te_log_site_ __VA_OPT__(,) __VA_ARGS__);                    \
+        }                                                                                       \
+    } while (0)
+
+// Statement compiled out by TE_COMPILED_LOG_LEVEL: the format is still checked
+// and the arguments still count as used, but nothing is evaluated
+#define TE_LOG_DISABLED(...)                                                                    \
+    do {                                                                                        \
+        if (false) {                                                                            \
+            ::trading_engine::core::check_log_format(__VA_ARGS__);                              \
+        }                                                                                       \
+    } while (0)
+
+// True when a statement at `level` would be logged: compiled in and enabled at runtime
+#define TE_LOG_ENABLED(level)                                                                   \
+    ((level) >= ::trading_engine::core::COMPILED_LOG_LEVEL &&                                   \
+     ::trading_engine::core::global_logger().is_enabled(level))
+
+#if TE_COMPILED_LOG_LEVEL <= 0
+#define TE_LOG_TRACE(...) TE_LOG_AT(::trading_engine::core::LogLevel::TRACE, __VA_ARGS__)
+#else
+#define TE_LOG_TRACE(...) TE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if TE_COMPILED_LOG_LEVEL <= 1
+#define TE_LOG_DEBUG(...) TE_LOG_AT(::trading_engine::core::LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define TE_LOG_DEBUG(...) TE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if TE_COMPILED_LOG_LEVEL <= 2
+#define TE_LOG_INFO(...)  TE_LOG_AT(::trading_engine::core::LogLevel::INFO, __VA_ARGS__)
+#else
+#define TE_LOG_INFO(...)  TE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if TE_COMPILED_LOG_LEVEL <= 3
+#define TE_LOG_WARN(...)  TE_LOG_AT(::trading_engine::core::LogLevel::WARN, __VA_ARGS__)
+#else
+#define TE_LOG_WARN(...)  TE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if TE_COMPILED_LOG_LEVEL <= 4
+#define TE_LOG_ERROR(...) TE_LOG_AT(::trading_engine::core::LogLevel::ERROR, __VA_ARGS__)
+#else
+#define TE_LOG_ERROR(...) TE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if TE_COMPILED_LOG_LEVEL <= 5
+#define TE_LOG_FATAL(...) TE_LOG_AT(::trading_engine::core::LogLevel::FATAL, __VA_ARGS__)
+#else
+#define TE_LOG_FATAL(...) TE_LOG_DISABLED(__VA_ARGS__)
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace trading_engine {
+namespace core {
+
+/**
+ * MappedFile - a file mapped into memory with mmap
+ *
+ * Move-only owner of the mapping. Failures are reported through the
+ * return value of create()/open_read(); a failed call leaves the object
+ * closed. Returns false everywhere on platforms without mmap.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map `path` read-write at exactly `size` bytes, creating it (zero-filled)
+    // if missing. An existing file keeps its contents and is resized to `size`.
+    bool open_write(const std::string& path, size_t size);
+
+    // Map an existing file read-only
+    bool open_read(const std::string& path);
+
+    // Flush dirty pages to the file (blocking)
+    bool sync();
+
+    // Unmap and close
+    void close();
+
+    // Accessors
+    bool is_open() const { return data_ != nullptr; }
+    std::byte* data() { return data_; }
+    const std::byte* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    int fd_ = -1;
+    std::string path_;
+};
+
+} // namespace core
+} // namespace trading_engine
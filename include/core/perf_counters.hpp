@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading_engine {
+namespace core {
+
+/**
+ * PerfCounterValues - hardware event counts over one measured interval
+ *
+ * Events the kernel or CPU would not provide stay zero and clear their
+ * has_* flag; `valid` is false when no counter could be opened at all.
+ */
+struct PerfCounterValues {
+    bool valid = false;
+    bool has_cycles = false;
+    bool has_instructions = false;
+    bool has_cache_misses = false;
+    bool has_branch_misses = false;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+
+    double instructions_per_cycle() const {
+        return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+};
+
+/**
+ * PerfCounters - user-space cycle, instruction, cache-miss and branch-miss
+ * counters for the calling thread via Linux perf_event
+ *
+ * Opening fails quietly where perf_event is missing or restricted
+ * (e.g. perf_event_paranoid, containers); is_available() reports it.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool is_available() const { return group_fd_ >= 0; }
+
+    // Zero and enable the counters
+    void start();
+
+    // Disable the counters and read what accumulated since start()
+    PerfCounterValues stop();
+
+private:
+    enum Event : size_t { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+    int group_fd_ = -1;
+    std::array<int, EVENT_COUNT> fds_;
+    std::array<uint64_t, EVENT_COUNT> ids_{};
+};
+
+} // namespace core
+} // namespace trading_engine
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "core/cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace trading_engine {
+namespace core {
+
+/**
+ * Round up to the next power of two (minimum 1)
+ */
+constexpr size_t next_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Lock-free single-producer single-consumer ring buffer
+ *
+ * Capacity is rounded up to a power of two so slots are found with a mask.
+ * The producer and consumer indices live on separate cache lines, and each
+ * side caches the other's index so it only reloads it when the ring looks
+ * full (or empty). Batch operations publish a whole run of slots with a
+ * single release store.
+ */
+template <typename T>
+class SPSCRingBuffer {
+public:
+    explicit SPSCRingBuffer(size_t capacity)
+        : mask_(next_power_of_two(capacity) - 1),
+          slots_(mask_ + 1) {}
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // Producer: append a value, false if the ring is full
+    bool try_push(const T& value) {
+        return try_push_with([&](T& slot) { slot = value; });
+    }
+
+    // Producer: fill the next slot in place, false if the ring is full
+    template <typename Func>
+    bool try_push_with(Func&& fill) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (free_slots(tail) == 0) {
+            return false; // Ring is full
+        }
+
+        fill(slots_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer: append as many values as fit; returns how many were queued
+    size_t try_push_batch(std::span<const T> values) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t count = std::min(values.size(), free_slots(tail));
+
+        for (size_t i = 0; i < count; ++i) {
+            slots_[(tail + i) & mask_] = values[i];
+        }
+        if (count > 0) {
+            tail_.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer: take the oldest value, false if the ring is empty
+    bool try_pop(T& value) {
+        return try_pop_with([&](T& slot) { value = std::move(slot); });
+    }
+
+    // Consumer: hand the oldest slot to a callback, false if the ring is empty
+    template <typename Func>
+    bool try_pop_with(Func&& consume) {
+        T* slot = front();
+        if (!slot) {
+            return false; // Ring is empty
+        }
+
+        consume(*slot);
+        pop();
+        return true;
+    }
+
+    // Consumer: take up to out.size() values; returns how many were taken
+    size_t try_pop_batch(std::span<T> out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t count = std::min(out.size(), queued_slots(head));
+
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(slots_[(head + i) & mask_]);
+        }
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer: peek at the oldest slot without releasing it (nullptr if empty)
+    T* front() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        return queued_slots(head) == 0 ? nullptr : &slots_[head & mask_];
+    }
+
+    // Consumer: release the slot returned by front()
+    void pop() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Approximate number of queued values (exact when both sides are idle)
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    // Producer side: free slots after tail, refreshing the cached head if needed
+    size_t free_slots(size_t tail) {
+        size_t free = capacity() - (tail - head_cache_);
+        if (free == 0) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - head_cache_);
+        }
+        return free;
+    }
+
+    // Consumer side: queued slots after head, refreshing the cached tail if needed
+    size_t queued_slots(size_t head) {
+        size_t queued = tail_cache_ - head;
+        if (queued == 0) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            queued = tail_cache_ - head;
+        }
+        return queued;
+    }
+
+    const size_t mask_;
+    std::vector<T> slots_;
+
+    // Producer state
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t head_cache_ = 0;
+
+    // Consumer state
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;
+};
+
+/**
+ * Lock-free multi-producer single-consumer ring buffer
+ *
+ * A bounded sequence-numbered ring: producers claim positions with a CAS on
+ * the tail and publish each slot by advancing its sequence number, and the
+ * single consumer frees slots in order. A batch push claims a whole run of
+ * positions with one CAS, so its values stay contiguous in the ring.
+ */
+template <typename T>
+class MPSCRingBuffer {
+public:
+    explicit MPSCRingBuffer(size_t capacity)
+        : mask_(next_power_of_two(capacity) - 1),
+          slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+    MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+
+    // Producer (any thread): append a value, false if the ring is full
+    bool try_push(const T& value) {
+        return try_push_with([&](T& slot) { slot = value; });
+    }
+
+    // Producer (any thread): fill the next slot in place, false if the ring is full
+    template <typename Func>
+    bool try_push_with(Func&& fill) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[pos & mask_];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                // Slot is free for this position; try to claim it
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence < pos) {
+                return false; // Ring is full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed); // Another producer won
+            }
+        }
+
+        fill(slot->value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer (any thread): append as many values as fit; returns how many were queued
+    size_t try_push_batch(std::span<const T> values) {
+        if (values.empty()) {
+            return 0;
+        }
+
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        size_t count;
+        while (true) {
+            const size_t head = head_.load(std::memory_order_acquire);
+            count = std::min(values.size(), capacity() - (pos - head));
+            if (count == 0) {
+                return 0; // Ring is full
+            }
+            if (tail_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            Slot& slot = slots_[(pos + i) & mask_];
+            slot.value = values[i];
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer: take the oldest value, false if the ring is empty
+    bool try_pop(T& value) {
+        return try_pop_with([&](T& slot) { value = std::move(slot); });
+    }
+
+    // Consumer: hand the oldest slot to a callback, false if the ring is empty
+    template <typename Func>
+    bool try_pop_with(Func&& consume) {
+        T* slot = front();
+        if (!slot) {
+            return false; // Ring is empty
+        }
+
+        consume(*slot);
+        pop();
+        return true;
+    }
+
+    // Consumer: take up to out.size() values; returns how many were taken
+    size_t try_pop_batch(std::span<T> out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < out.size()) {
+            Slot& slot = slots_[(head + count) & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head + count + 1) {
+                break; // Not yet published
+            }
+            out[count] = std::move(slot.value);
+            slot.sequence.store(head + count + capacity(), std::memory_order_release);
+            ++count;
+        }
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer: peek at the oldest published slot without releasing it (nullptr if none)
+    T* front() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[head & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return nullptr;
+        }
+        return &slot.value;
+    }
+
+    // Consumer: release the slot returned by front()
+    void pop() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        slots_[head & mask_].sequence.store(head + capacity(), std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Approximate number of claimed slots (exact when all sides are idle)
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Shared producer state
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+
+    // Consumer state
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+};
+
+} // namespace core
+} // namespace trading_engine
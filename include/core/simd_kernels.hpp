@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trading_engine {
+namespace core {
+namespace simd {
+
+/**
+ * Vectorized kernels over contiguous int64 arrays
+ *
+ * Used by the book's depth queries, which keep level prices and quantities
+ * in parallel arrays. On x86-64 the AVX2 versions are picked at run time
+ * when the CPU has AVX2, so the default build needs no -march flag; on
+ * AArch64 NEON is always there. Everything else gets the scalar versions,
+ * which give the same results.
+ */
+
+// Sum of values[0, count)
+int64_t sum(const int64_t* values, size_t count);
+
+// Sum of a[i] * b[i] with wrapping 64-bit arithmetic; callers bound the
+// products when the result has to be exact
+int64_t dot(const int64_t* a, const int64_t* b, size_t count);
+
+// Length of the leading run of `sorted` that lies within `limit`: values
+// <= limit for an ascending array, >= limit for a descending one
+size_t count_within(const int64_t* sorted, size_t count, int64_t limit, bool descending);
+
+// Index of the first element at which the running total of `values`
+// reaches `target` (count if it never does). `before` receives the total of
+// the elements ahead of that index. Values must not be negative.
+size_t prefix_search(const int64_t* values, size_t count, int64_t target, int64_t& before);
+
+// Instruction set the kernels run on: "avx2", "neon" or "scalar"
+const char* active_isa();
+
+} // namespace simd
+} // namespace core
+} // namespace trading_engine
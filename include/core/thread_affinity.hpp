@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace trading_engine {
+namespace core {
+
+// Number of hardware threads available (at least 1)
+size_t hardware_thread_count();
+
+// Pin the calling thread to a single CPU; returns false if unsupported or it fails
+bool pin_current_thread(int cpu);
+
+// CPUs the calling thread may currently run on (empty if unsupported)
+std::vector<int> current_thread_cpus();
+
+// Pin the calling thread to any of `cpus`; returns false if unsupported or it fails
+bool set_current_thread_cpus(const std::vector<int>& cpus);
+
+/**
+ * ScopedThreadPin - pins the calling thread for a scope, then restores the
+ * affinity it had before. A negative cpu leaves the thread alone.
+ */
+class ScopedThreadPin {
+public:
+    explicit ScopedThreadPin(int cpu);
+    ~ScopedThreadPin();
+
+    ScopedThreadPin(const ScopedThreadPin&) = delete;
+    ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+    bool pinned() const { return pinned_; }
+
+private:
+    std::vector<int> previous_;
+    bool pinned_ = false;
+};
+
+} // namespace core
+} // namespace trading_engine
@@ -1,13 +1,133 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <string>
 #include <utility>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TE_HAS_TSC 1
+#endif
+
 namespace trading_engine {
 namespace core {
 
+/**
+ * ClockSource - where Timer and order timestamps read the time from
+ */
+enum class ClockSource : uint8_t {
+    SYSTEM,  // std::chrono::system_clock
+    TSC      // Calibrated time-stamp counter (see TscClock)
+};
+
+/**
+ * TscClock - nanoseconds since the epoch from the CPU time-stamp counter
+ *
+ * A read is one rdtsc plus a multiply against the current calibration,
+ * which maps cycles onto system_clock nanoseconds. calibrate() measures
+ * the cycle rate once; recalibrate() refines it against the whole span
+ * since calibration, keeping the clock continuous. Readers never lock:
+ * the calibration is published under a sequence counter. Nothing else
+ * refreshes the rate: start_recalibration() runs a background thread that
+ * recalibrates periodically (selecting the TSC clock source starts it), and
+ * loops that would rather drive it themselves call maybe_recalibrate().
+ */
+class TscClock {
+public:
+    // Whether the CPU has an invariant TSC this clock can use
+    static bool is_available();
+
+    // Raw counter reads; cycles_ordered() waits for earlier instructions (rdtscp)
+    static uint64_t cycles() {
+#if defined(TE_HAS_TSC)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    static uint64_t cycles_ordered() {
+#if defined(TE_HAS_TSC)
+        unsigned int aux;
+        return __rdtscp(&aux);
+#else
+        return 0;
+#endif
+    }
+
+    // Current time in nanoseconds since the epoch (0 until calibrated)
+    static int64_t now_ns() {
+        const uint64_t now = cycles();
+        while (true) {
+            // Acquire loads keep the version re-check after the field reads
+            const uint32_t version = version_.load(std::memory_order_acquire);
+            const uint64_t base_cycles = base_cycles_.load(std::memory_order_acquire);
+            const int64_t base_ns = base_ns_.load(std::memory_order_acquire);
+            const uint64_t scale = scale_.load(std::memory_order_acquire);
+            if ((version & 1) == 0 && version_.load(std::memory_order_relaxed) == version) {
+                return now >= base_cycles ? base_ns + to_ns(now - base_cycles, scale)
+                                          : base_ns - to_ns(base_cycles - now, scale);
+            }
+        }
+    }
+
+    // Measure the cycle rate against system_clock over `window` (blocks for it)
+    static bool calibrate(std::chrono::microseconds window = std::chrono::milliseconds(10));
+
+    // Refine the rate over the span since calibrate(), without blocking
+    static void recalibrate();
+
+    // recalibrate() if RECALIBRATE_INTERVAL has passed since the last refinement
+    static void maybe_recalibrate();
+
+    // Run recalibrate() every `interval` on a background thread until
+    // stop_recalibration(). False if the clock isn't calibrated yet.
+    static bool start_recalibration(std::chrono::milliseconds interval = RECALIBRATE_INTERVAL);
+    static void stop_recalibration();
+    static bool is_recalibrating();
+
+    // Number of refinements published since startup
+    static uint64_t recalibration_count();
+
+    // Calibrated counter frequency (0 until calibrated)
+    static double cycles_per_ns();
+    static bool is_calibrated() { return scale_.load(std::memory_order_relaxed) != 0; }
+
+    static constexpr std::chrono::seconds RECALIBRATE_INTERVAL{1};
+
+private:
+    // Cycles to nanoseconds with a 32.32 fixed-point scale, split so the product cannot overflow
+    static int64_t to_ns(uint64_t delta, uint64_t scale) {
+        return static_cast<int64_t>((delta >> 32) * scale + (((delta & 0xffffffffULL) * scale) >> 32));
+    }
+
+    // Publish a new calibration under the sequence counter (writers are serialized)
+    static void publish(uint64_t base_cycles, int64_t base_ns, uint64_t scale);
+
+    static inline std::atomic<uint32_t> version_{0};
+    static inline std::atomic<uint64_t> base_cycles_{0};
+    static inline std::atomic<int64_t> base_ns_{0};
+    static inline std::atomic<uint64_t> scale_{0};  // Nanoseconds per cycle, 32.32 fixed point
+};
+
+namespace detail {
+inline std::atomic<ClockSource> clock_source{ClockSource::SYSTEM};
+}
+
+// Select the clock behind Timer and order timestamps. Selecting TSC calibrates
+// it first and starts its background recalibration; selecting SYSTEM stops it.
+// Returns false (and keeps the current source) if no usable TSC exists.
+bool set_clock_source(ClockSource source);
+
+inline ClockSource clock_source() {
+    return detail::clock_source.load(std::memory_order_relaxed);
+}
+
 /**
  * High-resolution timer utility for performance-critical applications.
  * Provides nanosecond precision timing capabilities.
@@ -20,69 +140,83 @@ public:
     using Duration = Clock::duration;
 
     // Constructor starts the timer
-    Timer() : start_time_(Clock::now()) {}
+    Timer() : start_ns_(now_ns()) {}
 
     // Reset the timer
     void reset() {
-        start_time_ = Clock::now();
+        start_ns_ = now_ns();
     }
 
     // Get elapsed time in various units
     int64_t elapsed_ns() const {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(
-            Clock::now() - start_time_).count();
+        return now_ns() - start_ns_;
     }
 
     int64_t elapsed_us() const {
-        return std::chrono::duration_cast<std::chrono::microseconds>(
-            Clock::now() - start_time_).count();
+        return elapsed_ns() / 1000;
     }
 
     int64_t elapsed_ms() const {
-        return std::chrono::duration_cast<std::chrono::milliseconds>(
-            Clock::now() - start_time_).count();
+        return elapsed_ns() / 1000000;
     }
 
     double elapsed_seconds() const {
-        return std::chrono::duration_cast<std::chrono::duration<double>>(
-            Clock::now() - start_time_).count();
+        return static_cast<double>(elapsed_ns()) / 1e9;
     }
 
-    // Get current time since epoch in nanoseconds
+    // Get current time since epoch in nanoseconds from the selected clock source
     static int64_t now_ns() {
+        if (clock_source() == ClockSource::TSC) {
+            return TscClock::now_ns();
+        }
+        return system_now_ns();
+    }
+
+    // Get current time since epoch in nanoseconds from std::chrono::system_clock
+    static int64_t system_now_ns() {
         return std::chrono::duration_cast<std::chrono::nanoseconds>(
-            Clock::now().time_since_epoch()).count();
+            std::chrono::system_clock::now().time_since_epoch()).count();
     }
 
     // Get current time since epoch in microseconds
     static int64_t now_us() {
-        return std::chrono::duration_cast<std::chrono::microseconds>(
-            Clock::now().time_since_epoch()).count();
+        return now_ns() / 1000;
     }
 
     // Get current time since epoch in milliseconds
     static int64_t now_ms() {
-        return std::chrono::duration_cast<std::chrono::milliseconds>(
-            Clock::now().time_since_epoch()).count();
+        return now_ns() / 1000000;
     }
 
     // Get current timestamp for logging (formatted as needed)
     static std::string timestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto now_time = std::chrono::system_clock::to_time_t(now);
-        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            now.time_since_epoch()).count() % 1000000000;
-
-        char time_str[32];
-        std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", std::localtime(&now_time));
-        
         char buffer[48];
-        std::snprintf(buffer, sizeof(buffer), "%s.%09ld", time_str, ns);
+        format_timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count(), buffer, sizeof(buffer));
         return std::string(buffer);
     }
 
+    // Format nanoseconds since the epoch as local "YYYY-MM-DD HH:MM:SS.nnnnnnnnn"
+    static size_t format_timestamp(int64_t epoch_ns, char* buffer, size_t size) {
+        std::time_t seconds = static_cast<std::time_t>(epoch_ns / 1000000000);
+        long ns = static_cast<long>(epoch_ns % 1000000000);
+
+        std::tm local_time{};
+#if defined(_WIN32)
+        localtime_s(&local_time, &seconds);
+#else
+        localtime_r(&seconds, &local_time);
+#endif
+
+        char time_str[32];
+        std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &local_time);
+
+        int written = std::snprintf(buffer, size, "%s.%09ld", time_str, ns);
+        return written < 0 ? 0 : std::min(static_cast<size_t>(written), size == 0 ? 0 : size - 1);
+    }
+
 private:
-    TimePoint start_time_;
+    int64_t start_ns_;
 };
 
 } // namespace core
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "core/ring_buffer.hpp"
+#include "orderbook/order_book.hpp"
+#include "orderbook/order_command.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::MatchSink;
+using orderbook::OrderBook;
+using orderbook::OrderBookConfig;
+using orderbook::OrderCommand;
+using orderbook::OrderMatch;
+using orderbook::Symbol;
+using orderbook::SymbolId;
+
+/**
+ * MatchingEngineConfig - construction-time options for a MatchingEngine
+ */
+struct MatchingEngineConfig {
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 65536;
+    static constexpr size_t DEFAULT_DRAIN_BATCH = 64;
+
+    // Number of worker threads; symbols are sharded across them by id
+    size_t worker_count = 1;
+
+    // CPU to pin each worker to (by worker index); missing entries stay unpinned
+    std::vector<int> worker_cpus;
+
+    // Inbound command slots per worker (rounded up to a power of two)
+    size_t queue_capacity = DEFAULT_QUEUE_CAPACITY;
+
+    // Most commands a worker takes off its queue at once
+    size_t drain_batch = DEFAULT_DRAIN_BATCH;
+
+    // Slots in each worker's market-data bus (0 leaves the buses off). Every
+    // book on a worker publishes onto that worker's bus; readers that fall
+    // more than about 3/4 of this behind lose the oldest events.
+    size_t market_data_bus_capacity = 0;
+
+    // Pre-trade gate attached to every book (nullptr for none); must outlive the engine
+    orderbook::RiskGate* risk_gate = nullptr;
+
+    // Book options used by add_symbol() when none are given
+    OrderBookConfig book_config;
+};
+
+/**
+ * MatchingEngine - owns one OrderBook per symbol and runs them on worker threads
+ *
+ * Symbols are registered before start() and keep their SymbolRegistry ids,
+ * which are dense process-wide, so books are found by direct indexing. Each id
+ * is owned by exactly one worker (id % worker_count), and every worker drains
+ * its own command queue in batches, so a book is only ever touched by one
+ * thread and the matching path takes no locks. The queues are MPSC rings, so
+ * any number of gateway threads may call submit() concurrently.
+ */
+class MatchingEngine {
+public:
+    // Called on the worker thread for every fill
+    using MatchHandler = std::function<void(SymbolId, const OrderMatch&)>;
+
+    // Called on the worker thread with a requested book image (see
+    // OrderBook::write_snapshot) and the book's market-data sequence at the time
+    using SnapshotHandler = std::function<void(SymbolId, std::span<const std::byte> image, uint64_t sequence)>;
+
+    explicit MatchingEngine(const MatchingEngineConfig& config = {});
+    ~MatchingEngine();
+
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    // Register a symbol (before start); returns the existing id if already known
+    SymbolId add_symbol(const Symbol& symbol);
+    SymbolId add_symbol(const Symbol& symbol, const OrderBookConfig& config);
+
+    // Look up a symbol id (INVALID_SYMBOL_ID if this engine doesn't trade it)
+    SymbolId find_symbol(const Symbol& symbol) const;
+
+    // Set the fill callback (before start)
+    void set_match_handler(MatchHandler handler);
+
+    // Set the snapshot callback (before start)
+    void set_snapshot_handler(SnapshotHandler handler);
+
+    // Start the worker threads
+    bool start();
+
+    // Drain the queues and join the workers
+    void stop();
+
+    // Queue a command for the worker owning its symbol; false if full or unknown
+    bool submit(const OrderCommand& command);
+
+    // Queue a run of commands that all belong to the same worker; returns how many were queued
+    size_t submit_batch(std::span<const OrderCommand> commands);
+
+    // Queue a request for an image of a symbol's book. The owning worker
+    // writes it between the commands queued before and after the request and
+    // passes it to the snapshot handler; false if full or unknown.
+    bool request_snapshot(SymbolId symbol_id) { return submit(OrderCommand::snapshot(symbol_id)); }
+
+    // Apply a command on the calling thread (only while stopped)
+    bool execute(const OrderCommand& command, MatchSink& sink);
+
+    // Get the book for a symbol (inspect only while stopped)
+    OrderBook* book(SymbolId symbol_id);
+    const OrderBook* book(SymbolId symbol_id) const;
+
+    // Worker that owns a symbol
+    size_t worker_for(SymbolId symbol_id) const { return symbol_id % workers_.size(); }
+
+    // Market-data bus a worker's books publish onto (nullptr if the buses are off).
+    // Readers take a cursor with subscribe() and poll it from their own thread.
+    const orderbook::MarketDataBus* market_data_bus(size_t worker) const;
+    const orderbook::MarketDataBus* market_data_bus_for(SymbolId symbol_id) const;
+
+    // Number of commands a worker has processed
+    uint64_t processed_count(size_t worker) const;
+
+    // Accessors
+    size_t symbol_count() const { return symbol_count_; }
+    size_t worker_count() const { return workers_.size(); }
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    const MatchingEngineConfig& config() const { return config_; }
+
+private:
+    struct Worker {
+        explicit Worker(size_t queue_capacity) : queue(queue_capacity) {}
+
+        core::MPSCRingBuffer<OrderCommand> queue;
+        std::unique_ptr<orderbook::MarketDataBus> bus;   // Written only by this worker
+        orderbook::MatchBuffer fills;
+        std::vector<std::byte> snapshot;                 // Image buffer, reused between requests
+        std::thread thread;
+        std::atomic<uint64_t> processed{0};
+    };
+
+    // Worker thread body
+    void run_worker(size_t index);
+
+    // Apply one command to its book, reporting fills to the sink
+    void process(const OrderCommand& command, MatchSink& sink);
+
+    // Write a book's image into `buffer` and hand it to the snapshot handler
+    void serve_snapshot(SymbolId symbol_id, std::vector<std::byte>& buffer);
+
+    // Check whether this engine has a book for a symbol
+    bool has_book(SymbolId symbol_id) const { return symbol_id < books_.size() && books_[symbol_id]; }
+
+    MatchingEngineConfig config_;
+    std::vector<std::unique_ptr<OrderBook>> books_;      // Indexed by SymbolId (null if not traded here)
+    size_t symbol_count_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    MatchHandler match_handler_;
+    SnapshotHandler snapshot_handler_;
+    std::atomic<bool> running_;
+};
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "market/replay.hpp"
+#include "orderbook/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::OrderId;
+using orderbook::Price;
+using orderbook::Quantity;
+using orderbook::Timestamp;
+
+/**
+ * Distribution - shape of a generated price offset or order size
+ *
+ * UNIFORM picks evenly over the range; GEOMETRIC makes each step away from
+ * the low end `decay` times less likely than the one before, which is how
+ * resting depth thins out away from the touch.
+ */
+enum class Distribution : uint8_t {
+    UNIFORM,
+    GEOMETRIC
+};
+
+/**
+ * OrderGeneratorConfig - what an OrderGenerator produces
+ *
+ * Probabilities are per generated command and are checked in the order
+ * cancel, modify, market; whatever is left is a new limit order. The first
+ * warmup_orders commands are all resting limit orders, to give the flow a
+ * book to act on.
+ */
+struct OrderGeneratorConfig {
+    static constexpr size_t DEFAULT_MAX_LIVE_ORDERS = 100000;
+
+    // Same seed and config, same command sequence
+    uint64_t seed = 1;
+
+    // Symbols to trade, picked uniformly (a config without any generates nothing)
+    std::vector<orderbook::SymbolId> symbols;
+
+    // Starting mid price of every symbol and the grid prices sit on
+    Price mid_price = Price(100.0);
+    Price tick_size = Price(0.01);
+
+    // Chance per command that a symbol's mid moves one tick up or down
+    double mid_walk_probability = 0.01;
+
+    // Limit prices: ticks behind the mid (from 1 to max_price_ticks), and the
+    // chance an order is priced through the mid instead so that it trades
+    Distribution price_distribution = Distribution::GEOMETRIC;
+    uint32_t max_price_ticks = 20;
+    double price_decay = 0.7;
+    double cross_probability = 0.05;
+
+    // Sizes: a number of lots from min_lots to max_lots
+    Distribution size_distribution = Distribution::UNIFORM;
+    Quantity lot_size = Quantity(1.0);
+    uint32_t min_lots = 1;
+    uint32_t max_lots = 10;
+    double size_decay = 0.5;
+
+    // Command mix; a modify changes the size, and with reprice_probability
+    // moves the order to a fresh price behind the mid as well
+    double cancel_probability = 0.3;
+    double modify_probability = 0.05;
+    double reprice_probability = 0.0;
+    double market_probability = 0.01;
+
+    // Market orders are this many times a drawn size (sweeps through the book)
+    uint32_t market_size_multiplier = 1;
+
+    // New limit orders, never crossing, generated before the mix applies
+    size_t warmup_orders = 0;
+
+    // Orders tracked for cancels and modifies; past this, cancels are forced
+    size_t max_live_orders = DEFAULT_MAX_LIVE_ORDERS;
+
+    // Arrival rate of the record timestamps (commands per second), evenly
+    // spaced or with exponential gaps (a Poisson process)
+    double rate = 1'000'000.0;
+    bool poisson_arrivals = true;
+    Timestamp start_time = 0;
+
+    // First order id handed out
+    OrderId first_order_id = 1;
+};
+
+/**
+ * OrderGenerator - seeded synthetic order flow
+ *
+ * Produces new orders around a per-symbol mid that random-walks, plus
+ * cancels and modifies of orders it generated earlier, as timestamped
+ * records (see ReplaySource). Random numbers come from a built-in
+ * xoshiro256** generator so the sequence doesn't depend on the standard
+ * library's distributions. The generator doesn't see fills, so some cancels
+ * and modifies name orders that have already traded away; books ignore those.
+ */
+class OrderGenerator : public ReplaySource {
+public:
+    explicit OrderGenerator(const OrderGeneratorConfig& config);
+
+    // Next record (never nullptr unless the config has no symbols)
+    const JournalRecord* next() override;
+
+    // Fill `out` with commands; returns how many were written
+    size_t generate(std::span<orderbook::OrderCommand> out);
+
+    // Start over from the seed
+    void reset();
+
+    // Accessors
+    uint64_t generated() const { return record_.sequence; }
+    size_t live_orders() const { return live_.size(); }
+    Price mid_price(size_t symbol_index) const { return mids_[symbol_index]; }
+    const OrderGeneratorConfig& config() const { return config_; }
+
+private:
+    struct LiveOrder {
+        uint32_t symbol_index = 0;
+        OrderId order_id = orderbook::INVALID_ORDER_ID;
+        orderbook::Side side = orderbook::Side::BUY;
+    };
+
+    // Raw 64 random bits, a double in [0, 1), and an integer in [0, bound)
+    uint64_t next_bits();
+    double next_unit();
+    uint64_t next_below(uint64_t bound);
+
+    // Draw from [low, high] with the given shape
+    uint32_t draw(Distribution distribution, uint32_t low, uint32_t high, double decay);
+
+    void make_command(orderbook::OrderCommand& command);
+    void make_new_order(orderbook::OrderCommand& command, uint32_t symbol_index, bool market, bool may_cross);
+    Price draw_price(uint32_t symbol_index, orderbook::Side side, bool may_cross);
+    Quantity draw_quantity();
+    LiveOrder take_live(bool remove);
+
+    OrderGeneratorConfig config_;
+    uint64_t state_[4] = {};
+    std::vector<Price> mids_;
+    std::vector<LiveOrder> live_;
+    OrderId next_order_id_ = orderbook::INVALID_ORDER_ID;
+    double clock_ = 0.0;            // Time of the next record, in nanoseconds
+    JournalRecord record_;
+};
+
+} // namespace market
+} // namespace trading_engine
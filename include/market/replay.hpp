@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core/mapped_file.hpp"
+#include "orderbook/journal.hpp"
+#include "orderbook/order_command.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::JournalRecord;
+
+/**
+ * ReplaySource - a stream of timestamped order commands
+ *
+ * Generators and file readers hand out JournalRecords, the same records the
+ * journal stores, so anything that can replay a journal can replay them.
+ */
+class ReplaySource {
+public:
+    virtual ~ReplaySource() = default;
+
+    // Next record, or nullptr at the end. The pointer stays valid until the next call.
+    virtual const JournalRecord* next() = 0;
+};
+
+// Parse a decimal like "-12.3456" straight into a Price/Quantity raw value
+// (4 implied decimals) with no floating point. Further digits round half away
+// from zero, as Price(double) does. False on anything else or on overflow.
+bool parse_fixed_point(std::string_view text, int64_t& raw);
+
+/**
+ * CsvReplaySource - order flow from a memory-mapped CSV file
+ *
+ * One command per line:
+ *
+ *   timestamp_ns,action,symbol,order_id,side,type,price,quantity,tif
+ *
+ * action is N (new), C (cancel) or M (modify); side B or S; type L (limit)
+ * or M (market); tif GTC, IOC or FOK (GTC if empty). Cancels need only the
+ * first four fields. A modify leaves an empty price or quantity unchanged.
+ * Blank lines, '#' comments and a header line are skipped. Symbols are
+ * looked up in the global SymbolRegistry. Rows that don't parse or name an
+ * unknown symbol are skipped and counted.
+ */
+class CsvReplaySource : public ReplaySource {
+public:
+    // Map `path`; check is_open() afterwards
+    explicit CsvReplaySource(const std::string& path);
+
+    const JournalRecord* next() override;
+
+    bool is_open() const { return file_.is_open(); }
+
+    // Rows that were skipped, and the line of the first one (0 if none)
+    uint64_t errors() const { return errors_; }
+    uint64_t first_error_line() const { return first_error_line_; }
+
+private:
+    // Parse one line into record_; false if it isn't a command
+    bool parse_line(std::string_view line);
+    orderbook::SymbolId resolve(std::string_view name);
+
+    core::MappedFile file_;
+    const char* position_ = nullptr;
+    const char* end_ = nullptr;
+    uint64_t line_ = 0;
+    uint64_t errors_ = 0;
+    uint64_t first_error_line_ = 0;
+    JournalRecord record_;
+    std::vector<std::pair<std::string, orderbook::SymbolId>> symbols_;   // Names seen so far
+};
+
+/**
+ * JournalReplaySource - order flow from journal segments
+ *
+ * The binary replay format is the journal itself: fixed 64-byte records in
+ * mapped segment files, read in place with no parsing. CSV flow is
+ * converted once with convert_csv_to_journal().
+ */
+class JournalReplaySource : public ReplaySource {
+public:
+    explicit JournalReplaySource(std::string directory) : reader_(std::move(directory)) {}
+
+    const JournalRecord* next() override { return reader_.next(); }
+
+private:
+    orderbook::JournalReader reader_;
+};
+
+// Write every command of a CSV file into a new journal in `directory` at its
+// CSV timestamp. Returns the number of records written; `errors` receives
+// the number of CSV rows skipped.
+uint64_t convert_csv_to_journal(const std::string& csv_path, const orderbook::JournalConfig& journal,
+                                uint64_t* errors = nullptr);
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "market/matching_engine.hpp"
+#include "market/replay.hpp"
+#include <cstdint>
+
+namespace trading_engine {
+namespace market {
+
+/**
+ * ReplayPacing - how fast a ReplayDriver feeds records
+ */
+enum class ReplayPacing : uint8_t {
+    AS_FAST_AS_POSSIBLE,   // Back to back, waiting only for queue space
+    WALL_CLOCK             // At the records' own spacing, scaled by speed
+};
+
+/**
+ * ReplayConfig - options for one ReplayDriver run
+ */
+struct ReplayConfig {
+    ReplayPacing pacing = ReplayPacing::AS_FAST_AS_POSSIBLE;
+
+    // WALL_CLOCK only: 2.0 replays twice as fast as recorded
+    double speed = 1.0;
+
+    // Stop after this many records (0 runs the source to its end)
+    uint64_t max_records = 0;
+};
+
+/**
+ * ReplayStats - what a ReplayDriver run did
+ */
+struct ReplayStats {
+    uint64_t records = 0;      // Records read from the source
+    uint64_t applied = 0;      // Commands queued (or applied) for the engine
+    uint64_t skipped = 0;      // Commands for symbols the engine doesn't trade
+    uint64_t fills = 0;        // Fills seen (stopped engine only)
+    int64_t elapsed_ns = 0;
+
+    // Records per second over the run
+    double rate() const { return elapsed_ns > 0 ? static_cast<double>(records) * 1e9 / static_cast<double>(elapsed_ns) : 0.0; }
+};
+
+/**
+ * ReplayDriver - feeds a ReplaySource into a MatchingEngine
+ *
+ * A running engine gets the commands through submit(), retrying while a
+ * queue is full, so the driver is one more producer for its queues. A
+ * stopped engine is driven synchronously on the calling thread instead:
+ * each command is applied to its book at the record's timestamp, like
+ * journal replay, so a backtest gives the same result every run.
+ */
+class ReplayDriver {
+public:
+    explicit ReplayDriver(MatchingEngine& engine, const ReplayConfig& config = {});
+
+    // Feed the source until it ends or max_records is reached
+    ReplayStats run(ReplaySource& source);
+
+    const ReplayConfig& config() const { return config_; }
+
+private:
+    MatchingEngine& engine_;
+    ReplayConfig config_;
+    orderbook::MatchBuffer fills_;
+};
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "market/matching_engine.hpp"
+#include "network/protocol.hpp"
+#include "network/tcp_server.hpp"
+#include "orderbook/market_data.hpp"
+#include "orderbook/match_sink.hpp"
+#include "orderbook/order_book.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading_engine {
+namespace network {
+
+/**
+ * MarketDataPublisherConfig - construction-time options for a MarketDataPublisher
+ */
+struct MarketDataPublisherConfig {
+    static constexpr size_t DEFAULT_MAX_PACKET_SIZE = 1472;   // 1500-byte MTU less IP and UDP headers
+    static constexpr size_t DEFAULT_RETRANSMIT_PACKETS = 1024;
+    static constexpr size_t DEFAULT_POLL_BATCH = 256;
+    static constexpr size_t DEFAULT_MAX_SESSION_SEND_BYTES = TcpServerConfig::DEFAULT_MAX_SEND_BYTES;
+
+    // Where packets go; a multicast group gets the multicast options below,
+    // any other address is sent to as plain unicast
+    std::string group_address = "239.255.0.1";
+    uint16_t group_port = 31000;
+
+    // Local interface to multicast from (empty: the system default)
+    std::string interface_address;
+    int multicast_ttl = 1;
+    bool multicast_loop = true;
+
+    // Largest datagram sent, header included
+    size_t max_packet_size = DEFAULT_MAX_PACKET_SIZE;
+
+    // Most recent packets kept for retransmit requests
+    size_t retransmit_packets = DEFAULT_RETRANSMIT_PACKETS;
+
+    // Address and port of the TCP recovery channel (port 0 picks a free one)
+    std::string recovery_address = "127.0.0.1";
+    uint16_t recovery_port = 0;
+
+    // Reply bytes a recovery session may have queued; one that goes over
+    // (it is not reading, or a snapshot image is larger) is dropped
+    size_t max_session_send_bytes = DEFAULT_MAX_SESSION_SEND_BYTES;
+
+    // Most events read from one bus per pass
+    size_t poll_batch = DEFAULT_POLL_BATCH;
+
+    // CPU to pin the publisher thread to (-1 leaves it unpinned)
+    int cpu = -1;
+
+    // Longest the thread sleeps in epoll_wait when there are no events
+    int poll_timeout_ms = 1;
+};
+
+/**
+ * MarketDataPublisher - UDP multicast feed of a MatchingEngine's book events
+ *
+ * One thread reads every worker's market-data bus and packs the events,
+ * unchanged, into sequence-numbered datagrams of up to max_packet_size
+ * bytes (see PacketHeader). A packet is sent when it is full or when the
+ * buses run dry, so there is one send per packet, never one per event, and
+ * the matching threads never see a subscriber.
+ *
+ * Receivers that miss packets recover over a TCP channel served by the
+ * same thread: a RETRANSMIT_REQUEST returns recent packets from a fixed
+ * retention ring, and a SNAPSHOT_REQUEST returns a book snapshot image
+ * (OrderBook::write_snapshot). The images come from a shadow book per
+ * symbol that the publisher keeps in step with the events it sends, so a
+ * snapshot always lines up exactly with the feed and taking one never
+ * touches the live books. Shadow books hold resting orders only, without
+ * owners. Events come off the buses as validated copies only; when a bus
+ * drops or discards events, every symbol on that worker is answered STALE
+ * while its shadow is re-seeded: the publisher asks the engine for an image of the
+ * live book (MatchingEngine::request_snapshot), which the book's own worker
+ * writes between two commands, holds that symbol's events until the feed
+ * has caught up with the image, then restores the image and replays the
+ * events that followed it. Replies are
+ * queued per session up to max_session_send_bytes, and a session that lets
+ * them pile up past that is dropped.
+ *
+ * start() must be called while the engine is stopped: the shadow books are
+ * seeded from the live books then, and the engine's snapshot handler is
+ * taken over for re-seeding.
+ */
+class MarketDataPublisher : private TcpHandler {
+public:
+    explicit MarketDataPublisher(market::MatchingEngine& engine, const MarketDataPublisherConfig& config = {});
+    ~MarketDataPublisher() override;
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    // Open the sockets, seed the shadow books and start the thread. False if
+    // the engine is running, has no market-data buses or a socket fails.
+    bool start();
+
+    // Send what is buffered, close the recovery sessions and join the thread
+    void stop();
+
+    // Port the recovery channel listens on (0 before start)
+    uint16_t recovery_port() const { return recovery_port_.load(std::memory_order_acquire); }
+
+    // Events that fit in one packet
+    size_t events_per_packet() const { return events_per_packet_; }
+
+    // Statistics, readable from any thread
+    uint64_t packets_sent() const { return packets_sent_.load(std::memory_order_relaxed); }
+    uint64_t events_sent() const { return events_sent_.load(std::memory_order_relaxed); }
+    uint64_t send_errors() const { return send_errors_.load(std::memory_order_relaxed); }
+    uint64_t events_lost() const { return events_lost_.load(std::memory_order_relaxed); }
+    uint64_t snapshots_served() const { return snapshots_served_.load(std::memory_order_relaxed); }
+    uint64_t retransmits_served() const { return retransmits_served_.load(std::memory_order_relaxed); }
+    uint64_t sessions_dropped() const { return recovery_.dropped_connections(); }
+
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    const MarketDataPublisherConfig& config() const { return config_; }
+
+private:
+    struct Shadow;
+    struct ImageMailbox;
+
+    // Publisher thread body
+    void run();
+
+    // Read the buses into packets; returns the number of events read
+    size_t drain_buses();
+    void add_event(const orderbook::MarketDataEvent& event);
+    void send_packet();
+
+    // Keep a symbol's shadow book in step with its events
+    void apply_event(const orderbook::MarketDataEvent& event);
+    void seed_shadows();
+
+    // Re-seeding a stale shadow book from an image of the live one
+    void mark_worker_stale(size_t worker);
+    void request_reseed(Shadow& shadow);
+    void collect_images();
+    void try_reseed(Shadow& shadow);
+
+    // Recovery channel; a false return drops the session
+    bool on_message(TcpConnection& session, const MessageHeader& header, const char* data) override;
+    bool serve_snapshot(TcpConnection& session, orderbook::SymbolId symbol_id);
+    bool serve_retransmit(TcpConnection& session, uint64_t first_packet, uint32_t count);
+    void close_all();
+
+    market::MatchingEngine& engine_;
+    MarketDataPublisherConfig config_;
+    size_t events_per_packet_;
+
+    // Publisher thread state
+    std::vector<orderbook::MarketDataBus::Cursor> cursors_;   // Indexed by worker
+    std::vector<std::unique_ptr<Shadow>> shadows_;    // Indexed by SymbolId (null if not traded)
+    orderbook::MatchBuffer shadow_fills_;
+    std::shared_ptr<ImageMailbox> images_;             // Shared with the engine's snapshot handler
+    std::vector<std::byte> snapshot_buffer_;
+
+    // Packet being filled, and the retention ring of sent packets
+    std::unique_ptr<char[]> packet_;
+    size_t packet_events_ = 0;
+    uint64_t next_packet_ = 1;
+    size_t retained_mask_ = 0;
+    std::unique_ptr<char[]> retained_;                // retained_mask_ + 1 slots of max_packet_size
+    std::unique_ptr<uint16_t[]> retained_sizes_;
+
+    int udp_fd_ = -1;
+    TcpServer recovery_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<uint16_t> recovery_port_{0};
+    std::atomic<uint64_t> packets_sent_{0};
+    std::atomic<uint64_t> events_sent_{0};
+    std::atomic<uint64_t> send_errors_{0};
+    std::atomic<uint64_t> events_lost_{0};
+    std::atomic<uint64_t> snapshots_served_{0};
+    std::atomic<uint64_t> retransmits_served_{0};
+};
+
+} // namespace network
+} // namespace trading_engine
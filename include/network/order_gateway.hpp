@@ -0,0 +1,128 @@
+#pragma once
+
+#include "market/matching_engine.hpp"
+#include "network/protocol.hpp"
+#include "network/tcp_server.hpp"
+#include "orderbook/market_data.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading_engine {
+namespace network {
+
+using market::MatchingEngine;
+using orderbook::OrderId;
+
+/**
+ * OrderGatewayConfig - construction-time options for an OrderGateway
+ */
+struct OrderGatewayConfig {
+    static constexpr size_t DEFAULT_RECEIVE_BUFFER = 64 * 1024;
+    static constexpr size_t DEFAULT_SEND_SLOTS = 4096;
+    static constexpr uint64_t DEFAULT_FIRST_ORDER_BLOCK = uint64_t{1} << 16;
+
+    // Address and port to listen on (port 0 picks a free one, see OrderGateway::port())
+    std::string bind_address = "127.0.0.1";
+    uint16_t port = 0;
+
+    // Bytes buffered per session for partially received messages
+    size_t receive_buffer_size = DEFAULT_RECEIVE_BUFFER;
+
+    // Outbound messages queued per session (send_slots * MAX_MESSAGE_SIZE bytes,
+    // allocated when the session is accepted); a session that fills it is dropped
+    size_t send_slots = DEFAULT_SEND_SLOTS;
+
+    // Order-id block of the first session; later sessions take the following
+    // blocks. Keep clear of other senders' blocks (StrategyRunner uses 1..N).
+    uint64_t first_order_block = DEFAULT_FIRST_ORDER_BLOCK;
+
+    // CPU to pin the I/O thread to (-1 leaves it unpinned)
+    int cpu = -1;
+
+    // Longest the I/O thread sleeps in epoll_wait before checking for fills
+    int poll_timeout_ms = 1;
+};
+
+/**
+ * OrderGateway - TCP order entry into a MatchingEngine
+ *
+ * One I/O thread runs a TcpServer's non-blocking epoll loop over the
+ * listening socket and every session. Client messages (see protocol.hpp) are decoded straight
+ * from a fixed per-session receive buffer and queued for the engine; each
+ * is answered with an ACK saying whether it was queued. Fills are picked up
+ * from the engine's market-data buses, so the matching threads never touch
+ * a socket, and routed to the session whose order traded.
+ *
+ * Every session gets a block of engine order ids, (block << 40) | client id,
+ * so client ids only need to be unique within a session and a fill's
+ * session is found from the id alone. A new order reusing an id that is
+ * still live is queued like any other and then rejected by the book.
+ * Replies wait in a per-session buffer sized up front and everything queued
+ * goes out in one send() per pass of the loop.
+ */
+class OrderGateway : private TcpHandler {
+public:
+    // Low bits of an engine order id carrying the client's own id
+    static constexpr unsigned CLIENT_ID_BITS = 40;
+
+    explicit OrderGateway(MatchingEngine& engine, const OrderGatewayConfig& config = {});
+    ~OrderGateway() override;
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // Listen and start the I/O thread; false if the socket can't be set up
+    bool start();
+
+    // Close every session and join the I/O thread
+    void stop();
+
+    // Port actually listened on (0 before start)
+    uint16_t port() const { return port_.load(std::memory_order_acquire); }
+
+    // Statistics, readable from any thread
+    size_t session_count() const { return server_.connection_count(); }
+    uint64_t messages_received() const { return messages_received_.load(std::memory_order_relaxed); }
+    uint64_t commands_queued() const { return commands_queued_.load(std::memory_order_relaxed); }
+    uint64_t messages_sent() const { return server_.messages_sent(); }
+    uint64_t write_calls() const { return server_.write_calls(); }
+
+    // Bus events missed (lost or discarded as overrun); fills among them never reach their session
+    uint64_t events_lost() const { return events_lost_.load(std::memory_order_relaxed); }
+
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    const OrderGatewayConfig& config() const { return config_; }
+
+private:
+    // I/O thread body
+    void run();
+
+    bool on_message(TcpConnection& session, const MessageHeader& header, const char* data) override;
+    void route_fills();
+    void route_fill(const orderbook::MarketDataEvent& event, OrderId order_id, orderbook::Side side, bool maker);
+
+    // Engine order id of a session's client order id
+    OrderId order_id(const TcpConnection& session, uint64_t client_order_id) const;
+    TcpConnection* session_for(OrderId order_id);
+
+    MatchingEngine& engine_;
+    OrderGatewayConfig config_;
+    std::vector<orderbook::MarketDataBus::Cursor> fill_cursors_;
+
+    // I/O thread state; session indices are never reused, index = block - first_order_block
+    TcpServer server_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<uint16_t> port_{0};
+    std::atomic<uint64_t> messages_received_{0};
+    std::atomic<uint64_t> commands_queued_{0};
+    std::atomic<uint64_t> events_lost_{0};
+};
+
+} // namespace network
+} // namespace trading_engine
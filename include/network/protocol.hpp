@@ -0,0 +1,257 @@
+#pragma once
+
+#include "orderbook/market_data.hpp"
+#include "orderbook/order_command.hpp"
+#include "orderbook/types.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace trading_engine {
+namespace network {
+
+static_assert(std::endian::native == std::endian::little,
+              "The wire protocol is little-endian and messages are copied as is");
+
+/**
+ * MessageType - kinds of framed messages (order entry and market-data recovery)
+ */
+enum class MessageType : uint8_t {
+    NEW_ORDER = 1,   // Client -> gateway
+    CANCEL = 2,      // Client -> gateway
+    MODIFY = 3,      // Client -> gateway
+    ACK = 4,         // Gateway -> client: the command was queued or refused
+    FILL = 5,        // Gateway -> client: an order executed
+
+    // Market-data recovery channel (see MarketDataPublisher)
+    SNAPSHOT_REQUEST = 6,     // Client -> publisher
+    RETRANSMIT_REQUEST = 7,   // Client -> publisher
+    SNAPSHOT = 8,             // Publisher -> client, followed by the snapshot image
+    RETRANSMIT = 9            // Publisher -> client, followed by the packets
+};
+
+/**
+ * MessageHeader - first 4 bytes of every message
+ *
+ * `length` covers the whole message including the header, so a reader can
+ * skip types it does not know.
+ */
+struct MessageHeader {
+    static constexpr uint8_t VERSION = 1;
+
+    uint16_t length = 0;
+    MessageType type = MessageType::NEW_ORDER;
+    uint8_t version = VERSION;
+};
+
+static_assert(sizeof(MessageHeader) == 4, "MessageHeader layout changed");
+
+/**
+ * Wire messages - fixed little-endian layouts with explicit padding
+ *
+ * Prices and quantities are the raw fixed-point values of Price and
+ * Quantity. Order ids on the wire are the client's own ids, unique within
+ * its session.
+ */
+struct NewOrderMessage {
+    MessageHeader header{sizeof(NewOrderMessage), MessageType::NEW_ORDER};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t client_order_id = 0;
+    int64_t price = 0;
+    int64_t quantity = 0;
+    int64_t aux_price = 0;               // Stop price or peg offset
+    orderbook::Side side = orderbook::Side::BUY;
+    orderbook::OrderType order_type = orderbook::OrderType::LIMIT;
+    orderbook::TimeInForce time_in_force = orderbook::TimeInForce::GTC;
+    uint8_t reserved[5] = {};
+};
+
+struct CancelMessage {
+    MessageHeader header{sizeof(CancelMessage), MessageType::CANCEL};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t client_order_id = 0;
+};
+
+struct ModifyMessage {
+    MessageHeader header{sizeof(ModifyMessage), MessageType::MODIFY};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t client_order_id = 0;
+    int64_t price = 0;
+    int64_t quantity = 0;
+    uint8_t modify_flags = 0;             // OrderCommand::MODIFY_* bits
+    uint8_t reserved[7] = {};
+};
+
+/**
+ * AckStatus - why a command was refused (ACCEPTED when it was queued)
+ */
+enum class AckStatus : uint8_t {
+    ACCEPTED = 0,
+    MALFORMED = 1,       // Bad field values
+    BAD_ORDER_ID = 2,    // Zero, or too large for the session's id block
+    UNKNOWN_SYMBOL = 3,
+    QUEUE_FULL = 4
+};
+
+struct AckMessage {
+    MessageHeader header{sizeof(AckMessage), MessageType::ACK};
+    MessageType acked_type = MessageType::NEW_ORDER;
+    AckStatus status = AckStatus::ACCEPTED;
+    uint8_t reserved[2] = {};
+    uint64_t client_order_id = 0;
+    uint64_t order_id = 0;                // Id the engine knows the order by
+};
+
+struct FillMessage {
+    MessageHeader header{sizeof(FillMessage), MessageType::FILL};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t client_order_id = 0;
+    int64_t price = 0;
+    int64_t quantity = 0;
+    int64_t timestamp = 0;
+    orderbook::Side side = orderbook::Side::BUY;
+    uint8_t maker = 0;                    // 1 if the client's order was resting
+    uint8_t reserved[6] = {};
+};
+
+/**
+ * Market-data packets - what the publisher multicasts
+ *
+ * Each UDP datagram is a PacketHeader followed by event_count
+ * MarketDataEvents, copied as the book published them. Packets are numbered
+ * from 1 without gaps, so a receiver that sees a jump asks the recovery
+ * channel for the missing packets, or for a fresh snapshot.
+ */
+struct PacketHeader {
+    static constexpr uint8_t VERSION = 1;
+
+    uint64_t sequence = 0;
+    uint16_t event_count = 0;
+    uint8_t version = VERSION;
+    uint8_t reserved[5] = {};
+};
+
+// Bytes a packet of `event_count` events takes
+constexpr size_t packet_size(size_t event_count) {
+    return sizeof(PacketHeader) + event_count * sizeof(orderbook::MarketDataEvent);
+}
+
+/**
+ * RecoveryStatus - outcome of a snapshot or retransmit request
+ */
+enum class RecoveryStatus : uint8_t {
+    OK = 0,
+    UNKNOWN_SYMBOL = 1,
+    STALE = 2,           // The publisher lost events for this symbol and is re-seeding it; ask again
+    NOT_AVAILABLE = 3    // The requested packets are no longer retained
+};
+
+struct SnapshotRequestMessage {
+    MessageHeader header{sizeof(SnapshotRequestMessage), MessageType::SNAPSHOT_REQUEST};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+};
+
+struct RetransmitRequestMessage {
+    MessageHeader header{sizeof(RetransmitRequestMessage), MessageType::RETRANSMIT_REQUEST};
+    uint32_t count = 0;
+    uint64_t first_packet = 0;
+};
+
+// Followed by image_size bytes of snapshot image (see orderbook/snapshot.hpp).
+// The image's journal_sequence is last_event_sequence, so a receiver restores
+// it and applies the symbol's events with later sequence numbers.
+struct SnapshotMessage {
+    MessageHeader header{sizeof(SnapshotMessage), MessageType::SNAPSHOT};
+    uint32_t symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t last_event_sequence = 0;
+    uint64_t image_size = 0;
+    RecoveryStatus status = RecoveryStatus::OK;
+    uint8_t reserved[7] = {};
+};
+
+// Followed by `count` packets, each a PacketHeader and its events
+struct RetransmitMessage {
+    MessageHeader header{sizeof(RetransmitMessage), MessageType::RETRANSMIT};
+    RecoveryStatus status = RecoveryStatus::OK;
+    uint8_t reserved[3] = {};
+    uint64_t first_packet = 0;
+    uint32_t count = 0;
+    uint32_t reserved2 = 0;
+};
+
+static_assert(sizeof(NewOrderMessage) == 48, "NewOrderMessage layout changed");
+static_assert(sizeof(CancelMessage) == 16, "CancelMessage layout changed");
+static_assert(sizeof(ModifyMessage) == 40, "ModifyMessage layout changed");
+static_assert(sizeof(AckMessage) == 24, "AckMessage layout changed");
+static_assert(sizeof(FillMessage) == 48, "FillMessage layout changed");
+static_assert(sizeof(PacketHeader) == 16, "PacketHeader layout changed");
+static_assert(sizeof(SnapshotRequestMessage) == 8, "SnapshotRequestMessage layout changed");
+static_assert(sizeof(RetransmitRequestMessage) == 16, "RetransmitRequestMessage layout changed");
+static_assert(sizeof(SnapshotMessage) == 32, "SnapshotMessage layout changed");
+static_assert(sizeof(RetransmitMessage) == 24, "RetransmitMessage layout changed");
+static_assert(std::is_trivially_copyable_v<NewOrderMessage> && std::is_trivially_copyable_v<CancelMessage> &&
+              std::is_trivially_copyable_v<ModifyMessage> && std::is_trivially_copyable_v<AckMessage> &&
+              std::is_trivially_copyable_v<FillMessage> && std::is_trivially_copyable_v<PacketHeader> &&
+              std::is_trivially_copyable_v<SnapshotMessage> && std::is_trivially_copyable_v<RetransmitMessage>,
+              "Wire messages must be memcpy-able");
+
+// Largest framed message either side sends (snapshot and retransmit payloads
+// follow their message and are not part of it)
+constexpr size_t MAX_MESSAGE_SIZE = 48;
+
+// Size a message of `type` must have (0 for unknown types)
+constexpr size_t message_size(MessageType type) {
+    switch (type) {
+        case MessageType::NEW_ORDER: return sizeof(NewOrderMessage);
+        case MessageType::CANCEL: return sizeof(CancelMessage);
+        case MessageType::MODIFY: return sizeof(ModifyMessage);
+        case MessageType::ACK: return sizeof(AckMessage);
+        case MessageType::FILL: return sizeof(FillMessage);
+        case MessageType::SNAPSHOT_REQUEST: return sizeof(SnapshotRequestMessage);
+        case MessageType::RETRANSMIT_REQUEST: return sizeof(RetransmitRequestMessage);
+        case MessageType::SNAPSHOT: return sizeof(SnapshotMessage);
+        case MessageType::RETRANSMIT: return sizeof(RetransmitMessage);
+        default: return 0;
+    }
+}
+
+// Read the header at the front of `data`. Returns nullopt until `size` bytes
+// hold a complete message; header.length is 0 when the framing is broken.
+inline std::optional<MessageHeader> peek_message(const char* data, size_t size) {
+    if (size < sizeof(MessageHeader)) {
+        return std::nullopt;
+    }
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.length < sizeof(MessageHeader) || header.length > MAX_MESSAGE_SIZE ||
+        header.version != MessageHeader::VERSION) {
+        header.length = 0; // Unrecoverable: the stream can't be re-framed
+        return header;
+    }
+    if (size < header.length) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+// Copy a complete message of type T out of the receive buffer (no allocation;
+// the copy is a few register loads since T is small and trivially copyable)
+template <typename T>
+T read_message(const char* data) {
+    T message;
+    std::memcpy(&message, data, sizeof(T));
+    return message;
+}
+
+// Build the engine command for a client message, with the engine's order id.
+// Returns nullopt if a field is out of range, including a limit or stop
+// price that isn't positive.
+std::optional<orderbook::OrderCommand> to_command(const NewOrderMessage& message, orderbook::OrderId order_id);
+std::optional<orderbook::OrderCommand> to_command(const CancelMessage& message, orderbook::OrderId order_id);
+std::optional<orderbook::OrderCommand> to_command(const ModifyMessage& message, orderbook::OrderId order_id);
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "network/protocol.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trading_engine {
+namespace network {
+
+/**
+ * TcpServerConfig - construction-time options for a TcpServer
+ */
+struct TcpServerConfig {
+    static constexpr size_t DEFAULT_RECEIVE_BUFFER = 2 * MAX_MESSAGE_SIZE;
+    static constexpr size_t DEFAULT_MAX_SEND_BYTES = 16 * 1024 * 1024;
+
+    // Address and port to listen on (port 0 picks a free one, see TcpServer::port())
+    std::string bind_address = "127.0.0.1";
+    uint16_t port = 0;
+
+    // Bytes buffered per connection for partially received messages
+    size_t receive_buffer_size = DEFAULT_RECEIVE_BUFFER;
+
+    // Outbound bytes a connection may have queued; one that goes over is dropped
+    size_t max_send_bytes = DEFAULT_MAX_SEND_BYTES;
+
+    // Outbound bytes allocated per connection up front (at most max_send_bytes)
+    size_t send_reserve = 0;
+
+    // Give a new connection the lowest free index; otherwise indices are never reused
+    bool reuse_indices = true;
+};
+
+/**
+ * TcpConnection - one accepted connection and its buffers
+ */
+struct TcpConnection {
+    TcpConnection(int socket, size_t connection_index, size_t receive_size, size_t send_reserve)
+        : fd(socket),
+          index(connection_index),
+          receive(std::make_unique<char[]>(receive_size)),
+          receive_capacity(receive_size) {
+        send.reserve(send_reserve);
+    }
+
+    size_t queued() const { return send.size() - sent; }
+
+    int fd;
+    size_t index;
+
+    // Bytes received but not yet decoded (a partial message at most)
+    std::unique_ptr<char[]> receive;
+    size_t receive_capacity;
+    size_t received = 0;
+
+    // Bytes waiting to be written; the first `sent` of them are out already
+    std::vector<char> send;
+    size_t sent = 0;
+    uint64_t queued_messages = 0;
+
+    bool pending_flush = false;
+    bool waiting_writable = false;   // EPOLLOUT armed after a short write
+};
+
+/**
+ * TcpHandler - receives the messages a TcpServer decodes
+ */
+class TcpHandler {
+public:
+    virtual ~TcpHandler() = default;
+
+    // One complete message (header.length bytes at data); false closes the connection
+    virtual bool on_message(TcpConnection& connection, const MessageHeader& header, const char* data) = 0;
+};
+
+/**
+ * TcpServer - non-blocking epoll plumbing shared by the TCP endpoints
+ *
+ * Owns the listening socket, the epoll set and every connection. poll()
+ * accepts, reads and frames the protocol.hpp messages straight out of each
+ * connection's receive buffer, and finishes writes the socket had no room
+ * for. Replies are queued as bytes and written by flush_pending() with one
+ * send() per connection for everything queued; a connection whose queue
+ * would exceed max_send_bytes is not reading its replies and is dropped.
+ *
+ * Not thread safe: everything but the statistics belongs to the thread that
+ * calls poll().
+ */
+class TcpServer {
+public:
+    // `name` prefixes the log lines
+    TcpServer(const TcpServerConfig& config, const char* name);
+    ~TcpServer();
+
+    TcpServer(const TcpServer&) = delete;
+    TcpServer& operator=(const TcpServer&) = delete;
+
+    // Bind, listen and set up epoll; false (and logged) if any step fails
+    bool open();
+
+    // Close every connection and the listening socket
+    void close();
+
+    // Port actually listened on (0 before open)
+    uint16_t port() const { return port_; }
+
+    // Wait up to timeout_ms for socket events and handle them; returns the
+    // number of events
+    int poll(int timeout_ms, TcpHandler& handler);
+
+    // Append one message to a connection's queue; false if that would take it
+    // over max_send_bytes, in which case the caller drops the connection
+    bool queue(TcpConnection& connection, const void* data, size_t size);
+
+    // Write every connection with queued bytes, dropping those that fail
+    void flush_pending();
+
+    // Connection at `index`, null if it has closed
+    TcpConnection* connection(size_t index);
+
+    void close_connection(size_t index);
+
+    // Statistics, readable from any thread
+    size_t connection_count() const { return connection_count_.load(std::memory_order_relaxed); }
+    uint64_t messages_sent() const { return messages_sent_.load(std::memory_order_relaxed); }
+    uint64_t write_calls() const { return write_calls_.load(std::memory_order_relaxed); }
+    uint64_t dropped_connections() const { return dropped_connections_.load(std::memory_order_relaxed); }
+
+    const TcpServerConfig& config() const { return config_; }
+
+private:
+    void accept_connections();
+    bool read(TcpConnection& connection, TcpHandler& handler);
+
+    // Write queued bytes; false if the connection failed
+    bool flush(TcpConnection& connection);
+
+    TcpServerConfig config_;
+    const char* name_;
+
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    uint16_t port_ = 0;
+    std::vector<std::unique_ptr<TcpConnection>> connections_;
+    std::vector<size_t> pending_flush_;   // Connections with queued bytes
+
+    std::atomic<size_t> connection_count_{0};
+    std::atomic<uint64_t> messages_sent_{0};
+    std::atomic<uint64_t> write_calls_{0};
+    std::atomic<uint64_t> dropped_connections_{0};
+};
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/price_level.hpp"
+#include "orderbook/price_ladder.hpp"
+#include <map>
+#include <memory>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * BookSide - the price levels of one side of the order book
+ *
+ * Levels are kept either in a std::map (any price) or in a tick-indexed
+ * PriceLadder (prices must lie on the tick grid). Both keep levels in
+ * priority order: descending for bids, ascending for asks.
+ */
+class BookSide {
+public:
+    // Constructor for a map-backed side
+    explicit BookSide(Side side);
+
+    // Constructor for a ladder-backed side
+    BookSide(Side side, Price tick_size, size_t ladder_ticks,
+             size_t ladder_max_ticks = PriceLadder::DEFAULT_MAX_TICKS);
+
+    // Check if a price can be stored on this side
+    bool accepts(Price price) const { return !ladder_ || ladder_->accepts(price); }
+
+    // Find the level at a price, nullptr if there is none
+    PriceLevel* find(Price price);
+    const PriceLevel* find(Price price) const;
+
+    // Find the level at a price, creating it if needed (nullptr if not accepted)
+    PriceLevel* find_or_create(Price price);
+
+    // Remove the level at a price
+    void erase(Price price);
+
+    // Get the best level, nullptr if the side is empty
+    PriceLevel* best();
+    const PriceLevel* best() const;
+
+    // Get the next level after the given price in priority order
+    const PriceLevel* next(Price price) const;
+
+    // Check if price a has priority over price b on this side
+    bool is_better(Price a, Price b) const { return side_ == Side::BUY ? a > b : a < b; }
+
+    // Visit levels from best to worst until the visitor returns false
+    template <typename Func>
+    void for_each_level(Func&& func) const {
+        if (ladder_) {
+            ladder_->for_each_level(func);
+            return;
+        }
+        for (const auto& [price, level] : levels_) {
+            if (!func(level)) {
+                break;
+            }
+        }
+    }
+
+    // Accessors
+    Side side() const { return side_; }
+    bool uses_ladder() const { return ladder_ != nullptr; }
+    size_t level_count() const { return ladder_ ? ladder_->level_count() : levels_.size(); }
+    bool empty() const { return level_count() == 0; }
+
+    // Remove all levels
+    void clear();
+
+private:
+    // Priority ordering for the map backend
+    struct LevelOrder {
+        Side side;
+        bool operator()(const Price& a, const Price& b) const {
+            return side == Side::BUY ? a > b : a < b;
+        }
+    };
+
+    Side side_;
+    std::map<Price, PriceLevel, LevelOrder> levels_;   // Map backend
+    std::unique_ptr<PriceLadder> ladder_;              // Ladder backend (optional)
+};
+
+} // namespace orderbook
+} // namespace trading_engine
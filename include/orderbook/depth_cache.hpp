@@ -0,0 +1,94 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+class BookSide;
+
+/**
+ * DepthLevel - one aggregated price level of L2 depth
+ */
+struct DepthLevel {
+    Price price;
+    Quantity quantity;
+    uint32_t order_count = 0;
+};
+
+/**
+ * DepthCache - incrementally maintained top-N depth for both sides of a book
+ *
+ * The book reports every level change as it happens, so readers get the
+ * current top-N levels as a span over fixed storage without walking or
+ * copying the book. sequence() increases on every change; a reader that
+ * sees the same sequence twice has seen the same depth. Prices and
+ * quantities are also kept as parallel raw arrays for the vectorized depth
+ * queries (see core/simd_kernels.hpp).
+ */
+class DepthCache {
+public:
+    static constexpr size_t DEFAULT_LEVELS = 10;
+
+    // Constructor with the number of levels kept per side
+    explicit DepthCache(size_t levels = DEFAULT_LEVELS);
+
+    // A level's aggregate changed (or the level was created)
+    void update_level(Side side, Price price, Quantity quantity, uint32_t order_count);
+
+    // A level was removed from the book. `book_side` supplies the level that
+    // moves up into the last slot when the cached range was full.
+    void remove_level(Side side, Price price, const BookSide& book_side);
+
+    // Rebuild one side from scratch
+    void rebuild(const BookSide& book_side);
+
+    // Drop all levels
+    void clear();
+
+    // Accessors
+    std::span<const DepthLevel> bids() const { return {bids_.data(), bid_count_}; }
+    std::span<const DepthLevel> asks() const { return {asks_.data(), ask_count_}; }
+    std::span<const DepthLevel> levels(Side side) const { return side == Side::BUY ? bids() : asks(); }
+    std::span<const int64_t> prices(Side side) const { return {columns(side).prices.data(), size_of(side)}; }
+    std::span<const int64_t> quantities(Side side) const { return {columns(side).quantities.data(), size_of(side)}; }
+    bool is_full(Side side) const { return size_of(side) == max_levels(); }
+    uint64_t sequence() const { return sequence_; }
+    size_t max_levels() const { return bids_.size(); }
+
+private:
+    // Raw price and quantity of each cached level, in the same order
+    struct Columns {
+        explicit Columns(size_t levels) : prices(levels), quantities(levels) {}
+
+        std::vector<int64_t> prices;
+        std::vector<int64_t> quantities;
+    };
+
+    std::vector<DepthLevel>& storage(Side side) { return side == Side::BUY ? bids_ : asks_; }
+    size_t& count(Side side) { return side == Side::BUY ? bid_count_ : ask_count_; }
+    size_t size_of(Side side) const { return side == Side::BUY ? bid_count_ : ask_count_; }
+    Columns& columns(Side side) { return side == Side::BUY ? bid_columns_ : ask_columns_; }
+    const Columns& columns(Side side) const { return side == Side::BUY ? bid_columns_ : ask_columns_; }
+
+    // Copy levels [from, size) of a side into its columns
+    void sync_columns(Side side, size_t from);
+
+    // Position of `price` in priority order on `side`: the first slot not better than it
+    static size_t lower_bound(Side side, const DepthLevel* levels, size_t count, Price price);
+
+    std::vector<DepthLevel> bids_;  // Fixed storage, best first
+    std::vector<DepthLevel> asks_;
+    Columns bid_columns_;
+    Columns ask_columns_;
+    size_t bid_count_ = 0;
+    size_t ask_count_ = 0;
+    uint64_t sequence_ = 0;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
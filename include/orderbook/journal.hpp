@@ -0,0 +1,161 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order_command.hpp"
+#include "orderbook/match_sink.hpp"
+#include "core/mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+class OrderBook;
+
+/**
+ * JournalRecord - one journaled command with its sequence and event time
+ *
+ * A slot whose sequence is zero has never been written; the sequence is
+ * stored last, so a record is either complete or invisible to readers.
+ */
+struct JournalRecord {
+    uint64_t sequence = 0;
+    Timestamp timestamp = 0;
+    OrderCommand command;
+};
+
+static_assert(std::is_trivially_copyable_v<JournalRecord>, "JournalRecord must be memcpy-able");
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord layout changed");
+
+/**
+ * JournalSegmentHeader - first 64 bytes of every segment file
+ */
+struct JournalSegmentHeader {
+    static constexpr uint64_t MAGIC = 0x314C4E524A455445ULL; // "ETEJRNL1"
+    static constexpr uint32_t VERSION = 2;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t record_size = sizeof(JournalRecord);
+    uint64_t capacity = 0;           // Records per segment
+    uint64_t segment_index = 0;
+    uint64_t first_sequence = 0;     // Sequence of the segment's first record
+    uint8_t reserved[24] = {};
+
+    bool is_valid() const {
+        return magic == MAGIC && version == VERSION && record_size == sizeof(JournalRecord) && capacity > 0;
+    }
+};
+
+static_assert(sizeof(JournalSegmentHeader) == 64, "JournalSegmentHeader layout changed");
+
+/**
+ * JournalConfig - where and how a journal stores its segments
+ */
+struct JournalConfig {
+    static constexpr size_t DEFAULT_RECORDS_PER_SEGMENT = 1 << 20;
+
+    std::string directory;
+    size_t records_per_segment = DEFAULT_RECORDS_PER_SEGMENT;
+};
+
+/**
+ * Journal - append-only write-ahead log of order commands
+ *
+ * Commands are written into fixed-size records of memory-mapped segment
+ * files, so an append is a store into mapped memory with no system call.
+ * A full segment is synced and the next one is created. Symbol ids are
+ * journaled as-is: recovery must intern symbols in the same order as the
+ * journaled run.
+ */
+class Journal {
+public:
+    explicit Journal(JournalConfig config);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Open the journal, resuming after the last complete record
+    bool open();
+
+    // Append a command at its event time. Returns its sequence, 0 on failure.
+    uint64_t append(const OrderCommand& command, Timestamp timestamp);
+    uint64_t append(const OrderCommand& command) { return append(command, current_timestamp()); }
+
+    // Flush the current segment to disk
+    bool sync();
+
+    // Sync and close the current segment
+    void close();
+
+    // Accessors
+    bool is_open() const { return segment_.is_open(); }
+    uint64_t last_sequence() const { return next_sequence_ - 1; }
+    uint64_t segment_index() const { return segment_index_; }
+    const JournalConfig& config() const { return config_; }
+
+    // Path of segment `index` in `directory`
+    static std::string segment_path(const std::string& directory, uint64_t index);
+
+    // Segment indices present in `directory`, ascending
+    static std::vector<uint64_t> list_segments(const std::string& directory);
+
+private:
+    // Map segment `index`, writing a header if the segment is new
+    bool open_segment(uint64_t index, uint64_t first_sequence);
+
+    JournalSegmentHeader* header() { return reinterpret_cast<JournalSegmentHeader*>(segment_.data()); }
+    JournalRecord* records() {
+        return reinterpret_cast<JournalRecord*>(segment_.data() + sizeof(JournalSegmentHeader));
+    }
+
+    JournalConfig config_;
+    core::MappedFile segment_;
+    uint64_t segment_index_ = 0;
+    size_t position_ = 0;         // Next free record in the segment
+    uint64_t next_sequence_ = 1;
+};
+
+/**
+ * JournalReader - reads journaled records in sequence order
+ *
+ * Segments are mapped read-only one at a time and records are returned in
+ * place. Reading stops at the first unwritten slot or sequence gap.
+ */
+class JournalReader {
+public:
+    explicit JournalReader(std::string directory);
+
+    // Next record, or nullptr at the end of the journal. The pointer stays
+    // valid until the reader moves past its segment.
+    const JournalRecord* next();
+
+    // Number of records returned so far
+    uint64_t records_read() const { return records_read_; }
+
+private:
+    // Map the next segment in the directory, false if none is left
+    bool open_next_segment();
+
+    std::string directory_;
+    std::vector<uint64_t> segments_;
+    size_t next_segment_ = 0;
+    core::MappedFile segment_;
+    const JournalRecord* records_ = nullptr;
+    size_t capacity_ = 0;
+    size_t position_ = 0;
+    uint64_t expected_sequence_ = 0;  // 0 until the first record is read
+    uint64_t records_read_ = 0;
+    bool done_ = false;
+};
+
+// Replay every journaled command for `book`'s symbol at its journaled event
+// time, reporting fills to the sink. Returns the number of commands applied.
+uint64_t replay_journal(JournalReader& reader, OrderBook& book, MatchSink& sink);
+
+} // namespace orderbook
+} // namespace trading_engine
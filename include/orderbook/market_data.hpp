@@ -0,0 +1,67 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "core/broadcast_ring.hpp"
+#include "core/ring_buffer.hpp"
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * MarketDataEventType - kinds of incremental book events
+ */
+enum class MarketDataEventType : uint8_t {
+    ORDER_ADDED,    // Order rests on the book: order_id, side, price, quantity
+    ORDER_REDUCED,  // Resting order shrank in place: quantity removed
+    ORDER_DELETED,  // Resting order left the book (cancel, replace, cancel_all)
+    TRADE,          // Fill: order_id is the maker, match_id the taker; the maker shrinks by quantity
+    LEVEL_CHANGED   // Aggregate at side/price is now quantity (zero when the level is gone)
+};
+
+// Convert an event type to string
+constexpr std::string_view to_string(MarketDataEventType type) {
+    switch (type) {
+        case MarketDataEventType::ORDER_ADDED: return "ORDER_ADDED";
+        case MarketDataEventType::ORDER_REDUCED: return "ORDER_REDUCED";
+        case MarketDataEventType::ORDER_DELETED: return "ORDER_DELETED";
+        case MarketDataEventType::TRADE: return "TRADE";
+        case MarketDataEventType::LEVEL_CHANGED: return "LEVEL_CHANGED";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * MarketDataEvent - fixed-width binary book event
+ *
+ * Trivially copyable so consumers can forward events with a plain memcpy.
+ * sequence numbers every event a book generates, including events dropped
+ * because the ring was full, so a gap in the sequence means lost events.
+ */
+struct MarketDataEvent {
+    uint64_t sequence = 0;
+    Timestamp timestamp = 0;
+    OrderId order_id = INVALID_ORDER_ID;
+    OrderId match_id = INVALID_ORDER_ID;
+    Price price;
+    Quantity quantity;
+    SymbolId symbol_id = INVALID_SYMBOL_ID;
+    MarketDataEventType type = MarketDataEventType::ORDER_ADDED;
+    Side side = Side::BUY;
+    uint16_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<MarketDataEvent>, "MarketDataEvent must be memcpy-able");
+static_assert(sizeof(MarketDataEvent) == 56, "MarketDataEvent layout changed");
+
+// Ring a book publishes events into; the book is the single producer
+using MarketDataRing = core::SPSCRingBuffer<MarketDataEvent>;
+
+// Bus that fans events out to any number of readers; the matching thread is
+// the single producer and readers never slow it down
+using MarketDataBus = core::BroadcastRing<MarketDataEvent>;
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * OrderMatch - represents a match between two orders
+ */
+struct OrderMatch {
+    OrderId maker_order_id;      // The resting order
+    OrderId taker_order_id;      // The incoming order
+    Price match_price;           // Price at which orders matched
+    Quantity match_quantity;     // Quantity matched
+    Timestamp timestamp;         // When the match occurred
+
+    // Constructor
+    OrderMatch(OrderId maker, OrderId taker, Price price, Quantity qty)
+        : OrderMatch(maker, taker, price, qty, current_timestamp()) {
+    }
+
+    // Constructor with a pre-captured match time
+    OrderMatch(OrderId maker, OrderId taker, Price price, Quantity qty, Timestamp time)
+        : maker_order_id(maker),
+          taker_order_id(taker),
+          match_price(price),
+          match_quantity(qty),
+          timestamp(time) {
+    }
+
+    // String representation
+    std::string to_string() const;
+};
+
+/**
+ * MatchSink - receives fills as the matching loop produces them
+ *
+ * The book calls on_match() straight from the price level walk, so no
+ * intermediate containers are built between the level and the sink.
+ */
+class MatchSink {
+public:
+    virtual ~MatchSink() = default;
+
+    // Called once per fill, in execution order
+    virtual void on_match(const OrderMatch& match) = 0;
+};
+
+/**
+ * MatchBuffer - reusable match sink backed by preallocated storage
+ *
+ * Storage is reserved up front and kept across clear(), so matching into a
+ * buffer allocates nothing unless a single call produces more fills than
+ * the reserved capacity.
+ */
+class MatchBuffer : public MatchSink {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    // Constructor with the number of fills to reserve
+    explicit MatchBuffer(size_t capacity = DEFAULT_CAPACITY);
+
+    void on_match(const OrderMatch& match) override { matches_.push_back(match); }
+
+    // Drop all fills (keeps storage)
+    void clear() { matches_.clear(); }
+
+    // Accessors
+    size_t size() const { return matches_.size(); }
+    bool empty() const { return matches_.empty(); }
+    size_t capacity() const { return matches_.capacity(); }
+    const OrderMatch& operator[](size_t index) const { return matches_[index]; }
+    std::span<const OrderMatch> matches() const { return matches_; }
+    auto begin() const { return matches_.begin(); }
+    auto end() const { return matches_.end(); }
+
+private:
+    std::vector<OrderMatch> matches_;
+};
+
+/**
+ * CallbackMatchSink - adapts any callable taking const OrderMatch& to a MatchSink
+ */
+template <typename Func>
+class CallbackMatchSink : public MatchSink {
+public:
+    explicit CallbackMatchSink(Func func) : func_(std::move(func)) {}
+
+    void on_match(const OrderMatch& match) override { func_(match); }
+
+private:
+    Func func_;
+};
+
+// Convenience factory for CallbackMatchSink
+template <typename Func>
+CallbackMatchSink<std::decay_t<Func>> make_match_sink(Func&& func) {
+    return CallbackMatchSink<std::decay_t<Func>>(std::forward<Func>(func));
+}
+
+} // namespace orderbook
+} // namespace trading_engine
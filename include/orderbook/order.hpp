@@ -1,77 +1,121 @@
 #pragma once
 
 #include "orderbook/types.hpp"
+#include "orderbook/order_record.hpp"
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace trading_engine {
 namespace orderbook {
 
 /**
  * Order - represents a single order in the order book
+ *
+ * Resting orders are linked directly into their PriceLevel's FIFO queue
+ * through the intrusive next/prev links below, so the level needs no
+ * separate list nodes or per-order lookup table. The order's own state is
+ * a packed OrderRecord laid out right after the links, so the fields the
+ * matching loop touches share the first cache line.
  */
 class Order {
 public:
     // Constructor for a new order
-    Order(OrderId id, Symbol symbol, Side side, OrderType type, 
+    Order(OrderId id, SymbolId symbol_id, Side side, OrderType type, 
           Quantity quantity, Price price, TimeInForce tif = TimeInForce::GTC);
     
+    // Constructor for a new order with an owner and a pre-captured creation time
+    Order(OrderId id, SymbolId symbol_id, Side side, OrderType type, 
+          Quantity quantity, Price price, TimeInForce tif, OwnerId owner, Timestamp timestamp);
+    
+    // Constructor taking a symbol name (interned in the global SymbolRegistry)
+    Order(OrderId id, std::string_view symbol, Side side, OrderType type, 
+          Quantity quantity, Price price, TimeInForce tif = TimeInForce::GTC);
+    
+    // Constructor restoring an order from a saved record
+    explicit Order(const OrderRecord& record);
+    
     // Default constructor for empty order
     Order();
     
+    // Orders are linked into price levels, so they are not copyable
+    Order(const Order&) = delete;
+    Order& operator=(const Order&) = delete;
+    
     // Accessors
-    OrderId id() const { return id_; }
-    Symbol symbol() const { return symbol_; }
-    Side side() const { return side_; }
-    OrderType type() const { return type_; }
-    Quantity quantity() const { return quantity_; }
-    Quantity executed_quantity() const { return executed_quantity_; }
-    Quantity remaining_quantity() const { return quantity_ - executed_quantity_; }
-    Price price() const { return price_; }
-    TimeInForce time_in_force() const { return time_in_force_; }
-    OrderStatus status() const { return status_; }
-    Timestamp timestamp() const { return timestamp_; }
+    OrderId id() const { return record_.id; }
+    SymbolId symbol_id() const { return record_.symbol_id; }
+    const Symbol& symbol() const;
+    Side side() const { return record_.side(); }
+    OrderType type() const { return record_.type(); }
+    Quantity quantity() const { return record_.quantity; }
+    Quantity executed_quantity() const { return record_.executed_quantity; }
+    Quantity remaining_quantity() const { return record_.remaining_quantity(); }
+    Price price() const { return record_.price; }
+    TimeInForce time_in_force() const { return record_.time_in_force(); }
+    OrderStatus status() const { return record_.status(); }
+    Timestamp timestamp() const { return record_.timestamp; }
     Timestamp last_update() const { return last_update_; }
+    OwnerId owner_id() const { return record_.owner_id; }
+    
+    // Trigger price of a stop order, and offset of a pegged order from its reference
+    Price stop_price() const { return record_.aux_price; }
+    Price peg_offset() const { return record_.aux_price; }
+    bool is_stop() const { return orderbook::is_stop(type()); }
+    bool is_pegged() const { return orderbook::is_pegged(type()); }
+    
+    // Compact copy of the order state
+    const OrderRecord& record() const { return record_; }
     
     // Assign/modify values
-    void set_price(Price price) { price_ = price; }
-    void set_quantity(Quantity quantity) { quantity_ = quantity; }
-    void set_status(OrderStatus status) { 
-        status_ = status; 
-        last_update_ = current_timestamp();
+    void set_price(Price price) { record_.price = price; }
+    void set_quantity(Quantity quantity) { record_.quantity = quantity; }
+    void set_owner(OwnerId owner) { record_.owner_id = owner; }
+    void set_timestamp(Timestamp timestamp) { record_.timestamp = timestamp; }
+    void set_type(OrderType type) { record_.set_type(type); }
+    void set_stop_price(Price price) { record_.aux_price = price; }
+    void set_peg_offset(Price offset) { record_.aux_price = offset; }
+    void set_status(OrderStatus status) { set_status(status, current_timestamp()); }
+    void set_status(OrderStatus status, Timestamp now) { 
+        record_.set_status(status); 
+        last_update_ = now;
     }
     
     // Execute part or all of the order
-    void execute(Quantity exec_qty);
+    void execute(Quantity exec_qty) { execute(exec_qty, current_timestamp()); }
+    void execute(Quantity exec_qty, Timestamp now);
     
     // Cancel the order
-    void cancel();
+    void cancel() { cancel(current_timestamp()); }
+    void cancel(Timestamp now);
     
     // Check if the order is active (can be executed)
     bool is_active() const;
     
     // Check if the order is fully executed
     bool is_filled() const { 
-        return executed_quantity_ == quantity_ || status_ == OrderStatus::FILLED; 
+        return record_.executed_quantity == record_.quantity || status() == OrderStatus::FILLED; 
     }
     
     // Check if order is valid
-    bool is_valid() const { return id_ != INVALID_ORDER_ID; }
+    bool is_valid() const { return record_.id != INVALID_ORDER_ID; }
+    
+    // Price level this order is resting in (nullptr if not resting)
+    PriceLevel* level() const { return level_; }
+    bool is_resting() const { return level_ != nullptr; }
     
     // String representation for debug/logging
     std::string to_string() const;
     
 private:
-    OrderId id_;
-    Symbol symbol_;
-    Side side_;
-    OrderType type_;
-    Quantity quantity_;
-    Quantity executed_quantity_; // How much of the order has been executed
-    Price price_;
-    TimeInForce time_in_force_;
-    OrderStatus status_;
-    Timestamp timestamp_;       // Time when order was created
+    // Intrusive FIFO links, maintained by the PriceLevel the order rests in.
+    // The level owns its orders through the forward links.
+    friend class PriceLevel;
+    std::shared_ptr<Order> next_;
+    Order* prev_ = nullptr;
+    PriceLevel* level_ = nullptr;
+    
+    OrderRecord record_;
     Timestamp last_update_;     // Time of last status change
 };
 
@@ -3,60 +3,141 @@
 #include "orderbook/types.hpp"
 #include "orderbook/order.hpp"
 #include "orderbook/price_level.hpp"
+#include "orderbook/book_side.hpp"
+#include "orderbook/order_pool.hpp"
+#include "orderbook/order_index.hpp"
+#include "orderbook/stop_book.hpp"
+#include "orderbook/peg_book.hpp"
+#include "orderbook/match_sink.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include "orderbook/order_command.hpp"
+#include "orderbook/depth_cache.hpp"
+#include "orderbook/market_data.hpp"
+#include "orderbook/risk_gate.hpp"
+#include "orderbook/snapshot.hpp"
 #include <map>
-#include <unordered_map>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace trading_engine {
 namespace orderbook {
 
 /**
- * OrderMatch - represents a match between two orders
+ * OrderBookConfig - construction-time options for an OrderBook
  */
-struct OrderMatch {
-    OrderId maker_order_id;      // The resting order
-    OrderId taker_order_id;      // The incoming order
-    Price match_price;           // Price at which orders matched
-    Quantity match_quantity;     // Quantity matched
-    Timestamp timestamp;         // When the match occurred
-    
-    // Constructor
-    OrderMatch(OrderId maker, OrderId taker, Price price, Quantity qty)
-        : maker_order_id(maker),
-          taker_order_id(taker),
-          match_price(price),
-          match_quantity(qty),
-          timestamp(current_timestamp()) {
-    }
+struct OrderBookConfig {
+    // Keep price levels in a tick-indexed ladder instead of a std::map.
+    // Limit prices must then lie on the tick grid; off-tick orders are rejected.
+    bool use_price_ladder = false;
     
-    // String representation
-    std::string to_string() const;
+    // Minimum price increment used by the ladder
+    Price tick_size = Price(int64_t{1});
+    
+    // Initial ladder window per side, in ticks (grows on demand)
+    size_t ladder_ticks = PriceLadder::DEFAULT_TICKS;
+    
+    // Largest ladder window per side, in ticks. Orders priced so far from the
+    // rest of their side that the window would have to grow past it are rejected.
+    size_t ladder_max_ticks = PriceLadder::DEFAULT_MAX_TICKS;
+    
+    // Number of orders preallocated in the book's order pool
+    size_t order_pool_capacity = OrderPool::DEFAULT_CAPACITY;
+    
+    // Number of live orders the id index holds before it has to grow
+    size_t order_index_capacity = OrderIndex::DEFAULT_CAPACITY;
+    
+    // Number of levels per side kept in the incremental depth cache
+    size_t depth_levels = DepthCache::DEFAULT_LEVELS;
+};
+
+/**
+ * CancelFilter - selects the resting orders cancel_all() removes
+ *
+ * Unset fields match everything; the price range is inclusive.
+ */
+struct CancelFilter {
+    std::optional<Side> side;
+    std::optional<Price> min_price;
+    std::optional<Price> max_price;
+    std::optional<OwnerId> owner;
+};
+
+/**
+ * SweepCost - what taking a quantity from one side of the book would cost
+ *
+ * Amounts are in notional() units: raw price times quantity over the
+ * quantity scale. impact is how much worse the sweep is than filling the
+ * whole quantity at the touch, so it is never negative.
+ */
+struct SweepCost {
+    Quantity filled;          // Quantity available, up to the amount asked for
+    int64_t notional = 0;     // Total paid (buy) or received (sell)
+    int64_t impact = 0;
+    Price average_price;      // VWAP of `filled` (zero if nothing fills)
+    Price worst_price;        // Last level the sweep reaches
+    size_t levels = 0;        // Levels it touches
+    bool complete = false;    // The whole quantity is available
 };
 
 /**
  * OrderBook - maintains bid and ask sides and matches orders
+ *
+ * Besides limit and market orders the book takes stop orders, held in a
+ * StopBook until the last trade price reaches their stop price, and
+ * pegged orders, which rest at a price derived from the unpegged best bid
+ * and ask. After every command that can trade, triggered stops are run and
+ * peg groups whose reference moved are repriced, until the book settles.
  */
 class OrderBook {
 public:
-    // Constructor with symbol
-    explicit OrderBook(const Symbol& symbol);
+    // Constructor with symbol (interned in the global SymbolRegistry)
+    explicit OrderBook(const Symbol& symbol, const OrderBookConfig& config = {});
+    
+    // Constructor with an already interned symbol
+    explicit OrderBook(SymbolId symbol_id, const OrderBookConfig& config = {});
     
-    // Add a new order to the book
+    // Add a new order to the book (rejected if its id is still live here)
     std::vector<OrderMatch> add_order(OrderPtr order);
     
-    // Cancel an existing order
+    // Add a new order to the book, reporting fills to the sink as they happen
+    void add_order(OrderPtr order, MatchSink& sink);
+    
+    // Cancel an existing order (resting, or a pending stop or pegged order).
+    // Pegs re-follow the book at the next command that can trade.
     bool cancel_order(OrderId order_id);
     
-    // Modify an existing order (price or quantity)
+    // Modify an existing order (price or quantity). A quantity decrease keeps
+    // time priority; a same-price increase moves to the back of the level; a
+    // price change re-queues the same order at the new price, matching first
+    // if it crosses. Reducing to the executed quantity cancels the remainder.
+    // Pegged orders only take quantity amends; pending orders can only be cancelled.
     std::vector<OrderMatch> modify_order(OrderId order_id, 
                                          std::optional<Price> new_price, 
                                          std::optional<Quantity> new_quantity);
     
-    // Get an order by ID
+    // Modify an existing order, reporting any fills from the replacement to the sink
+    void modify_order(OrderId order_id,
+                      std::optional<Price> new_price,
+                      std::optional<Quantity> new_quantity,
+                      MatchSink& sink);
+    
+    // Apply a batch of commands for this book's symbol in order, reporting every
+    // fill to the sink. The event time is read once for the whole batch.
+    // Commands for other symbols are skipped. Returns the number applied.
+    size_t submit_batch(std::span<const OrderCommand> commands, MatchSink& sink);
+    
+    // Apply one command at a caller-supplied event time (used by journal replay,
+    // where the journaled time makes the result reproducible)
+    void apply(const OrderCommand& command, Timestamp now, MatchSink& sink);
+    
+    // Cancel every resting order the filter selects. Returns the number cancelled.
+    size_t cancel_all(const CancelFilter& filter = {});
+    
+    // Get an order by ID (resting or pending)
     OrderPtr get_order(OrderId order_id) const;
     
     // Get the best bid price
@@ -89,6 +170,32 @@ public:
     // Get all asks as price -> quantity map (in ascending order)
     std::map<Price, Quantity> get_asks() const;
     
+    // Get the top bid/ask levels (best first) without copying; the view stays
+    // valid for the book's lifetime and reflects every later change
+    std::span<const DepthLevel> bid_depth() const { return depth_.bids(); }
+    std::span<const DepthLevel> ask_depth() const { return depth_.asks(); }
+    
+    // Get the depth change counter; unchanged means the depth views are unchanged
+    uint64_t depth_sequence() const { return depth_.sequence(); }
+    
+    // Publish incremental market-data events into `ring` (nullptr stops publishing).
+    // The ring must outlive the book or be detached first.
+    void set_market_data_ring(MarketDataRing* ring) { market_data_ = ring; }
+    
+    // Also publish every event onto a broadcast bus (nullptr detaches it). The
+    // bus is shared by all books on one thread and must outlive them.
+    void set_market_data_bus(MarketDataBus* bus) { market_data_bus_ = bus; }
+    
+    // Check new orders against `gate` and report fills to it (nullptr detaches it).
+    // Orders the gate refuses are REJECTED. The gate must outlive the book.
+    void set_risk_gate(RiskGate* gate) { risk_gate_ = gate; }
+    RiskGate* risk_gate() const { return risk_gate_; }
+    
+    // Get the number of events generated, and how many were lost to a full ring
+    // (the bus never refuses an event; its readers count their own losses)
+    uint64_t market_data_sequence() const { return market_data_sequence_; }
+    uint64_t market_data_dropped() const { return market_data_dropped_; }
+    
     // Get the total quantity across all bid levels
     Quantity get_total_bid_quantity() const;
     
@@ -101,46 +208,200 @@ public:
     // Get the number of price levels on the ask side
     size_t ask_level_count() const;
     
-    // Get the total number of orders in the book
+    // Get the number of live orders resting in the book (filled and
+    // cancelled orders are dropped as soon as they leave their level)
     size_t order_count() const;
     
+    // Get the number of accepted orders waiting off the book: untriggered
+    // stops, and pegged orders without a reference price
+    size_t pending_order_count() const { return pending_.size(); }
+    
+    // Get the number of untriggered stop orders
+    size_t stop_order_count() const { return stops_.size(); }
+    
+    // Get the price of the last trade, which stop orders trigger on
+    std::optional<Price> last_trade_price() const { return last_trade_price_; }
+    
+    // Check, without touching the book, whether an order on `side` for `quantity`
+    // could fill completely at prices up to `limit_price` (any price if not set)
+    bool can_fill(Side side, Quantity quantity, std::optional<Price> limit_price) const;
+    
+    // Cost of taking `quantity` with an order on `side` (BUY sweeps the asks).
+    // Levels in the depth cache are scanned with vectorized kernels; only a
+    // sweep that runs past the cached levels walks the book.
+    SweepCost sweep_cost(Side side, Quantity quantity) const;
+    
+    // Total resting quantity on `side` priced within `ticks` ticks of its best
+    // price (0 counts the best level alone). Vectorized over the cached levels.
+    Quantity depth_within(Side side, uint32_t ticks) const;
+    
     // Get the symbol this book is for
-    Symbol symbol() const { return symbol_; }
+    const Symbol& symbol() const { return symbol_info_->name; }
+    SymbolId symbol_id() const { return symbol_id_; }
+    
+    // Get the symbol's reference data (tick, lot, price band)
+    const SymbolInfo& symbol_info() const { return *symbol_info_; }
+    
+    // Get the configuration this book was built with
+    const OrderBookConfig& config() const { return config_; }
+    
+    // Get the pool used for orders created by (or for) this book
+    OrderPool& order_pool() { return order_pool_; }
     
     // Clear the order book (remove all orders)
     void clear();
     
+    // Get the number of bytes write_snapshot() needs for the current book
+    size_t snapshot_size() const;
+    
+    // Write every resting order, level by level in FIFO order, plus the side
+    // totals as a flat binary image (see snapshot.hpp). False if `out` is too small.
+    bool write_snapshot(std::span<std::byte> out, uint64_t journal_sequence = 0) const;
+    
+    // Replace the book's contents with a snapshot image, linking orders straight
+    // into their levels without matching. On failure the book is left empty.
+    bool restore_snapshot(std::span<const std::byte> image, uint64_t* journal_sequence = nullptr);
+    
     // Get a string representation of the order book for debug/logging
     std::string to_string() const;
     
 private:
+    // Number of commands ahead whose index slots submit_batch() prefetches
+    // (their orders follow at half the distance)
+    static constexpr size_t PREFETCH_DISTANCE = 8;
+    
+    // Starting size of the pending-order index (it grows on demand)
+    static constexpr size_t PENDING_INDEX_CAPACITY = 64;
+    
+    // Command implementations; all run at event time now_
+    void process_command(const OrderCommand& command, MatchSink& sink);
+    void process_add(OrderPtr order, MatchSink& sink);
+    
+    // Match a market or limit order and rest what a GTC limit order has left
+    void execute_order(OrderPtr order, MatchSink& sink);
+    bool process_cancel(OrderId order_id);
+    void process_modify(OrderId order_id,
+                        std::optional<Price> new_price,
+                        std::optional<Quantity> new_quantity,
+                        MatchSink& sink);
+    
+    // Check whether a limit at `price` on `side` would trade against the opposite side
+    bool crosses(Side side, Price price) const;
+    
+    // Run triggered stops and reprice moved peg groups until neither changes
+    // the book. Re-entrant calls (from orders submitted while settling) return.
+    void settle(MatchSink& sink);
+    
+    // Stop orders: check the trigger against the last trade, turn a triggered
+    // stop into its market or limit order, and run every triggered stop
+    bool stop_triggered(const Order& order) const;
+    static void elect(Order& order);
+    bool trigger_stops(MatchSink& sink);
+    
+    // Pegged orders: the unpegged best price of a side, the price a group
+    // rests at (unset if there is no reference), and group repricing
+    std::optional<Price> reference_price(Side side) const;
+    std::optional<Price> peg_price(const PegKey& key, std::optional<Price> bid_reference,
+                                   std::optional<Price> ask_reference) const;
+    bool reprice_pegs(MatchSink& sink);
+    
+    // Take an order off its level, or out of the pending index
+    void lift_order(Order& order);
+    
+    // Put a pegged order at `price`, matching first if it crosses, or park it
+    // pending without a price. Returns false if nothing of it is left to rest.
+    bool place_pegged(const OrderPtr& order, std::optional<Price> price, MatchSink& sink);
+    
+    // Cancel the selected orders of one side
+    size_t cancel_side(Side side, const CancelFilter& filter);
+    
     // Match a market order
-    std::vector<OrderMatch> match_market_order(OrderPtr order);
+    void match_market_order(Order& order, MatchSink& sink);
     
     // Match a limit order
-    std::vector<OrderMatch> match_limit_order(OrderPtr order);
+    void match_limit_order(Order& order, MatchSink& sink);
+    
+    // Execute an order against the opposite side, up to an optional limit price
+    void match_against(BookSide& opposite, Order& order,
+                       std::optional<Price> limit_price, MatchSink& sink);
     
     // Add a limit order to the book (after matching)
     void add_limit_order_to_book(OrderPtr order);
     
-    // Remove price level if empty
+    // Remove price level if empty, refreshing depth either way
     void remove_price_level_if_empty(Price price, Side side);
+    void refresh_level(BookSide& book_side, PriceLevel& level);
+    
+    // Report a changed level to the depth cache and the event stream
+    void update_depth(Side side, const PriceLevel& level);
+    
+    // Append one event to the market-data ring and bus, if attached
+    void publish(MarketDataEventType type, Side side, OrderId order_id, OrderId match_id,
+                 Price price, Quantity quantity) {
+        if (market_data_ || market_data_bus_) {
+            publish_event(type, side, order_id, match_id, price, quantity);
+        }
+    }
+    void publish_event(MarketDataEventType type, Side side, OrderId order_id, OrderId match_id,
+                       Price price, Quantity quantity);
+    
+    // Release an order's unexecuted size from its owner's open exposure
+    void release_exposure(const Order& order);
     
     // Process a match between two orders
-    OrderMatch create_match(OrderPtr maker, OrderPtr taker, Quantity match_qty);
+    OrderMatch create_match(const Order& maker, const Order& taker, Quantity match_qty);
+    
+    // Get the side an order rests on
+    BookSide& side_for(Side side) { return side == Side::BUY ? bid_levels_ : ask_levels_; }
+    const BookSide& side_for(Side side) const { return side == Side::BUY ? bid_levels_ : ask_levels_; }
+    
+    // Get the running total quantity for a side
+    Quantity& total_for(Side side) { return side == Side::BUY ? total_bid_quantity_ : total_ask_quantity_; }
+    Quantity total_for(Side side) const { return side == Side::BUY ? total_bid_quantity_ : total_ask_quantity_; }
+    
+    SymbolId symbol_id_;  // The symbol this order book represents
+    const SymbolInfo* symbol_info_;
+    OrderBookConfig config_;
     
-    Symbol symbol_;  // The symbol this order book represents
+    // Pooled storage for orders the book creates
+    OrderPool order_pool_;
     
-    // Order storage - using maps with appropriate comparators for best bid/ask tracking
-    std::map<Price, PriceLevelPtr, std::greater<Price>> bid_levels_; // Descending order
-    std::map<Price, PriceLevelPtr> ask_levels_;                      // Ascending order
+    // Price levels - kept in priority order (bids descending, asks ascending)
+    BookSide bid_levels_;
+    BookSide ask_levels_;
+    
+    // Top-N depth, kept in step with the levels
+    DepthCache depth_;
     
     // Order lookup by ID
-    std::unordered_map<OrderId, OrderPtr> orders_;
+    OrderIndex orders_;
+    
+    // Accepted orders that are not resting on a level (see pending_order_count)
+    OrderIndex pending_;
+    
+    // Stop orders by trigger price, and pegged orders by what they follow
+    StopBook stops_;
+    PegBook pegs_;
+    
+    // Last trade price, and the references the peg groups were last priced from
+    std::optional<Price> last_trade_price_;
+    std::optional<Price> peg_bid_reference_;
+    std::optional<Price> peg_ask_reference_;
+    bool settling_ = false;
     
     // Total quantity on each side
     Quantity total_bid_quantity_;
     Quantity total_ask_quantity_;
+    
+    // Event time of the call in progress
+    Timestamp now_ = 0;
+    
+    // Incremental event output
+    MarketDataRing* market_data_ = nullptr;
+    MarketDataBus* market_data_bus_ = nullptr;
+    RiskGate* risk_gate_ = nullptr;
+    uint64_t market_data_sequence_ = 0;
+    uint64_t market_data_dropped_ = 0;
 };
 
 // Shared pointer typedef for convenience
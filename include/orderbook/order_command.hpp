@@ -0,0 +1,129 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <optional>
+#include <type_traits>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * CommandType - what an OrderCommand asks the book to do
+ */
+enum class CommandType : uint8_t {
+    NEW = 0,      // Add a new order
+    CANCEL = 1,   // Cancel a resting order
+    MODIFY = 2,   // Change price and/or quantity of a resting order
+    SNAPSHOT = 3  // Take an image of the book between two commands (left to its owner)
+};
+
+/**
+ * OrderCommand - fixed-size, trivially copyable order instruction
+ *
+ * Carries everything needed to create, cancel or modify an order without
+ * owning any heap memory, so commands can be queued between threads and
+ * the Order itself is only created by the thread that owns the book.
+ */
+struct OrderCommand {
+    static constexpr uint8_t MODIFY_PRICE = 0x1;
+    static constexpr uint8_t MODIFY_QUANTITY = 0x2;
+
+    CommandType type = CommandType::NEW;
+    Side side = Side::BUY;
+    OrderType order_type = OrderType::LIMIT;
+    TimeInForce time_in_force = TimeInForce::GTC;
+    uint8_t modify_flags = 0;          // MODIFY_* bits for MODIFY commands
+    SymbolId symbol_id = INVALID_SYMBOL_ID;
+    OwnerId owner_id = NO_OWNER;       // Owner recorded on NEW orders
+    OrderId order_id = INVALID_ORDER_ID;
+    Price price;
+    Quantity quantity;
+    Price aux_price;                   // Stop price (STOP*) or peg offset (PEG_*) on NEW orders
+
+    // Build a new-order command
+    static OrderCommand new_order(SymbolId symbol_id, OrderId order_id, Side side, OrderType type,
+                                  Quantity quantity, Price price, TimeInForce tif = TimeInForce::GTC,
+                                  OwnerId owner = NO_OWNER) {
+        OrderCommand command;
+        command.type = CommandType::NEW;
+        command.symbol_id = symbol_id;
+        command.order_id = order_id;
+        command.side = side;
+        command.order_type = type;
+        command.quantity = quantity;
+        command.price = price;
+        command.time_in_force = tif;
+        command.owner_id = owner;
+        return command;
+    }
+
+    // Build a new stop order: a stop-market order without a limit price,
+    // a stop-limit order with one
+    static OrderCommand new_stop(SymbolId symbol_id, OrderId order_id, Side side, Quantity quantity,
+                                 Price stop_price, std::optional<Price> limit_price = std::nullopt,
+                                 TimeInForce tif = TimeInForce::GTC, OwnerId owner = NO_OWNER) {
+        OrderCommand command = new_order(symbol_id, order_id, side,
+                                         limit_price ? OrderType::STOP_LIMIT : OrderType::STOP,
+                                         quantity, limit_price.value_or(Price()), tif, owner);
+        command.aux_price = stop_price;
+        return command;
+    }
+
+    // Build a new pegged order (PEG_MID or PEG_PRIMARY) `offset` away from its reference
+    static OrderCommand new_pegged(SymbolId symbol_id, OrderId order_id, Side side, OrderType type,
+                                   Quantity quantity, Price offset = Price(),
+                                   TimeInForce tif = TimeInForce::GTC, OwnerId owner = NO_OWNER) {
+        OrderCommand command = new_order(symbol_id, order_id, side, type, quantity, Price(), tif, owner);
+        command.aux_price = offset;
+        return command;
+    }
+
+    // Build a cancel command
+    static OrderCommand cancel(SymbolId symbol_id, OrderId order_id) {
+        OrderCommand command;
+        command.type = CommandType::CANCEL;
+        command.symbol_id = symbol_id;
+        command.order_id = order_id;
+        return command;
+    }
+
+    // Build a modify command (unset fields are left unchanged)
+    static OrderCommand modify(SymbolId symbol_id, OrderId order_id,
+                               std::optional<Price> new_price, std::optional<Quantity> new_quantity) {
+        OrderCommand command;
+        command.type = CommandType::MODIFY;
+        command.symbol_id = symbol_id;
+        command.order_id = order_id;
+        if (new_price) {
+            command.price = *new_price;
+            command.modify_flags |= MODIFY_PRICE;
+        }
+        if (new_quantity) {
+            command.quantity = *new_quantity;
+            command.modify_flags |= MODIFY_QUANTITY;
+        }
+        return command;
+    }
+
+    // Build a snapshot request (see MatchingEngine::request_snapshot)
+    static OrderCommand snapshot(SymbolId symbol_id) {
+        OrderCommand command;
+        command.type = CommandType::SNAPSHOT;
+        command.symbol_id = symbol_id;
+        return command;
+    }
+
+    // Fields a MODIFY command changes
+    std::optional<Price> new_price() const {
+        return (modify_flags & MODIFY_PRICE) ? std::optional<Price>(price) : std::nullopt;
+    }
+    std::optional<Quantity> new_quantity() const {
+        return (modify_flags & MODIFY_QUANTITY) ? std::optional<Quantity>(quantity) : std::nullopt;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<OrderCommand>, "OrderCommand is copied through lock-free rings");
+static_assert(sizeof(OrderCommand) <= 64, "OrderCommand should fit in a cache line");
+
+} // namespace orderbook
+} // namespace trading_engine
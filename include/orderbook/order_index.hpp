@@ -0,0 +1,167 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "core/cache.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * OrderIndex - flat open-addressing map from OrderId to its order
+ *
+ * Ids and orders live in parallel power-of-two arrays probed linearly from
+ * the id's low bits, so dense, increasing exchange ids land in consecutive
+ * slots and rarely collide. Erase shifts the rest of the probe run back
+ * rather than leaving tombstones, so lookups stay short however many
+ * orders come and go. The table is sized for a capacity up front and only
+ * grows once that capacity is exceeded (see growth_count()).
+ */
+class OrderIndex {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr size_t MAX_LOAD_PERCENT = 50;
+
+    // Constructor with the number of orders to hold without growing
+    explicit OrderIndex(size_t capacity = DEFAULT_CAPACITY);
+
+    // Order stored for `id`, nullptr if none
+    OrderPtr* find(OrderId id) {
+        size_t slot = locate(id);
+        return slot == NOT_FOUND ? nullptr : &orders_[slot];
+    }
+
+    const OrderPtr* find(OrderId id) const {
+        size_t slot = locate(id);
+        return slot == NOT_FOUND ? nullptr : &orders_[slot];
+    }
+
+    bool contains(OrderId id) const { return locate(id) != NOT_FOUND; }
+
+    // Store `order` under `id`, replacing any previous entry.
+    // Returns true if the id was new; INVALID_ORDER_ID is never stored.
+    bool insert_or_assign(OrderId id, OrderPtr order) {
+        if (id == INVALID_ORDER_ID) {
+            return false;
+        }
+
+        size_t slot = home(id);
+        while (keys_[slot] != INVALID_ORDER_ID) {
+            if (keys_[slot] == id) {
+                orders_[slot] = std::move(order);
+                return false;
+            }
+            slot = (slot + 1) & mask_;
+        }
+
+        if ((size_ + 1) * 100 > keys_.size() * MAX_LOAD_PERCENT) {
+            grow();
+            slot = home(id);
+            while (keys_[slot] != INVALID_ORDER_ID) {
+                slot = (slot + 1) & mask_;
+            }
+        }
+
+        keys_[slot] = id;
+        orders_[slot] = std::move(order);
+        ++size_;
+        return true;
+    }
+
+    // Remove the entry for `id`; returns false if there was none
+    bool erase(OrderId id) {
+        size_t hole = locate(id);
+        if (hole == NOT_FOUND) {
+            return false;
+        }
+        orders_[hole].reset();
+
+        // Backward-shift deletion: pull later entries of the run into the
+        // hole whenever the hole lies on their probe path
+        size_t next = (hole + 1) & mask_;
+        while (keys_[next] != INVALID_ORDER_ID) {
+            size_t distance_from_home = (next - home(keys_[next])) & mask_;
+            size_t distance_from_hole = (next - hole) & mask_;
+            if (distance_from_home >= distance_from_hole) {
+                keys_[hole] = keys_[next];
+                orders_[hole] = std::move(orders_[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        keys_[hole] = INVALID_ORDER_ID;
+        --size_;
+        return true;
+    }
+
+    // Warm the cache lines of the id's home slot (key and value), so a find()
+    // issued a little later doesn't miss
+    void prefetch(OrderId id) const {
+        size_t slot = home(id);
+        core::prefetch_read(&keys_[slot]);
+        core::prefetch_read(&orders_[slot]);
+    }
+
+    // Remove every entry (keeps the table size)
+    void clear();
+
+    // Make room for `count` entries without growing later
+    void reserve(size_t count);
+
+    // Visit every (id, order) pair in slot order
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (size_t slot = 0; slot < keys_.size(); ++slot) {
+            if (keys_[slot] != INVALID_ORDER_ID) {
+                func(keys_[slot], orders_[slot]);
+            }
+        }
+    }
+
+    // Accessors
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return keys_.size() * MAX_LOAD_PERCENT / 100; }
+    size_t slot_count() const { return keys_.size(); }
+    size_t growth_count() const { return growth_count_; }
+
+private:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    size_t home(OrderId id) const { return static_cast<size_t>(id) & mask_; }
+
+    size_t locate(OrderId id) const {
+        if (id == INVALID_ORDER_ID) {
+            return NOT_FOUND;
+        }
+        size_t slot = home(id);
+        while (true) {
+            OrderId key = keys_[slot];
+            if (key == id) {
+                return slot;
+            }
+            if (key == INVALID_ORDER_ID) {
+                return NOT_FOUND;
+            }
+            slot = (slot + 1) & mask_;
+        }
+    }
+
+    // Double the table and reinsert every entry
+    void grow();
+    void rehash(size_t slots);
+
+    static size_t slots_for(size_t capacity);
+
+    std::vector<OrderId> keys_;        // INVALID_ORDER_ID marks an empty slot
+    std::vector<OrderPtr> orders_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t growth_count_ = 0;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
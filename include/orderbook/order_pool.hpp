@@ -0,0 +1,144 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace trading_engine {
+namespace orderbook {
+
+namespace detail {
+
+/**
+ * OrderSlab - preallocated block storage backing an OrderPool
+ *
+ * Blocks are handed out by a single owning thread and may be returned from
+ * any thread (the free list is a single-consumer Treiber stack). The slab
+ * counts its owner plus every outstanding block and deletes itself when the
+ * last of them is released, so orders may outlive the pool that made them.
+ */
+class OrderSlab {
+public:
+    OrderSlab(size_t capacity, size_t block_size);
+    ~OrderSlab();
+
+    OrderSlab(const OrderSlab&) = delete;
+    OrderSlab& operator=(const OrderSlab&) = delete;
+
+    // Allocate a block (falls back to the heap when full or oversized)
+    void* allocate(size_t bytes, size_t alignment);
+
+    // Return a block; may delete the slab if the owner is gone
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept;
+
+    // Drop the owner's reference
+    void release() noexcept;
+
+    // Accessors
+    size_t capacity() const { return capacity_; }
+    size_t block_size() const { return block_size_; }
+    size_t in_use() const { return in_use_.load(std::memory_order_relaxed); }
+    size_t heap_fallbacks() const { return heap_fallbacks_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    bool owns(const void* ptr) const {
+        auto p = static_cast<const std::byte*>(ptr);
+        return p >= storage_ && p < storage_ + capacity_ * block_size_;
+    }
+
+    void drop_ref() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    size_t capacity_;
+    size_t block_size_;
+    std::byte* storage_;
+    std::atomic<FreeBlock*> free_list_;
+    std::atomic<size_t> refs_;             // Owner + outstanding blocks
+    std::atomic<size_t> in_use_;           // Outstanding slab blocks
+    std::atomic<size_t> heap_fallbacks_;   // Allocations served by the heap
+};
+
+/**
+ * Allocator that routes std::allocate_shared through an OrderSlab
+ */
+template <typename T>
+class OrderSlabAllocator {
+public:
+    using value_type = T;
+
+    explicit OrderSlabAllocator(OrderSlab* slab) noexcept : slab_(slab) {}
+
+    template <typename U>
+    OrderSlabAllocator(const OrderSlabAllocator<U>& other) noexcept : slab_(other.slab()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(slab_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        slab_->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    OrderSlab* slab() const noexcept { return slab_; }
+
+    template <typename U>
+    bool operator==(const OrderSlabAllocator<U>& other) const noexcept { return slab_ == other.slab(); }
+
+private:
+    OrderSlab* slab_;
+};
+
+} // namespace detail
+
+/**
+ * OrderPool - fixed-capacity slab storage for Orders
+ *
+ * create() places the Order and its shared_ptr control block in a single
+ * preallocated block, so creating a pooled order costs no heap allocation
+ * until the pool is exhausted (after which it falls back to the heap).
+ * Create orders on the owning thread; releasing them is safe from any thread.
+ */
+class OrderPool {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    // Constructor with the number of orders to preallocate
+    explicit OrderPool(size_t capacity = DEFAULT_CAPACITY);
+    ~OrderPool();
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    // Create a pooled order (same arguments as the Order constructor)
+    template <typename... Args>
+    OrderPtr create(Args&&... args) {
+        return std::allocate_shared<Order>(detail::OrderSlabAllocator<Order>(slab_),
+                                           std::forward<Args>(args)...);
+    }
+
+    // Accessors
+    size_t capacity() const { return slab_->capacity(); }
+    size_t in_use() const { return slab_->in_use(); }
+    size_t available() const { return capacity() - in_use(); }
+    size_t heap_fallbacks() const { return slab_->heap_fallbacks(); }
+    size_t block_size() const { return slab_->block_size(); }
+
+private:
+    detail::OrderSlab* slab_;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
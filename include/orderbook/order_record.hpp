@@ -0,0 +1,71 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <type_traits>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * OrderRecord - compact, trivially copyable order state
+ *
+ * Holds everything that describes an order except its book links, with the
+ * side, type, time in force and status packed into one 32-bit word. Order
+ * keeps its state in one of these, and snapshot/replay code can copy records
+ * around with memcpy.
+ */
+struct OrderRecord {
+    // Bit layout of the packed flags word
+    static constexpr uint32_t SIDE_SHIFT = 0;    // 1 bit
+    static constexpr uint32_t TYPE_SHIFT = 1;    // 3 bits
+    static constexpr uint32_t TIF_SHIFT = 4;     // 2 bits
+    static constexpr uint32_t STATUS_SHIFT = 6;  // 4 bits
+    static constexpr uint32_t SIDE_MASK = 0x1u << SIDE_SHIFT;
+    static constexpr uint32_t TYPE_MASK = 0x7u << TYPE_SHIFT;
+    static constexpr uint32_t TIF_MASK = 0x3u << TIF_SHIFT;
+    static constexpr uint32_t STATUS_MASK = 0xFu << STATUS_SHIFT;
+    
+    OrderId id = INVALID_ORDER_ID;
+    Price price;
+    Quantity quantity;
+    Quantity executed_quantity;   // How much of the order has been executed
+    Timestamp timestamp = 0;      // Time when order was created
+    SymbolId symbol_id = INVALID_SYMBOL_ID;
+    uint32_t flags = 0;           // Side, type, TIF and status (see pack_flags)
+    OwnerId owner_id = NO_OWNER;  // Participant that owns the order
+    uint32_t reserved = 0;        // Keeps the record free of implicit padding
+    Price aux_price;              // Stop price (STOP*) or peg offset (PEG_*)
+    
+    // Pack the enum fields into a flags word
+    static constexpr uint32_t pack_flags(Side side, OrderType type, TimeInForce tif, OrderStatus status) {
+        return (static_cast<uint32_t>(side) << SIDE_SHIFT) |
+               (static_cast<uint32_t>(type) << TYPE_SHIFT) |
+               (static_cast<uint32_t>(tif) << TIF_SHIFT) |
+               (static_cast<uint32_t>(status) << STATUS_SHIFT);
+    }
+    
+    // Unpacked accessors
+    constexpr Side side() const { return static_cast<Side>((flags & SIDE_MASK) >> SIDE_SHIFT); }
+    constexpr OrderType type() const { return static_cast<OrderType>((flags & TYPE_MASK) >> TYPE_SHIFT); }
+    constexpr TimeInForce time_in_force() const { return static_cast<TimeInForce>((flags & TIF_MASK) >> TIF_SHIFT); }
+    constexpr OrderStatus status() const { return static_cast<OrderStatus>((flags & STATUS_MASK) >> STATUS_SHIFT); }
+    
+    constexpr void set_type(OrderType type) {
+        flags = (flags & ~TYPE_MASK) | (static_cast<uint32_t>(type) << TYPE_SHIFT);
+    }
+    
+    constexpr void set_status(OrderStatus status) {
+        flags = (flags & ~STATUS_MASK) | (static_cast<uint32_t>(status) << STATUS_SHIFT);
+    }
+    
+    Quantity remaining_quantity() const { return quantity - executed_quantity; }
+};
+
+static_assert(sizeof(OrderRecord) == 64, "OrderRecord should stay at 64 bytes");
+static_assert(sizeof(OrderRecord) <= 64, "OrderRecord must fit in a cache line");
+static_assert(alignof(OrderRecord) == alignof(int64_t), "OrderRecord must not need extra alignment");
+static_assert(std::is_trivially_copyable_v<OrderRecord>, "OrderRecord must be trivially copyable");
+static_assert(std::is_standard_layout_v<OrderRecord>, "OrderRecord must be standard layout");
+
+} // namespace orderbook
+} // namespace trading_engine
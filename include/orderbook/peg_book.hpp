@@ -0,0 +1,100 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order.hpp"
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * PegKey - what a pegged order's price follows: side, peg type and offset
+ */
+struct PegKey {
+    Side side = Side::BUY;
+    OrderType type = OrderType::PEG_MID;
+    Price offset;
+    
+    bool operator<(const PegKey& other) const {
+        if (side != other.side) {
+            return side < other.side;
+        }
+        if (type != other.type) {
+            return type < other.type;
+        }
+        return offset < other.offset;
+    }
+};
+
+/**
+ * PegGroup - pegged orders sharing a key, in arrival order
+ *
+ * Every order of a group is priced alike, so the group records the price
+ * its orders currently rest at (unset while there is no reference price
+ * and the orders are parked off the book).
+ */
+struct PegGroup {
+    std::optional<Price> price;
+    std::vector<OrderPtr> orders;
+};
+
+/**
+ * PegBook - pegged orders of one book, grouped by PegKey
+ *
+ * Repricing works per group: when a reference price moves, each group
+ * computes its new price once and moves its orders together, instead of
+ * every pegged order being re-evaluated on its own.
+ */
+class PegBook {
+public:
+    // Key a pegged order is grouped under
+    static PegKey key_for(const Order& order) {
+        return PegKey{order.side(), order.type(), order.peg_offset()};
+    }
+    
+    // Append a pegged order to its group, returning the group and whether it is new
+    std::pair<PegGroup*, bool> add(OrderPtr order);
+    
+    // Remove a pegged order from its group; returns false if it isn't grouped
+    bool remove(const Order& order);
+    
+    // Find the group for a key, nullptr if there is none
+    PegGroup* find(const PegKey& key);
+    
+    // Visit every group as func(const PegKey&, PegGroup&). Groups may be
+    // changed, but not added or removed, while visiting.
+    template <typename Func>
+    void for_each_group(Func&& func) {
+        for (auto& [key, group] : groups_) {
+            func(key, group);
+        }
+    }
+    
+    template <typename Func>
+    void for_each_group(Func&& func) const {
+        for (const auto& [key, group] : groups_) {
+            func(key, group);
+        }
+    }
+    
+    // Drop groups that have no orders left
+    void prune();
+    
+    // Remove every group
+    void clear() { groups_.clear(); }
+    
+    // Accessors
+    size_t group_count() const { return groups_.size(); }
+    size_t order_count() const;
+    bool empty() const { return groups_.empty(); }
+    
+private:
+    std::map<PegKey, PegGroup> groups_;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+// Notional value of `quantity` at `price` in raw price units, computed in
+// fixed point (a 128-bit product only when the 64-bit one would overflow)
+inline int64_t notional(Price price, Quantity quantity) {
+    int64_t product = 0;
+    if (!__builtin_mul_overflow(price.raw_value(), quantity.raw_value(), &product)) {
+        return product / Quantity::SCALE_FACTOR;
+    }
+    __extension__ using wide = __int128;
+    return static_cast<int64_t>(static_cast<wide>(price.raw_value()) * quantity.raw_value() /
+                                Quantity::SCALE_FACTOR);
+}
+
+/**
+ * Position - one account's holding in one symbol
+ *
+ * Kept on an average-cost basis: `cost` is the signed notional paid for the
+ * open position (negative when short), and closing trades realise the
+ * difference between their price and the average cost of what they close.
+ * All amounts are raw price units (Price::SCALE_FACTOR per currency unit).
+ * open_buy and open_sell are the unexecuted quantity of the account's live
+ * orders, which would move `net` if they filled.
+ */
+struct Position {
+    Quantity net;                 // Long positive, short negative
+    int64_t cost = 0;             // Signed notional of the open position
+    int64_t realized_pnl = 0;
+    Quantity bought;
+    Quantity sold;
+    uint64_t fill_count = 0;
+    Quantity open_buy;
+    Quantity open_sell;
+
+    // Apply one execution
+    void apply_fill(Side side, Price price, Quantity quantity);
+
+    // Profit of the open position marked at `mark`
+    int64_t unrealized_pnl(Price mark) const { return notional(mark, net) - cost; }
+
+    // Average entry price of the open position (zero when flat)
+    Price average_price() const;
+
+    bool is_flat() const { return net.is_zero(); }
+};
+
+/**
+ * PositionBook - positions of every account in every symbol
+ *
+ * One flat array of accounts x symbols indexed [owner][symbol], sized up
+ * front, so a fill updates its cells without hashing or allocation. Cells
+ * of different symbols never share state, so books on different threads
+ * can update the same account at once as long as each symbol stays on one
+ * thread.
+ */
+class PositionBook {
+public:
+    // Constructor with the number of accounts (OwnerIds 0..accounts-1) and symbols tracked
+    PositionBook(size_t accounts, size_t symbols);
+
+    // Record a fill for an account; false if the account or symbol is out of range
+    bool on_fill(OwnerId owner, SymbolId symbol_id, Side side, Price price, Quantity quantity);
+
+    // Add or release unexecuted quantity of an account's live orders. Releases
+    // stop at zero. False if the account or symbol is out of range.
+    bool add_open(OwnerId owner, SymbolId symbol_id, Side side, Quantity quantity);
+    bool release_open(OwnerId owner, SymbolId symbol_id, Side side, Quantity quantity);
+
+    // Drop the open quantity of every account in a symbol
+    void clear_open(SymbolId symbol_id);
+
+    // Position of an account in a symbol (nullptr if out of range)
+    Position* find(OwnerId owner, SymbolId symbol_id) {
+        return contains(owner, symbol_id) ? &positions_[index(owner, symbol_id)] : nullptr;
+    }
+    const Position* find(OwnerId owner, SymbolId symbol_id) const {
+        return contains(owner, symbol_id) ? &positions_[index(owner, symbol_id)] : nullptr;
+    }
+
+    // Realised P&L of an account summed over all symbols
+    int64_t realized_pnl(OwnerId owner) const;
+
+    // Reset every position to flat
+    void clear();
+
+    bool contains(OwnerId owner, SymbolId symbol_id) const {
+        return owner < accounts_ && symbol_id < symbols_;
+    }
+
+    // Accessors
+    size_t account_count() const { return accounts_; }
+    size_t symbol_count() const { return symbols_; }
+
+private:
+    size_t index(OwnerId owner, SymbolId symbol_id) const {
+        return static_cast<size_t>(owner) * symbols_ + symbol_id;
+    }
+
+    size_t accounts_;
+    size_t symbols_;
+    std::vector<Position> positions_;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
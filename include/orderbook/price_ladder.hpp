@@ -0,0 +1,130 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/price_level.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * PriceLadder - contiguous, tick-indexed storage for one side of the book
+ *
+ * Slot i holds the level at price base + i * tick. Occupied slots are tracked
+ * in a bitmap so the best price and the next level in priority order are
+ * found with word-sized bit scans instead of tree walks. When a price falls
+ * outside the window the ladder recenters (and grows if the occupied span
+ * no longer fits), moving the existing levels into the new window. Growth
+ * stops at max_ticks: a price that would stretch the occupied span past it
+ * is not accepted, so one far-off order can't allocate millions of slots.
+ */
+class PriceLadder {
+public:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+    static constexpr size_t DEFAULT_TICKS = 4096;
+    static constexpr size_t DEFAULT_MAX_TICKS = size_t(1) << 20;
+
+    // Constructor with side, tick size, initial window size and the largest
+    // window it may grow to (both in ticks)
+    PriceLadder(Side side, Price tick_size, size_t ticks = DEFAULT_TICKS, size_t max_ticks = DEFAULT_MAX_TICKS);
+
+    // Check if a price lies on the tick grid
+    bool is_on_tick(Price price) const { return price.raw_value() % tick_ == 0; }
+
+    // Check if a price can be stored: on the tick grid, far enough from the
+    // ends of the int64 range that a max_ticks window around it can be
+    // represented, and close enough to the occupied levels that the window
+    // stays within max_ticks
+    bool accepts(Price price) const;
+
+    // Find the level at a price, nullptr if there is none
+    PriceLevel* find(Price price);
+    const PriceLevel* find(Price price) const;
+
+    // Find the level at a price, creating it if needed
+    // Returns nullptr if the price is not on the tick grid.
+    // Note: may recenter, which invalidates previously returned pointers.
+    PriceLevel* find_or_create(Price price);
+
+    // Release the level at a price (its orders are discarded)
+    void erase(Price price);
+
+    // Get the best level (highest bid / lowest ask), nullptr if empty
+    PriceLevel* best();
+    const PriceLevel* best() const;
+
+    // Get the next level after the given price in priority order
+    const PriceLevel* next(Price price) const;
+
+    // Visit levels from best to worst until the visitor returns false
+    template <typename Func>
+    void for_each_level(Func&& func) const {
+        for (size_t i = best_; i != NPOS; i = next_occupied(i)) {
+            if (!func(slots_[i])) {
+                break;
+            }
+        }
+    }
+
+    // Accessors
+    Side side() const { return side_; }
+    Price tick_size() const { return Price(tick_); }
+    Price base_price() const { return Price(base_); }
+    size_t capacity() const { return slots_.size(); }
+    size_t max_capacity() const { return max_ticks_; }
+    size_t level_count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // Remove all levels (the window is kept)
+    void clear();
+
+private:
+    // Slot index for a price, NPOS if outside the window or off tick
+    size_t index_of(Price price) const;
+
+    // Price stored at a slot index
+    Price price_at(size_t index) const { return Price(base_ + static_cast<int64_t>(index) * tick_); }
+
+    // Move the window so that it covers the occupied range plus the given price
+    void recenter(Price price);
+
+    // Rebuild the slot array with the given base and capacity
+    void rebuild(int64_t new_base, size_t new_capacity);
+
+    // Bitmap helpers
+    bool is_occupied(size_t index) const {
+        return (occupied_[index >> 6] >> (index & 63)) & 1;
+    }
+    void set_occupied(size_t index) { occupied_[index >> 6] |= uint64_t(1) << (index & 63); }
+    void clear_occupied(size_t index) { occupied_[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+
+    // Lowest occupied index >= from, NPOS if none
+    size_t scan_up(size_t from) const;
+
+    // Highest occupied index <= from, NPOS if none
+    size_t scan_down(size_t from) const;
+
+    // Next occupied slot after index in priority order (worse price)
+    size_t next_occupied(size_t index) const {
+        if (side_ == Side::BUY) {
+            return index == 0 ? NPOS : scan_down(index - 1);
+        }
+        return scan_up(index + 1);
+    }
+
+    Side side_;
+    int64_t tick_;                       // Tick size in raw price units
+    int64_t base_;                       // Raw price of slot 0
+    std::vector<PriceLevel> slots_;      // One level per tick in the window
+    std::vector<uint64_t> occupied_;     // Bitmap of non-empty slots
+    size_t max_ticks_;                   // Largest window the ladder grows to
+    int64_t reach_;                      // Raw span of a max_ticks window, plus a tick
+    size_t count_;                       // Number of occupied slots
+    size_t best_;                        // Index of the best level, NPOS when empty
+};
+
+} // namespace orderbook
+} // namespace trading_engine
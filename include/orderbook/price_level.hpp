@@ -2,10 +2,10 @@
 
 #include "orderbook/types.hpp"
 #include "orderbook/order.hpp"
-#include <list>
-#include <unordered_map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace trading_engine {
 namespace orderbook {
@@ -13,21 +13,44 @@ namespace orderbook {
 /**
  * PriceLevel - represents a single price level in the order book
  * Contains a FIFO queue of orders at the same price
+ *
+ * The queue is an intrusive doubly-linked list threaded through the orders
+ * themselves. Operations taking an Order& are O(1); the OrderId overloads
+ * walk the queue and are meant for tests and diagnostics.
  */
 class PriceLevel {
 public:
     // Constructor with price
     explicit PriceLevel(Price price);
     
+    // Releases all orders still queued at this level
+    ~PriceLevel();
+    
+    // Levels can be moved (orders are re-pointed at the new level) but not copied
+    PriceLevel(PriceLevel&& other) noexcept;
+    PriceLevel& operator=(PriceLevel&& other) noexcept;
+    PriceLevel(const PriceLevel&) = delete;
+    PriceLevel& operator=(const PriceLevel&) = delete;
+    
     // Add an order to this price level (at the end of the queue)
     void add_order(OrderPtr order);
     
     // Remove an order from this price level
     bool remove_order(OrderId order_id);
     
+    // Remove an order resting at this level in O(1)
+    bool remove_order(Order& order);
+    
     // Modify an existing order's quantity
     bool modify_order_quantity(OrderId order_id, Quantity new_quantity);
     
+    // Modify the quantity of an order resting at this level in O(1)
+    bool modify_order_quantity(Order& order, Quantity new_quantity);
+    
+    // Move an order resting at this level to the back of the queue in O(1)
+    // (it loses time priority, e.g. after a quantity increase)
+    bool requeue_order(Order& order);
+    
     // Get the oldest order at this price level
     OrderPtr get_first_order() const;
     
@@ -38,23 +61,105 @@ public:
     // Returns a list of executed orders and their quantities
     std::vector<std::pair<OrderPtr, Quantity>> execute_quantity(Quantity quantity);
     
+    // Execute the oldest order(s) for the given quantity at event time `now`,
+    // reporting each fill to on_fill(const OrderPtr& maker, Quantity exec_qty)
+    // as it happens. Fully executed orders are unlinked after their callback.
+    // Returns the total quantity executed.
+    template <typename Func>
+    Quantity execute_quantity(Quantity quantity, Timestamp now, Func&& on_fill) {
+        Quantity remaining_qty = quantity;
+        
+        // Process orders FIFO until we've executed the requested quantity
+        // or run out of orders at this level
+        while (head_ && remaining_qty > Quantity::ZERO) {
+            Order& order = *head_;
+            
+            // Determine how much of this order to execute
+            Quantity order_remaining = order.remaining_quantity();
+            Quantity exec_qty = (remaining_qty < order_remaining) ? remaining_qty : order_remaining;
+            
+            if (exec_qty > Quantity::ZERO) {
+                // Execute the order and update the level
+                order.execute(exec_qty, now);
+                total_quantity_ = total_quantity_ - exec_qty;
+                remaining_qty = remaining_qty - exec_qty;
+                
+                on_fill(head_, exec_qty);
+            }
+            
+            // If order is fully executed, remove it
+            if (order.is_filled() || order.remaining_quantity() <= Quantity::ZERO) {
+                unlink(order);
+            }
+        }
+        
+        return quantity - remaining_qty;
+    }
+    
+    // Unlink every order pred(const Order&) selects, handing each removed
+    // order to on_removed(OrderPtr). Returns the number removed.
+    template <typename Pred, typename Func>
+    size_t remove_orders_if(Pred&& pred, Func&& on_removed) {
+        size_t removed = 0;
+        Order* order = head_.get();
+        while (order) {
+            Order* next = order->next_.get();
+            if (pred(static_cast<const Order&>(*order))) {
+                total_quantity_ = total_quantity_ - order->remaining_quantity();
+                on_removed(unlink(*order));
+                ++removed;
+            }
+            order = next;
+        }
+        return removed;
+    }
+    
     // Accessors
     Price price() const { return price_; }
     Quantity total_quantity() const { return total_quantity_; }
-    size_t order_count() const { return orders_.size(); }
-    bool is_empty() const { return orders_.empty(); }
+    size_t order_count() const { return order_count_; }
+    size_t pegged_count() const { return pegged_count_; }
+    bool has_unpegged_orders() const { return order_count_ > pegged_count_; }
+    bool is_empty() const { return head_ == nullptr; }
     
     // Get all orders at this price level (in FIFO order)
     std::vector<OrderPtr> get_all_orders() const;
     
+    // Visit orders in FIFO order until the visitor returns false
+    template <typename Func>
+    void for_each_order(Func&& func) const {
+        for (const Order* order = head_.get(); order; order = order->next_.get()) {
+            if (!func(*order)) {
+                break;
+            }
+        }
+    }
+    
     // String representation for debug/logging
     std::string to_string() const;
     
 private:
+    // Find an order by ID by walking the queue
+    Order* find(OrderId order_id) const;
+    
+    // Link an order at the back of the queue
+    void link_back(OrderPtr order);
+    
+    // Unlink an order from the queue, returning the level's reference to it
+    OrderPtr unlink(Order& order);
+    
+    // Drop all orders without recursing down the chain of links
+    void release_all();
+    
+    // Point every queued order at this level
+    void adopt_orders();
+    
     Price price_;                      // Price level
     Quantity total_quantity_;          // Total quantity of all orders at this level
-    std::list<OrderPtr> orders_;       // Orders in FIFO order
-    std::unordered_map<OrderId, std::list<OrderPtr>::iterator> order_map_; // For O(1) lookup
+    OrderPtr head_;                    // Oldest order (owns the chain)
+    Order* tail_;                      // Newest order
+    size_t order_count_;               // Number of queued orders
+    size_t pegged_count_ = 0;          // How many of them are pegged
 };
 
 // Shared pointer typedefs for convenience
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "orderbook/order.hpp"
+#include "orderbook/position_book.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include "orderbook/types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * RiskLimits - pre-trade limits of one account
+ *
+ * Notional limits are in raw price units (see notional()). The defaults
+ * leave everything unlimited.
+ */
+struct RiskLimits {
+    Quantity max_order_quantity = Quantity::MAX_VALUE;
+    int64_t max_order_notional = std::numeric_limits<int64_t>::max();
+
+    // Largest absolute position per symbol if the order, and every other open
+    // order of the account on the same side, filled completely. Orders that
+    // shrink the position always pass.
+    Quantity max_position = Quantity::MAX_VALUE;
+};
+
+/**
+ * RiskCheck - outcome of a pre-trade check
+ */
+enum class RiskCheck : uint8_t {
+    PASSED,
+    UNKNOWN_ACCOUNT,   // Owner or symbol outside the gate's arrays
+    ORDER_QUANTITY,
+    ORDER_NOTIONAL,
+    POSITION_LIMIT,
+    PRICE_BAND,        // Limit price too far from the reference (fat finger)
+    NO_REFERENCE       // Order without a price of its own and nothing to value it at
+};
+
+// Convert a check result to string
+constexpr std::string_view to_string(RiskCheck check) {
+    switch (check) {
+        case RiskCheck::PASSED: return "PASSED";
+        case RiskCheck::UNKNOWN_ACCOUNT: return "UNKNOWN_ACCOUNT";
+        case RiskCheck::ORDER_QUANTITY: return "ORDER_QUANTITY";
+        case RiskCheck::ORDER_NOTIONAL: return "ORDER_NOTIONAL";
+        case RiskCheck::POSITION_LIMIT: return "POSITION_LIMIT";
+        case RiskCheck::PRICE_BAND: return "PRICE_BAND";
+        case RiskCheck::NO_REFERENCE: return "NO_REFERENCE";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * RiskGate - pre-trade checks and live positions for every account
+ *
+ * A book with a gate attached checks each new order, and each amend that
+ * raises an order's quantity or moves its price, before it can rest or
+ * match, and reports every fill back so positions, P&L and the per-symbol
+ * reference price (the last trade) stay current. It also reports each
+ * accepted order's open quantity until the order fills or leaves the book,
+ * so the position limit covers resting exposure too; attach the gate before
+ * the book takes orders, or those already resting are not counted. Limits live in a flat
+ * array indexed by OwnerId and positions in a PositionBook, so a check is
+ * a few loads and compares with no hashing, locking or allocation.
+ *
+ * Limits are set up before trading starts. After that each symbol's cells
+ * are only touched by the thread that owns its book, so one gate can serve
+ * every worker of a MatchingEngine.
+ */
+class RiskGate {
+public:
+    // Constructor with the number of accounts (OwnerIds 0..accounts-1) and symbols covered
+    RiskGate(size_t accounts, size_t symbols);
+
+    // Set an account's limits (before trading); false if the account is out of range
+    bool set_limits(OwnerId owner, const RiskLimits& limits);
+    const RiskLimits* limits(OwnerId owner) const {
+        return owner < limits_.size() ? &limits_[owner] : nullptr;
+    }
+
+    // Seed the reference price of a symbol (fills keep it current afterwards)
+    void set_reference_price(SymbolId symbol_id, Price price);
+    Price reference_price(SymbolId symbol_id) const {
+        return symbol_id < reference_prices_.size() ? reference_prices_[symbol_id] : Price();
+    }
+
+    // Check an order before it enters the book. Stop-market orders are valued
+    // at their stop price, and orders without a price of their own (market,
+    // pegged) at the reference price; under a notional limit they are refused
+    // with NO_REFERENCE until the symbol has one.
+    RiskCheck check(const Order& order, const SymbolInfo& info) const {
+        return check(order, order.price(), order.quantity(), Quantity::ZERO, info);
+    }
+
+    // Check a resting order as if amended to `price` and total `quantity`
+    // (as modify_order takes them); what has already executed still counts
+    // towards the order size but is in the position already
+    RiskCheck check_amend(const Order& order, Price price, Quantity quantity, const SymbolInfo& info) const {
+        return check(order, price, quantity, order.remaining_quantity(), info);
+    }
+
+    // Open quantity of an accepted order: counted when accepted, adjusted by
+    // an amend (from the order's remaining quantity before it), and released
+    // by fills or when the order leaves the book unfilled
+    void on_accept(SymbolId symbol_id, const Order& order) {
+        positions_.add_open(order.owner_id(), symbol_id, order.side(), order.remaining_quantity());
+    }
+    void on_amend(SymbolId symbol_id, const Order& order, Quantity old_remaining);
+    void on_release(SymbolId symbol_id, const Order& order) {
+        positions_.release_open(order.owner_id(), symbol_id, order.side(), order.remaining_quantity());
+    }
+
+    // Record a fill between two orders of a book for `symbol_id`
+    void on_fill(SymbolId symbol_id, const Order& maker, const Order& taker, Price price, Quantity quantity);
+
+    // Positions of every account
+    PositionBook& positions() { return positions_; }
+    const PositionBook& positions() const { return positions_; }
+
+private:
+    // `counted` is the part of the order already in the account's open quantity
+    RiskCheck check(const Order& order, Price price, Quantity quantity, Quantity counted,
+                    const SymbolInfo& info) const;
+
+    std::vector<RiskLimits> limits_;        // Indexed by OwnerId
+    std::vector<Price> reference_prices_;   // Indexed by SymbolId
+    PositionBook positions_;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
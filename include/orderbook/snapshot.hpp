@@ -0,0 +1,69 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order_record.hpp"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace trading_engine {
+namespace orderbook {
+
+class OrderBook;
+
+/**
+ * Snapshot image layout
+ *
+ *   SnapshotHeader
+ *   bid levels, best first:  SnapshotLevel, then its OrderRecords in FIFO order
+ *   ask levels, best first:  SnapshotLevel, then its OrderRecords in FIFO order
+ *   pending orders:          OrderRecords of untriggered stops in trigger
+ *                            order, then of parked pegs in arrival order
+ *
+ * All records are trivially copyable and written in native byte order.
+ */
+struct SnapshotHeader {
+    static constexpr uint64_t MAGIC = 0x3150414E53455445ULL; // "ETESNAP1"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr uint32_t HAS_LAST_TRADE = 0x1;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t order_record_size = sizeof(OrderRecord);
+    uint64_t journal_sequence = 0;   // Last journal record reflected in the image
+    SymbolId symbol_id = INVALID_SYMBOL_ID;
+    uint32_t flags = 0;              // HAS_LAST_TRADE if last_trade_price is set
+    uint64_t bid_levels = 0;
+    uint64_t ask_levels = 0;
+    uint64_t order_count = 0;        // Resting orders
+    Quantity total_bid_quantity;
+    Quantity total_ask_quantity;
+    uint64_t pending_count = 0;      // Pending stop and pegged orders
+    Price last_trade_price;          // Price stop orders trigger on
+
+    bool is_valid() const {
+        return magic == MAGIC && version == VERSION && order_record_size == sizeof(OrderRecord);
+    }
+};
+
+struct SnapshotLevel {
+    Price price;
+    Quantity total_quantity;
+    uint64_t order_count = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>, "SnapshotHeader must be memcpy-able");
+static_assert(std::is_trivially_copyable_v<SnapshotLevel>, "SnapshotLevel must be memcpy-able");
+static_assert(sizeof(SnapshotHeader) == 88, "SnapshotHeader layout changed");
+static_assert(sizeof(SnapshotLevel) == 24, "SnapshotLevel layout changed");
+
+// Write `book` to `path` through a file mapping. `journal_sequence` records
+// where replay of the journal tail should resume. Returns false on failure.
+bool save_snapshot(const OrderBook& book, const std::string& path, uint64_t journal_sequence = 0);
+
+// Restore `book` from `path`, reporting the image's journal sequence through
+// `journal_sequence` if given. On failure the book is left empty.
+bool load_snapshot(OrderBook& book, const std::string& path, uint64_t* journal_sequence = nullptr);
+
+} // namespace orderbook
+} // namespace trading_engine
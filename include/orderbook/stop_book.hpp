@@ -0,0 +1,65 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include "orderbook/order.hpp"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * StopBook - pending stop orders of one book, sorted by trigger price
+ *
+ * Buy stops trigger once the last trade is at or above their stop price,
+ * sell stops once it is at or below, so each side is kept in the order its
+ * stops trigger and only the front has to be looked at after a trade.
+ * Stops with the same stop price trigger in arrival order. Entries are
+ * order ids; the orders themselves are owned by the book.
+ */
+class StopBook {
+public:
+    // Queue a stop order under its side and stop price
+    void add(const Order& order);
+    
+    // Remove a queued stop order; returns false if it isn't queued
+    bool remove(const Order& order);
+    
+    // Pop the next stop triggered by a trade at `last_trade`, buy stops
+    // first. Returns INVALID_ORDER_ID when none is triggered.
+    OrderId pop_triggered(Price last_trade);
+    
+    // Remove every stop
+    void clear();
+    
+    // Visit every queued id, buy stops then sell stops, in trigger order
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (const auto& [price, id] : buy_stops_) {
+            func(id);
+        }
+        for (const auto& [price, id] : sell_stops_) {
+            func(id);
+        }
+    }
+    
+    // Accessors
+    size_t size() const { return buy_stops_.size() + sell_stops_.size(); }
+    bool empty() const { return buy_stops_.empty() && sell_stops_.empty(); }
+    
+    // Lowest buy stop and highest sell stop, i.e. the next prices that trigger
+    std::optional<Price> next_buy_trigger() const;
+    std::optional<Price> next_sell_trigger() const;
+    
+private:
+    template <typename Map>
+    static bool erase(Map& stops, const Order& order);
+    
+    std::multimap<Price, OrderId> buy_stops_;                          // Ascending
+    std::multimap<Price, OrderId, std::greater<Price>> sell_stops_;    // Descending
+};
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "orderbook/types.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace trading_engine {
+namespace orderbook {
+
+/**
+ * SymbolInfo - static reference data for a symbol
+ */
+struct SymbolInfo {
+    Symbol name;
+    Price tick_size = Price(int64_t{1});        // Minimum price increment
+    Quantity lot_size = Quantity(int64_t{1});   // Minimum quantity increment
+    Price min_price = Price::MIN_VALUE;         // Lowest accepted limit price
+    Price max_price = Price::MAX_VALUE;         // Highest accepted limit price
+    uint32_t price_band_bps = 0;                // Fat-finger band around the reference price (0 = off)
+    
+    // Check a limit price against the tick grid and price band
+    bool accepts_price(Price price) const {
+        return price >= min_price && price <= max_price &&
+               (tick_size.raw_value() <= 1 || price.raw_value() % tick_size.raw_value() == 0);
+    }
+    
+    // Check a limit price against the fat-finger band around `reference`
+    // (always true without a band or a reference price)
+    bool within_band(Price price, Price reference) const {
+        if (price_band_bps == 0 || reference.raw_value() <= 0) {
+            return true;
+        }
+        int64_t distance = price.raw_value() - reference.raw_value();
+        distance = distance < 0 ? -distance : distance;
+        return distance * 10000 <= reference.raw_value() * static_cast<int64_t>(price_band_bps);
+    }
+    
+    // Check a quantity against the lot size
+    bool accepts_quantity(Quantity quantity) const {
+        return lot_size.raw_value() <= 1 || quantity.raw_value() % lot_size.raw_value() == 0;
+    }
+};
+
+/**
+ * SymbolRegistry - interns symbol strings to dense SymbolIds
+ *
+ * Ids are handed out in registration order and never reused, and entries
+ * are stored in fixed chunks that never move, so lookups by id are lock-free
+ * and references to an entry stay valid for the registry's lifetime. Names
+ * are found through an open-addressed table of ids that is only ever added
+ * to; it grows by publishing a copy twice the size, and replaced tables are
+ * kept until the registry goes away, so lookups by name are lock-free too.
+ * Only interning a new name (or updating reference data) takes the mutex.
+ */
+class SymbolRegistry {
+public:
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNKS = 1024;
+    static constexpr size_t MAX_SYMBOLS = CHUNK_SIZE * MAX_CHUNKS;
+    
+    SymbolRegistry();
+    ~SymbolRegistry();
+    
+    SymbolRegistry(const SymbolRegistry&) = delete;
+    SymbolRegistry& operator=(const SymbolRegistry&) = delete;
+    
+    // Get the id for a name, registering it with default reference data if new
+    SymbolId intern(std::string_view name);
+    
+    // Register a symbol with reference data (updates the data if already known;
+    // do that before the symbol starts trading, readers don't lock)
+    SymbolId register_symbol(const SymbolInfo& info);
+    
+    // Look up an id (INVALID_SYMBOL_ID if unknown)
+    SymbolId find(std::string_view name) const;
+    
+    // Get the reference data for an id (nullptr if unknown)
+    const SymbolInfo* info(SymbolId id) const;
+    
+    // Get the name for an id (empty if unknown)
+    const Symbol& name(SymbolId id) const;
+    
+    // Number of registered symbols
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+    
+    // Process-wide registry used by Order and OrderBook
+    static SymbolRegistry& global();
+    
+private:
+    // Name index: slots hold ids (INVALID_SYMBOL_ID when empty), at most half full
+    struct NameIndex {
+        explicit NameIndex(size_t capacity);
+        
+        size_t mask;
+        std::unique_ptr<std::atomic<SymbolId>[]> slots;
+    };
+    
+    static constexpr size_t INITIAL_INDEX_CAPACITY = 64;
+    
+    // Append a new entry (mutex must be held)
+    SymbolId append(const SymbolInfo& info);
+    
+    // Id of a published name; lock-free, INVALID_SYMBOL_ID if not (yet) there
+    SymbolId lookup(std::string_view name) const;
+    
+    // Add an id to the index, growing it first if needed (mutex must be held)
+    void index(SymbolId id);
+    
+    SymbolInfo& entry(SymbolId id) const { return chunks_[id / CHUNK_SIZE][id % CHUNK_SIZE]; }
+    
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<NameIndex>> indexes_;   // Every table so far; the last is current
+    std::atomic<const NameIndex*> index_;
+    std::array<std::unique_ptr<SymbolInfo[]>, MAX_CHUNKS> chunks_;
+    std::atomic<size_t> size_;
+};
+
+} // namespace orderbook
+} // namespace trading_engine
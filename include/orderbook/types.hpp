@@ -1,6 +1,8 @@
 #pragma once
 
+#include "core/timer.hpp"
 #include <cstdint>
+#include <cmath>
 #include <string>
 #include <chrono>
 #include <limits>
@@ -27,6 +29,19 @@ constexpr OrderId INVALID_ORDER_ID = 0;
  */
 using Symbol = std::string;
 
+/**
+ * SymbolId - dense integer handle for a symbol
+ * Assigned in registration order so it can index per-symbol arrays directly
+ */
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL_ID = std::numeric_limits<uint32_t>::max();
+
+/**
+ * OwnerId - identifies the participant (account/session) that owns an order
+ */
+using OwnerId = uint32_t;
+constexpr OwnerId NO_OWNER = 0;
+
 /**
  * Price - fixed point decimal for deterministic arithmetic
  * Represents price in the smallest currency unit (e.g. cents)
@@ -35,19 +50,20 @@ using Symbol = std::string;
 class Price {
 public:
     static constexpr int64_t SCALE_FACTOR = 10000;
-    static constexpr Price INVALID = Price(std::numeric_limits<int64_t>::lowest());
-    static constexpr Price MAX_VALUE = Price(std::numeric_limits<int64_t>::max());
-    static constexpr Price MIN_VALUE = Price(std::numeric_limits<int64_t>::min());
-    static constexpr Price ZERO = Price(0);
+    static const Price INVALID;
+    static const Price MAX_VALUE;
+    static const Price MIN_VALUE;
+    static const Price ZERO;
 
     // Default constructor
     constexpr Price() : value_(0) {}
     
     // Integer constructor
     constexpr explicit Price(int64_t value) : value_(value) {}
+    constexpr explicit Price(int value) : value_(value) {}
     
-    // Double constructor - converts to fixed point
-    explicit Price(double value) : value_(static_cast<int64_t>(value * SCALE_FACTOR)) {}
+    // Double constructor - converts to fixed point (rounded to the nearest unit)
+    explicit Price(double value) : value_(std::llround(value * SCALE_FACTOR)) {}
     
     // Convert to double
     double to_double() const { return static_cast<double>(value_) / SCALE_FACTOR; }
@@ -76,6 +92,11 @@ private:
     int64_t value_;  // Raw fixed point value
 };
 
+inline constexpr Price Price::INVALID = Price(std::numeric_limits<int64_t>::lowest());
+inline constexpr Price Price::MAX_VALUE = Price(std::numeric_limits<int64_t>::max());
+inline constexpr Price Price::MIN_VALUE = Price(std::numeric_limits<int64_t>::min());
+inline constexpr Price Price::ZERO = Price(0);
+
 /**
  * Quantity - fixed point decimal for deterministic arithmetic
  * Represents quantity in the smallest unit (e.g. shares, contracts)
@@ -84,19 +105,20 @@ private:
 class Quantity {
 public:
     static constexpr int64_t SCALE_FACTOR = 10000;
-    static constexpr Quantity INVALID = Quantity(std::numeric_limits<int64_t>::lowest());
-    static constexpr Quantity MAX_VALUE = Quantity(std::numeric_limits<int64_t>::max());
-    static constexpr Quantity MIN_VALUE = Quantity(std::numeric_limits<int64_t>::min());
-    static constexpr Quantity ZERO = Quantity(0);
+    static const Quantity INVALID;
+    static const Quantity MAX_VALUE;
+    static const Quantity MIN_VALUE;
+    static const Quantity ZERO;
 
     // Default constructor
     constexpr Quantity() : value_(0) {}
     
     // Integer constructor
     constexpr explicit Quantity(int64_t value) : value_(value) {}
+    constexpr explicit Quantity(int value) : value_(value) {}
     
-    // Double constructor - converts to fixed point
-    explicit Quantity(double value) : value_(static_cast<int64_t>(value * SCALE_FACTOR)) {}
+    // Double constructor - converts to fixed point (rounded to the nearest unit)
+    explicit Quantity(double value) : value_(std::llround(value * SCALE_FACTOR)) {}
     
     // Convert to double
     double to_double() const { return static_cast<double>(value_) / SCALE_FACTOR; }
@@ -128,6 +150,11 @@ private:
     int64_t value_;  // Raw fixed point value
 };
 
+inline constexpr Quantity Quantity::INVALID = Quantity(std::numeric_limits<int64_t>::lowest());
+inline constexpr Quantity Quantity::MAX_VALUE = Quantity(std::numeric_limits<int64_t>::max());
+inline constexpr Quantity Quantity::MIN_VALUE = Quantity(std::numeric_limits<int64_t>::min());
+inline constexpr Quantity Quantity::ZERO = Quantity(0);
+
 /**
  * Order Side - buy or sell
  */
@@ -150,7 +177,11 @@ enum class OrderType : uint8_t {
     LIMIT = 0,       // Limit order - specifies price and quantity
     MARKET = 1,      // Market order - specifies only quantity, executes at market price
     CANCEL = 2,      // Cancel order - cancels an existing order
-    MODIFY = 3       // Modify order - modifies an existing order
+    MODIFY = 3,      // Modify order - modifies an existing order
+    STOP = 4,        // Stop order - becomes a market order once the stop price trades
+    STOP_LIMIT = 5,  // Stop-limit order - becomes a limit order once the stop price trades
+    PEG_MID = 6,     // Midpoint peg - rests at the midpoint plus an offset
+    PEG_PRIMARY = 7  // Primary peg - rests at its own side's best price plus an offset
 };
 
 /**
@@ -162,10 +193,24 @@ constexpr const char* to_string(OrderType type) {
         case OrderType::MARKET: return "MARKET";
         case OrderType::CANCEL: return "CANCEL";
         case OrderType::MODIFY: return "MODIFY";
+        case OrderType::STOP:   return "STOP";
+        case OrderType::STOP_LIMIT: return "STOP_LIMIT";
+        case OrderType::PEG_MID: return "PEG_MID";
+        case OrderType::PEG_PRIMARY: return "PEG_PRIMARY";
         default:                return "UNKNOWN";
     }
 }
 
+// Check if an order type waits for a trigger price
+constexpr bool is_stop(OrderType type) {
+    return type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+}
+
+// Check if an order type takes its price from the book
+constexpr bool is_pegged(OrderType type) {
+    return type == OrderType::PEG_MID || type == OrderType::PEG_PRIMARY;
+}
+
 /**
  * Time in Force - how long an order remains active
  */
@@ -223,11 +268,10 @@ constexpr const char* to_string(OrderStatus status) {
 using Timestamp = int64_t;
 
 /**
- * Get current timestamp in nanoseconds
+ * Get current timestamp in nanoseconds from the selected core::ClockSource
  */
 inline Timestamp current_timestamp() {
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    return core::Timer::now_ns();
 }
 
 } // namespace orderbook
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "core/ring_buffer.hpp"
+#include "orderbook/order_command.hpp"
+#include "orderbook/types.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace trading_engine {
+namespace strategy {
+
+using orderbook::OrderCommand;
+using orderbook::OrderId;
+using orderbook::OrderType;
+using orderbook::OwnerId;
+using orderbook::Price;
+using orderbook::Quantity;
+using orderbook::Side;
+using orderbook::SymbolId;
+using orderbook::TimeInForce;
+using orderbook::Timestamp;
+
+// Ring a strategy sends its orders through; the strategy's thread is the single producer
+using OrderEntryRing = core::SPSCRingBuffer<OrderCommand>;
+
+/**
+ * TopOfBook - latest best bid/offer of one symbol as seen by a strategy
+ *
+ * Delivered once per poll for every subscribed symbol that changed, however
+ * many events changed it; `updates` counts the events folded into it.
+ * Prices are unset (zero raw) and quantities zero for an empty side.
+ * Once the runner loses events for the symbol, `incomplete` stays set.
+ */
+struct TopOfBook {
+    SymbolId symbol_id = orderbook::INVALID_SYMBOL_ID;
+    Price bid_price;
+    Quantity bid_quantity;
+    Price ask_price;
+    Quantity ask_quantity;
+    Price last_trade_price;
+    Quantity last_trade_quantity;
+    Timestamp timestamp = 0;       // Time of the latest event folded in
+    uint64_t sequence = 0;         // Book sequence of that event
+    uint32_t updates = 0;          // Events coalesced since the previous update
+    bool incomplete = false;       // Events were lost: price levels unchanged since may be missing
+
+    bool has_bid() const { return !bid_quantity.is_zero(); }
+    bool has_ask() const { return !ask_quantity.is_zero(); }
+};
+
+/**
+ * Fill - one execution of an order the strategy sent
+ */
+struct Fill {
+    SymbolId symbol_id = orderbook::INVALID_SYMBOL_ID;
+    OrderId order_id = orderbook::INVALID_ORDER_ID;      // The strategy's order
+    OrderId contra_order_id = orderbook::INVALID_ORDER_ID;
+    Side side = Side::BUY;                               // Side of the strategy's order
+    Price price;
+    Quantity quantity;
+    Timestamp timestamp = 0;
+    bool maker = false;                                  // The strategy's order was resting
+};
+
+/**
+ * Strategy - base class for trading logic run by a StrategyRunner
+ *
+ * Every hook is called on the strategy's own thread, so a strategy needs no
+ * locking of its own state. Orders go out through the strategy's own SPSC
+ * order-entry ring and get ids from a block reserved for the strategy, which
+ * is also how its fills are recognised in the market-data stream.
+ */
+class Strategy {
+public:
+    explicit Strategy(std::string name) : name_(std::move(name)) {}
+    virtual ~Strategy() = default;
+
+    Strategy(const Strategy&) = delete;
+    Strategy& operator=(const Strategy&) = delete;
+
+    // Called once on the strategy's thread before any other hook
+    virtual void on_start() {}
+
+    // Latest top of book of a subscribed symbol that changed
+    virtual void on_book_update(const TopOfBook& top) { (void)top; }
+
+    // An order the strategy sent has (partially) filled
+    virtual void on_order_fill(const Fill& fill) { (void)fill; }
+
+    // Timer callback, every StrategyRunnerConfig::tick_interval_ns
+    virtual void on_tick(Timestamp now) { (void)now; }
+
+    // Called once on the strategy's thread after the last other hook
+    virtual void on_stop() {}
+
+    // Receive book updates for a symbol (before the strategy is added to a runner)
+    void subscribe(SymbolId symbol_id);
+    bool is_subscribed(SymbolId symbol_id) const {
+        return symbol_id < subscriptions_.size() && subscriptions_[symbol_id];
+    }
+    const std::vector<SymbolId>& subscribed_symbols() const { return subscribed_; }
+
+    // Owner stamped on every new order (NO_OWNER by default)
+    void set_owner(OwnerId owner) { owner_ = owner; }
+    OwnerId owner() const { return owner_; }
+
+    // Check whether an order id came from this strategy's block
+    bool owns_order(OrderId order_id) const {
+        return order_id_block_ != 0 && (order_id >> ORDER_ID_BITS) == order_id_block_;
+    }
+
+    // Accessors
+    const std::string& name() const { return name_; }
+    uint64_t orders_sent() const { return orders_sent_; }
+    uint64_t orders_refused() const { return orders_refused_; }
+
+protected:
+    // Send a new order with the next id of the strategy's block; returns the id,
+    // or INVALID_ORDER_ID if the order-entry ring is full (or not attached)
+    OrderId send_order(SymbolId symbol_id, Side side, OrderType type, Quantity quantity, Price price,
+                       TimeInForce tif = TimeInForce::GTC);
+
+    // Cancel or amend one of the strategy's orders; false if the ring is full
+    bool send_cancel(SymbolId symbol_id, OrderId order_id);
+    bool send_modify(SymbolId symbol_id, OrderId order_id,
+                     std::optional<Price> new_price, std::optional<Quantity> new_quantity);
+
+    // Send a prepared command as is; false if the ring is full
+    bool send(const OrderCommand& command);
+
+private:
+    friend class StrategyRunner;
+
+    // Low bits of an order id number orders within a strategy's block
+    static constexpr unsigned ORDER_ID_BITS = 40;
+
+    std::string name_;
+    std::vector<bool> subscriptions_;    // Indexed by SymbolId
+    std::vector<SymbolId> subscribed_;
+    OwnerId owner_ = orderbook::NO_OWNER;
+
+    // Set by the runner
+    OrderEntryRing* order_ring_ = nullptr;
+    uint64_t order_id_block_ = 0;        // 0 until the strategy is added to a runner
+    uint64_t next_order_ = 0;
+
+    uint64_t orders_sent_ = 0;
+    uint64_t orders_refused_ = 0;
+};
+
+} // namespace strategy
+} // namespace trading_engine
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "market/matching_engine.hpp"
+#include "orderbook/market_data.hpp"
+#include "strategy/strategy.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace trading_engine {
+namespace strategy {
+
+using market::MatchingEngine;
+using orderbook::MarketDataBus;
+using orderbook::MarketDataEvent;
+
+/**
+ * StrategyRunnerConfig - construction-time options for a StrategyRunner
+ */
+struct StrategyRunnerConfig {
+    static constexpr size_t DEFAULT_ORDER_RING_CAPACITY = 4096;
+    static constexpr size_t DEFAULT_POLL_BATCH = 256;
+
+    // CPU to pin each strategy's thread to (by strategy index); missing entries stay unpinned
+    std::vector<int> strategy_cpus;
+
+    // CPU for the thread forwarding strategy orders to the engine (-1 leaves it unpinned)
+    int order_entry_cpu = -1;
+
+    // Order-entry slots per strategy (rounded up to a power of two)
+    size_t order_ring_capacity = DEFAULT_ORDER_RING_CAPACITY;
+
+    // Most events a strategy takes off each bus before its book updates go out
+    size_t poll_batch = DEFAULT_POLL_BATCH;
+
+    // Interval between on_tick() calls in nanoseconds (0 disables ticks)
+    int64_t tick_interval_ns = 0;
+};
+
+/**
+ * StrategyRunner - runs strategies against a MatchingEngine, one thread each
+ *
+ * Every strategy reads the engine's market-data buses through its own
+ * cursors and keeps its own mirror of the levels of the symbols it
+ * subscribed to. Events are applied in batches and each changed symbol is
+ * reported once per batch with the top of book after the whole batch, so a
+ * strategy that is slow to poll gets one update per symbol instead of one
+ * per change. Fills are reported as they are read.
+ *
+ * Orders flow back through one SPSC ring per strategy, drained by a single
+ * order-entry thread into the engine's queues, so strategies never contend
+ * with each other or with the matching threads. A strategy that falls a
+ * whole bus window behind loses events (see events_lost()). The mirrors of
+ * the symbols on that bus are then cleared and the next update of each says
+ * TopOfBook::incomplete: levels come back only as they change again, and a
+ * level the new touch crosses is dropped.
+ */
+class StrategyRunner {
+public:
+    explicit StrategyRunner(MatchingEngine& engine, const StrategyRunnerConfig& config = {});
+    ~StrategyRunner();
+
+    StrategyRunner(const StrategyRunner&) = delete;
+    StrategyRunner& operator=(const StrategyRunner&) = delete;
+
+    // Add a strategy (before start); it must outlive the runner. Events published
+    // from now on are delivered to it. False if running or already added.
+    bool add_strategy(Strategy& strategy);
+
+    // Start a thread per strategy plus the order-entry thread (the engine should be running)
+    bool start();
+
+    // Stop the strategies, forward the orders they already sent, and join every thread
+    void stop();
+
+    // Deliver pending events and due ticks to one strategy on the calling thread
+    // (only while stopped); returns the number of events read
+    size_t poll(size_t index);
+
+    // Move queued strategy orders to the engine on the calling thread (only while
+    // stopped); returns the number handed over
+    size_t forward();
+
+    // Events a strategy lost by falling a whole bus window behind
+    uint64_t events_lost(size_t index) const;
+
+    // Orders handed to the engine, and orders dropped because the engine refused them
+    uint64_t orders_forwarded() const { return orders_forwarded_.load(std::memory_order_relaxed); }
+    uint64_t orders_rejected() const { return orders_rejected_.load(std::memory_order_relaxed); }
+
+    // Accessors
+    size_t strategy_count() const { return sessions_.size(); }
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+    const StrategyRunnerConfig& config() const { return config_; }
+
+private:
+    // Levels of one symbol rebuilt from LEVEL_CHANGED events
+    struct BookMirror {
+        std::map<Price, Quantity, std::greater<Price>> bids;
+        std::map<Price, Quantity> asks;
+        TopOfBook top;
+        bool dirty = false;
+    };
+
+    struct Session {
+        Session(Strategy& owner, size_t ring_capacity) : strategy(&owner), orders(ring_capacity) {}
+
+        Strategy* strategy;
+        OrderEntryRing orders;
+        std::vector<MarketDataBus::Cursor> cursors;
+        std::vector<std::unique_ptr<BookMirror>> books;   // Indexed by SymbolId (subscribed only)
+        std::vector<SymbolId> dirty;                      // Symbols changed in this batch
+        Timestamp next_tick = 0;
+        std::thread thread;
+    };
+
+    // Strategy thread body
+    void run_strategy(size_t index);
+
+    // Order-entry thread body
+    void run_order_entry();
+
+    // Read one batch of events and deliver the coalesced updates and due ticks
+    size_t poll_session(Session& session);
+    void apply(Session& session, const MarketDataEvent& event);
+
+    // Clear the mirrors of the subscribed symbols a worker's bus carries after it lost events
+    void reset_books(Session& session, size_t worker);
+    void report_fill(Session& session, const MarketDataEvent& event, OrderId order_id,
+                     OrderId contra_order_id, Side side, bool maker);
+
+    // Hand queued orders of every strategy to the engine; a full engine queue
+    // leaves the rest of that strategy's orders for the next pass
+    size_t forward_orders();
+
+    MatchingEngine& engine_;
+    StrategyRunnerConfig config_;
+    std::vector<const MarketDataBus*> buses_;             // One per engine worker that has one
+    std::vector<std::unique_ptr<Session>> sessions_;
+    std::thread order_entry_thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> forwarding_;
+    std::atomic<uint64_t> orders_forwarded_{0};
+    std::atomic<uint64_t> orders_rejected_{0};
+};
+
+} // namespace strategy
+} // namespace trading_engine
@@ -1,10 +1,185 @@
 #include "core/benchmark.hpp"
+#include <fstream>
+#include <limits>
+#include <ostream>
 
 namespace trading_engine {
 namespace core {
 
-// Benchmark implementation is mostly in the header
-// This file is kept for potential future optimizations or additional features
+namespace {
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// CSV fields are quoted if they could be mistaken for separators
+void write_csv_field(std::ostream& out, const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c : text) {
+        if (c == '"') {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+double per_call(uint64_t total, int64_t iterations) {
+    return iterations > 0 ? static_cast<double>(total) / static_cast<double>(iterations) : 0.0;
+}
+
+} // namespace
+
+BenchmarkResult Benchmark::summarize(const std::string& name, const std::vector<int64_t>& batch_times_ns,
+                                     int64_t batch_size, double overhead_ns) {
+    BenchmarkResult result{name, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    result.batch_size = std::max<int64_t>(1, batch_size);
+    result.overhead_ns = overhead_ns;
+    if (batch_times_ns.empty()) {
+        return result;
+    }
+
+    // Per-call time of each sample, net of the timing overhead
+    std::vector<double> times;
+    times.reserve(batch_times_ns.size());
+    double total = 0.0;
+    for (int64_t raw : batch_times_ns) {
+        double net = std::max(0.0, static_cast<double>(raw) - overhead_ns);
+        total += net;
+        times.push_back(net / static_cast<double>(result.batch_size));
+    }
+    std::sort(times.begin(), times.end());
+
+    const size_t count = times.size();
+    result.iterations = static_cast<int64_t>(count) * result.batch_size;
+    result.total_time_ns = std::max<int64_t>(1, std::llround(total));
+    result.min_time_ns = std::llround(times.front());
+    result.max_time_ns = std::llround(times.back());
+    result.mean_time_ns = total / static_cast<double>(result.iterations);
+
+    // Calculate standard deviation
+    double variance = 0.0;
+    for (double time : times) {
+        double diff = time - result.mean_time_ns;
+        variance += diff * diff;
+    }
+    result.stddev_time_ns = std::sqrt(variance / static_cast<double>(count));
+
+    // Calculate percentiles
+    auto at = [&](double quantile) {
+        size_t index = static_cast<size_t>(static_cast<double>(count) * quantile);
+        return times[std::min(index, count - 1)];
+    };
+    result.median_time_ns = (count % 2 == 0)
+        ? (times[count / 2 - 1] + times[count / 2]) / 2.0
+        : times[count / 2];
+    result.p90_time_ns = at(0.9);
+    result.p99_time_ns = at(0.99);
+    result.p999_time_ns = at(0.999);
+    return result;
+}
+
+double Benchmark::measure_overhead(int64_t batch_size) {
+    constexpr int TRIES = 16;
+    int64_t best = std::numeric_limits<int64_t>::max();
+    for (int t = 0; t < TRIES; ++t) {
+        const int64_t start = Timer::now_ns();
+        for (int64_t b = 0; b < batch_size; ++b) {
+            clobber_memory();
+        }
+        best = std::min(best, Timer::now_ns() - start);
+    }
+    return static_cast<double>(best);
+}
+
+void Benchmark::write_json(std::ostream& out, std::span<const BenchmarkResult> results) {
+    out << "{\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        write_json_string(out, r.name);
+        out << ", \"iterations\": " << r.iterations
+            << ", \"batch_size\": " << r.batch_size
+            << ", \"total_time_ns\": " << r.total_time_ns
+            << ", \"ops_per_sec\": " << r.iterations_per_sec()
+            << ", \"mean_ns\": " << r.mean_time_ns
+            << ", \"stddev_ns\": " << r.stddev_time_ns
+            << ", \"min_ns\": " << r.min_time_ns
+            << ", \"max_ns\": " << r.max_time_ns
+            << ", \"median_ns\": " << r.median_time_ns
+            << ", \"p90_ns\": " << r.p90_time_ns
+            << ", \"p99_ns\": " << r.p99_time_ns
+            << ", \"p999_ns\": " << r.p999_time_ns
+            << ", \"overhead_ns\": " << r.overhead_ns
+            << ", \"cpu\": " << r.cpu;
+        if (r.counters.valid) {
+            out << ", \"cycles_per_op\": " << per_call(r.counters.cycles, r.iterations)
+                << ", \"instructions_per_op\": " << per_call(r.counters.instructions, r.iterations)
+                << ", \"cache_misses_per_op\": " << per_call(r.counters.cache_misses, r.iterations)
+                << ", \"branch_misses_per_op\": " << per_call(r.counters.branch_misses, r.iterations);
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void Benchmark::write_csv(std::ostream& out, std::span<const BenchmarkResult> results) {
+    out << "name,iterations,batch_size,total_time_ns,ops_per_sec,mean_ns,stddev_ns,min_ns,max_ns,"
+           "median_ns,p90_ns,p99_ns,p999_ns,overhead_ns,cpu,"
+           "cycles_per_op,instructions_per_op,cache_misses_per_op,branch_misses_per_op\n";
+    for (const BenchmarkResult& r : results) {
+        write_csv_field(out, r.name);
+        out << ',' << r.iterations << ',' << r.batch_size << ',' << r.total_time_ns
+            << ',' << r.iterations_per_sec() << ',' << r.mean_time_ns << ',' << r.stddev_time_ns
+            << ',' << r.min_time_ns << ',' << r.max_time_ns << ',' << r.median_time_ns
+            << ',' << r.p90_time_ns << ',' << r.p99_time_ns << ',' << r.p999_time_ns
+            << ',' << r.overhead_ns << ',' << r.cpu;
+        if (r.counters.valid) {
+            out << ',' << per_call(r.counters.cycles, r.iterations)
+                << ',' << per_call(r.counters.instructions, r.iterations)
+                << ',' << per_call(r.counters.cache_misses, r.iterations)
+                << ',' << per_call(r.counters.branch_misses, r.iterations);
+        } else {
+            out << ",,,,";
+        }
+        out << '\n';
+    }
+}
+
+bool Benchmark::save_results(const std::string& path, std::span<const BenchmarkResult> results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        write_csv(out, results);
+    } else {
+        write_json(out, results);
+    }
+    return static_cast<bool>(out);
+}
 
 } // namespace core
-} // namespace trading_engine 
\ No newline at end of file
+} // namespace trading_engine
@@ -0,0 +1,233 @@
+#include "core/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+
+namespace trading_engine {
+namespace core {
+
+HistogramSnapshot::HistogramSnapshot()
+    : counts(LatencyHistogram::BUCKET_COUNT, 0) {
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+uint64_t HistogramSnapshot::percentile(double p) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the requested sample, 1-based
+    double clamped = std::clamp(p, 0.0, 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::clamp(LatencyHistogram::bucket_upper_bound(i), min, max);
+        }
+    }
+    return max;
+}
+
+void HistogramSnapshot::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    count = 0;
+    sum = 0;
+    min = std::numeric_limits<uint64_t>::max();
+    max = 0;
+}
+
+std::string HistogramSnapshot::to_string() const {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "count=%llu mean=%.1f p50=%llu p99=%llu p99.9=%llu p99.99=%llu max=%llu",
+                  static_cast<unsigned long long>(count), mean(),
+                  static_cast<unsigned long long>(percentile(50.0)),
+                  static_cast<unsigned long long>(percentile(99.0)),
+                  static_cast<unsigned long long>(percentile(99.9)),
+                  static_cast<unsigned long long>(percentile(99.99)),
+                  static_cast<unsigned long long>(count == 0 ? 0 : max));
+    return buffer;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(std::make_unique<std::atomic<uint64_t>[]>(BUCKET_COUNT)) {
+    reset();
+}
+
+void LatencyHistogram::snapshot_into(HistogramSnapshot& out) const {
+    // The count comes from the buckets themselves so percentiles stay
+    // consistent with what was copied, even while the owner keeps recording
+    uint64_t count = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t value = counts_[i].load(std::memory_order_relaxed);
+        out.counts[i] += value;
+        count += value;
+    }
+    if (count == 0) {
+        return;
+    }
+    out.count += count;
+    out.sum += sum_.load(std::memory_order_relaxed);
+    out.min = std::min(out.min, min_.load(std::memory_order_relaxed));
+    out.max = std::max(out.max, max_.load(std::memory_order_relaxed));
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+LatencyProbe::LatencyProbe(std::string name)
+    : name_(std::move(name)) {
+}
+
+LatencyProbe::~LatencyProbe() {
+    for (auto& shard : shards_) {
+        delete shard.load(std::memory_order_acquire);
+    }
+}
+
+HistogramSnapshot LatencyProbe::snapshot() const {
+    HistogramSnapshot out;
+    for (const auto& shard : shards_) {
+        if (const LatencyHistogram* histogram = shard.load(std::memory_order_acquire)) {
+            histogram->snapshot_into(out);
+        }
+    }
+    return out;
+}
+
+void LatencyProbe::reset() {
+    for (auto& shard : shards_) {
+        if (LatencyHistogram* histogram = shard.load(std::memory_order_acquire)) {
+            histogram->reset();
+        }
+    }
+}
+
+namespace {
+
+// Slots of the threads that record, handed out once per thread
+struct SlotPool {
+    std::mutex mutex;
+    std::vector<size_t> released;   // Slots of exited threads, reused first
+    size_t unused = 0;              // Slots from here on were never handed out
+    size_t overflow = 0;            // Spreads threads that must share a slot
+    std::atomic<uint64_t> shared{0};
+};
+
+SlotPool& slot_pool() {
+    static SlotPool pool;
+    return pool;
+}
+
+// Holds a thread's slot for its lifetime and releases it on exit
+class SlotOwner {
+public:
+    SlotOwner() {
+        SlotPool& pool = slot_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.released.empty()) {
+            slot_ = pool.released.back();
+            pool.released.pop_back();
+        } else if (pool.unused < LatencyProbe::MAX_THREADS) {
+            slot_ = pool.unused++;
+        } else {
+            slot_ = pool.overflow++ % LatencyProbe::MAX_THREADS;
+            owned_ = false;
+            pool.shared.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // The next owner picks up the shards through the mutex, after this thread's last record
+    ~SlotOwner() {
+        if (owned_) {
+            SlotPool& pool = slot_pool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.released.push_back(slot_);
+        }
+    }
+
+    size_t slot() const { return slot_; }
+
+private:
+    size_t slot_ = 0;
+    bool owned_ = true;
+};
+
+} // namespace
+
+size_t LatencyProbe::thread_slot() {
+    thread_local SlotOwner owner;
+    return owner.slot();
+}
+
+uint64_t LatencyProbe::shared_slots() {
+    return slot_pool().shared.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram& LatencyProbe::create_shard(size_t slot) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    LatencyHistogram* expected = nullptr;
+    if (shards_[slot].compare_exchange_strong(expected, histogram.get(), std::memory_order_acq_rel)) {
+        return *histogram.release();
+    }
+    return *expected; // Another thread sharing the slot got there first
+}
+
+namespace {
+
+struct ProbeRegistry {
+    std::mutex mutex;
+    std::deque<LatencyProbe> probes;
+};
+
+ProbeRegistry& probe_registry() {
+    static ProbeRegistry registry;
+    return registry;
+}
+
+} // namespace
+
+LatencyProbe& latency_probe(std::string_view name) {
+    ProbeRegistry& registry = probe_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (LatencyProbe& probe : registry.probes) {
+        if (probe.name() == name) {
+            return probe;
+        }
+    }
+    return registry.probes.emplace_back(std::string(name));
+}
+
+std::vector<LatencyProbe*> latency_probes() {
+    ProbeRegistry& registry = probe_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<LatencyProbe*> out;
+    out.reserve(registry.probes.size());
+    for (LatencyProbe& probe : registry.probes) {
+        out.push_back(&probe);
+    }
+    return out;
+}
+
+} // namespace core
+} // namespace trading_engine
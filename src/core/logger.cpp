@@ -1,10 +1,295 @@
 #include "core/logger.hpp"
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 namespace trading_engine {
 namespace core {
 
-// Logger implementation is mostly in the header
-// This file is kept for potential future optimizations or additional features
+namespace {
+
+// Bounded appender over a caller buffer; always leaves room for the terminator
+struct LineWriter {
+    char* out;
+    size_t size;
+    size_t length = 0;
+
+    void append(std::string_view text) {
+        size_t room = size - 1 - length;
+        size_t count = std::min(text.size(), room);
+        std::memcpy(out + length, text.data(), count);
+        length += count;
+    }
+
+    template <typename... Args>
+    void appendf(const char* format, Args... args) {
+        size_t room = size - length;
+        int written = std::snprintf(out + length, room, format, args...);
+        if (written > 0) {
+            length += std::min(static_cast<size_t>(written), room - 1);
+        }
+    }
+};
+
+bool is_flag(char c) {
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+bool is_length_modifier(char c) {
+    return c == 'h' || c == 'l' || c == 'L' || c == 'z' || c == 'j' || c == 't' || c == 'q';
+}
+
+bool is_float_conversion(char c) {
+    return c == 'f' || c == 'F' || c == 'e' || c == 'E' || c == 'g' || c == 'G' || c == 'a' || c == 'A';
+}
+
+bool is_unsigned_conversion(char c) {
+    return c == 'u' || c == 'o' || c == 'x' || c == 'X';
+}
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+} // namespace
+
+size_t format_deferred_entry(const DeferredLogEntry& entry, char* out, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    out[0] = '\0';
+    if (!entry.site) {
+        return 0;
+    }
+
+    LineWriter writer{out, size};
+
+    // Same prefix as the text path
+    char timestamp[48];
+    Timer::format_timestamp(entry.timestamp_ns, timestamp, sizeof(timestamp));
+    writer.appendf("[%s] [%s] [%zu] ", timestamp, to_string(entry.site->level).data(), entry.thread_id);
+
+    // Replay the format one conversion at a time against the stored arguments,
+    // rewriting each length modifier to match how the value was stored
+    const char* p = entry.site->format;
+    size_t next_arg = 0;
+    while (*p) {
+        const char* literal = p;
+        while (*p && *p != '%') {
+            ++p;
+        }
+        writer.append(std::string_view(literal, static_cast<size_t>(p - literal)));
+        if (!*p) {
+            break;
+        }
+
+        const char* spec_begin = p++;
+        if (*p == '%') {
+            writer.append("%");
+            ++p;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion; '*' takes an int argument
+        // The last few bytes are kept for the rewritten length and conversion
+        char spec[48];
+        size_t spec_len = 0;
+        auto add = [&](char c) {
+            if (spec_len < sizeof(spec) - 8) {
+                spec[spec_len++] = c;
+            }
+        };
+        auto copy_number = [&](const char*& cursor) {
+            if (*cursor == '*') {
+                long long value = 0;
+                if (next_arg < entry.arg_count) {
+                    const auto& arg = entry.args[next_arg];
+                    value = entry.types[next_arg] == DeferredLogEntry::ArgType::UINT
+                        ? static_cast<long long>(arg.u) : static_cast<long long>(arg.i);
+                    ++next_arg;
+                }
+                char digits[24];
+                std::snprintf(digits, sizeof(digits), "%lld", value);
+                for (const char* c = digits; *c; ++c) {
+                    add(*c);
+                }
+                ++cursor;
+                return;
+            }
+            while (*cursor >= '0' && *cursor <= '9') {
+                add(*cursor++);
+            }
+        };
+
+        add('%');
+        while (is_flag(*p)) {
+            add(*p++);
+        }
+        copy_number(p);
+        const size_t width_len = spec_len;
+        bool has_precision = false;
+        if (*p == '.') {
+            has_precision = true;
+            add(*p++);
+            copy_number(p);
+        }
+        while (is_length_modifier(*p)) {
+            ++p;
+        }
+
+        char conversion = *p;
+        if (!conversion) {
+            writer.append(spec_begin); // Dangling '%' at the end
+            break;
+        }
+        ++p;
+
+        if (conversion == 'n') {
+            continue; // Never write through stored pointers
+        }
+        if (next_arg >= entry.arg_count) {
+            writer.append(std::string_view(spec_begin, static_cast<size_t>(p - spec_begin)));
+            continue; // Missing argument: keep the spec visible
+        }
+
+        const auto& arg = entry.args[next_arg];
+        auto finish = [&](const char* length_and_conversion) {
+            size_t i = spec_len;
+            for (const char* c = length_and_conversion; *c && i < sizeof(spec) - 1; ++c) {
+                spec[i++] = *c;
+            }
+            spec[i] = '\0';
+            return spec;
+        };
+        char conv[2] = {conversion, '\0'};
+        char length_conv[4] = {'l', 'l', conversion, '\0'};
+
+        switch (entry.types[next_arg]) {
+            case DeferredLogEntry::ArgType::INT:
+                if (is_float_conversion(conversion)) {
+                    writer.appendf(finish(conv), static_cast<double>(arg.i));
+                } else if (conversion == 'c') {
+                    writer.appendf(finish("c"), static_cast<int>(arg.i));
+                } else if (is_unsigned_conversion(conversion)) {
+                    writer.appendf(finish(length_conv), static_cast<unsigned long long>(arg.i));
+                } else {
+                    writer.appendf(finish("lld"), static_cast<long long>(arg.i));
+                }
+                break;
+            case DeferredLogEntry::ArgType::UINT:
+                if (is_float_conversion(conversion)) {
+                    writer.appendf(finish(conv), static_cast<double>(arg.u));
+                } else if (conversion == 'c') {
+                    writer.appendf(finish("c"), static_cast<int>(arg.u));
+                } else if (is_unsigned_conversion(conversion)) {
+                    writer.appendf(finish(length_conv), static_cast<unsigned long long>(arg.u));
+                } else {
+                    writer.appendf(finish("llu"), static_cast<unsigned long long>(arg.u));
+                }
+                break;
+            case DeferredLogEntry::ArgType::DOUBLE:
+                writer.appendf(finish(is_float_conversion(conversion) ? conv : "g"), arg.d);
+                break;
+            case DeferredLogEntry::ArgType::STRING: {
+                // Stored strings are not terminated, so the length becomes the precision
+                int length = static_cast<int>(arg.s.length);
+                if (has_precision) {
+                    spec[spec_len] = '\0';
+                    int precision = std::atoi(spec + width_len + 1);
+                    if (precision >= 0 && spec[width_len + 1] != '-') {
+                        length = std::min(length, precision);
+                    }
+                }
+                spec_len = width_len;
+                writer.appendf(finish(".*s"), length, entry.strings + arg.s.offset);
+                break;
+            }
+            case DeferredLogEntry::ArgType::POINTER:
+                writer.appendf(finish("p"), arg.p);
+                break;
+        }
+        ++next_arg;
+    }
+
+    return writer.length;
+}
+
+void Logger::flush_worker() {
+    size_t idle = 0;
+    while (is_running_.load(std::memory_order_relaxed)) {
+        if (drain() > 0) {
+            idle = 0;
+            continue;
+        }
+
+        // Nothing queued: spin briefly, then yield, then park until a writer
+        // wakes us or the timeout passes
+        ++idle;
+        if (idle < SPIN_ITERATIONS) {
+            cpu_relax();
+        } else if (idle < SPIN_ITERATIONS + YIELD_ITERATIONS) {
+            std::this_thread::yield();
+        } else {
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            parked_.store(true, std::memory_order_seq_cst);
+            if (buffer_.empty() && deferred_.empty() && is_running_.load(std::memory_order_relaxed)) {
+                park_cv_.wait_for(lock, PARK_TIMEOUT);
+            }
+            parked_.store(false, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+    // Final flush on shutdown
+    drain();
+}
+
+size_t Logger::drain() {
+    size_t written = 0;
+    char line[LogRingBuffer::LOG_ENTRY_SIZE];
+
+    while (true) {
+        // A ring read after the other also shows what the same thread queued on it
+        // before that entry, so an empty look at either is taken only once the
+        // other one has been read first
+        DeferredLogEntry* deferred = deferred_.front();
+        const LogRingBuffer::LogEntry* text = buffer_.front();
+        if (text && !deferred) {
+            deferred = deferred_.front();
+        }
+        if (!text && !deferred) {
+            break;
+        }
+
+        if (text && (!deferred || text->timestamp_ns <= deferred->timestamp_ns)) {
+            write_line(text->message());
+            buffer_.pop();
+        } else {
+            size_t length = format_deferred_entry(*deferred, line, sizeof(line));
+            deferred_.pop();
+            write_line(std::string_view(line, length));
+        }
+        ++written;
+    }
+
+    return written;
+}
+
+void Logger::write_line(std::string_view line) {
+    // Write to stdout
+    std::fprintf(stdout, "%.*s\n", static_cast<int>(line.size()), line.data());
+
+    // Write to file if configured
+    if (file_output_ && file_output_->is_open()) {
+        file_output_->write(line.data(), static_cast<std::streamsize>(line.size()));
+        file_output_->put('\n');
+        file_output_->flush();
+    }
+}
 
 } // namespace core
-} // namespace trading_engine 
\ No newline at end of file
+} // namespace trading_engine
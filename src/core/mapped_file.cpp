@@ -0,0 +1,132 @@
+#include "core/mapped_file.hpp"
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TE_HAS_MMAP 1
+#endif
+
+namespace trading_engine {
+namespace core {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      fd_(std::exchange(other.fd_, -1)),
+      path_(std::move(other.path_)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        fd_ = std::exchange(other.fd_, -1);
+        path_ = std::move(other.path_);
+    }
+    return *this;
+}
+
+bool MappedFile::open_write(const std::string& path, size_t size) {
+    close();
+#if defined(TE_HAS_MMAP)
+    if (size == 0) {
+        return false;
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Extending with ftruncate leaves the new range zero-filled
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    data_ = static_cast<std::byte*>(addr);
+    size_ = size;
+    fd_ = fd;
+    path_ = path;
+    return true;
+#else
+    (void)path;
+    (void)size;
+    return false;
+#endif
+}
+
+bool MappedFile::open_read(const std::string& path) {
+    close();
+#if defined(TE_HAS_MMAP)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    // Replay reads front to back
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+
+    data_ = static_cast<std::byte*>(addr);
+    size_ = size;
+    fd_ = fd;
+    path_ = path;
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+bool MappedFile::sync() {
+#if defined(TE_HAS_MMAP)
+    return data_ && ::msync(data_, size_, MS_SYNC) == 0;
+#else
+    return false;
+#endif
+}
+
+void MappedFile::close() {
+#if defined(TE_HAS_MMAP)
+    if (data_) {
+        ::munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    fd_ = -1;
+    path_.clear();
+}
+
+} // namespace core
+} // namespace trading_engine
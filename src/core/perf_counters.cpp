@@ -0,0 +1,126 @@
+#include "core/perf_counters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#define TE_HAS_PERF_EVENT 1
+#endif
+
+namespace trading_engine {
+namespace core {
+
+#if defined(TE_HAS_PERF_EVENT)
+
+namespace {
+
+int open_event(uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd < 0 ? 1 : 0;   // The leader gates the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+
+    constexpr uint64_t configs[EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    // The first event that opens leads the group; later ones that fail are skipped
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        int fd = open_event(configs[i], group_fd_);
+        if (fd < 0) {
+            continue;
+        }
+        if (group_fd_ < 0) {
+            group_fd_ = fd;
+        }
+        fds_[i] = fd;
+        ioctl(fd, PERF_EVENT_IOC_ID, &ids_[i]);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (group_fd_ < 0) {
+        return;
+    }
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounterValues PerfCounters::stop() {
+    PerfCounterValues values;
+    if (group_fd_ < 0) {
+        return values;
+    }
+    ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP | PERF_FORMAT_ID: nr, then {value, id} per event
+    uint64_t buffer[1 + 2 * EVENT_COUNT] = {};
+    if (::read(group_fd_, buffer, sizeof(buffer)) <= 0) {
+        return values;
+    }
+
+    const uint64_t count = buffer[0];
+    for (uint64_t n = 0; n < count && n < EVENT_COUNT; ++n) {
+        const uint64_t value = buffer[1 + 2 * n];
+        const uint64_t id = buffer[2 + 2 * n];
+        for (size_t i = 0; i < EVENT_COUNT; ++i) {
+            if (fds_[i] < 0 || ids_[i] != id) {
+                continue;
+            }
+            switch (static_cast<Event>(i)) {
+                case CYCLES:        values.cycles = value;        values.has_cycles = true;        break;
+                case INSTRUCTIONS:  values.instructions = value;  values.has_instructions = true;  break;
+                case CACHE_MISSES:  values.cache_misses = value;  values.has_cache_misses = true;  break;
+                case BRANCH_MISSES: values.branch_misses = value; values.has_branch_misses = true; break;
+                case EVENT_COUNT:   break;
+            }
+        }
+    }
+    values.valid = true;
+    return values;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {
+}
+
+PerfCounterValues PerfCounters::stop() {
+    return {};
+}
+
+#endif
+
+} // namespace core
+} // namespace trading_engine
@@ -0,0 +1,269 @@
+#include "core/simd_kernels.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define TE_SIMD_AVX2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define TE_SIMD_NEON 1
+#endif
+
+namespace trading_engine {
+namespace core {
+namespace simd {
+
+namespace {
+
+// Reference versions; also used for tails shorter than a vector
+
+int64_t sum_scalar(const int64_t* values, size_t count) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += static_cast<uint64_t>(values[i]);
+    }
+    return static_cast<int64_t>(total);
+}
+
+int64_t dot_scalar(const int64_t* a, const int64_t* b, size_t count) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]);
+    }
+    return static_cast<int64_t>(total);
+}
+
+size_t count_within_scalar(const int64_t* sorted, size_t count, int64_t limit, bool descending) {
+    size_t i = 0;
+    while (i < count && (descending ? sorted[i] >= limit : sorted[i] <= limit)) {
+        ++i;
+    }
+    return i;
+}
+
+size_t prefix_search_scalar(const int64_t* values, size_t count, int64_t target, int64_t& before) {
+    int64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (total + values[i] >= target) {
+            before = total;
+            return i;
+        }
+        total += values[i];
+    }
+    before = total;
+    return count;
+}
+
+#if defined(TE_SIMD_AVX2)
+
+#define TE_AVX2 __attribute__((target("avx2")))
+
+TE_AVX2 int64_t horizontal_sum(__m256i v) {
+    __m128i pair = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(pair) + _mm_extract_epi64(pair, 1);
+}
+
+TE_AVX2 int64_t sum_avx2(const int64_t* values, size_t count) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        total = _mm256_add_epi64(total, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+    }
+    return horizontal_sum(total) + sum_scalar(values + i, count - i);
+}
+
+// Low 64 bits of a 64x64 product from three 32x32 multiplies (AVX2 has no
+// 64-bit lane multiply)
+TE_AVX2 __m256i multiply_low(__m256i a, __m256i b) {
+    __m256i low = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+TE_AVX2 int64_t dot_avx2(const int64_t* a, const int64_t* b, size_t count) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        total = _mm256_add_epi64(total, multiply_low(x, y));
+    }
+    return horizontal_sum(total) + dot_scalar(a + i, b + i, count - i);
+}
+
+TE_AVX2 size_t count_within_avx2(const int64_t* sorted, size_t count, int64_t limit, bool descending) {
+    const __m256i bound = _mm256_set1_epi64x(limit);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sorted + i));
+        __m256i outside = descending ? _mm256_cmpgt_epi64(bound, v) : _mm256_cmpgt_epi64(v, bound);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(outside));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    return i + count_within_scalar(sorted + i, count - i, limit, descending);
+}
+
+TE_AVX2 size_t prefix_search_avx2(const int64_t* values, size_t count, int64_t target, int64_t& before) {
+    if (target <= 0) {
+        before = 0;
+        return 0;
+    }
+
+    // Inclusive scan of four lanes in two shift-and-add steps, plus the carry
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i threshold = _mm256_set1_epi64x(target - 1);
+    __m256i carry = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+        v = _mm256_add_epi64(v, carry);
+
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, threshold)));
+        if (mask != 0) {
+            alignas(32) int64_t running[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(running), v);
+            size_t lane = static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            before = lane == 0 ? _mm256_extract_epi64(carry, 0) : running[lane - 1];
+            return i + lane;
+        }
+        carry = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    int64_t rest = 0;
+    int64_t total = _mm256_extract_epi64(carry, 0);
+    size_t index = prefix_search_scalar(values + i, count - i, target - total, rest);
+    before = total + rest;
+    return i + index;
+}
+
+#undef TE_AVX2
+
+#elif defined(TE_SIMD_NEON)
+
+int64_t sum_neon(const int64_t* values, size_t count) {
+    int64x2_t total = vdupq_n_s64(0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        total = vaddq_s64(total, vld1q_s64(values + i));
+    }
+    return vaddvq_s64(total) + sum_scalar(values + i, count - i);
+}
+
+size_t count_within_neon(const int64_t* sorted, size_t count, int64_t limit, bool descending) {
+    const int64x2_t bound = vdupq_n_s64(limit);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int64x2_t v = vld1q_s64(sorted + i);
+        uint64x2_t inside = descending ? vcgeq_s64(v, bound) : vcleq_s64(v, bound);
+        if (vminvq_u32(vreinterpretq_u32_u64(inside)) == 0) {
+            return i + (vgetq_lane_u64(inside, 0) ? 1 : 0);
+        }
+    }
+    return i + count_within_scalar(sorted + i, count - i, limit, descending);
+}
+
+size_t prefix_search_neon(const int64_t* values, size_t count, int64_t target, int64_t& before) {
+    if (target <= 0) {
+        before = 0;
+        return 0;
+    }
+
+    const int64x2_t zero = vdupq_n_s64(0);
+    const int64x2_t threshold = vdupq_n_s64(target);
+    int64x2_t carry = zero;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int64x2_t v = vld1q_s64(values + i);
+        v = vaddq_s64(vaddq_s64(v, vextq_s64(zero, v, 1)), carry);
+        uint64x2_t reached = vcgeq_s64(v, threshold);
+        if (vgetq_lane_u64(reached, 0)) {
+            before = vgetq_lane_s64(carry, 0);
+            return i;
+        }
+        if (vgetq_lane_u64(reached, 1)) {
+            before = vgetq_lane_s64(v, 0);
+            return i + 1;
+        }
+        carry = vdupq_laneq_s64(v, 1);
+    }
+
+    int64_t rest = 0;
+    int64_t total = vgetq_lane_s64(carry, 0);
+    size_t index = prefix_search_scalar(values + i, count - i, target - total, rest);
+    before = total + rest;
+    return i + index;
+}
+
+#endif
+
+#if defined(TE_SIMD_AVX2)
+bool detect_avx2() {
+    __builtin_cpu_init(); // May run before libgcc's own constructor does it
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool HAS_AVX2 = detect_avx2();
+#endif
+
+} // namespace
+
+int64_t sum(const int64_t* values, size_t count) {
+#if defined(TE_SIMD_AVX2)
+    if (HAS_AVX2) {
+        return sum_avx2(values, count);
+    }
+#elif defined(TE_SIMD_NEON)
+    return sum_neon(values, count);
+#endif
+    return sum_scalar(values, count);
+}
+
+int64_t dot(const int64_t* a, const int64_t* b, size_t count) {
+#if defined(TE_SIMD_AVX2)
+    if (HAS_AVX2) {
+        return dot_avx2(a, b, count);
+    }
+#endif
+    // NEON has no 64-bit lane multiply either, and the scalar loop is as fast
+    return dot_scalar(a, b, count);
+}
+
+size_t count_within(const int64_t* sorted, size_t count, int64_t limit, bool descending) {
+#if defined(TE_SIMD_AVX2)
+    if (HAS_AVX2) {
+        return count_within_avx2(sorted, count, limit, descending);
+    }
+#elif defined(TE_SIMD_NEON)
+    return count_within_neon(sorted, count, limit, descending);
+#endif
+    return count_within_scalar(sorted, count, limit, descending);
+}
+
+size_t prefix_search(const int64_t* values, size_t count, int64_t target, int64_t& before) {
+#if defined(TE_SIMD_AVX2)
+    if (HAS_AVX2) {
+        return prefix_search_avx2(values, count, target, before);
+    }
+#elif defined(TE_SIMD_NEON)
+    return prefix_search_neon(values, count, target, before);
+#endif
+    return prefix_search_scalar(values, count, target, before);
+}
+
+const char* active_isa() {
+#if defined(TE_SIMD_AVX2)
+    return HAS_AVX2 ? "avx2" : "scalar";
+#elif defined(TE_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace simd
+} // namespace core
+} // namespace trading_engine
@@ -1,10 +1,206 @@
 #include "core/timer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(TE_HAS_TSC)
+#include <cpuid.h>
+#endif
 
 namespace trading_engine {
 namespace core {
 
-// Timer implementation is mostly in the header
-// This file is kept for potential future platform-specific optimizations
+namespace {
+
+// Serializes calibration writers; readers go through the sequence counter
+std::mutex calibration_mutex;
+
+// First calibration point, kept so recalibrate() can measure over the longest span
+struct CalibrationAnchor {
+    uint64_t cycles = 0;
+    int64_t ns = 0;
+};
+CalibrationAnchor anchor;
+
+std::atomic<uint64_t> recalibrations{0};
+
+// Background thread behind start_recalibration(); joined at exit
+struct RecalibrationDriver {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread thread;
+    bool running = false;
+
+    ~RecalibrationDriver() { stop(); }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+RecalibrationDriver& driver() {
+    static RecalibrationDriver instance;
+    return instance;
+}
+
+// Nanoseconds per cycle as 32.32 fixed point
+uint64_t compute_scale(uint64_t cycles, int64_t ns) {
+    if (cycles == 0 || ns <= 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(static_cast<double>(ns) * 4294967296.0 / static_cast<double>(cycles));
+}
+
+// Read the counter and the system clock as close together as possible
+std::pair<uint64_t, int64_t> sample() {
+    uint64_t before = TscClock::cycles_ordered();
+    int64_t ns = Timer::system_now_ns();
+    uint64_t after = TscClock::cycles_ordered();
+    return {before + (after - before) / 2, ns};
+}
+
+} // namespace
+
+bool TscClock::is_available() {
+#if defined(TE_HAS_TSC)
+    // CPUID 0x80000007 EDX bit 8: invariant TSC (constant rate across P/C-states)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool TscClock::calibrate(std::chrono::microseconds window) {
+    if (!is_available()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(calibration_mutex);
+    auto [start_cycles, start_ns] = sample();
+    const int64_t window_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(window).count();
+    while (Timer::system_now_ns() - start_ns < window_ns) {
+    }
+    auto [end_cycles, end_ns] = sample();
+
+    uint64_t scale = compute_scale(end_cycles - start_cycles, end_ns - start_ns);
+    if (scale == 0) {
+        return false;
+    }
+
+    anchor = {start_cycles, start_ns};
+    publish(end_cycles, end_ns, scale);
+    return true;
+}
+
+void TscClock::recalibrate() {
+    std::lock_guard<std::mutex> lock(calibration_mutex);
+    if (!is_calibrated()) {
+        return;
+    }
+
+    // Rebase at the current reading so the clock stays continuous; only the
+    // rate changes, measured over the whole span since the anchor
+    auto [now_cycles, now_ns_system] = sample();
+    uint64_t scale = compute_scale(now_cycles - anchor.cycles, now_ns_system - anchor.ns);
+    if (scale == 0) {
+        return;
+    }
+
+    const uint64_t old_base_cycles = base_cycles_.load(std::memory_order_relaxed);
+    const int64_t old_base_ns = base_ns_.load(std::memory_order_relaxed);
+    const uint64_t old_scale = scale_.load(std::memory_order_relaxed);
+    const int64_t current = old_base_ns + to_ns(now_cycles - old_base_cycles, old_scale);
+
+    publish(now_cycles, current, scale);
+    recalibrations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TscClock::maybe_recalibrate() {
+    const uint64_t scale = scale_.load(std::memory_order_relaxed);
+    if (scale == 0) {
+        return;
+    }
+    const int64_t interval_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(RECALIBRATE_INTERVAL).count();
+    const uint64_t since = cycles() - base_cycles_.load(std::memory_order_relaxed);
+    if (to_ns(since, scale) >= interval_ns) {
+        recalibrate();
+    }
+}
+
+bool TscClock::start_recalibration(std::chrono::milliseconds interval) {
+    if (!is_calibrated()) {
+        return false;
+    }
+
+    RecalibrationDriver& d = driver();
+    d.stop();   // Restart with the new interval
+    std::lock_guard<std::mutex> lock(d.mutex);
+    d.running = true;
+    d.thread = std::thread([&d, interval]() {
+        std::unique_lock<std::mutex> lock(d.mutex);
+        while (!d.wake.wait_for(lock, interval, [&d]() { return !d.running; })) {
+            lock.unlock();
+            recalibrate();
+            lock.lock();
+        }
+    });
+    return true;
+}
+
+void TscClock::stop_recalibration() {
+    driver().stop();
+}
+
+bool TscClock::is_recalibrating() {
+    RecalibrationDriver& d = driver();
+    std::lock_guard<std::mutex> lock(d.mutex);
+    return d.running;
+}
+
+uint64_t TscClock::recalibration_count() {
+    return recalibrations.load(std::memory_order_relaxed);
+}
+
+double TscClock::cycles_per_ns() {
+    const uint64_t scale = scale_.load(std::memory_order_relaxed);
+    return scale == 0 ? 0.0 : 4294967296.0 / static_cast<double>(scale);
+}
+
+void TscClock::publish(uint64_t base_cycles, int64_t base_ns, uint64_t scale) {
+    const uint32_t version = version_.load(std::memory_order_relaxed);
+    // Release stores order the odd version before any field a reader can observe
+    version_.store(version + 1, std::memory_order_relaxed);
+    base_cycles_.store(base_cycles, std::memory_order_release);
+    base_ns_.store(base_ns, std::memory_order_release);
+    scale_.store(scale, std::memory_order_release);
+    version_.store(version + 2, std::memory_order_release);
+}
+
+bool set_clock_source(ClockSource source) {
+    if (source == ClockSource::TSC) {
+        if (!TscClock::is_calibrated() && !TscClock::calibrate()) {
+            return false;
+        }
+        if (!TscClock::is_recalibrating()) {
+            TscClock::start_recalibration();
+        }
+    } else {
+        TscClock::stop_recalibration();
+    }
+    detail::clock_source.store(source, std::memory_order_relaxed);
+    return true;
+}
 
 } // namespace core
-} // namespace trading_engine 
\ No newline at end of file
+} // namespace trading_engine
@@ -13,7 +13,7 @@ void test_function() {
     // Simulate some work
     volatile int sum = 0;
     for (int i = 0; i < 1000; ++i) {
-        sum += i;
+        sum = sum + i;
     }
 }
 
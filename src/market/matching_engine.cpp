@@ -0,0 +1,242 @@
+#include "market/matching_engine.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/logger.hpp"
+#include "core/thread_affinity.hpp"
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::CommandType;
+using orderbook::OrderPtr;
+
+MatchingEngine::MatchingEngine(const MatchingEngineConfig& config)
+    : config_(config),
+      symbol_count_(0),
+      running_(false) {
+    size_t worker_count = config_.worker_count == 0 ? 1 : config_.worker_count;
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>(config_.queue_capacity));
+        if (config_.market_data_bus_capacity > 0) {
+            workers_.back()->bus = std::make_unique<orderbook::MarketDataBus>(config_.market_data_bus_capacity);
+        }
+    }
+}
+
+MatchingEngine::~MatchingEngine() {
+    stop();
+}
+
+SymbolId MatchingEngine::add_symbol(const Symbol& symbol) {
+    return add_symbol(symbol, config_.book_config);
+}
+
+SymbolId MatchingEngine::add_symbol(const Symbol& symbol, const OrderBookConfig& config) {
+    SymbolId id = find_symbol(symbol);
+    if (id != orderbook::INVALID_SYMBOL_ID) {
+        return id;
+    }
+
+    // Books are fixed once the workers are running
+    if (is_running()) {
+        return orderbook::INVALID_SYMBOL_ID;
+    }
+
+    id = orderbook::SymbolRegistry::global().intern(symbol);
+    if (id == orderbook::INVALID_SYMBOL_ID) {
+        return id; // Registry full
+    }
+
+    if (id >= books_.size()) {
+        books_.resize(id + 1);
+    }
+    books_[id] = std::make_unique<OrderBook>(id, config);
+    books_[id]->set_market_data_bus(workers_[worker_for(id)]->bus.get());
+    books_[id]->set_risk_gate(config_.risk_gate);
+    ++symbol_count_;
+    return id;
+}
+
+SymbolId MatchingEngine::find_symbol(const Symbol& symbol) const {
+    SymbolId id = orderbook::SymbolRegistry::global().find(symbol);
+    return has_book(id) ? id : orderbook::INVALID_SYMBOL_ID;
+}
+
+void MatchingEngine::set_match_handler(MatchHandler handler) {
+    if (!is_running()) {
+        match_handler_ = std::move(handler);
+    }
+}
+
+void MatchingEngine::set_snapshot_handler(SnapshotHandler handler) {
+    if (!is_running()) {
+        snapshot_handler_ = std::move(handler);
+    }
+}
+
+bool MatchingEngine::start() {
+    if (is_running()) {
+        return false;
+    }
+
+    running_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&MatchingEngine::run_worker, this, i);
+    }
+
+    TE_LOG_INFO("MatchingEngine started: %zu symbols on %zu workers",
+                symbol_count_, workers_.size());
+    return true;
+}
+
+void MatchingEngine::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+bool MatchingEngine::submit(const OrderCommand& command) {
+    if (!has_book(command.symbol_id)) {
+        return false; // Unknown symbol
+    }
+    return workers_[worker_for(command.symbol_id)]->queue.try_push(command);
+}
+
+size_t MatchingEngine::submit_batch(std::span<const OrderCommand> commands) {
+    if (commands.empty() || !has_book(commands.front().symbol_id)) {
+        return 0;
+    }
+
+    // Queue the leading run of commands routed to the same worker
+    size_t worker = worker_for(commands.front().symbol_id);
+    size_t count = 1;
+    while (count < commands.size() && has_book(commands[count].symbol_id) &&
+           worker_for(commands[count].symbol_id) == worker) {
+        ++count;
+    }
+
+    return workers_[worker]->queue.try_push_batch(commands.first(count));
+}
+
+bool MatchingEngine::execute(const OrderCommand& command, MatchSink& sink) {
+    if (is_running() || !has_book(command.symbol_id)) {
+        return false;
+    }
+    process(command, sink);
+    return true;
+}
+
+OrderBook* MatchingEngine::book(SymbolId symbol_id) {
+    return has_book(symbol_id) ? books_[symbol_id].get() : nullptr;
+}
+
+const OrderBook* MatchingEngine::book(SymbolId symbol_id) const {
+    return has_book(symbol_id) ? books_[symbol_id].get() : nullptr;
+}
+
+const orderbook::MarketDataBus* MatchingEngine::market_data_bus(size_t worker) const {
+    return worker < workers_.size() ? workers_[worker]->bus.get() : nullptr;
+}
+
+const orderbook::MarketDataBus* MatchingEngine::market_data_bus_for(SymbolId symbol_id) const {
+    return has_book(symbol_id) ? workers_[worker_for(symbol_id)]->bus.get() : nullptr;
+}
+
+uint64_t MatchingEngine::processed_count(size_t worker) const {
+    if (worker >= workers_.size()) {
+        return 0;
+    }
+    return workers_[worker]->processed.load(std::memory_order_relaxed);
+}
+
+void MatchingEngine::run_worker(size_t index) {
+    Worker& worker = *workers_[index];
+
+    if (index < config_.worker_cpus.size() && !core::pin_current_thread(config_.worker_cpus[index])) {
+        TE_LOG_WARN("MatchingEngine worker %zu could not be pinned to CPU %d",
+                    index, config_.worker_cpus[index]);
+    }
+
+    std::vector<OrderCommand> batch(config_.drain_batch == 0 ? 1 : config_.drain_batch);
+    while (true) {
+        size_t count = worker.queue.try_pop_batch(batch);
+        if (count > 0) {
+            // Queue hop to dispatch: the whole drained batch, fills included
+            TE_LATENCY_PROBE("engine.dispatch");
+
+            // Hand each run of commands for the same symbol to its book in one call
+            size_t begin = 0;
+            while (begin < count) {
+                SymbolId symbol_id = batch[begin].symbol_id;
+                if (batch[begin].type == CommandType::SNAPSHOT) {
+                    serve_snapshot(symbol_id, worker.snapshot);
+                    ++begin;
+                    continue;
+                }
+                size_t end = begin + 1;
+                while (end < count && batch[end].symbol_id == symbol_id &&
+                       batch[end].type != CommandType::SNAPSHOT) {
+                    ++end;
+                }
+
+                worker.fills.clear();
+                books_[symbol_id]->submit_batch(std::span<const OrderCommand>(batch.data() + begin, end - begin),
+                                                worker.fills);
+
+                if (match_handler_) {
+                    for (const OrderMatch& match : worker.fills) {
+                        match_handler_(symbol_id, match);
+                    }
+                }
+                begin = end;
+            }
+
+            worker.processed.fetch_add(count, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Exit only once stopped and everything queued before stop() is handled
+        if (!running_.load(std::memory_order_acquire)) {
+            if (worker.queue.empty()) {
+                break;
+            }
+            continue;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+void MatchingEngine::process(const OrderCommand& command, MatchSink& sink) {
+    if (command.type == CommandType::SNAPSHOT) {
+        std::vector<std::byte> buffer;
+        serve_snapshot(command.symbol_id, buffer);
+        return;
+    }
+
+    // The book builds orders from its own pool on this, the owning, thread
+    books_[command.symbol_id]->apply(command, orderbook::current_timestamp(), sink);
+}
+
+void MatchingEngine::serve_snapshot(SymbolId symbol_id, std::vector<std::byte>& buffer) {
+    if (!snapshot_handler_) {
+        return;
+    }
+    const OrderBook& book = *books_[symbol_id];
+    size_t size = book.snapshot_size();
+    if (buffer.size() < size) {
+        buffer.resize(size);
+    }
+    std::span<std::byte> image(buffer.data(), size);
+    book.write_snapshot(image, book.market_data_sequence());
+    snapshot_handler_(symbol_id, image, book.market_data_sequence());
+}
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,203 @@
+#include "market/order_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::OrderCommand;
+using orderbook::OrderType;
+using orderbook::Side;
+
+namespace {
+
+__extension__ using wide = unsigned __int128;
+
+constexpr double NANOS_PER_SECOND = 1e9;
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+} // namespace
+
+OrderGenerator::OrderGenerator(const OrderGeneratorConfig& config)
+    : config_(config) {
+    config_.max_price_ticks = std::max<uint32_t>(config_.max_price_ticks, 1);
+    config_.max_lots = std::max(config_.max_lots, std::max<uint32_t>(config_.min_lots, 1));
+    config_.min_lots = std::clamp<uint32_t>(config_.min_lots, 1, config_.max_lots);
+    config_.max_live_orders = std::max<size_t>(config_.max_live_orders, 1);
+    config_.market_size_multiplier = std::max<uint32_t>(config_.market_size_multiplier, 1);
+    if (config_.tick_size.raw_value() <= 0) {
+        config_.tick_size = Price(int64_t{1});
+    }
+    reset();
+}
+
+void OrderGenerator::reset() {
+    uint64_t seed = config_.seed;
+    for (uint64_t& word : state_) {
+        word = splitmix64(seed);
+    }
+
+    // Mids start on the tick grid
+    const int64_t tick = config_.tick_size.raw_value();
+    const int64_t mid = std::max(config_.mid_price.raw_value() / tick, int64_t{1}) * tick;
+    mids_.assign(config_.symbols.size(), Price(mid));
+
+    live_.clear();
+    next_order_id_ = config_.first_order_id;
+    clock_ = 0.0;
+    record_ = JournalRecord{};
+}
+
+uint64_t OrderGenerator::next_bits() {
+    // xoshiro256**
+    const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+}
+
+double OrderGenerator::next_unit() {
+    return static_cast<double>(next_bits() >> 11) * 0x1.0p-53;
+}
+
+uint64_t OrderGenerator::next_below(uint64_t bound) {
+    return static_cast<uint64_t>((static_cast<wide>(next_bits()) * bound) >> 64);
+}
+
+uint32_t OrderGenerator::draw(Distribution distribution, uint32_t low, uint32_t high, double decay) {
+    const uint64_t span = uint64_t{high} - low + 1;
+    if (distribution == Distribution::UNIFORM || decay >= 1.0) {
+        return low + static_cast<uint32_t>(next_below(span));
+    }
+    if (decay <= 0.0) {
+        return low;
+    }
+
+    // Inverse CDF of the geometric distribution truncated to the span
+    double tail = 1.0 - std::pow(decay, static_cast<double>(span));
+    double step = std::floor(std::log1p(-next_unit() * tail) / std::log(decay));
+    return low + static_cast<uint32_t>(std::min(step, static_cast<double>(span - 1)));
+}
+
+const JournalRecord* OrderGenerator::next() {
+    if (config_.symbols.empty()) {
+        return nullptr;
+    }
+
+    record_.sequence += 1;
+    record_.timestamp = config_.start_time + static_cast<Timestamp>(clock_);
+    make_command(record_.command);
+
+    if (config_.rate > 0.0) {
+        double gap = NANOS_PER_SECOND / config_.rate;
+        clock_ += config_.poisson_arrivals ? -std::log1p(-next_unit()) * gap : gap;
+    }
+    return &record_;
+}
+
+size_t OrderGenerator::generate(std::span<OrderCommand> out) {
+    size_t count = 0;
+    for (; count < out.size(); ++count) {
+        const JournalRecord* record = next();
+        if (!record) {
+            break;
+        }
+        out[count] = record->command;
+    }
+    return count;
+}
+
+void OrderGenerator::make_command(OrderCommand& command) {
+    const int64_t tick = config_.tick_size.raw_value();
+    uint32_t symbol_index = static_cast<uint32_t>(next_below(config_.symbols.size()));
+    if (next_unit() < config_.mid_walk_probability) {
+        int64_t mid = mids_[symbol_index].raw_value() + ((next_bits() & 1) ? tick : -tick);
+        mids_[symbol_index] = Price(std::max(mid, tick));
+    }
+
+    if (record_.sequence <= config_.warmup_orders) {
+        make_new_order(command, symbol_index, false, false);
+        return;
+    }
+
+    // Cancels and modifies need something to act on; otherwise a new order
+    double choice = next_unit();
+    bool full = live_.size() >= config_.max_live_orders;
+    if (!live_.empty() && (full || choice < config_.cancel_probability)) {
+        LiveOrder order = take_live(true);
+        command = OrderCommand::cancel(config_.symbols[order.symbol_index], order.order_id);
+        return;
+    }
+    choice -= config_.cancel_probability;
+    if (!live_.empty() && choice >= 0.0 && choice < config_.modify_probability) {
+        LiveOrder order = take_live(false);
+        std::optional<Price> price;
+        if (config_.reprice_probability > 0.0 && next_unit() < config_.reprice_probability) {
+            price = draw_price(order.symbol_index, order.side, false);
+        }
+        command = OrderCommand::modify(config_.symbols[order.symbol_index], order.order_id, price,
+                                       draw_quantity());
+        return;
+    }
+    choice -= config_.modify_probability;
+    make_new_order(command, symbol_index, choice >= 0.0 && choice < config_.market_probability, true);
+}
+
+void OrderGenerator::make_new_order(OrderCommand& command, uint32_t symbol_index, bool market, bool may_cross) {
+    const Side side = (next_bits() & 1) ? Side::SELL : Side::BUY;
+    const OrderId order_id = next_order_id_++;
+    const orderbook::SymbolId symbol_id = config_.symbols[symbol_index];
+    Quantity quantity = draw_quantity();
+    if (market) {
+        quantity = Quantity(quantity.raw_value() * config_.market_size_multiplier);
+        command = OrderCommand::new_order(symbol_id, order_id, side, OrderType::MARKET, quantity, Price());
+        return;
+    }
+
+    command = OrderCommand::new_order(symbol_id, order_id, side, OrderType::LIMIT, quantity,
+                                      draw_price(symbol_index, side, may_cross));
+    live_.push_back({symbol_index, order_id, side});
+}
+
+Price OrderGenerator::draw_price(uint32_t symbol_index, Side side, bool may_cross) {
+    // Behind the mid on the order's own side, or through it when crossing
+    const int64_t tick = config_.tick_size.raw_value();
+    int64_t offset = int64_t{draw(config_.price_distribution, 1, config_.max_price_ticks, config_.price_decay)} * tick;
+    bool behind = next_unit() >= config_.cross_probability || !may_cross;
+    int64_t price = mids_[symbol_index].raw_value() + ((side == Side::BUY) == behind ? -offset : offset);
+    return Price(std::max(price, tick));
+}
+
+Quantity OrderGenerator::draw_quantity() {
+    uint32_t lots = draw(config_.size_distribution, config_.min_lots, config_.max_lots, config_.size_decay);
+    return Quantity(static_cast<int64_t>(lots) * config_.lot_size.raw_value());
+}
+
+OrderGenerator::LiveOrder OrderGenerator::take_live(bool remove) {
+    size_t index = static_cast<size_t>(next_below(live_.size()));
+    LiveOrder order = live_[index];
+    if (remove) {
+        live_[index] = live_.back();
+        live_.pop_back();
+    }
+    return order;
+}
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,255 @@
+#include "market/replay.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include <cstring>
+
+namespace trading_engine {
+namespace market {
+
+using orderbook::OrderCommand;
+using orderbook::OrderType;
+using orderbook::Price;
+using orderbook::Quantity;
+using orderbook::Side;
+using orderbook::SymbolId;
+using orderbook::TimeInForce;
+
+static_assert(Price::SCALE_FACTOR == 10000 && Quantity::SCALE_FACTOR == 10000,
+              "parse_fixed_point assumes 4 implied decimals");
+
+namespace {
+
+constexpr int FRACTION_DIGITS = 4;
+
+// Split off the next comma-separated field
+std::string_view next_field(std::string_view& line) {
+    size_t comma = line.find(',');
+    std::string_view field = line.substr(0, comma);
+    line = comma == std::string_view::npos ? std::string_view() : line.substr(comma + 1);
+    return field;
+}
+
+bool parse_unsigned(std::string_view text, uint64_t& value) {
+    if (text.empty()) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9' || __builtin_mul_overflow(value, 10, &value) ||
+            __builtin_add_overflow(value, static_cast<uint64_t>(c - '0'), &value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_signed(std::string_view text, int64_t& value) {
+    bool negative = !text.empty() && text.front() == '-';
+    uint64_t magnitude = 0;
+    if (!parse_unsigned(negative ? text.substr(1) : text, magnitude) ||
+        magnitude > static_cast<uint64_t>(INT64_MAX)) {
+        return false;
+    }
+    value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+} // namespace
+
+bool parse_fixed_point(std::string_view text, int64_t& raw) {
+    bool negative = false;
+    if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+
+    size_t dot = text.find('.');
+    std::string_view whole = text.substr(0, dot);
+    std::string_view fraction = dot == std::string_view::npos ? std::string_view() : text.substr(dot + 1);
+    if (whole.empty() && fraction.empty()) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    if (!whole.empty() && !parse_unsigned(whole, value)) {
+        return false;
+    }
+
+    // Scale by hand: four digits are kept, the fifth decides the rounding
+    uint64_t fraction_value = 0;
+    bool round_up = false;
+    for (size_t i = 0; i < fraction.size(); ++i) {
+        char c = fraction[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        if (i < FRACTION_DIGITS) {
+            fraction_value = fraction_value * 10 + static_cast<uint64_t>(c - '0');
+        } else if (i == FRACTION_DIGITS) {
+            round_up = c >= '5';
+        }
+    }
+    for (size_t i = fraction.size(); i < FRACTION_DIGITS; ++i) {
+        fraction_value *= 10;
+    }
+
+    if (__builtin_mul_overflow(value, static_cast<uint64_t>(Price::SCALE_FACTOR), &value) ||
+        __builtin_add_overflow(value, fraction_value + (round_up ? 1 : 0), &value) ||
+        value > static_cast<uint64_t>(INT64_MAX)) {
+        return false;
+    }
+    raw = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+}
+
+CsvReplaySource::CsvReplaySource(const std::string& path) {
+    if (file_.open_read(path)) {
+        position_ = reinterpret_cast<const char*>(file_.data());
+        end_ = position_ + file_.size();
+    }
+}
+
+const JournalRecord* CsvReplaySource::next() {
+    while (position_ < end_) {
+        const char* newline = static_cast<const char*>(std::memchr(position_, '\n', static_cast<size_t>(end_ - position_)));
+        const char* line_end = newline ? newline : end_;
+        std::string_view line(position_, static_cast<size_t>(line_end - position_));
+        position_ = newline ? newline + 1 : end_;
+        ++line_;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        // Blank lines, comments and a header row (anything not starting with a digit)
+        if (line.empty() || line.front() < '0' || line.front() > '9') {
+            continue;
+        }
+        if (parse_line(line)) {
+            return &record_;
+        }
+        if (errors_++ == 0) {
+            first_error_line_ = line_;
+        }
+    }
+    return nullptr;
+}
+
+bool CsvReplaySource::parse_line(std::string_view line) {
+    int64_t timestamp = 0;
+    uint64_t order_id = 0;
+    std::string_view timestamp_field = next_field(line);
+    std::string_view action = next_field(line);
+    if (!parse_signed(timestamp_field, timestamp) || action.size() != 1) {
+        return false;
+    }
+    SymbolId symbol_id = resolve(next_field(line));
+    if (symbol_id == orderbook::INVALID_SYMBOL_ID || !parse_unsigned(next_field(line), order_id)) {
+        return false;
+    }
+
+    std::string_view side_field = next_field(line);
+    std::string_view type_field = next_field(line);
+    std::string_view price_field = next_field(line);
+    std::string_view quantity_field = next_field(line);
+    std::string_view tif_field = next_field(line);
+
+    OrderCommand command;
+    switch (action.front()) {
+        case 'N': {
+            if (side_field.size() != 1 || (side_field.front() != 'B' && side_field.front() != 'S') ||
+                type_field.size() != 1 || (type_field.front() != 'L' && type_field.front() != 'M')) {
+                return false;
+            }
+            Side side = side_field.front() == 'B' ? Side::BUY : Side::SELL;
+            OrderType type = type_field.front() == 'L' ? OrderType::LIMIT : OrderType::MARKET;
+
+            int64_t price = 0;
+            int64_t quantity = 0;
+            if ((type == OrderType::LIMIT || !price_field.empty()) && !parse_fixed_point(price_field, price)) {
+                return false;
+            }
+            if (!parse_fixed_point(quantity_field, quantity)) {
+                return false;
+            }
+
+            TimeInForce tif = TimeInForce::GTC;
+            if (tif_field == "IOC") {
+                tif = TimeInForce::IOC;
+            } else if (tif_field == "FOK") {
+                tif = TimeInForce::FOK;
+            } else if (!tif_field.empty() && tif_field != "GTC") {
+                return false;
+            }
+            command = OrderCommand::new_order(symbol_id, order_id, side, type, Quantity(quantity), Price(price), tif);
+            break;
+        }
+        case 'C':
+            command = OrderCommand::cancel(symbol_id, order_id);
+            break;
+        case 'M': {
+            std::optional<Price> price;
+            std::optional<Quantity> quantity;
+            int64_t raw = 0;
+            if (!price_field.empty()) {
+                if (!parse_fixed_point(price_field, raw)) {
+                    return false;
+                }
+                price = Price(raw);
+            }
+            if (!quantity_field.empty()) {
+                if (!parse_fixed_point(quantity_field, raw)) {
+                    return false;
+                }
+                quantity = Quantity(raw);
+            }
+            if (!price && !quantity) {
+                return false;
+            }
+            command = OrderCommand::modify(symbol_id, order_id, price, quantity);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    record_.sequence += 1;
+    record_.timestamp = timestamp;
+    record_.command = command;
+    return true;
+}
+
+SymbolId CsvReplaySource::resolve(std::string_view name) {
+    // Flow files name a handful of symbols, so a short list beats the registry lock
+    for (const auto& [known, id] : symbols_) {
+        if (known == name) {
+            return id;
+        }
+    }
+    SymbolId id = orderbook::SymbolRegistry::global().find(name);
+    if (id != orderbook::INVALID_SYMBOL_ID) {
+        symbols_.emplace_back(std::string(name), id);
+    }
+    return id;
+}
+
+uint64_t convert_csv_to_journal(const std::string& csv_path, const orderbook::JournalConfig& journal_config,
+                                uint64_t* errors) {
+    CsvReplaySource source(csv_path);
+    orderbook::Journal journal(journal_config);
+    uint64_t written = 0;
+    if (source.is_open() && journal.open()) {
+        while (const JournalRecord* record = source.next()) {
+            if (journal.append(record->command, record->timestamp) == 0) {
+                break;
+            }
+            ++written;
+        }
+        journal.close();
+    }
+    if (errors) {
+        *errors = source.errors();
+    }
+    return written;
+}
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,85 @@
+#include "market/replay_driver.hpp"
+#include <chrono>
+#include <thread>
+
+namespace trading_engine {
+namespace market {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Gaps longer than this are slept through; shorter ones are spun
+constexpr auto SPIN_THRESHOLD = std::chrono::microseconds(200);
+
+void wait_until(Clock::time_point deadline) {
+    while (true) {
+        auto now = Clock::now();
+        if (now >= deadline) {
+            return;
+        }
+        if (deadline - now > SPIN_THRESHOLD) {
+            std::this_thread::sleep_for(deadline - now - SPIN_THRESHOLD);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace
+
+ReplayDriver::ReplayDriver(MatchingEngine& engine, const ReplayConfig& config)
+    : engine_(engine),
+      config_(config) {
+    if (!(config_.speed > 0.0)) {
+        config_.speed = 1.0;
+    }
+}
+
+ReplayStats ReplayDriver::run(ReplaySource& source) {
+    ReplayStats stats;
+    const bool live = engine_.is_running();
+    const bool paced = config_.pacing == ReplayPacing::WALL_CLOCK;
+    const auto start = Clock::now();
+    orderbook::Timestamp first_timestamp = 0;
+
+    while (config_.max_records == 0 || stats.records < config_.max_records) {
+        const JournalRecord* record = source.next();
+        if (!record) {
+            break;
+        }
+        if (stats.records++ == 0) {
+            first_timestamp = record->timestamp;
+        }
+
+        const OrderCommand& command = record->command;
+        OrderBook* book = engine_.book(command.symbol_id);
+        if (!book) {
+            ++stats.skipped;
+            continue;
+        }
+
+        if (paced) {
+            auto offset = static_cast<double>(record->timestamp - first_timestamp) / config_.speed;
+            wait_until(start + std::chrono::nanoseconds(static_cast<int64_t>(offset)));
+        }
+
+        if (live) {
+            // The book exists, so a refusal means a full queue
+            while (!engine_.submit(command)) {
+                std::this_thread::yield();
+            }
+        } else {
+            book->apply(command, record->timestamp, fills_);
+            stats.fills += fills_.size();
+            fills_.clear();
+        }
+        ++stats.applied;
+    }
+
+    stats.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    return stats;
+}
+
+} // namespace market
+} // namespace trading_engine
@@ -0,0 +1,548 @@
+#include "network/market_data_publisher.hpp"
+#include "core/logger.hpp"
+#include "core/ring_buffer.hpp"
+#include "core/thread_affinity.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <optional>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace trading_engine {
+namespace network {
+
+using orderbook::MarketDataEvent;
+using orderbook::MarketDataEventType;
+using orderbook::OrderBook;
+using orderbook::OrderCommand;
+using orderbook::OrderType;
+using orderbook::Quantity;
+using orderbook::SymbolId;
+
+namespace {
+
+// Packets the retention ring can never be smaller than
+constexpr size_t MIN_RETAINED_PACKETS = 16;
+
+// Largest UDP payload IPv4 can carry
+constexpr size_t MAX_DATAGRAM_SIZE = 65507;
+
+/**
+ * BookImage - a snapshot image of a live book and the sequence it reflects
+ */
+struct BookImage {
+    SymbolId symbol_id = orderbook::INVALID_SYMBOL_ID;
+    uint64_t sequence = 0;
+    std::vector<std::byte> bytes;
+};
+
+// Copy a book's resting orders onto `to`, level by level in queue order
+void copy_resting(const OrderBook& from, OrderBook& to, orderbook::MatchBuffer& fills) {
+    auto copy_side = [&](const std::vector<orderbook::Price>& prices, orderbook::Side side) {
+        for (orderbook::Price price : prices) {
+            for (const auto& order : from.get_orders_at_level(price, side)) {
+                to.apply(OrderCommand::new_order(to.symbol_id(), order->id(), side, OrderType::LIMIT,
+                                                 order->remaining_quantity(), price),
+                         order->timestamp(), fills);
+            }
+        }
+    };
+    copy_side(from.get_bid_prices(), orderbook::Side::BUY);
+    copy_side(from.get_ask_prices(), orderbook::Side::SELL);
+}
+
+TcpServerConfig recovery_config(const MarketDataPublisherConfig& config) {
+    TcpServerConfig server;
+    server.bind_address = config.recovery_address;
+    server.port = config.recovery_port;
+    server.max_send_bytes = config.max_session_send_bytes;
+    return server;   // Recovery sessions carry no state between requests, so indices are reused
+}
+
+} // namespace
+
+/**
+ * Shadow - the publisher's copy of one symbol's resting orders
+ */
+struct MarketDataPublisher::Shadow {
+    Shadow(SymbolId symbol_id, const orderbook::OrderBookConfig& config) : book(symbol_id, config) {}
+
+    OrderBook book;
+    uint64_t sequence = 0;   // Last event applied (read, while re-seeding)
+    bool stale = false;      // An event was lost; the book can't be trusted
+
+    // Set once an image of the live book is requested; events read from then
+    // on wait in the backlog until the image is in and the feed has caught up
+    bool reseeding = false;
+    bool reseed_again = false;   // Events were missed after the request; the image may predate them
+    std::optional<BookImage> image;
+    std::vector<MarketDataEvent> backlog;
+};
+
+/**
+ * ImageMailbox - book images on their way from the engine's workers
+ *
+ * Owned jointly with the engine's snapshot handler, so an image written
+ * after the publisher is gone still has somewhere to land.
+ */
+struct MarketDataPublisher::ImageMailbox {
+    std::mutex mutex;
+    std::vector<BookImage> images;
+    std::atomic<bool> ready{false};
+};
+
+MarketDataPublisher::MarketDataPublisher(market::MatchingEngine& engine, const MarketDataPublisherConfig& config)
+    : engine_(engine),
+      config_(config),
+      images_(std::make_shared<ImageMailbox>()),
+      recovery_(recovery_config(config), "MarketDataPublisher"),
+      running_(false) {
+    // A packet holds at least one event and still fits in a datagram
+    config_.max_packet_size = std::clamp(config_.max_packet_size, packet_size(1), MAX_DATAGRAM_SIZE);
+    events_per_packet_ = (config_.max_packet_size - sizeof(PacketHeader)) / sizeof(MarketDataEvent);
+    config_.max_packet_size = packet_size(events_per_packet_);
+    config_.poll_batch = std::max<size_t>(config_.poll_batch, 1);
+
+    retained_mask_ = core::next_power_of_two(std::max(config_.retransmit_packets, MIN_RETAINED_PACKETS)) - 1;
+    packet_ = std::make_unique<char[]>(config_.max_packet_size);
+    retained_ = std::make_unique<char[]>((retained_mask_ + 1) * config_.max_packet_size);
+    retained_sizes_ = std::make_unique<uint16_t[]>(retained_mask_ + 1);
+}
+
+MarketDataPublisher::~MarketDataPublisher() {
+    stop();
+}
+
+void MarketDataPublisher::seed_shadows() {
+    shadows_.clear();
+    orderbook::MatchBuffer fills;
+    const size_t symbols = orderbook::SymbolRegistry::global().size();
+    for (SymbolId symbol_id = 0; symbol_id < symbols; ++symbol_id) {
+        const OrderBook* live = engine_.book(symbol_id);
+        if (!live) {
+            continue;
+        }
+        if (symbol_id >= shadows_.size()) {
+            shadows_.resize(symbol_id + 1);
+        }
+        auto shadow = std::make_unique<Shadow>(symbol_id, live->config());
+        copy_resting(*live, shadow->book, fills);
+        shadow->sequence = live->market_data_sequence();
+        shadows_[symbol_id] = std::move(shadow);
+    }
+}
+
+void MarketDataPublisher::apply_event(const MarketDataEvent& event) {
+    if (event.symbol_id >= shadows_.size() || !shadows_[event.symbol_id]) {
+        return;
+    }
+    Shadow& shadow = *shadows_[event.symbol_id];
+    if (shadow.reseeding) {
+        shadow.backlog.push_back(event);
+        shadow.sequence = event.sequence;
+        try_reseed(shadow);
+        return;
+    }
+    if (event.sequence != shadow.sequence + 1) {
+        shadow.stale = true;
+    }
+    shadow.sequence = event.sequence;
+    if (shadow.stale) {
+        request_reseed(shadow);
+        return;
+    }
+
+    // Shadow orders never execute, so an order's quantity is what it has left
+    OrderBook& book = shadow.book;
+    shadow_fills_.clear();
+    switch (event.type) {
+        case MarketDataEventType::ORDER_ADDED:
+            book.apply(OrderCommand::new_order(event.symbol_id, event.order_id, event.side, OrderType::LIMIT,
+                                               event.quantity, event.price),
+                       event.timestamp, shadow_fills_);
+            break;
+        case MarketDataEventType::ORDER_REDUCED:
+        case MarketDataEventType::TRADE: {
+            orderbook::OrderPtr order = book.get_order(event.order_id);
+            if (!order) {
+                shadow.stale = true;
+                request_reseed(shadow);
+                return;
+            }
+            Quantity left = order->remaining_quantity() - event.quantity;
+            if (left > Quantity::ZERO) {
+                book.apply(OrderCommand::modify(event.symbol_id, event.order_id, std::nullopt, left),
+                           event.timestamp, shadow_fills_);
+            } else {
+                book.apply(OrderCommand::cancel(event.symbol_id, event.order_id), event.timestamp, shadow_fills_);
+            }
+            break;
+        }
+        case MarketDataEventType::ORDER_DELETED:
+            book.apply(OrderCommand::cancel(event.symbol_id, event.order_id), event.timestamp, shadow_fills_);
+            break;
+        case MarketDataEventType::LEVEL_CHANGED:
+            break; // Follows from the order events
+    }
+
+    // The live book never leaves a crossed book behind, so a shadow fill means
+    // the copy has drifted
+    if (!shadow_fills_.empty()) {
+        shadow.stale = true;
+        request_reseed(shadow);
+    }
+}
+
+void MarketDataPublisher::mark_worker_stale(size_t worker) {
+    // A missed event's symbol is unknown, so every book on the bus is re-seeded;
+    // relying on the next sequence gap would leave a quiet symbol wrong
+    for (auto& shadow : shadows_) {
+        if (!shadow || engine_.worker_for(shadow->book.symbol_id()) != worker) {
+            continue;
+        }
+        shadow->stale = true;
+        if (shadow->reseeding) {
+            shadow->reseed_again = true;
+        } else {
+            request_reseed(*shadow);
+        }
+    }
+}
+
+void MarketDataPublisher::request_reseed(Shadow& shadow) {
+    // Retried on the symbol's next event or snapshot request if the queue is full
+    if (!shadow.reseeding) {
+        shadow.reseeding = engine_.request_snapshot(shadow.book.symbol_id());
+    }
+}
+
+void MarketDataPublisher::collect_images() {
+    if (!images_->ready.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+    std::vector<BookImage> images;
+    {
+        std::lock_guard<std::mutex> lock(images_->mutex);
+        images.swap(images_->images);
+    }
+    for (BookImage& image : images) {
+        Shadow* shadow = image.symbol_id < shadows_.size() ? shadows_[image.symbol_id].get() : nullptr;
+        if (shadow && shadow->reseeding) {
+            shadow->image = std::move(image);
+            try_reseed(*shadow);
+        }
+    }
+}
+
+void MarketDataPublisher::try_reseed(Shadow& shadow) {
+    // The image may be ahead of the bus; wait until every event it reflects
+    // has been read and sent, so a snapshot never runs ahead of the feed
+    if (!shadow.image || shadow.image->sequence > shadow.sequence) {
+        return;
+    }
+    BookImage image = std::move(*shadow.image);
+    std::vector<MarketDataEvent> backlog;
+    backlog.swap(shadow.backlog);
+    shadow.image.reset();
+    shadow.reseeding = false;
+    if (shadow.reseed_again) {
+        // Still stale: events newer than this image may be missing
+        shadow.reseed_again = false;
+        request_reseed(shadow);
+        return;
+    }
+
+    // The live image carries owners, stops and pegs; the shadow keeps only
+    // the resting orders, as when it was seeded
+    OrderBook live(shadow.book.symbol_id(), shadow.book.config());
+    if (!live.restore_snapshot(image.bytes)) {
+        TE_LOG_WARN("MarketDataPublisher: bad image of symbol %u, asking again",
+                    static_cast<unsigned>(image.symbol_id));
+        request_reseed(shadow);
+        return;
+    }
+    shadow_fills_.clear();
+    shadow.book.clear();
+    copy_resting(live, shadow.book, shadow_fills_);
+    shadow.sequence = image.sequence;
+    shadow.stale = false;
+
+    // Events up to the image are in it already
+    for (const MarketDataEvent& event : backlog) {
+        if (event.sequence > image.sequence) {
+            apply_event(event);
+        }
+    }
+}
+
+#if defined(__linux__)
+
+bool MarketDataPublisher::start() {
+    if (is_running()) {
+        return false;
+    }
+    if (engine_.is_running()) {
+        TE_LOG_ERROR("MarketDataPublisher: start it before the engine so the shadow books can be seeded");
+        return false;
+    }
+
+    cursors_.clear();
+    for (size_t worker = 0; worker < engine_.worker_count(); ++worker) {
+        if (const orderbook::MarketDataBus* bus = engine_.market_data_bus(worker)) {
+            cursors_.push_back(bus->subscribe());
+        }
+    }
+    if (cursors_.empty()) {
+        TE_LOG_ERROR("MarketDataPublisher: engine has no market-data buses");
+        return false;
+    }
+
+    // Feed socket; connect() fixes the destination so each packet is one send()
+    sockaddr_in group{};
+    group.sin_family = AF_INET;
+    group.sin_port = htons(config_.group_port);
+    if (::inet_pton(AF_INET, config_.group_address.c_str(), &group.sin_addr) != 1) {
+        TE_LOG_ERROR("MarketDataPublisher: bad group address %s", config_.group_address.c_str());
+        return false;
+    }
+    udp_fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (udp_fd_ < 0) {
+        TE_LOG_ERROR("MarketDataPublisher: cannot open the feed socket: %s", std::strerror(errno));
+        return false;
+    }
+    if (IN_MULTICAST(ntohl(group.sin_addr.s_addr))) {
+        unsigned char ttl = static_cast<unsigned char>(config_.multicast_ttl);
+        unsigned char loop = config_.multicast_loop ? 1 : 0;
+        ::setsockopt(udp_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        ::setsockopt(udp_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        in_addr interface{};
+        if (!config_.interface_address.empty() &&
+            (::inet_pton(AF_INET, config_.interface_address.c_str(), &interface) != 1 ||
+             ::setsockopt(udp_fd_, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0)) {
+            TE_LOG_ERROR("MarketDataPublisher: bad multicast interface %s", config_.interface_address.c_str());
+            close_all();
+            return false;
+        }
+    }
+    if (::connect(udp_fd_, reinterpret_cast<const sockaddr*>(&group), sizeof(group)) != 0) {
+        TE_LOG_ERROR("MarketDataPublisher: cannot send to %s:%u: %s", config_.group_address.c_str(),
+                     static_cast<unsigned>(config_.group_port), std::strerror(errno));
+        close_all();
+        return false;
+    }
+
+    if (!recovery_.open()) {
+        close_all();
+        return false;
+    }
+
+    seed_shadows();
+    packet_events_ = 0;
+    engine_.set_snapshot_handler([images = images_](SymbolId symbol_id, std::span<const std::byte> image,
+                                                    uint64_t sequence) {
+        std::lock_guard<std::mutex> lock(images->mutex);
+        images->images.push_back({symbol_id, sequence, std::vector<std::byte>(image.begin(), image.end())});
+        images->ready.store(true, std::memory_order_release);
+    });
+
+    recovery_port_.store(recovery_.port(), std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MarketDataPublisher::run, this);
+
+    TE_LOG_INFO("MarketDataPublisher sending to %s:%u, recovery on %s:%u", config_.group_address.c_str(),
+                static_cast<unsigned>(config_.group_port), config_.recovery_address.c_str(),
+                static_cast<unsigned>(recovery_port()));
+    return true;
+}
+
+void MarketDataPublisher::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    recovery_port_.store(0, std::memory_order_release);
+}
+
+void MarketDataPublisher::run() {
+    if (config_.cpu >= 0 && !core::pin_current_thread(config_.cpu)) {
+        TE_LOG_WARN("MarketDataPublisher could not be pinned to CPU %d", config_.cpu);
+    }
+
+    while (running_.load(std::memory_order_acquire)) {
+        // Don't sleep while the buses still have events
+        size_t read = drain_buses();
+        collect_images();
+        recovery_.poll(read > 0 ? 0 : config_.poll_timeout_ms, *this);
+        recovery_.flush_pending();
+    }
+
+    // Whatever the engine published before stop goes out too
+    while (drain_buses() > 0) {
+    }
+    close_all();
+}
+
+size_t MarketDataPublisher::drain_buses() {
+    size_t read = 0;
+    for (size_t worker = 0; worker < cursors_.size(); ++worker) {
+        auto& cursor = cursors_[worker];
+        uint64_t missed = cursor.lost() + cursor.overruns();
+        read += cursor.poll([&](const MarketDataEvent& event, uint64_t) { add_event(event); },
+                            config_.poll_batch);
+        missed = cursor.lost() + cursor.overruns() - missed;
+        if (missed > 0) {
+            events_lost_.fetch_add(missed, std::memory_order_relaxed);
+            TE_LOG_WARN("MarketDataPublisher fell behind the market-data bus, %llu events lost",
+                        static_cast<unsigned long long>(missed));
+            mark_worker_stale(worker);
+        }
+    }
+
+    // A part-filled packet goes out once the buses are drained
+    if (packet_events_ > 0) {
+        send_packet();
+    }
+    return read;
+}
+
+void MarketDataPublisher::add_event(const MarketDataEvent& event) {
+    std::memcpy(packet_.get() + packet_size(packet_events_), &event, sizeof(event));
+    apply_event(event);
+    if (++packet_events_ == events_per_packet_) {
+        send_packet();
+    }
+}
+
+void MarketDataPublisher::send_packet() {
+    PacketHeader header;
+    header.sequence = next_packet_++;
+    header.event_count = static_cast<uint16_t>(packet_events_);
+    std::memcpy(packet_.get(), &header, sizeof(header));
+    const size_t size = packet_size(packet_events_);
+    packet_events_ = 0;
+
+    // Kept for retransmission whether or not the send works
+    size_t slot = header.sequence & retained_mask_;
+    std::memcpy(retained_.get() + slot * config_.max_packet_size, packet_.get(), size);
+    retained_sizes_[slot] = static_cast<uint16_t>(size);
+
+    if (::send(udp_fd_, packet_.get(), size, 0) < 0) {
+        send_errors_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    packets_sent_.fetch_add(1, std::memory_order_relaxed);
+    events_sent_.fetch_add(header.event_count, std::memory_order_relaxed);
+}
+
+bool MarketDataPublisher::on_message(TcpConnection& session, const MessageHeader& header, const char* data) {
+    size_t expected = message_size(header.type);
+    if (expected == 0) {
+        return true; // Unknown type: skipped by its length
+    }
+    if (header.length != expected) {
+        return false;
+    }
+
+    switch (header.type) {
+        case MessageType::SNAPSHOT_REQUEST:
+            return serve_snapshot(session, read_message<SnapshotRequestMessage>(data).symbol_id);
+        case MessageType::RETRANSMIT_REQUEST: {
+            auto request = read_message<RetransmitRequestMessage>(data);
+            return serve_retransmit(session, request.first_packet, request.count);
+        }
+        default:
+            return true; // Not a request
+    }
+}
+
+bool MarketDataPublisher::serve_snapshot(TcpConnection& session, SymbolId symbol_id) {
+    SnapshotMessage reply;
+    reply.symbol_id = symbol_id;
+    Shadow* shadow = symbol_id < shadows_.size() ? shadows_[symbol_id].get() : nullptr;
+    if (!shadow) {
+        reply.status = RecoveryStatus::UNKNOWN_SYMBOL;
+        return recovery_.queue(session, &reply, sizeof(reply));
+    }
+    if (shadow->stale) {
+        request_reseed(*shadow);
+        reply.status = RecoveryStatus::STALE;
+        reply.last_event_sequence = shadow->sequence;
+        return recovery_.queue(session, &reply, sizeof(reply));
+    }
+
+    // Requests are served after drain_buses() has sent every event the
+    // shadow book reflects, so the image never runs ahead of the feed
+    size_t size = shadow->book.snapshot_size();
+    if (snapshot_buffer_.size() < size) {
+        snapshot_buffer_.resize(size);
+    }
+    shadow->book.write_snapshot(std::span<std::byte>(snapshot_buffer_.data(), size), shadow->sequence);
+    reply.last_event_sequence = shadow->sequence;
+    reply.image_size = size;
+    if (!recovery_.queue(session, &reply, sizeof(reply)) ||
+        !recovery_.queue(session, snapshot_buffer_.data(), size)) {
+        return false;
+    }
+    snapshots_served_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool MarketDataPublisher::serve_retransmit(TcpConnection& session, uint64_t first_packet, uint32_t count) {
+    // Only packets still in the ring can be sent, so the answer may be a subrange
+    const uint64_t last = next_packet_ - 1;
+    const uint64_t oldest = last > retained_mask_ ? last - retained_mask_ : 1;
+    uint64_t first = std::max(first_packet, oldest);
+    uint64_t end = count == 0 ? first : std::min(first_packet + count - 1, last) + 1;
+
+    RetransmitMessage reply;
+    if (first_packet == 0 || first >= end) {
+        reply.status = RecoveryStatus::NOT_AVAILABLE;
+        return recovery_.queue(session, &reply, sizeof(reply));
+    }
+    reply.first_packet = first;
+    reply.count = static_cast<uint32_t>(end - first);
+    if (!recovery_.queue(session, &reply, sizeof(reply))) {
+        return false;
+    }
+    for (uint64_t sequence = first; sequence < end; ++sequence) {
+        size_t slot = sequence & retained_mask_;
+        if (!recovery_.queue(session, retained_.get() + slot * config_.max_packet_size, retained_sizes_[slot])) {
+            return false;
+        }
+    }
+    retransmits_served_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MarketDataPublisher::close_all() {
+    recovery_.close();
+    if (udp_fd_ >= 0) {
+        ::close(udp_fd_);
+        udp_fd_ = -1;
+    }
+}
+
+#else
+
+// epoll is Linux-only; elsewhere the publisher never starts
+bool MarketDataPublisher::start() {
+    return false;
+}
+
+void MarketDataPublisher::stop() {
+}
+
+#endif
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,200 @@
+#include "network/order_gateway.hpp"
+#include "core/logger.hpp"
+#include "core/thread_affinity.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace network {
+
+using orderbook::MarketDataEvent;
+using orderbook::MarketDataEventType;
+using orderbook::OrderCommand;
+using orderbook::Side;
+
+namespace {
+
+constexpr uint64_t CLIENT_ID_MASK = (uint64_t{1} << OrderGateway::CLIENT_ID_BITS) - 1;
+
+TcpServerConfig server_config(const OrderGatewayConfig& config) {
+    TcpServerConfig server;
+    server.bind_address = config.bind_address;
+    server.port = config.port;
+    server.receive_buffer_size = config.receive_buffer_size;
+    server.max_send_bytes = std::max<size_t>(config.send_slots, 1) * MAX_MESSAGE_SIZE;
+    server.send_reserve = server.max_send_bytes;   // Replies never allocate
+    server.reuse_indices = false;                  // Blocks are never reused, so a late fill can't reach a new session
+    return server;
+}
+
+} // namespace
+
+OrderGateway::OrderGateway(MatchingEngine& engine, const OrderGatewayConfig& config)
+    : engine_(engine),
+      config_(config),
+      server_(server_config(config), "OrderGateway"),
+      running_(false) {}
+
+OrderGateway::~OrderGateway() {
+    stop();
+}
+
+bool OrderGateway::start() {
+    if (is_running() || !server_.open()) {
+        return false;
+    }
+
+    // Fills are read from the buses from now on
+    fill_cursors_.clear();
+    for (size_t worker = 0; worker < engine_.worker_count(); ++worker) {
+        if (const orderbook::MarketDataBus* bus = engine_.market_data_bus(worker)) {
+            fill_cursors_.push_back(bus->subscribe());
+        }
+    }
+    if (fill_cursors_.empty()) {
+        TE_LOG_WARN("OrderGateway: engine has no market-data buses, clients get no fills");
+    }
+
+    port_.store(server_.port(), std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&OrderGateway::run, this);
+
+    TE_LOG_INFO("OrderGateway listening on %s:%u", config_.bind_address.c_str(), static_cast<unsigned>(port()));
+    return true;
+}
+
+void OrderGateway::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    port_.store(0, std::memory_order_release);
+}
+
+void OrderGateway::run() {
+    if (config_.cpu >= 0 && !core::pin_current_thread(config_.cpu)) {
+        TE_LOG_WARN("OrderGateway could not be pinned to CPU %d", config_.cpu);
+    }
+
+    while (running_.load(std::memory_order_acquire)) {
+        server_.poll(config_.poll_timeout_ms, *this);
+        route_fills();
+        server_.flush_pending();
+    }
+
+    // Last replies go out before the sessions close
+    route_fills();
+    server_.flush_pending();
+    server_.close();
+}
+
+bool OrderGateway::on_message(TcpConnection& session, const MessageHeader& header, const char* data) {
+    messages_received_.fetch_add(1, std::memory_order_relaxed);
+
+    size_t expected = message_size(header.type);
+    if (expected == 0) {
+        return true; // Unknown type: skipped by its length
+    }
+    if (header.length != expected) {
+        return false; // Known type with the wrong size: the stream is broken
+    }
+
+    AckMessage ack;
+    ack.acked_type = header.type;
+    std::optional<OrderCommand> command;
+    uint64_t client_order_id = 0;
+    switch (header.type) {
+        case MessageType::NEW_ORDER: {
+            auto message = read_message<NewOrderMessage>(data);
+            client_order_id = message.client_order_id;
+            command = to_command(message, order_id(session, client_order_id));
+            break;
+        }
+        case MessageType::CANCEL: {
+            auto message = read_message<CancelMessage>(data);
+            client_order_id = message.client_order_id;
+            command = to_command(message, order_id(session, client_order_id));
+            break;
+        }
+        case MessageType::MODIFY: {
+            auto message = read_message<ModifyMessage>(data);
+            client_order_id = message.client_order_id;
+            command = to_command(message, order_id(session, client_order_id));
+            break;
+        }
+        default:
+            return true; // Gateway-to-client types are ignored
+    }
+
+    ack.client_order_id = client_order_id;
+    if (client_order_id == 0 || client_order_id > CLIENT_ID_MASK) {
+        ack.status = AckStatus::BAD_ORDER_ID;
+    } else if (!command) {
+        ack.status = AckStatus::MALFORMED;
+    } else if (!engine_.book(command->symbol_id)) {
+        ack.status = AckStatus::UNKNOWN_SYMBOL;
+    } else if (!engine_.submit(*command)) {
+        ack.status = AckStatus::QUEUE_FULL;
+    } else {
+        ack.order_id = command->order_id;
+        commands_queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A full queue closes the session
+    return server_.queue(session, &ack, sizeof(ack));
+}
+
+void OrderGateway::route_fills() {
+    for (auto& cursor : fill_cursors_) {
+        // Only validated copies come off the bus, so a lapped event is never routed
+        uint64_t missed = cursor.lost() + cursor.overruns();
+        cursor.poll([&](const MarketDataEvent& event, uint64_t) {
+            if (event.type != MarketDataEventType::TRADE) {
+                return;
+            }
+            route_fill(event, event.order_id, event.side, true);
+            route_fill(event, event.match_id, event.side == Side::BUY ? Side::SELL : Side::BUY, false);
+        });
+        missed = cursor.lost() + cursor.overruns() - missed;
+        if (missed > 0) {
+            events_lost_.fetch_add(missed, std::memory_order_relaxed);
+            TE_LOG_WARN("OrderGateway fell behind the market-data bus, %llu events lost",
+                        static_cast<unsigned long long>(missed));
+        }
+    }
+}
+
+void OrderGateway::route_fill(const MarketDataEvent& event, OrderId order_id, Side side, bool maker) {
+    TcpConnection* session = session_for(order_id);
+    if (!session) {
+        return; // Not a gateway order, or its session is gone
+    }
+
+    FillMessage fill;
+    fill.symbol_id = event.symbol_id;
+    fill.client_order_id = order_id & CLIENT_ID_MASK;
+    fill.price = event.price.raw_value();
+    fill.quantity = event.quantity.raw_value();
+    fill.timestamp = event.timestamp;
+    fill.side = side;
+    fill.maker = maker ? 1 : 0;
+    if (!server_.queue(*session, &fill, sizeof(fill))) {
+        server_.close_connection(session->index);
+    }
+}
+
+OrderId OrderGateway::order_id(const TcpConnection& session, uint64_t client_order_id) const {
+    return ((config_.first_order_block + session.index) << CLIENT_ID_BITS) | client_order_id;
+}
+
+TcpConnection* OrderGateway::session_for(OrderId order_id) {
+    uint64_t block = order_id >> CLIENT_ID_BITS;
+    if (block < config_.first_order_block) {
+        return nullptr;
+    }
+    return server_.connection(block - config_.first_order_block);
+}
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,70 @@
+#include "network/protocol.hpp"
+
+namespace trading_engine {
+namespace network {
+
+using orderbook::OrderCommand;
+using orderbook::OrderId;
+using orderbook::OrderType;
+using orderbook::Price;
+using orderbook::Quantity;
+using orderbook::Side;
+using orderbook::TimeInForce;
+
+namespace {
+
+bool valid_side(Side side) {
+    return side == Side::BUY || side == Side::SELL;
+}
+
+} // namespace
+
+std::optional<OrderCommand> to_command(const NewOrderMessage& message, OrderId order_id) {
+    // CANCEL and MODIFY are commands of their own, not order types on the wire
+    OrderType type = message.order_type;
+    bool known_type = type == OrderType::LIMIT || type == OrderType::MARKET ||
+                      orderbook::is_stop(type) || orderbook::is_pegged(type);
+    if (!valid_side(message.side) || !known_type || message.quantity <= 0 ||
+        static_cast<uint8_t>(message.time_in_force) > static_cast<uint8_t>(TimeInForce::FOK)) {
+        return std::nullopt;
+    }
+
+    // Limit and stop prices must be positive; market and pegged orders carry none
+    bool has_limit = type == OrderType::LIMIT || type == OrderType::STOP_LIMIT;
+    if ((has_limit && message.price <= 0) || (orderbook::is_stop(type) && message.aux_price <= 0)) {
+        return std::nullopt;
+    }
+
+    OrderCommand command = OrderCommand::new_order(message.symbol_id, order_id, message.side, type,
+                                                   Quantity(message.quantity), Price(message.price),
+                                                   message.time_in_force);
+    command.aux_price = Price(message.aux_price);
+    return command;
+}
+
+std::optional<OrderCommand> to_command(const CancelMessage& message, OrderId order_id) {
+    return OrderCommand::cancel(message.symbol_id, order_id);
+}
+
+std::optional<OrderCommand> to_command(const ModifyMessage& message, OrderId order_id) {
+    constexpr uint8_t KNOWN_FLAGS = OrderCommand::MODIFY_PRICE | OrderCommand::MODIFY_QUANTITY;
+    if (message.modify_flags == 0 || (message.modify_flags & ~KNOWN_FLAGS) != 0) {
+        return std::nullopt;
+    }
+
+    std::optional<Price> price;
+    std::optional<Quantity> quantity;
+    if (message.modify_flags & OrderCommand::MODIFY_PRICE) {
+        if (message.price <= 0) {
+            return std::nullopt; // Same rule as a new limit price
+        }
+        price = Price(message.price);
+    }
+    if (message.modify_flags & OrderCommand::MODIFY_QUANTITY) {
+        quantity = Quantity(message.quantity);
+    }
+    return OrderCommand::modify(message.symbol_id, order_id, price, quantity);
+}
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,300 @@
+#include "network/tcp_server.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace trading_engine {
+namespace network {
+
+namespace {
+
+// epoll token of the listening socket; connections use their index
+constexpr uint64_t LISTEN_TOKEN = ~uint64_t{0};
+
+} // namespace
+
+TcpServer::TcpServer(const TcpServerConfig& config, const char* name) : config_(config), name_(name) {
+    config_.receive_buffer_size = std::max(config_.receive_buffer_size, MAX_MESSAGE_SIZE);
+    config_.max_send_bytes = std::max(config_.max_send_bytes, MAX_MESSAGE_SIZE);
+    config_.send_reserve = std::min(config_.send_reserve, config_.max_send_bytes);
+}
+
+TcpServer::~TcpServer() {
+    close();
+}
+
+TcpConnection* TcpServer::connection(size_t index) {
+    return index < connections_.size() ? connections_[index].get() : nullptr;
+}
+
+bool TcpServer::queue(TcpConnection& connection, const void* data, size_t size) {
+    if (connection.queued() + size > config_.max_send_bytes) {
+        TE_LOG_WARN("%s: dropping connection %zu, it is not reading its replies", name_, connection.index);
+        dropped_connections_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Move the unsent tail down before growing, so the reserve is reused
+    std::vector<char>& send = connection.send;
+    if (connection.sent > 0 && send.size() + size > send.capacity()) {
+        send.erase(send.begin(), send.begin() + static_cast<std::ptrdiff_t>(connection.sent));
+        connection.sent = 0;
+    }
+    const char* bytes = static_cast<const char*>(data);
+    send.insert(send.end(), bytes, bytes + size);
+    ++connection.queued_messages;
+
+    if (!connection.pending_flush) {
+        connection.pending_flush = true;
+        pending_flush_.push_back(connection.index);
+    }
+    return true;
+}
+
+#if defined(__linux__)
+
+bool TcpServer::open() {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1) {
+        TE_LOG_ERROR("%s: bad bind address %s", name_, config_.bind_address.c_str());
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int reuse = 1;
+    if (listen_fd_ < 0 ||
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        ::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, SOMAXCONN) != 0) {
+        TE_LOG_ERROR("%s: cannot listen on %s:%u: %s", name_, config_.bind_address.c_str(),
+                     static_cast<unsigned>(config_.port), std::strerror(errno));
+        close();
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TOKEN;
+    if (epoll_fd_ < 0 || ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event) != 0) {
+        TE_LOG_ERROR("%s: epoll setup failed: %s", name_, std::strerror(errno));
+        close();
+        return false;
+    }
+
+    port_ = ntohs(address.sin_port);
+    return true;
+}
+
+void TcpServer::close() {
+    for (size_t index = 0; index < connections_.size(); ++index) {
+        close_connection(index);
+    }
+    connections_.clear();
+    pending_flush_.clear();
+    for (int* fd : {&epoll_fd_, &listen_fd_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    port_ = 0;
+}
+
+int TcpServer::poll(int timeout_ms, TcpHandler& handler) {
+    constexpr int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    int ready = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout_ms);
+    for (int i = 0; i < ready; ++i) {
+        if (events[i].data.u64 == LISTEN_TOKEN) {
+            accept_connections();
+            continue;
+        }
+
+        // Connections closed earlier in this pass are skipped
+        size_t index = static_cast<size_t>(events[i].data.u64);
+        TcpConnection* connection = connections_[index].get();
+        if (!connection) {
+            continue;
+        }
+        bool healthy = (events[i].events & EPOLLERR) == 0;
+        if (healthy && (events[i].events & (EPOLLIN | EPOLLHUP))) {
+            healthy = read(*connection, handler);
+        }
+        if (healthy && (events[i].events & EPOLLOUT)) {
+            healthy = flush(*connection);
+        }
+        if (!healthy) {
+            close_connection(index);
+        }
+    }
+    return std::max(ready, 0);
+}
+
+void TcpServer::accept_connections() {
+    while (true) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is drained
+        }
+
+        int no_delay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+        size_t index = connections_.size();
+        if (config_.reuse_indices) {
+            index = 0;
+            while (index < connections_.size() && connections_[index]) {
+                ++index;
+            }
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = index;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        if (index == connections_.size()) {
+            connections_.emplace_back();
+        }
+        connections_[index] = std::make_unique<TcpConnection>(fd, index, config_.receive_buffer_size,
+                                                              config_.send_reserve);
+        connection_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool TcpServer::read(TcpConnection& connection, TcpHandler& handler) {
+    ssize_t count = ::recv(connection.fd, connection.receive.get() + connection.received,
+                           connection.receive_capacity - connection.received, 0);
+    if (count == 0) {
+        return false; // Peer closed
+    }
+    if (count < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    connection.received += static_cast<size_t>(count);
+
+    // Decode every complete message in place, then keep the partial tail
+    const char* data = connection.receive.get();
+    size_t offset = 0;
+    while (auto header = peek_message(data + offset, connection.received - offset)) {
+        if (header->length == 0 || !handler.on_message(connection, *header, data + offset)) {
+            return false;
+        }
+        offset += header->length;
+    }
+    if (offset > 0) {
+        std::memmove(connection.receive.get(), data + offset, connection.received - offset);
+        connection.received -= offset;
+    }
+    return true;
+}
+
+bool TcpServer::flush(TcpConnection& connection) {
+    while (connection.queued() > 0) {
+        ssize_t written = ::send(connection.fd, connection.send.data() + connection.sent, connection.queued(),
+                                 MSG_NOSIGNAL);
+        write_calls_.fetch_add(1, std::memory_order_relaxed);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+
+            // Socket buffer full: finish when it drains
+            if (!connection.waiting_writable) {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT;
+                event.data.u64 = connection.index;
+                ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+                connection.waiting_writable = true;
+            }
+            return true;
+        }
+        connection.sent += static_cast<size_t>(written);
+    }
+
+    // Everything is out: the buffer keeps its capacity for the next replies
+    connection.send.clear();
+    connection.sent = 0;
+    messages_sent_.fetch_add(connection.queued_messages, std::memory_order_relaxed);
+    connection.queued_messages = 0;
+    if (connection.waiting_writable) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = connection.index;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.waiting_writable = false;
+    }
+    return true;
+}
+
+void TcpServer::flush_pending() {
+    for (size_t index : pending_flush_) {
+        TcpConnection* connection = connections_[index].get();
+        if (!connection) {
+            continue;
+        }
+        connection->pending_flush = false;
+        if (!flush(*connection)) {
+            close_connection(index);
+        }
+    }
+    pending_flush_.clear();
+}
+
+void TcpServer::close_connection(size_t index) {
+    TcpConnection* connection = this->connection(index);
+    if (!connection) {
+        return;
+    }
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection->fd, nullptr);
+    ::close(connection->fd);
+    connections_[index].reset();
+    connection_count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+#else
+
+// epoll is Linux-only; elsewhere the server never opens
+bool TcpServer::open() {
+    return false;
+}
+
+void TcpServer::close() {
+}
+
+int TcpServer::poll(int, TcpHandler&) {
+    return 0;
+}
+
+void TcpServer::flush_pending() {
+    pending_flush_.clear();
+}
+
+void TcpServer::close_connection(size_t) {
+}
+
+#endif
+
+} // namespace network
+} // namespace trading_engine
@@ -0,0 +1,78 @@
+#include "orderbook/book_side.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+BookSide::BookSide(Side side)
+    : side_(side), levels_(LevelOrder{side}) {
+}
+
+BookSide::BookSide(Side side, Price tick_size, size_t ladder_ticks, size_t ladder_max_ticks)
+    : side_(side),
+      levels_(LevelOrder{side}),
+      ladder_(std::make_unique<PriceLadder>(side, tick_size, ladder_ticks, ladder_max_ticks)) {
+}
+
+PriceLevel* BookSide::find(Price price) {
+    if (ladder_) {
+        return ladder_->find(price);
+    }
+    auto it = levels_.find(price);
+    return it == levels_.end() ? nullptr : &it->second;
+}
+
+const PriceLevel* BookSide::find(Price price) const {
+    if (ladder_) {
+        return ladder_->find(price);
+    }
+    auto it = levels_.find(price);
+    return it == levels_.end() ? nullptr : &it->second;
+}
+
+PriceLevel* BookSide::find_or_create(Price price) {
+    if (ladder_) {
+        return ladder_->find_or_create(price);
+    }
+    auto it = levels_.try_emplace(price, price).first;
+    return &it->second;
+}
+
+void BookSide::erase(Price price) {
+    if (ladder_) {
+        ladder_->erase(price);
+        return;
+    }
+    levels_.erase(price);
+}
+
+PriceLevel* BookSide::best() {
+    if (ladder_) {
+        return ladder_->best();
+    }
+    return levels_.empty() ? nullptr : &levels_.begin()->second;
+}
+
+const PriceLevel* BookSide::best() const {
+    if (ladder_) {
+        return ladder_->best();
+    }
+    return levels_.empty() ? nullptr : &levels_.begin()->second;
+}
+
+const PriceLevel* BookSide::next(Price price) const {
+    if (ladder_) {
+        return ladder_->next(price);
+    }
+    auto it = levels_.upper_bound(price);
+    return it == levels_.end() ? nullptr : &it->second;
+}
+
+void BookSide::clear() {
+    if (ladder_) {
+        ladder_->clear();
+    }
+    levels_.clear();
+}
+
+} // namespace orderbook
+} // namespace trading_engine
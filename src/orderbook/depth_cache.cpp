@@ -0,0 +1,111 @@
+#include "orderbook/depth_cache.hpp"
+#include "orderbook/book_side.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace orderbook {
+
+DepthCache::DepthCache(size_t levels)
+    : bids_(levels), asks_(levels), bid_columns_(levels), ask_columns_(levels) {
+}
+
+void DepthCache::update_level(Side side, Price price, Quantity quantity, uint32_t order_count) {
+    std::vector<DepthLevel>& levels = storage(side);
+    size_t& size = count(side);
+
+    size_t pos = lower_bound(side, levels.data(), size, price);
+    if (pos < size && levels[pos].price == price) {
+        // Known level: update in place
+        levels[pos].quantity = quantity;
+        levels[pos].order_count = order_count;
+        columns(side).quantities[pos] = quantity.raw_value();
+        ++sequence_;
+        return;
+    }
+
+    if (pos >= levels.size()) {
+        return; // Worse than every cached level of a full side
+    }
+
+    // New level inside the cached range: shift worse levels down, dropping the last if full
+    size_t last = std::min(size, levels.size() - 1);
+    std::move_backward(levels.begin() + pos, levels.begin() + last, levels.begin() + last + 1);
+    levels[pos] = DepthLevel{price, quantity, order_count};
+    size = std::min(size + 1, levels.size());
+    sync_columns(side, pos);
+    ++sequence_;
+}
+
+void DepthCache::remove_level(Side side, Price price, const BookSide& book_side) {
+    std::vector<DepthLevel>& levels = storage(side);
+    size_t& size = count(side);
+
+    size_t pos = lower_bound(side, levels.data(), size, price);
+    if (pos >= size || levels[pos].price != price) {
+        return; // Not in the cached range
+    }
+
+    bool was_full = size == levels.size();
+    std::move(levels.begin() + pos + 1, levels.begin() + size, levels.begin() + pos);
+    --size;
+
+    // Pull the next level up from the book into the freed last slot
+    if (was_full) {
+        const PriceLevel* next = size == 0 ? book_side.best() : book_side.next(levels[size - 1].price);
+        if (next) {
+            levels[size++] = DepthLevel{next->price(), next->total_quantity(),
+                                        static_cast<uint32_t>(next->order_count())};
+        }
+    }
+    sync_columns(side, pos);
+    ++sequence_;
+}
+
+void DepthCache::rebuild(const BookSide& book_side) {
+    std::vector<DepthLevel>& levels = storage(book_side.side());
+    size_t& size = count(book_side.side());
+
+    size = 0;
+    if (!levels.empty()) {
+        book_side.for_each_level([&](const PriceLevel& level) {
+            levels[size++] = DepthLevel{level.price(), level.total_quantity(),
+                                        static_cast<uint32_t>(level.order_count())};
+            return size < levels.size();
+        });
+    }
+    sync_columns(book_side.side(), 0);
+    ++sequence_;
+}
+
+void DepthCache::clear() {
+    bid_count_ = 0;
+    ask_count_ = 0;
+    ++sequence_;
+}
+
+void DepthCache::sync_columns(Side side, size_t from) {
+    const std::vector<DepthLevel>& levels = storage(side);
+    Columns& target = columns(side);
+    for (size_t i = from, size = count(side); i < size; ++i) {
+        target.prices[i] = levels[i].price.raw_value();
+        target.quantities[i] = levels[i].quantity.raw_value();
+    }
+}
+
+size_t DepthCache::lower_bound(Side side, const DepthLevel* levels, size_t count, Price price) {
+    // Linear scan: the cached range is short
+    size_t pos = 0;
+    if (side == Side::BUY) {
+        while (pos < count && levels[pos].price > price) {
+            ++pos;
+        }
+    } else {
+        while (pos < count && levels[pos].price < price) {
+            ++pos;
+        }
+    }
+    return pos;
+}
+
+} // namespace orderbook
+} // namespace trading_engine
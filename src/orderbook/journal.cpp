@@ -0,0 +1,241 @@
+#include "orderbook/journal.hpp"
+#include "orderbook/order_book.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace trading_engine {
+namespace orderbook {
+
+namespace {
+
+constexpr const char* SEGMENT_PREFIX = "journal-";
+constexpr const char* SEGMENT_SUFFIX = ".seg";
+
+size_t segment_bytes(size_t capacity) {
+    return sizeof(JournalSegmentHeader) + capacity * sizeof(JournalRecord);
+}
+
+// Sequence loads/stores go through atomic_ref so record contents are
+// ordered before the sequence that makes them visible
+uint64_t load_sequence(const JournalRecord& record) {
+    return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(record.sequence)).load(std::memory_order_acquire);
+}
+
+} // namespace
+
+Journal::Journal(JournalConfig config)
+    : config_(std::move(config)) {
+}
+
+Journal::~Journal() {
+    close();
+}
+
+bool Journal::open() {
+    close();
+    if (config_.directory.empty() || config_.records_per_segment == 0) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(config_.directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    std::vector<uint64_t> segments = list_segments(config_.directory);
+    if (segments.empty()) {
+        return open_segment(0, 1);
+    }
+
+    // Resume in the newest segment after its last complete record
+    if (!open_segment(segments.back(), 0)) {
+        return false;
+    }
+
+    const JournalSegmentHeader& head = *header();
+    const JournalRecord* slots = records();
+    position_ = 0;
+    while (position_ < head.capacity &&
+           load_sequence(slots[position_]) == head.first_sequence + position_) {
+        ++position_;
+    }
+    next_sequence_ = head.first_sequence + position_;
+    return true;
+}
+
+uint64_t Journal::append(const OrderCommand& command, Timestamp timestamp) {
+    if (!segment_.is_open()) {
+        return 0;
+    }
+
+    // Roll to a fresh segment once this one is full
+    if (position_ == header()->capacity) {
+        segment_.sync();
+        if (!open_segment(segment_index_ + 1, next_sequence_)) {
+            return 0;
+        }
+    }
+
+    JournalRecord& slot = records()[position_];
+    slot.timestamp = timestamp;
+    slot.command = command;
+
+    uint64_t sequence = next_sequence_++;
+    std::atomic_ref<uint64_t>(slot.sequence).store(sequence, std::memory_order_release);
+    ++position_;
+    return sequence;
+}
+
+bool Journal::sync() {
+    return segment_.sync();
+}
+
+void Journal::close() {
+    if (segment_.is_open()) {
+        segment_.sync();
+        segment_.close();
+    }
+    position_ = 0;
+}
+
+std::string Journal::segment_path(const std::string& directory, uint64_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s%08llu%s", SEGMENT_PREFIX,
+                  static_cast<unsigned long long>(index), SEGMENT_SUFFIX);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::vector<uint64_t> Journal::list_segments(const std::string& directory) {
+    std::vector<uint64_t> segments;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        std::string name = entry.path().filename().string();
+        unsigned long long index = 0;
+        char suffix[8] = {};
+        if (std::sscanf(name.c_str(), "journal-%llu%7s", &index, suffix) == 2 &&
+            std::string(suffix) == SEGMENT_SUFFIX) {
+            segments.push_back(index);
+        }
+    }
+
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool Journal::open_segment(uint64_t index, uint64_t first_sequence) {
+    std::string path = segment_path(config_.directory, index);
+
+    // An existing segment keeps the capacity it was created with
+    std::error_code ec;
+    bool exists = std::filesystem::exists(path, ec);
+    size_t capacity = config_.records_per_segment;
+    if (exists) {
+        core::MappedFile probe;
+        if (!probe.open_read(path) || probe.size() < sizeof(JournalSegmentHeader)) {
+            return false;
+        }
+        const auto* existing = reinterpret_cast<const JournalSegmentHeader*>(probe.data());
+        if (!existing->is_valid() || probe.size() != segment_bytes(existing->capacity)) {
+            return false;
+        }
+        capacity = existing->capacity;
+    }
+
+    core::MappedFile segment;
+    if (!segment.open_write(path, segment_bytes(capacity))) {
+        return false;
+    }
+
+    segment_ = std::move(segment);
+    segment_index_ = index;
+    position_ = 0;
+
+    if (!exists) {
+        JournalSegmentHeader head;
+        head.capacity = capacity;
+        head.segment_index = index;
+        head.first_sequence = first_sequence;
+        *header() = head;
+        next_sequence_ = first_sequence;
+    }
+    return true;
+}
+
+JournalReader::JournalReader(std::string directory)
+    : directory_(std::move(directory)),
+      segments_(Journal::list_segments(directory_)) {
+}
+
+const JournalRecord* JournalReader::next() {
+    while (!done_) {
+        if (position_ < capacity_) {
+            const JournalRecord& record = records_[position_];
+            uint64_t sequence = load_sequence(record);
+            if (sequence != 0 && (expected_sequence_ == 0 || sequence == expected_sequence_)) {
+                ++position_;
+                expected_sequence_ = sequence + 1;
+                ++records_read_;
+                return &record;
+            }
+            if (sequence != 0) {
+                done_ = true; // Sequence gap: stop rather than replay out of order
+                return nullptr;
+            }
+            // Unwritten slot: only the newest segment may end early
+        }
+
+        if (!open_next_segment()) {
+            done_ = true;
+        }
+    }
+    return nullptr;
+}
+
+bool JournalReader::open_next_segment() {
+    // A segment that ended before its capacity was the last one written
+    if (records_ && position_ < capacity_) {
+        return false;
+    }
+
+    while (next_segment_ < segments_.size()) {
+        std::string path = Journal::segment_path(directory_, segments_[next_segment_++]);
+        core::MappedFile segment;
+        if (!segment.open_read(path) || segment.size() < sizeof(JournalSegmentHeader)) {
+            return false;
+        }
+
+        const auto* head = reinterpret_cast<const JournalSegmentHeader*>(segment.data());
+        if (!head->is_valid() || segment.size() != segment_bytes(head->capacity) ||
+            (expected_sequence_ != 0 && head->first_sequence != expected_sequence_)) {
+            return false;
+        }
+
+        segment_ = std::move(segment);
+        records_ = reinterpret_cast<const JournalRecord*>(segment_.data() + sizeof(JournalSegmentHeader));
+        capacity_ = head->capacity;
+        position_ = 0;
+        return true;
+    }
+    return false;
+}
+
+uint64_t replay_journal(JournalReader& reader, OrderBook& book, MatchSink& sink) {
+    uint64_t applied = 0;
+    while (const JournalRecord* record = reader.next()) {
+        if (record->command.symbol_id != book.symbol_id()) {
+            continue;
+        }
+        book.apply(record->command, record->timestamp, sink);
+        ++applied;
+    }
+    return applied;
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,24 @@
+#include "orderbook/match_sink.hpp"
+#include <sstream>
+
+namespace trading_engine {
+namespace orderbook {
+
+// OrderMatch to_string implementation
+std::string OrderMatch::to_string() const {
+    std::stringstream ss;
+    ss << "Match[maker=" << maker_order_id
+       << ", taker=" << taker_order_id
+       << ", price=" << match_price.to_string()
+       << ", qty=" << match_quantity.to_string()
+       << ", time=" << timestamp
+       << "]";
+    return ss.str();
+}
+
+MatchBuffer::MatchBuffer(size_t capacity) {
+    matches_.reserve(capacity);
+}
+
+} // namespace orderbook
+} // namespace trading_engine
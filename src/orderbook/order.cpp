@@ -1,81 +1,91 @@
 #include "orderbook/order.hpp"
+#include "orderbook/symbol_registry.hpp"
 #include <sstream>
 
 namespace trading_engine {
 namespace orderbook {
 
-Order::Order(OrderId id, Symbol symbol, Side side, OrderType type,
+Order::Order(OrderId id, SymbolId symbol_id, Side side, OrderType type,
              Quantity quantity, Price price, TimeInForce tif)
-    : id_(id),
-      symbol_(symbol),
-      side_(side),
-      type_(type),
-      quantity_(quantity),
-      executed_quantity_(Quantity::ZERO),
-      price_(price),
-      time_in_force_(tif),
-      status_(OrderStatus::NEW),
-      timestamp_(current_timestamp()),
-      last_update_(timestamp_) {
+    : Order(id, symbol_id, side, type, quantity, price, tif, NO_OWNER, current_timestamp()) {
+}
+
+Order::Order(OrderId id, SymbolId symbol_id, Side side, OrderType type,
+             Quantity quantity, Price price, TimeInForce tif, OwnerId owner, Timestamp timestamp) {
+    record_.id = id;
+    record_.symbol_id = symbol_id;
+    record_.quantity = quantity;
+    record_.executed_quantity = Quantity::ZERO;
+    record_.price = price;
+    record_.flags = OrderRecord::pack_flags(side, type, tif, OrderStatus::NEW);
+    record_.owner_id = owner;
+    record_.timestamp = timestamp;
+    last_update_ = timestamp;
+}
+
+Order::Order(OrderId id, std::string_view symbol, Side side, OrderType type,
+             Quantity quantity, Price price, TimeInForce tif)
+    : Order(id, SymbolRegistry::global().intern(symbol), side, type, quantity, price, tif) {
+}
+
+Order::Order(const OrderRecord& record)
+    : record_(record),
+      last_update_(record.timestamp) {
 }
 
 Order::Order()
-    : id_(INVALID_ORDER_ID),
-      symbol_(""),
-      side_(Side::BUY),
-      type_(OrderType::LIMIT),
-      quantity_(Quantity::ZERO),
-      executed_quantity_(Quantity::ZERO),
-      price_(Price::ZERO),
-      time_in_force_(TimeInForce::GTC),
-      status_(OrderStatus::NEW),
-      timestamp_(current_timestamp()),
-      last_update_(timestamp_) {
+    : Order(INVALID_ORDER_ID, INVALID_SYMBOL_ID, Side::BUY, OrderType::LIMIT,
+            Quantity::ZERO, Price::ZERO, TimeInForce::GTC) {
+}
+
+const Symbol& Order::symbol() const {
+    return SymbolRegistry::global().name(record_.symbol_id);
 }
 
-void Order::execute(Quantity exec_qty) {
+void Order::execute(Quantity exec_qty, Timestamp now) {
     // Ensure we don't execute more than available
     if (exec_qty > remaining_quantity()) {
         exec_qty = remaining_quantity();
     }
     
-    executed_quantity_ = executed_quantity_ + exec_qty;
+    record_.executed_quantity = record_.executed_quantity + exec_qty;
     
     // Update status
-    if (executed_quantity_ == quantity_) {
-        status_ = OrderStatus::FILLED;
-    } else if (executed_quantity_ > Quantity::ZERO) {
-        status_ = OrderStatus::PARTIALLY_FILLED;
+    if (record_.executed_quantity == record_.quantity) {
+        record_.set_status(OrderStatus::FILLED);
+    } else if (record_.executed_quantity > Quantity::ZERO) {
+        record_.set_status(OrderStatus::PARTIALLY_FILLED);
     }
     
-    last_update_ = current_timestamp();
+    last_update_ = now;
 }
 
-void Order::cancel() {
+void Order::cancel(Timestamp now) {
     if (is_active()) {
-        status_ = OrderStatus::CANCELLED;
-        last_update_ = current_timestamp();
+        record_.set_status(OrderStatus::CANCELLED);
+        last_update_ = now;
     }
 }
 
 bool Order::is_active() const {
-    return status_ == OrderStatus::NEW ||
-           status_ == OrderStatus::ACCEPTED ||
-           status_ == OrderStatus::PARTIALLY_FILLED;
+    OrderStatus current = status();
+    return current == OrderStatus::NEW ||
+           current == OrderStatus::ACCEPTED ||
+           current == OrderStatus::PARTIALLY_FILLED;
 }
 
 std::string Order::to_string() const {
     std::stringstream ss;
-    ss << "Order[id=" << id_ 
-       << ", symbol=" << symbol_
-       << ", side=" << ::trading_engine::orderbook::to_string(side_)
-       << ", type=" << ::trading_engine::orderbook::to_string(type_)
-       << ", qty=" << quantity_.to_string()
-       << ", exec_qty=" << executed_quantity_.to_string()
-       << ", price=" << price_.to_string()
-       << ", tif=" << ::trading_engine::orderbook::to_string(time_in_force_)
-       << ", status=" << ::trading_engine::orderbook::to_string(status_)
-       << ", time=" << timestamp_
+    ss << "Order[id=" << record_.id 
+       << ", symbol=" << symbol()
+       << ", side=" << ::trading_engine::orderbook::to_string(side())
+       << ", type=" << ::trading_engine::orderbook::to_string(type())
+       << ", qty=" << record_.quantity.to_string()
+       << ", exec_qty=" << record_.executed_quantity.to_string()
+       << ", price=" << record_.price.to_string()
+       << ", tif=" << ::trading_engine::orderbook::to_string(time_in_force())
+       << ", status=" << ::trading_engine::orderbook::to_string(status())
+       << ", time=" << record_.timestamp
        << ", last_update=" << last_update_
        << "]";
     return ss.str();
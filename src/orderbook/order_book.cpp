@@ -1,105 +1,329 @@
 #include "orderbook/order_book.hpp"
 #include <sstream>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
+#include "core/cache.hpp"
+#include "core/latency_histogram.hpp"
 #include "core/logger.hpp"
+#include "core/simd_kernels.hpp"
 
 namespace trading_engine {
 namespace orderbook {
 
-// OrderMatch to_string implementation
-std::string OrderMatch::to_string() const {
-    std::stringstream ss;
-    ss << "Match[maker=" << maker_order_id
-       << ", taker=" << taker_order_id
-       << ", price=" << match_price.to_string()
-       << ", qty=" << match_quantity.to_string()
-       << ", time=" << timestamp
-       << "]";
-    return ss.str();
+namespace {
+
+// Build one side of the book according to the configuration
+BookSide make_side(Side side, const OrderBookConfig& config) {
+    if (config.use_price_ladder) {
+        return BookSide(side, config.tick_size, config.ladder_ticks, config.ladder_max_ticks);
+    }
+    return BookSide(side);
+}
+
+// Reference data used when a book is built for an id the registry doesn't know
+const SymbolInfo UNKNOWN_SYMBOL_INFO;
+
+const SymbolInfo* lookup_symbol_info(SymbolId symbol_id) {
+    const SymbolInfo* info = SymbolRegistry::global().info(symbol_id);
+    return info ? info : &UNKNOWN_SYMBOL_INFO;
+}
+
+// Integer division rounding toward negative infinity
+int64_t floor_div(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+}
+
+} // namespace
+
+OrderBook::OrderBook(const Symbol& symbol, const OrderBookConfig& config)
+    : OrderBook(SymbolRegistry::global().intern(symbol), config) {
 }
 
-OrderBook::OrderBook(const Symbol& symbol)
-    : symbol_(symbol),
+OrderBook::OrderBook(SymbolId symbol_id, const OrderBookConfig& config)
+    : symbol_id_(symbol_id),
+      symbol_info_(lookup_symbol_info(symbol_id)),
+      config_(config),
+      order_pool_(config.order_pool_capacity),
+      bid_levels_(make_side(Side::BUY, config)),
+      ask_levels_(make_side(Side::SELL, config)),
+      depth_(config.depth_levels),
+      orders_(config.order_index_capacity),
+      pending_(PENDING_INDEX_CAPACITY),
       total_bid_quantity_(Quantity::ZERO),
       total_ask_quantity_(Quantity::ZERO) {
 }
 
 std::vector<OrderMatch> OrderBook::add_order(OrderPtr order) {
+    std::vector<OrderMatch> matches;
+    auto sink = make_match_sink([&](const OrderMatch& match) { matches.push_back(match); });
+    add_order(std::move(order), sink);
+    return matches;
+}
+
+void OrderBook::add_order(OrderPtr order, MatchSink& sink) {
+    now_ = current_timestamp();
+    process_add(std::move(order), sink);
+    settle(sink);
+}
+
+bool OrderBook::cancel_order(OrderId order_id) {
+    now_ = current_timestamp();
+    return process_cancel(order_id);
+}
+
+std::vector<OrderMatch> OrderBook::modify_order(OrderId order_id, 
+                                               std::optional<Price> new_price, 
+                                               std::optional<Quantity> new_quantity) {
+    std::vector<OrderMatch> matches;
+    auto sink = make_match_sink([&](const OrderMatch& match) { matches.push_back(match); });
+    modify_order(order_id, new_price, new_quantity, sink);
+    return matches;
+}
+
+void OrderBook::modify_order(OrderId order_id,
+                             std::optional<Price> new_price,
+                             std::optional<Quantity> new_quantity,
+                             MatchSink& sink) {
+    now_ = current_timestamp();
+    process_modify(order_id, new_price, new_quantity, sink);
+    settle(sink);
+}
+
+size_t OrderBook::submit_batch(std::span<const OrderCommand> commands, MatchSink& sink) {
+    now_ = current_timestamp();
+    
+    // Two stages per command that names a resting order: the index slot is
+    // warmed PREFETCH_DISTANCE commands ahead, and the order it points at half
+    // that far ahead, by which time the lookup no longer misses
+    auto names_order = [&](const OrderCommand& command) {
+        return command.type != CommandType::NEW && command.symbol_id == symbol_id_;
+    };
+    auto prefetch_slot = [&](size_t index) {
+        if (index < commands.size() && names_order(commands[index])) {
+            orders_.prefetch(commands[index].order_id);
+        }
+    };
+    auto prefetch_order = [&](size_t index) {
+        if (index < commands.size() && names_order(commands[index])) {
+            if (const OrderPtr* order = orders_.find(commands[index].order_id)) {
+                core::prefetch_write(order->get());
+            }
+        }
+    };
+    constexpr size_t ORDER_DISTANCE = PREFETCH_DISTANCE / 2;
+    
+    for (size_t i = 0; i < PREFETCH_DISTANCE; ++i) {
+        prefetch_slot(i);
+    }
+    for (size_t i = 0; i < ORDER_DISTANCE; ++i) {
+        prefetch_order(i);
+    }
+    
+    size_t applied = 0;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        prefetch_slot(i + PREFETCH_DISTANCE);
+        prefetch_order(i + ORDER_DISTANCE);
+        
+        const OrderCommand& command = commands[i];
+        if (command.symbol_id != symbol_id_) {
+            continue; // Not for this book
+        }
+        
+        process_command(command, sink);
+        ++applied;
+    }
+    
+    return applied;
+}
+
+void OrderBook::apply(const OrderCommand& command, Timestamp now, MatchSink& sink) {
+    now_ = now;
+    process_command(command, sink);
+}
+
+size_t OrderBook::cancel_all(const CancelFilter& filter) {
+    now_ = current_timestamp();
+    
+    size_t cancelled = 0;
+    if (!filter.side || *filter.side == Side::BUY) {
+        cancelled += cancel_side(Side::BUY, filter);
+    }
+    if (!filter.side || *filter.side == Side::SELL) {
+        cancelled += cancel_side(Side::SELL, filter);
+    }
+    return cancelled;
+}
+
+void OrderBook::process_command(const OrderCommand& command, MatchSink& sink) {
+    switch (command.type) {
+        case CommandType::NEW: {
+            OrderPtr order = order_pool_.create(
+                command.order_id,
+                symbol_id_,
+                command.side,
+                command.order_type,
+                command.quantity,
+                command.price,
+                command.time_in_force,
+                command.owner_id,
+                now_
+            );
+            order->set_stop_price(command.aux_price); // Or the peg offset
+            process_add(std::move(order), sink);
+            break;
+        }
+        case CommandType::CANCEL:
+            process_cancel(command.order_id);
+            break;
+        case CommandType::MODIFY:
+            process_modify(command.order_id, command.new_price(), command.new_quantity(), sink);
+            break;
+        case CommandType::SNAPSHOT:
+            break; // Changes nothing; whoever owns the book writes the image
+    }
+    
+    settle(sink);
+}
+
+void OrderBook::process_add(OrderPtr order, MatchSink& sink) {
+    TE_LATENCY_PROBE("orderbook.add_order");
+
     if (!order || !order->is_valid()) {
-        return {}; // Invalid order
+        return; // Invalid order
+    }
+    
+    // Reject ids that are still live (the index would lose the first order),
+    // orders outside the symbol's lot size, tick grid or price band, limit
+    // prices the level storage cannot represent, and off-grid stop prices
+    OrderType type = order->type();
+    bool has_limit = type == OrderType::LIMIT || type == OrderType::STOP_LIMIT;
+    if (type == OrderType::CANCEL || type == OrderType::MODIFY ||
+        orders_.find(order->id()) || pending_.find(order->id()) ||
+        !symbol_info_->accepts_quantity(order->quantity()) ||
+        (has_limit && (!symbol_info_->accepts_price(order->price()) || !side_for(order->side()).accepts(order->price()))) ||
+        (order->is_stop() && !symbol_info_->accepts_price(order->stop_price()))) {
+        order->set_status(OrderStatus::REJECTED, now_);
+        return;
+    }
+    
+    // Pre-trade limits of the order's owner
+    if (risk_gate_ && risk_gate_->check(*order, *symbol_info_) != RiskCheck::PASSED) {
+        order->set_status(OrderStatus::REJECTED, now_);
+        return;
+    }
+    
+    // Set order status to accepted; its size is open exposure from here on
+    order->set_status(OrderStatus::ACCEPTED, now_);
+    if (risk_gate_) {
+        risk_gate_->on_accept(symbol_id_, *order);
+    }
+    
+    // Stops wait in the stop book unless the last trade has already reached them
+    if (order->is_stop()) {
+        if (!stop_triggered(*order)) {
+            stops_.add(*order);
+            OrderId id = order->id();
+            pending_.insert_or_assign(id, std::move(order));
+            return;
+        }
+        elect(*order);
     }
     
-    // Set order status to accepted
-    order->set_status(OrderStatus::ACCEPTED);
+    // Pegs join their group and rest at its current price
+    if (order->is_pegged()) {
+        auto [group, created] = pegs_.add(order);
+        if (created) {
+            group->price = peg_price(PegBook::key_for(*order), reference_price(Side::BUY),
+                                     reference_price(Side::SELL));
+        }
+        if (!place_pegged(order, group->price, sink)) {
+            pegs_.remove(*order);
+            pegs_.prune();
+        }
+        return;
+    }
     
+    execute_order(std::move(order), sink);
+}
+
+void OrderBook::execute_order(OrderPtr order, MatchSink& sink) {
     // Match order based on its type
-    std::vector<OrderMatch> matches;
     if (order->type() == OrderType::MARKET) {
-        matches = match_market_order(order);
+        match_market_order(*order, sink);
     } else if (order->type() == OrderType::LIMIT) {
-        matches = match_limit_order(order);
+        match_limit_order(*order, sink);
         
-        // If the order is not fully filled and not IOC, add it to the book
-        if (!order->is_filled() && order->time_in_force() != TimeInForce::IOC) {
+        // If the order is not fully filled and neither IOC nor a killed FOK,
+        // add it to the book
+        if (!order->is_filled() && order->time_in_force() == TimeInForce::GTC) {
             add_limit_order_to_book(order);
+            return;
         }
     }
     
-    return matches;
+    // Whatever didn't trade is dropped
+    release_exposure(*order);
 }
 
-bool OrderBook::cancel_order(OrderId order_id) {
+bool OrderBook::process_cancel(OrderId order_id) {
     // Find the order
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
-        return false; // Order not found
+    const OrderPtr* found = orders_.find(order_id);
+    if (!found) {
+        // Pending orders have no level to leave
+        const OrderPtr* pending = pending_.find(order_id);
+        if (!pending) {
+            return false; // Order not found
+        }
+        OrderPtr order = *pending;
+        if (order->is_stop()) {
+            stops_.remove(*order);
+        } else if (order->is_pegged()) {
+            pegs_.remove(*order);
+            pegs_.prune();
+        }
+        release_exposure(*order);
+        pending_.erase(order_id);
+        order->set_status(OrderStatus::CANCELLED, now_);
+        return true;
     }
     
-    OrderPtr order = it->second;
+    OrderPtr order = *found;
     
     // Get the price level
     Price price = order->price();
     Side side = order->side();
     
-    // Remove from appropriate price level
+    // Unlink from the price level the order rests in
     bool removed = false;
-    if (side == Side::BUY) {
-        auto level_it = bid_levels_.find(price);
-        if (level_it != bid_levels_.end()) {
-            PriceLevelPtr level = level_it->second;
-            removed = level->remove_order(order_id);
+    PriceLevel* level = order->level();
+    if (level) {
+        removed = level->remove_order(*order);
+        
+        if (removed) {
+            publish(MarketDataEventType::ORDER_DELETED, side, order_id, INVALID_ORDER_ID,
+                    price, order->remaining_quantity());
             
-            if (removed) {
-                // Update total quantity
-                total_bid_quantity_ = total_bid_quantity_ - order->remaining_quantity();
-                
-                // Remove empty level
-                remove_price_level_if_empty(price, side);
-            }
-        }
-    } else {
-        auto level_it = ask_levels_.find(price);
-        if (level_it != ask_levels_.end()) {
-            PriceLevelPtr level = level_it->second;
-            removed = level->remove_order(order_id);
+            // Update total quantity
+            total_for(side) = total_for(side) - order->remaining_quantity();
             
-            if (removed) {
-                // Update total quantity
-                total_ask_quantity_ = total_ask_quantity_ - order->remaining_quantity();
-                
-                // Remove empty level
-                remove_price_level_if_empty(price, side);
-            }
+            // Remove empty level
+            remove_price_level_if_empty(price, side);
         }
     }
     
     if (removed) {
         // Mark the order as cancelled
-        order->cancel();
+        release_exposure(*order);
+        order->cancel(now_);
         
-        // Remove from orders map
-        orders_.erase(it);
+        // Remove from the id index, and from its peg group
+        orders_.erase(order_id);
+        if (order->is_pegged()) {
+            pegs_.remove(*order);
+            pegs_.prune();
+        }
         
         return true;
     }
@@ -107,104 +331,312 @@ bool OrderBook::cancel_order(OrderId order_id) {
     return false;
 }
 
-std::vector<OrderMatch> OrderBook::modify_order(OrderId order_id, 
-                                               std::optional<Price> new_price, 
-                                               std::optional<Quantity> new_quantity) {
+void OrderBook::process_modify(OrderId order_id,
+                               std::optional<Price> new_price,
+                               std::optional<Quantity> new_quantity,
+                               MatchSink& sink) {
     // If neither price nor quantity is modified, do nothing
     if (!new_price && !new_quantity) {
-        return {};
+        return;
     }
     
-    // Find the order
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
-        return {}; // Order not found
+    // Find the order; only resting orders can be amended
+    const OrderPtr* found = orders_.find(order_id);
+    if (!found || !(*found)->level()) {
+        return; // Order not found
+    }
+    
+    OrderPtr order = *found;
+    Side side = order->side();
+    Price price = new_price.value_or(order->price());
+    Quantity quantity = new_quantity.value_or(order->quantity());
+    
+    // Reject amends below what has already executed, or outside the
+    // symbol's lot size, tick grid or the side's storage, and re-pricing a
+    // pegged order; the order is kept
+    if (quantity < order->executed_quantity() ||
+        (order->is_pegged() && price != order->price()) ||
+        (quantity != order->quantity() && !symbol_info_->accepts_quantity(quantity)) ||
+        (price != order->price() && (!symbol_info_->accepts_price(price) || !side_for(side).accepts(price)))) {
+        return;
     }
     
-    OrderPtr order = it->second;
+    // Amends that add size or move the price face the owner's limits again
+    if (risk_gate_ && (quantity > order->quantity() || price != order->price()) &&
+        risk_gate_->check_amend(*order, price, quantity, *symbol_info_) != RiskCheck::PASSED) {
+        return;
+    }
     
-    // If only quantity is modified and it's a decrease, just update the order
-    if (!new_price && new_quantity && *new_quantity <= order->quantity()) {
-        // Get the price level
-        Price price = order->price();
-        Side side = order->side();
+    // Reducing to the executed quantity leaves nothing to rest: the
+    // remainder is cancelled
+    if (quantity == order->executed_quantity()) {
+        process_cancel(order_id);
+        order->set_status(OrderStatus::CANCELLED, now_);
+        return;
+    }
+    
+    PriceLevel* level = order->level();
+    Quantity old_remaining = order->remaining_quantity();
+    
+    if (price == order->price()) {
+        if (quantity == order->quantity()) {
+            return; // Nothing changes
+        }
         
-        if (side == Side::BUY) {
-            auto level_it = bid_levels_.find(price);
-            if (level_it != bid_levels_.end()) {
-                PriceLevelPtr level = level_it->second;
-                
-                // Update quantity
-                Quantity old_remaining = order->remaining_quantity();
-                level->modify_order_quantity(order_id, *new_quantity);
-                Quantity new_remaining = order->remaining_quantity();
-                
-                // Update total quantity
-                total_bid_quantity_ = total_bid_quantity_ - old_remaining + new_remaining;
-            }
+        // Same price: amend in place. A decrease keeps time priority; an
+        // increase moves to the back of the same level, with no allocation
+        level->modify_order_quantity(*order, quantity);
+        Quantity new_remaining = order->remaining_quantity();
+        total_for(side) = total_for(side) - old_remaining + new_remaining;
+        if (risk_gate_) {
+            risk_gate_->on_amend(symbol_id_, *order, old_remaining);
+        }
+        
+        if (new_remaining < old_remaining) {
+            publish(MarketDataEventType::ORDER_REDUCED, side, order_id, INVALID_ORDER_ID,
+                    price, old_remaining - new_remaining);
         } else {
-            auto level_it = ask_levels_.find(price);
-            if (level_it != ask_levels_.end()) {
-                PriceLevelPtr level = level_it->second;
-                
-                // Update quantity
-                Quantity old_remaining = order->remaining_quantity();
-                level->modify_order_quantity(order_id, *new_quantity);
-                Quantity new_remaining = order->remaining_quantity();
-                
-                // Update total quantity
-                total_ask_quantity_ = total_ask_quantity_ - old_remaining + new_remaining;
-            }
+            level->requeue_order(*order);
+            order->set_timestamp(now_);
+            publish(MarketDataEventType::ORDER_DELETED, side, order_id, INVALID_ORDER_ID,
+                    price, old_remaining);
+            publish(MarketDataEventType::ORDER_ADDED, side, order_id, INVALID_ORDER_ID,
+                    price, new_remaining);
         }
+        update_depth(side, *level);
         
         // Mark as replaced
-        order->set_status(OrderStatus::REPLACED);
+        order->set_status(OrderStatus::REPLACED, now_);
+        return;
+    }
+    
+    // Price change: lift the same order object out of its level...
+    Price old_price = order->price();
+    level->remove_order(*order);
+    total_for(side) = total_for(side) - old_remaining;
+    publish(MarketDataEventType::ORDER_DELETED, side, order_id, INVALID_ORDER_ID,
+            old_price, old_remaining);
+    remove_price_level_if_empty(old_price, side);
+    
+    order->set_price(price);
+    order->set_quantity(quantity);
+    order->set_timestamp(now_);
+    order->set_status(OrderStatus::REPLACED, now_);
+    if (risk_gate_) {
+        risk_gate_->on_amend(symbol_id_, *order, old_remaining);
+    }
+    
+    // ...rematch only if the new price reaches the opposite side...
+    if (crosses(side, price)) {
+        match_limit_order(*order, sink);
+    }
+    
+    // ...and rest whatever is left at the new price
+    if (order->is_filled() || order->time_in_force() != TimeInForce::GTC) {
+        release_exposure(*order);
+        orders_.erase(order_id);
+    } else {
+        add_limit_order_to_book(order);
+    }
+}
+
+bool OrderBook::crosses(Side side, Price price) const {
+    const BookSide& opposite = side_for(side == Side::BUY ? Side::SELL : Side::BUY);
+    const PriceLevel* best = opposite.best();
+    return best && !opposite.is_better(price, best->price());
+}
+
+void OrderBook::settle(MatchSink& sink) {
+    if (settling_ || (stops_.empty() && pegs_.empty())) {
+        return;
+    }
+    settling_ = true;
+    
+    // Stops fire on trades, and trades and fired stops move the references
+    // pegs follow, so keep going until a pass changes nothing
+    bool changed = true;
+    while (changed) {
+        changed = trigger_stops(sink);
+        changed = reprice_pegs(sink) || changed;
+    }
+    
+    pegs_.prune();
+    settling_ = false;
+}
+
+bool OrderBook::stop_triggered(const Order& order) const {
+    if (!last_trade_price_) {
+        return false;
+    }
+    return order.side() == Side::BUY ? *last_trade_price_ >= order.stop_price()
+                                     : *last_trade_price_ <= order.stop_price();
+}
+
+void OrderBook::elect(Order& order) {
+    order.set_type(order.type() == OrderType::STOP ? OrderType::MARKET : OrderType::LIMIT);
+}
+
+bool OrderBook::trigger_stops(MatchSink& sink) {
+    bool triggered = false;
+    
+    // Each triggered stop can trade and move the last price, so the stop
+    // book is asked again after every one
+    while (last_trade_price_) {
+        OrderId id = stops_.pop_triggered(*last_trade_price_);
+        if (id == INVALID_ORDER_ID) {
+            break;
+        }
+        
+        const OrderPtr* found = pending_.find(id);
+        if (!found) {
+            continue;
+        }
+        OrderPtr order = *found;
+        pending_.erase(id);
+        
+        elect(*order);
+        execute_order(std::move(order), sink);
+        triggered = true;
+    }
+    
+    return triggered;
+}
+
+std::optional<Price> OrderBook::reference_price(Side side) const {
+    // Skip levels holding nothing but pegs, so pegs never follow themselves
+    std::optional<Price> reference;
+    side_for(side).for_each_level([&](const PriceLevel& level) {
+        if (level.has_unpegged_orders()) {
+            reference = level.price();
+            return false;
+        }
+        return true;
+    });
+    return reference;
+}
+
+std::optional<Price> OrderBook::peg_price(const PegKey& key, std::optional<Price> bid_reference,
+                                          std::optional<Price> ask_reference) const {
+    std::optional<Price> price;
+    if (key.type == OrderType::PEG_PRIMARY) {
+        std::optional<Price> same_side = key.side == Side::BUY ? bid_reference : ask_reference;
+        if (same_side) {
+            price = *same_side + key.offset;
+        }
+    } else if (bid_reference && ask_reference) {
+        // Midpoint plus offset, rounded onto the tick grid away from the
+        // opposite side (twice the target is kept so odd sums stay exact)
+        const Price& tick_size = config_.use_price_ladder ? config_.tick_size : symbol_info_->tick_size;
+        int64_t step = 2 * std::max<int64_t>(1, tick_size.raw_value());
+        int64_t twice = bid_reference->raw_value() + ask_reference->raw_value() + 2 * key.offset.raw_value();
+        int64_t ticks = key.side == Side::BUY ? floor_div(twice, step) : -floor_div(-twice, step);
+        price = Price(ticks * (step / 2));
+    }
+    
+    if (price && (!symbol_info_->accepts_price(*price) || !side_for(key.side).accepts(*price))) {
+        return std::nullopt;
+    }
+    return price;
+}
+
+bool OrderBook::reprice_pegs(MatchSink& sink) {
+    if (pegs_.empty()) {
+        return false;
+    }
+    
+    // Nothing pegs follow has moved: no group needs looking at
+    std::optional<Price> bid_reference = reference_price(Side::BUY);
+    std::optional<Price> ask_reference = reference_price(Side::SELL);
+    if (bid_reference == peg_bid_reference_ && ask_reference == peg_ask_reference_) {
+        return false;
+    }
+    peg_bid_reference_ = bid_reference;
+    peg_ask_reference_ = ask_reference;
+    
+    // Each group is priced once and moved as a whole, keeping its arrival order
+    bool repriced = false;
+    pegs_.for_each_group([&](const PegKey& key, PegGroup& group) {
+        std::optional<Price> price = peg_price(key, bid_reference, ask_reference);
+        if (price == group.price) {
+            return;
+        }
+        group.price = price;
+        repriced = true;
         
-        return {};
+        std::vector<OrderPtr> orders;
+        orders.swap(group.orders);
+        for (const OrderPtr& order : orders) {
+            lift_order(*order);
+        }
+        for (OrderPtr& order : orders) {
+            if (place_pegged(order, price, sink)) {
+                group.orders.push_back(std::move(order));
+            }
+        }
+    });
+    
+    return repriced;
+}
+
+void OrderBook::lift_order(Order& order) {
+    PriceLevel* level = order.level();
+    if (!level) {
+        pending_.erase(order.id());
+        return;
     }
     
-    // Otherwise, treat as cancel and replace
-    // Cancel the old order
-    bool cancelled = cancel_order(order_id);
-    if (!cancelled) {
-        return {};
+    Side side = order.side();
+    Price price = order.price();
+    Quantity remaining = order.remaining_quantity();
+    level->remove_order(order);
+    total_for(side) = total_for(side) - remaining;
+    publish(MarketDataEventType::ORDER_DELETED, side, order.id(), INVALID_ORDER_ID, price, remaining);
+    remove_price_level_if_empty(price, side);
+    orders_.erase(order.id());
+}
+
+bool OrderBook::place_pegged(const OrderPtr& order, std::optional<Price> price, MatchSink& sink) {
+    if (!price) {
+        pending_.insert_or_assign(order->id(), order);
+        return true;
     }
     
-    // Create a new order with the same properties but new price/quantity
-    OrderPtr new_order = std::make_shared<Order>(
-        order_id,
-        order->symbol(),
-        order->side(),
-        order->type(),
-        new_quantity.value_or(order->quantity()),
-        new_price.value_or(order->price()),
-        order->time_in_force()
-    );
+    order->set_price(*price);
+    order->set_timestamp(now_);
+    if (crosses(order->side(), *price)) {
+        match_limit_order(*order, sink);
+    }
     
-    // Add the new order to the book (which will do matching)
-    return add_order(new_order);
+    if (order->is_filled() || order->time_in_force() != TimeInForce::GTC) {
+        release_exposure(*order);
+        return false;
+    }
+    add_limit_order_to_book(order);
+    return true;
 }
 
 OrderPtr OrderBook::get_order(OrderId order_id) const {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
-        return nullptr;
+    const OrderPtr* order = orders_.find(order_id);
+    if (!order) {
+        order = pending_.find(order_id);
     }
-    return it->second;
+    return order ? *order : nullptr;
 }
 
 std::optional<Price> OrderBook::best_bid() const {
-    if (bid_levels_.empty()) {
+    const PriceLevel* level = bid_levels_.best();
+    if (!level) {
         return std::nullopt;
     }
-    return bid_levels_.begin()->first;
+    return level->price();
 }
 
 std::optional<Price> OrderBook::best_ask() const {
-    if (ask_levels_.empty()) {
+    const PriceLevel* level = ask_levels_.best();
+    if (!level) {
         return std::nullopt;
     }
-    return ask_levels_.begin()->first;
+    return level->price();
 }
 
 std::optional<Price> OrderBook::spread() const {
@@ -232,32 +664,18 @@ std::optional<Price> OrderBook::midpoint() const {
 }
 
 std::vector<OrderPtr> OrderBook::get_orders_at_level(Price price, Side side) const {
-    if (side == Side::BUY) {
-        auto it = bid_levels_.find(price);
-        if (it != bid_levels_.end()) {
-            return it->second->get_all_orders();
-        }
-    } else {
-        auto it = ask_levels_.find(price);
-        if (it != ask_levels_.end()) {
-            return it->second->get_all_orders();
-        }
+    const PriceLevel* level = side_for(side).find(price);
+    if (level) {
+        return level->get_all_orders();
     }
     
     return {};
 }
 
 Quantity OrderBook::get_quantity_at_level(Price price, Side side) const {
-    if (side == Side::BUY) {
-        auto it = bid_levels_.find(price);
-        if (it != bid_levels_.end()) {
-            return it->second->total_quantity();
-        }
-    } else {
-        auto it = ask_levels_.find(price);
-        if (it != ask_levels_.end()) {
-            return it->second->total_quantity();
-        }
+    const PriceLevel* level = side_for(side).find(price);
+    if (level) {
+        return level->total_quantity();
     }
     
     return Quantity::ZERO;
@@ -265,22 +683,24 @@ Quantity OrderBook::get_quantity_at_level(Price price, Side side) const {
 
 std::vector<Price> OrderBook::get_bid_prices() const {
     std::vector<Price> prices;
-    prices.reserve(bid_levels_.size());
+    prices.reserve(bid_levels_.level_count());
     
-    for (const auto& [price, _] : bid_levels_) {
-        prices.push_back(price);
-    }
+    bid_levels_.for_each_level([&](const PriceLevel& level) {
+        prices.push_back(level.price());
+        return true;
+    });
     
     return prices;
 }
 
 std::vector<Price> OrderBook::get_ask_prices() const {
     std::vector<Price> prices;
-    prices.reserve(ask_levels_.size());
+    prices.reserve(ask_levels_.level_count());
     
-    for (const auto& [price, _] : ask_levels_) {
-        prices.push_back(price);
-    }
+    ask_levels_.for_each_level([&](const PriceLevel& level) {
+        prices.push_back(level.price());
+        return true;
+    });
     
     return prices;
 }
@@ -288,9 +708,10 @@ std::vector<Price> OrderBook::get_ask_prices() const {
 std::map<Price, Quantity, std::greater<Price>> OrderBook::get_bids() const {
     std::map<Price, Quantity, std::greater<Price>> result;
     
-    for (const auto& [price, level] : bid_levels_) {
-        result[price] = level->total_quantity();
-    }
+    bid_levels_.for_each_level([&](const PriceLevel& level) {
+        result.emplace_hint(result.end(), level.price(), level.total_quantity());
+        return true;
+    });
     
     return result;
 }
@@ -298,9 +719,10 @@ std::map<Price, Quantity, std::greater<Price>> OrderBook::get_bids() const {
 std::map<Price, Quantity> OrderBook::get_asks() const {
     std::map<Price, Quantity> result;
     
-    for (const auto& [price, level] : ask_levels_) {
-        result[price] = level->total_quantity();
-    }
+    ask_levels_.for_each_level([&](const PriceLevel& level) {
+        result.emplace_hint(result.end(), level.price(), level.total_quantity());
+        return true;
+    });
     
     return result;
 }
@@ -314,29 +736,344 @@ Quantity OrderBook::get_total_ask_quantity() const {
 }
 
 size_t OrderBook::bid_level_count() const {
-    return bid_levels_.size();
+    return bid_levels_.level_count();
 }
 
 size_t OrderBook::ask_level_count() const {
-    return ask_levels_.size();
+    return ask_levels_.level_count();
 }
 
 size_t OrderBook::order_count() const {
     return orders_.size();
 }
 
+bool OrderBook::can_fill(Side side, Quantity quantity, std::optional<Price> limit_price) const {
+    if (quantity <= Quantity::ZERO) {
+        return true;
+    }
+    
+    // Not enough resting quantity on the whole opposite side
+    Side opposite_side = side == Side::BUY ? Side::SELL : Side::BUY;
+    if (total_for(opposite_side) < quantity) {
+        return false;
+    }
+    
+    // Accumulate level depth in priority order until the limit or the quantity is reached
+    const BookSide& opposite = side_for(opposite_side);
+    Quantity available = Quantity::ZERO;
+    opposite.for_each_level([&](const PriceLevel& level) {
+        if (limit_price && opposite.is_better(*limit_price, level.price())) {
+            return false;
+        }
+        available = available + level.total_quantity();
+        return available < quantity;
+    });
+    
+    return available >= quantity;
+}
+
+SweepCost OrderBook::sweep_cost(Side side, Quantity quantity) const {
+    __extension__ using wide = __int128;
+
+    SweepCost cost;
+    const int64_t wanted = quantity.raw_value();
+    if (wanted <= 0) {
+        cost.complete = true;
+        return cost;
+    }
+
+    // Whole levels first: find where the running quantity reaches the order
+    const Side book_side = side == Side::BUY ? Side::SELL : Side::BUY;
+    std::span<const int64_t> prices = depth_.prices(book_side);
+    std::span<const int64_t> quantities = depth_.quantities(book_side);
+    const size_t cached = prices.size();
+    int64_t taken = 0;
+    size_t whole = core::simd::prefix_search(quantities.data(), cached, wanted, taken);
+
+    // Every swept price lies between the first and the last, so if that bound
+    // times the quantity fits in 64 bits, so does every partial sum of the dot product
+    wide paid = 0;
+    if (whole > 0) {
+        int64_t bound = std::max(std::abs(prices[0]), std::abs(prices[whole - 1]));
+        int64_t product = 0;
+        if (!__builtin_mul_overflow(bound, taken, &product)) {
+            paid = core::simd::dot(prices.data(), quantities.data(), whole);
+        } else {
+            for (size_t i = 0; i < whole; ++i) {
+                paid += static_cast<wide>(prices[i]) * quantities[i];
+            }
+        }
+        cost.worst_price = Price(prices[whole - 1]);
+    }
+    cost.levels = whole;
+
+    auto take = [&](int64_t price, int64_t available) {
+        int64_t part = std::min(available, wanted - taken);
+        paid += static_cast<wide>(price) * part;
+        taken += part;
+        cost.worst_price = Price(price);
+        ++cost.levels;
+    };
+    if (whole < cached) {
+        take(prices[whole], quantities[whole]);
+    } else if (depth_.is_full(book_side)) {
+        // The cache ran out before the order did: continue down the book
+        const BookSide& levels = side_for(book_side);
+        const PriceLevel* level = cached > 0 ? levels.next(Price(prices[cached - 1])) : levels.best();
+        for (; level && taken < wanted; level = levels.next(level->price())) {
+            take(level->price().raw_value(), level->total_quantity().raw_value());
+        }
+    }
+
+    if (taken > 0) {
+        const int64_t best = cached > 0 ? prices[0] : cost.worst_price.raw_value();
+        wide at_touch = static_cast<wide>(best) * taken;
+        cost.notional = static_cast<int64_t>(paid / Quantity::SCALE_FACTOR);
+        cost.impact = static_cast<int64_t>((side == Side::BUY ? paid - at_touch : at_touch - paid) /
+                                           Quantity::SCALE_FACTOR);
+        cost.average_price = Price(static_cast<int64_t>(paid / taken));
+    }
+    cost.filled = Quantity(taken);
+    cost.complete = taken == wanted;
+    return cost;
+}
+
+Quantity OrderBook::depth_within(Side side, uint32_t ticks) const {
+    std::span<const int64_t> prices = depth_.prices(side);
+    std::span<const int64_t> quantities = depth_.quantities(side);
+    const BookSide& levels = side_for(side);
+    const PriceLevel* best = prices.empty() ? levels.best() : nullptr;
+    if (prices.empty() && !best) {
+        return Quantity::ZERO;
+    }
+
+    // Worst price still in range, saturating far from the touch
+    const Price& tick_size = config_.use_price_ladder ? config_.tick_size : symbol_info_->tick_size;
+    int64_t reach = 0;
+    if (__builtin_mul_overflow(static_cast<int64_t>(ticks), std::max<int64_t>(1, tick_size.raw_value()), &reach)) {
+        reach = INT64_MAX;
+    }
+    const int64_t best_price = prices.empty() ? best->price().raw_value() : prices[0];
+    int64_t limit = 0;
+    if (side == Side::BUY ? __builtin_sub_overflow(best_price, reach, &limit)
+                          : __builtin_add_overflow(best_price, reach, &limit)) {
+        limit = side == Side::BUY ? INT64_MIN : INT64_MAX;
+    }
+
+    size_t within = core::simd::count_within(prices.data(), prices.size(), limit, side == Side::BUY);
+    int64_t total = core::simd::sum(quantities.data(), within);
+
+    // Every cached level is in range and there may be more behind them
+    if (within == prices.size() && depth_.is_full(side)) {
+        const PriceLevel* level = prices.empty() ? best : levels.next(Price(prices.back()));
+        for (; level && !levels.is_better(Price(limit), level->price()); level = levels.next(level->price())) {
+            total += level->total_quantity().raw_value();
+        }
+    }
+    return Quantity(total);
+}
+
 void OrderBook::clear() {
     bid_levels_.clear();
     ask_levels_.clear();
     orders_.clear();
+    pending_.clear();
+    stops_.clear();
+    pegs_.clear();
+    last_trade_price_.reset();
+    peg_bid_reference_.reset();
+    peg_ask_reference_.reset();
+    depth_.clear();
     total_bid_quantity_ = Quantity::ZERO;
     total_ask_quantity_ = Quantity::ZERO;
+    if (risk_gate_) {
+        risk_gate_->positions().clear_open(symbol_id_);
+    }
+}
+
+size_t OrderBook::snapshot_size() const {
+    size_t resting = 0;
+    for (const BookSide* book_side : {&bid_levels_, &ask_levels_}) {
+        book_side->for_each_level([&](const PriceLevel& level) {
+            resting += level.order_count();
+            return true;
+        });
+    }
+    
+    return sizeof(SnapshotHeader) +
+           (bid_levels_.level_count() + ask_levels_.level_count()) * sizeof(SnapshotLevel) +
+           (resting + pending_.size()) * sizeof(OrderRecord);
+}
+
+bool OrderBook::write_snapshot(std::span<std::byte> out, uint64_t journal_sequence) const {
+    if (out.size() < snapshot_size()) {
+        return false;
+    }
+    
+    // The header goes in last, once the order count is known
+    std::byte* cursor = out.data() + sizeof(SnapshotHeader);
+    auto put = [&](const auto& value) {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    };
+    
+    uint64_t order_count = 0;
+    for (const BookSide* book_side : {&bid_levels_, &ask_levels_}) {
+        book_side->for_each_level([&](const PriceLevel& level) {
+            put(SnapshotLevel{level.price(), level.total_quantity(), level.order_count()});
+            level.for_each_order([&](const Order& order) {
+                put(order.record());
+                return true;
+            });
+            order_count += level.order_count();
+            return true;
+        });
+    }
+    
+    // Pending orders follow, in the order they are to be queued again
+    uint64_t pending_count = 0;
+    auto put_pending = [&](OrderId id) {
+        if (const OrderPtr* order = pending_.find(id)) {
+            put((*order)->record());
+            ++pending_count;
+        }
+    };
+    stops_.for_each(put_pending);
+    pegs_.for_each_group([&](const PegKey&, const PegGroup& group) {
+        if (!group.price) {
+            for (const OrderPtr& order : group.orders) {
+                put_pending(order->id());
+            }
+        }
+    });
+    
+    SnapshotHeader header;
+    header.journal_sequence = journal_sequence;
+    header.symbol_id = symbol_id_;
+    header.bid_levels = bid_levels_.level_count();
+    header.ask_levels = ask_levels_.level_count();
+    header.order_count = order_count;
+    header.total_bid_quantity = total_bid_quantity_;
+    header.total_ask_quantity = total_ask_quantity_;
+    header.pending_count = pending_count;
+    if (last_trade_price_) {
+        header.flags |= SnapshotHeader::HAS_LAST_TRADE;
+        header.last_trade_price = *last_trade_price_;
+    }
+    std::memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+bool OrderBook::restore_snapshot(std::span<const std::byte> image, uint64_t* journal_sequence) {
+    clear();
+    
+    const std::byte* cursor = image.data();
+    const std::byte* end = image.data() + image.size();
+    auto take = [&](auto& value) {
+        if (static_cast<size_t>(end - cursor) < sizeof(value)) {
+            return false; // Truncated image
+        }
+        std::memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        return true;
+    };
+    
+    SnapshotHeader header;
+    if (!take(header) || !header.is_valid() || header.symbol_id != symbol_id_) {
+        return false;
+    }
+    orders_.reserve(header.order_count);
+    
+    // Levels arrive in priority order with their orders in FIFO order, so each
+    // order is linked at the back of its level
+    auto restore_side = [&](Side side, uint64_t level_count) {
+        BookSide& book_side = side_for(side);
+        for (uint64_t i = 0; i < level_count; ++i) {
+            SnapshotLevel snapshot_level;
+            if (!take(snapshot_level) || snapshot_level.order_count == 0) {
+                return false;
+            }
+            
+            PriceLevel* level = book_side.find_or_create(snapshot_level.price);
+            if (!level || !level->is_empty()) {
+                return false; // Unrepresentable or repeated price
+            }
+            
+            for (uint64_t j = 0; j < snapshot_level.order_count; ++j) {
+                OrderRecord record;
+                if (!take(record) || record.side() != side || record.price != snapshot_level.price) {
+                    return false;
+                }
+                OrderPtr order = order_pool_.create(record);
+                level->add_order(order);
+                if (order->is_pegged()) {
+                    pegs_.add(order).first->price = order->price();
+                }
+                orders_.insert_or_assign(record.id, std::move(order));
+            }
+            
+            if (level->total_quantity() != snapshot_level.total_quantity) {
+                return false;
+            }
+            total_for(side) = total_for(side) + level->total_quantity();
+        }
+        return true;
+    };
+    
+    // Pending stops go back into the stop book, parked pegs into their groups
+    auto restore_pending = [&]() {
+        for (uint64_t i = 0; i < header.pending_count; ++i) {
+            OrderRecord record;
+            if (!take(record)) {
+                return false;
+            }
+            OrderPtr order = order_pool_.create(record);
+            if (order->is_stop()) {
+                stops_.add(*order);
+            } else if (order->is_pegged()) {
+                pegs_.add(order);
+            } else {
+                return false;
+            }
+            pending_.insert_or_assign(record.id, std::move(order));
+        }
+        return pending_.size() == header.pending_count;
+    };
+    
+    bool restored = restore_side(Side::BUY, header.bid_levels) &&
+                    restore_side(Side::SELL, header.ask_levels) &&
+                    restore_pending() &&
+                    cursor == end &&
+                    orders_.size() == header.order_count &&
+                    total_bid_quantity_ == header.total_bid_quantity &&
+                    total_ask_quantity_ == header.total_ask_quantity;
+    if (!restored) {
+        clear();
+        return false;
+    }
+    
+    depth_.rebuild(bid_levels_);
+    depth_.rebuild(ask_levels_);
+    if (risk_gate_) {
+        auto reopen = [&](OrderId, const OrderPtr& order) { risk_gate_->on_accept(symbol_id_, *order); };
+        orders_.for_each(reopen);
+        pending_.for_each(reopen);
+    }
+    if (header.flags & SnapshotHeader::HAS_LAST_TRADE) {
+        last_trade_price_ = header.last_trade_price;
+    }
+    peg_bid_reference_ = reference_price(Side::BUY);
+    peg_ask_reference_ = reference_price(Side::SELL);
+    if (journal_sequence) {
+        *journal_sequence = header.journal_sequence;
+    }
+    return true;
 }
 
 std::string OrderBook::to_string() const {
     std::stringstream ss;
     
-    ss << "OrderBook[symbol=" << symbol_
+    ss << "OrderBook[symbol=" << symbol()
        << ", bids=" << bid_level_count()
        << ", asks=" << ask_level_count()
        << ", orders=" << order_count()
@@ -366,195 +1103,123 @@ std::string OrderBook::to_string() const {
     return ss.str();
 }
 
-std::vector<OrderMatch> OrderBook::match_market_order(OrderPtr order) {
-    std::vector<OrderMatch> matches;
+size_t OrderBook::cancel_side(Side side, const CancelFilter& filter) {
+    BookSide& book_side = side_for(side);
     
-    if (!order || order->type() != OrderType::MARKET) {
-        return matches;
-    }
-    
-    Side side = order->side();
-    Quantity remaining_qty = order->remaining_quantity();
-    
-    // Market orders execute against the opposite side
-    if (side == Side::BUY) {
-        // Buy order executes against asks
-        while (remaining_qty > Quantity::ZERO && !ask_levels_.empty()) {
-            auto it = ask_levels_.begin(); // Best (lowest) ask
-            PriceLevelPtr level = it->second;
-            
-            // Execute quantity at this level
-            auto executed = level->execute_quantity(remaining_qty);
-            
-            for (const auto& [maker, exec_qty] : executed) {
-                // Create match record
-                matches.push_back(create_match(maker, order, exec_qty));
-                
-                // Update remaining quantity
-                remaining_qty = remaining_qty - exec_qty;
-                
-                // Update total quantity
-                total_ask_quantity_ = total_ask_quantity_ - exec_qty;
-            }
-            
-            // Remove level if empty
-            if (level->is_empty()) {
-                ask_levels_.erase(it);
-            }
-            
-            // Stop if filled or IOC/FOK with partial fill
-            if (remaining_qty <= Quantity::ZERO || 
-                (order->time_in_force() == TimeInForce::FOK && remaining_qty < order->quantity())) {
-                break;
-            }
+    // Collect the levels in range first; levels are erased as they empty
+    std::vector<Price> prices;
+    book_side.for_each_level([&](const PriceLevel& level) {
+        if ((!filter.min_price || level.price() >= *filter.min_price) &&
+            (!filter.max_price || level.price() <= *filter.max_price)) {
+            prices.push_back(level.price());
         }
-    } else {
-        // Sell order executes against bids
-        while (remaining_qty > Quantity::ZERO && !bid_levels_.empty()) {
-            auto it = bid_levels_.begin(); // Best (highest) bid
-            PriceLevelPtr level = it->second;
-            
-            // Execute quantity at this level
-            auto executed = level->execute_quantity(remaining_qty);
-            
-            for (const auto& [maker, exec_qty] : executed) {
-                // Create match record
-                matches.push_back(create_match(maker, order, exec_qty));
-                
-                // Update remaining quantity
-                remaining_qty = remaining_qty - exec_qty;
-                
-                // Update total quantity
-                total_bid_quantity_ = total_bid_quantity_ - exec_qty;
-            }
-            
-            // Remove level if empty
-            if (level->is_empty()) {
-                bid_levels_.erase(it);
-            }
-            
-            // Stop if filled or IOC/FOK with partial fill
-            if (remaining_qty <= Quantity::ZERO || 
-                (order->time_in_force() == TimeInForce::FOK && remaining_qty < order->quantity())) {
-                break;
-            }
+        return true;
+    });
+    
+    size_t cancelled = 0;
+    for (Price price : prices) {
+        PriceLevel* level = book_side.find(price);
+        if (!level) {
+            continue;
         }
+        
+        // Unlink the selected orders; the rest keep their queue positions
+        Quantity before = level->total_quantity();
+        cancelled += level->remove_orders_if(
+            [&](const Order& order) { return !filter.owner || order.owner_id() == *filter.owner; },
+            [&](OrderPtr order) {
+                publish(MarketDataEventType::ORDER_DELETED, side, order->id(), INVALID_ORDER_ID,
+                        price, order->remaining_quantity());
+                release_exposure(*order);
+                order->cancel(now_);
+                orders_.erase(order->id());
+                if (order->is_pegged()) {
+                    pegs_.remove(*order);
+                }
+            });
+        
+        total_for(side) = total_for(side) - (before - level->total_quantity());
+        refresh_level(book_side, *level);
     }
+    pegs_.prune();
     
-    // Update order's executed quantity
-    order->execute(order->quantity() - remaining_qty);
+    return cancelled;
+}
+
+void OrderBook::match_market_order(Order& order, MatchSink& sink) {
+    if (order.type() != OrderType::MARKET) {
+        return;
+    }
     
-    // Handle FOK orders - if not fully matched, cancel all matches
-    if (order->time_in_force() == TimeInForce::FOK && remaining_qty > Quantity::ZERO) {
-        order->set_status(OrderStatus::CANCELLED);
-        return {}; // Return empty matches
+    // Market orders execute against the opposite side at any price
+    BookSide& opposite = side_for(order.side() == Side::BUY ? Side::SELL : Side::BUY);
+    match_against(opposite, order, std::nullopt, sink);
+}
+
+void OrderBook::match_limit_order(Order& order, MatchSink& sink) {
+    if (order.type() != OrderType::LIMIT && !order.is_pegged()) {
+        return;
     }
     
-    return matches;
+    // Limit (and pegged) orders execute against the opposite side up to their limit price
+    BookSide& opposite = side_for(order.side() == Side::BUY ? Side::SELL : Side::BUY);
+    match_against(opposite, order, order.price(), sink);
 }
 
-std::vector<OrderMatch> OrderBook::match_limit_order(OrderPtr order) {
-    std::vector<OrderMatch> matches;
+void OrderBook::match_against(BookSide& opposite, Order& order,
+                              std::optional<Price> limit_price, MatchSink& sink) {
+    TE_LATENCY_PROBE("orderbook.match");
+
+    Quantity remaining_qty = order.remaining_quantity();
     
-    if (!order || order->type() != OrderType::LIMIT) {
-        return matches;
+    // FOK orders that cannot fill completely are killed before touching the book
+    if (order.time_in_force() == TimeInForce::FOK &&
+        !can_fill(order.side(), remaining_qty, limit_price)) {
+        order.set_status(OrderStatus::CANCELLED, now_);
+        return;
     }
     
-    Side side = order->side();
-    Price limit_price = order->price();
-    Quantity remaining_qty = order->remaining_quantity();
-    
-    // Limit orders execute against the opposite side up to their limit price
-    if (side == Side::BUY) {
-        // Buy order executes against asks with price <= limit_price
-        while (remaining_qty > Quantity::ZERO && !ask_levels_.empty()) {
-            auto it = ask_levels_.begin(); // Best (lowest) ask
-            
-            // If the best ask price is higher than our limit, we're done matching
-            if (it->first > limit_price) {
-                break;
-            }
-            
-            PriceLevelPtr level = it->second;
-            
-            // Execute quantity at this level
-            auto executed = level->execute_quantity(remaining_qty);
-            
-            for (const auto& [maker, exec_qty] : executed) {
-                // Create match record
-                matches.push_back(create_match(maker, order, exec_qty));
-                
-                // Update remaining quantity
-                remaining_qty = remaining_qty - exec_qty;
-                
-                // Update total quantity
-                total_ask_quantity_ = total_ask_quantity_ - exec_qty;
-            }
-            
-            // Remove level if empty
-            if (level->is_empty()) {
-                ask_levels_.erase(it);
-            }
-            
-            // Stop if filled or IOC/FOK with partial fill
-            if (remaining_qty <= Quantity::ZERO || 
-                (order->time_in_force() == TimeInForce::FOK && remaining_qty < order->quantity())) {
-                break;
-            }
+    Quantity& opposite_total = total_for(opposite.side());
+    
+    while (remaining_qty > Quantity::ZERO) {
+        PriceLevel* level = opposite.best(); // Best (highest bid / lowest ask)
+        if (!level) {
+            break;
         }
-    } else {
-        // Sell order executes against bids with price >= limit_price
-        while (remaining_qty > Quantity::ZERO && !bid_levels_.empty()) {
-            auto it = bid_levels_.begin(); // Best (highest) bid
-            
-            // If the best bid price is lower than our limit, we're done matching
-            if (it->first < limit_price) {
-                break;
-            }
-            
-            PriceLevelPtr level = it->second;
-            
-            // Execute quantity at this level
-            auto executed = level->execute_quantity(remaining_qty);
-            
-            for (const auto& [maker, exec_qty] : executed) {
-                // Create match record
-                matches.push_back(create_match(maker, order, exec_qty));
-                
-                // Update remaining quantity
-                remaining_qty = remaining_qty - exec_qty;
-                
-                // Update total quantity
-                total_bid_quantity_ = total_bid_quantity_ - exec_qty;
-            }
-            
-            // Remove level if empty
-            if (level->is_empty()) {
-                bid_levels_.erase(it);
-            }
+        
+        // If the best opposite price is worse than our limit, we're done matching
+        if (limit_price && opposite.is_better(*limit_price, level->price())) {
+            break;
+        }
+        
+        // Execute quantity at this level, reporting each fill as it happens
+        Quantity executed = level->execute_quantity(remaining_qty, now_, [&](const OrderPtr& maker, Quantity exec_qty) {
+            sink.on_match(create_match(*maker, order, exec_qty));
             
-            // Stop if filled or IOC/FOK with partial fill
-            if (remaining_qty <= Quantity::ZERO || 
-                (order->time_in_force() == TimeInForce::FOK && remaining_qty < order->quantity())) {
-                break;
+            // A filled maker leaves the id index now; the level unlinks it
+            // right after, which drops the book's last reference to it
+            if (maker->is_filled()) {
+                orders_.erase(maker->id());
+                if (maker->is_pegged()) {
+                    pegs_.remove(*maker);
+                }
             }
-        }
-    }
-    
-    // Update order's executed quantity
-    order->execute(order->quantity() - remaining_qty);
-    
-    // Handle FOK orders - if not fully matched, cancel all matches
-    if (order->time_in_force() == TimeInForce::FOK && remaining_qty > Quantity::ZERO) {
-        order->set_status(OrderStatus::CANCELLED);
-        return {}; // Return empty matches
+        });
+        
+        // Update remaining quantity and the side total
+        remaining_qty = remaining_qty - executed;
+        opposite_total = opposite_total - executed;
+        
+        // Remove level if empty, refreshing depth either way
+        refresh_level(opposite, *level);
     }
     
-    return matches;
+    // Update order's executed quantity (a re-priced order may already be part filled)
+    order.execute(order.remaining_quantity() - remaining_qty, now_);
 }
 
 void OrderBook::add_limit_order_to_book(OrderPtr order) {
-    if (!order || order->type() != OrderType::LIMIT || order->is_filled()) {
+    if (!order || (order->type() != OrderType::LIMIT && !order->is_pegged()) || order->is_filled()) {
         return;
     }
     
@@ -563,60 +1228,92 @@ void OrderBook::add_limit_order_to_book(OrderPtr order) {
     Price price = order->price();
     
     // Find or create the price level
-    PriceLevelPtr level;
-    
-    if (side == Side::BUY) {
-        auto it = bid_levels_.find(price);
-        if (it == bid_levels_.end()) {
-            level = std::make_shared<PriceLevel>(price);
-            bid_levels_[price] = level;
-        } else {
-            level = it->second;
-        }
-        
-        // Update total quantity
-        total_bid_quantity_ = total_bid_quantity_ + order->remaining_quantity();
-    } else {
-        auto it = ask_levels_.find(price);
-        if (it == ask_levels_.end()) {
-            level = std::make_shared<PriceLevel>(price);
-            ask_levels_[price] = level;
-        } else {
-            level = it->second;
-        }
-        
-        // Update total quantity
-        total_ask_quantity_ = total_ask_quantity_ + order->remaining_quantity();
+    PriceLevel* level = side_for(side).find_or_create(price);
+    if (!level) {
+        release_exposure(*order);
+        return; // Price not representable on this side
     }
     
+    // Update total quantity
+    total_for(side) = total_for(side) + order->remaining_quantity();
+    
     // Add the order to the level
     level->add_order(order);
+    publish(MarketDataEventType::ORDER_ADDED, side, order->id(), INVALID_ORDER_ID,
+            price, order->remaining_quantity());
+    update_depth(side, *level);
     
     // Add to orders map
-    orders_[order->id()] = order;
+    orders_.insert_or_assign(order->id(), order);
 }
 
 void OrderBook::remove_price_level_if_empty(Price price, Side side) {
-    if (side == Side::BUY) {
-        auto it = bid_levels_.find(price);
-        if (it != bid_levels_.end() && it->second->is_empty()) {
-            bid_levels_.erase(it);
-        }
+    BookSide& book_side = side_for(side);
+    PriceLevel* level = book_side.find(price);
+    if (level) {
+        refresh_level(book_side, *level);
+    }
+}
+
+void OrderBook::refresh_level(BookSide& book_side, PriceLevel& level) {
+    if (level.is_empty()) {
+        Price price = level.price();
+        book_side.erase(price);
+        depth_.remove_level(book_side.side(), price, book_side);
+        publish(MarketDataEventType::LEVEL_CHANGED, book_side.side(), INVALID_ORDER_ID, INVALID_ORDER_ID,
+                price, Quantity::ZERO);
     } else {
-        auto it = ask_levels_.find(price);
-        if (it != ask_levels_.end() && it->second->is_empty()) {
-            ask_levels_.erase(it);
-        }
+        update_depth(book_side.side(), level);
     }
 }
 
-OrderMatch OrderBook::create_match(OrderPtr maker, OrderPtr taker, Quantity match_qty) {
-    using core::TE_LOG_DEBUG;
-    
+void OrderBook::update_depth(Side side, const PriceLevel& level) {
+    depth_.update_level(side, level.price(), level.total_quantity(),
+                        static_cast<uint32_t>(level.order_count()));
+    publish(MarketDataEventType::LEVEL_CHANGED, side, INVALID_ORDER_ID, INVALID_ORDER_ID,
+            level.price(), level.total_quantity());
+}
+
+void OrderBook::publish_event(MarketDataEventType type, Side side, OrderId order_id, OrderId match_id,
+                              Price price, Quantity quantity) {
+    uint64_t sequence = ++market_data_sequence_;
+    auto fill = [&](MarketDataEvent& event) {
+        event.sequence = sequence;
+        event.timestamp = now_;
+        event.order_id = order_id;
+        event.match_id = match_id;
+        event.price = price;
+        event.quantity = quantity;
+        event.symbol_id = symbol_id_;
+        event.type = type;
+        event.side = side;
+        event.reserved = 0;
+    };
+
+    if (market_data_bus_) {
+        market_data_bus_->publish_with(fill);
+    }
+    if (market_data_ && !market_data_->try_push_with(fill)) {
+        ++market_data_dropped_; // Consumers see the gap in sequence numbers
+    }
+}
+
+void OrderBook::release_exposure(const Order& order) {
+    if (risk_gate_ && !order.is_filled()) {
+        risk_gate_->on_release(symbol_id_, order);
+    }
+}
+
+OrderMatch OrderBook::create_match(const Order& maker, const Order& taker, Quantity match_qty) {
     // Create match record
-    OrderMatch match(maker->id(), taker->id(), maker->price(), match_qty);
+    OrderMatch match(maker.id(), taker.id(), maker.price(), match_qty, now_);
+    last_trade_price_ = maker.price();
+    if (risk_gate_) {
+        risk_gate_->on_fill(symbol_id_, maker, taker, maker.price(), match_qty);
+    }
+    publish(MarketDataEventType::TRADE, maker.side(), maker.id(), taker.id(), maker.price(), match_qty);
     
-    // Log the match
+    // Log the match (to_string() only runs when debug output is on)
     TE_LOG_DEBUG("Match: %s", match.to_string().c_str());
     
     return match;
@@ -0,0 +1,61 @@
+#include "orderbook/order_index.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace trading_engine {
+namespace orderbook {
+
+OrderIndex::OrderIndex(size_t capacity) {
+    size_t slots = slots_for(capacity);
+    keys_.assign(slots, INVALID_ORDER_ID);
+    orders_.resize(slots);
+    mask_ = slots - 1;
+}
+
+void OrderIndex::clear() {
+    std::fill(keys_.begin(), keys_.end(), INVALID_ORDER_ID);
+    for (auto& order : orders_) {
+        order.reset();
+    }
+    size_ = 0;
+}
+
+void OrderIndex::reserve(size_t count) {
+    size_t slots = slots_for(count);
+    if (slots > keys_.size()) {
+        rehash(slots);
+    }
+}
+
+void OrderIndex::grow() {
+    ++growth_count_;
+    rehash(keys_.size() * 2);
+}
+
+void OrderIndex::rehash(size_t slots) {
+    std::vector<OrderId> old_keys(slots, INVALID_ORDER_ID);
+    std::vector<OrderPtr> old_orders(slots);
+    old_keys.swap(keys_);
+    old_orders.swap(orders_);
+    mask_ = slots - 1;
+
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] == INVALID_ORDER_ID) {
+            continue;
+        }
+        size_t slot = home(old_keys[i]);
+        while (keys_[slot] != INVALID_ORDER_ID) {
+            slot = (slot + 1) & mask_;
+        }
+        keys_[slot] = old_keys[i];
+        orders_[slot] = std::move(old_orders[i]);
+    }
+}
+
+size_t OrderIndex::slots_for(size_t capacity) {
+    size_t needed = std::max<size_t>(capacity, 8) * 100 / MAX_LOAD_PERCENT;
+    return std::bit_ceil(needed);
+}
+
+} // namespace orderbook
+} // namespace trading_engine
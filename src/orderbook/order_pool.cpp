@@ -0,0 +1,104 @@
+#include "orderbook/order_pool.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+namespace detail {
+
+namespace {
+
+// Room for the shared_ptr control block and allocator next to the Order
+constexpr size_t CONTROL_BLOCK_ALLOWANCE = 48;
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+OrderSlab::OrderSlab(size_t capacity, size_t block_size)
+    : capacity_(capacity),
+      block_size_(round_up(block_size, BLOCK_ALIGNMENT)),
+      storage_(nullptr),
+      free_list_(nullptr),
+      refs_(1),
+      in_use_(0),
+      heap_fallbacks_(0) {
+    if (capacity_ == 0) {
+        return;
+    }
+
+    storage_ = static_cast<std::byte*>(
+        ::operator new(capacity_ * block_size_, std::align_val_t(BLOCK_ALIGNMENT)));
+
+    // Thread every block onto the free list, lowest address first
+    FreeBlock* head = nullptr;
+    for (size_t i = capacity_; i-- > 0;) {
+        auto block = reinterpret_cast<FreeBlock*>(storage_ + i * block_size_);
+        block->next = head;
+        head = block;
+    }
+    free_list_.store(head, std::memory_order_relaxed);
+}
+
+OrderSlab::~OrderSlab() {
+    if (storage_) {
+        ::operator delete(storage_, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+}
+
+void* OrderSlab::allocate(size_t bytes, size_t alignment) {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+
+    if (bytes <= block_size_ && alignment <= BLOCK_ALIGNMENT) {
+        // Pop a block (only the owning thread pops, so this is ABA-free)
+        FreeBlock* head = free_list_.load(std::memory_order_acquire);
+        while (head && !free_list_.compare_exchange_weak(
+                           head, head->next,
+                           std::memory_order_acquire, std::memory_order_acquire)) {
+        }
+
+        if (head) {
+            in_use_.fetch_add(1, std::memory_order_relaxed);
+            return head;
+        }
+    }
+
+    // Slab exhausted or request too large
+    heap_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+void OrderSlab::deallocate(void* ptr, size_t bytes, size_t alignment) noexcept {
+    if (owns(ptr)) {
+        // Push the block back
+        auto block = static_cast<FreeBlock*>(ptr);
+        block->next = free_list_.load(std::memory_order_relaxed);
+        while (!free_list_.compare_exchange_weak(
+                   block->next, block,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        ::operator delete(ptr, bytes, std::align_val_t(alignment));
+    }
+
+    drop_ref();
+}
+
+void OrderSlab::release() noexcept {
+    drop_ref();
+}
+
+} // namespace detail
+
+OrderPool::OrderPool(size_t capacity)
+    : slab_(new detail::OrderSlab(capacity, sizeof(Order) + detail::CONTROL_BLOCK_ALLOWANCE)) {
+}
+
+OrderPool::~OrderPool() {
+    slab_->release();
+}
+
+} // namespace orderbook
+} // namespace trading_engine
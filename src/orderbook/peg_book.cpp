@@ -0,0 +1,46 @@
+#include "orderbook/peg_book.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace orderbook {
+
+std::pair<PegGroup*, bool> PegBook::add(OrderPtr order) {
+    auto [it, inserted] = groups_.try_emplace(key_for(*order));
+    it->second.orders.push_back(std::move(order));
+    return {&it->second, inserted};
+}
+
+bool PegBook::remove(const Order& order) {
+    PegGroup* group = find(key_for(order));
+    if (!group) {
+        return false;
+    }
+    
+    auto it = std::find_if(group->orders.begin(), group->orders.end(),
+                           [&](const OrderPtr& grouped) { return grouped.get() == &order; });
+    if (it == group->orders.end()) {
+        return false;
+    }
+    group->orders.erase(it);
+    return true;
+}
+
+PegGroup* PegBook::find(const PegKey& key) {
+    auto it = groups_.find(key);
+    return it == groups_.end() ? nullptr : &it->second;
+}
+
+void PegBook::prune() {
+    std::erase_if(groups_, [](const auto& entry) { return entry.second.orders.empty(); });
+}
+
+size_t PegBook::order_count() const {
+    size_t count = 0;
+    for (const auto& [key, group] : groups_) {
+        count += group.orders.size();
+    }
+    return count;
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,114 @@
+#include "orderbook/position_book.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace orderbook {
+
+void Position::apply_fill(Side side, Price price, Quantity quantity) {
+    int64_t remaining = side == Side::BUY ? quantity.raw_value() : -quantity.raw_value();
+    int64_t held = net.raw_value();
+
+    if (side == Side::BUY) {
+        bought = bought + quantity;
+    } else {
+        sold = sold + quantity;
+    }
+    ++fill_count;
+
+    // Close against the open position first, at its average cost
+    if (held != 0 && (held > 0) != (remaining > 0)) {
+        int64_t closing = std::min(held > 0 ? held : -held, remaining > 0 ? remaining : -remaining);
+        int64_t closing_signed = held > 0 ? -closing : closing;
+
+        __extension__ using wide = __int128;
+        int64_t closed_cost = static_cast<int64_t>(static_cast<wide>(cost) * closing / (held > 0 ? held : -held));
+        realized_pnl += -notional(price, Quantity(closing_signed)) - closed_cost;
+        cost -= closed_cost;
+        held += closing_signed;
+        remaining -= closing_signed;
+        if (held == 0) {
+            cost = 0; // Drop rounding residue once flat
+        }
+    }
+
+    // Anything left opens (or adds to) a position in the fill's direction
+    if (remaining != 0) {
+        cost += notional(price, Quantity(remaining));
+        held += remaining;
+    }
+    net = Quantity(held);
+}
+
+Price Position::average_price() const {
+    if (net.is_zero()) {
+        return Price();
+    }
+    __extension__ using wide = __int128;
+    return Price(static_cast<int64_t>(static_cast<wide>(cost) * Quantity::SCALE_FACTOR / net.raw_value()));
+}
+
+PositionBook::PositionBook(size_t accounts, size_t symbols)
+    : accounts_(accounts),
+      symbols_(symbols),
+      positions_(accounts * symbols) {
+}
+
+bool PositionBook::on_fill(OwnerId owner, SymbolId symbol_id, Side side, Price price, Quantity quantity) {
+    Position* position = find(owner, symbol_id);
+    if (!position) {
+        return false;
+    }
+    position->apply_fill(side, price, quantity);
+    return true;
+}
+
+bool PositionBook::add_open(OwnerId owner, SymbolId symbol_id, Side side, Quantity quantity) {
+    Position* position = find(owner, symbol_id);
+    if (!position) {
+        return false;
+    }
+    Quantity& open = side == Side::BUY ? position->open_buy : position->open_sell;
+    open = open + quantity;
+    return true;
+}
+
+bool PositionBook::release_open(OwnerId owner, SymbolId symbol_id, Side side, Quantity quantity) {
+    Position* position = find(owner, symbol_id);
+    if (!position) {
+        return false;
+    }
+    Quantity& open = side == Side::BUY ? position->open_buy : position->open_sell;
+    open = quantity < open ? open - quantity : Quantity::ZERO;
+    return true;
+}
+
+void PositionBook::clear_open(SymbolId symbol_id) {
+    if (symbol_id >= symbols_) {
+        return;
+    }
+    for (size_t owner = 0; owner < accounts_; ++owner) {
+        Position& position = positions_[index(static_cast<OwnerId>(owner), symbol_id)];
+        position.open_buy = Quantity::ZERO;
+        position.open_sell = Quantity::ZERO;
+    }
+}
+
+int64_t PositionBook::realized_pnl(OwnerId owner) const {
+    if (owner >= accounts_) {
+        return 0;
+    }
+    int64_t total = 0;
+    for (size_t symbol = 0; symbol < symbols_; ++symbol) {
+        total += positions_[index(owner, static_cast<SymbolId>(symbol))].realized_pnl;
+    }
+    return total;
+}
+
+void PositionBook::clear() {
+    for (auto& position : positions_) {
+        position = Position{};
+    }
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,275 @@
+#include "orderbook/price_ladder.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace trading_engine {
+namespace orderbook {
+
+namespace {
+
+// Round a slot count up to a whole number of bitmap words
+size_t round_to_words(size_t ticks) {
+    return std::max<size_t>(64, (ticks + 63) & ~static_cast<size_t>(63));
+}
+
+// Raw price minus the window base; false if it doesn't fit in int64
+bool offset_of(int64_t raw, int64_t base, int64_t& offset) {
+    return !__builtin_sub_overflow(raw, base, &offset);
+}
+
+} // namespace
+
+PriceLadder::PriceLadder(Side side, Price tick_size, size_t ticks, size_t max_ticks)
+    : side_(side),
+      tick_(tick_size.raw_value() > 0 ? tick_size.raw_value() : 1),
+      base_(0),
+      max_ticks_(round_to_words(std::max(ticks, max_ticks))),
+      count_(0),
+      best_(NPOS) {
+    if (__builtin_mul_overflow(static_cast<int64_t>(max_ticks_) + 1, tick_, &reach_)) {
+        reach_ = std::numeric_limits<int64_t>::max();
+    }
+    rebuild(0, round_to_words(ticks));
+}
+
+bool PriceLadder::accepts(Price price) const {
+    if (!is_on_tick(price)) {
+        return false;
+    }
+
+    // Every window built around the price stays inside int64, so the offset
+    // and slot price arithmetic below can't overflow
+    int64_t raw = price.raw_value();
+    int64_t edge;
+    if (__builtin_sub_overflow(raw, reach_, &edge) || __builtin_add_overflow(raw, reach_, &edge)) {
+        return false;
+    }
+    if (count_ == 0 || index_of(price) != NPOS) {
+        return true; // Fits the current window, or recentering alone makes it fit
+    }
+
+    // Occupied span including the price; unsigned so extreme prices can't overflow
+    uint64_t low = static_cast<uint64_t>(std::min(price_at(scan_up(0)).raw_value(), price.raw_value()));
+    uint64_t high = static_cast<uint64_t>(std::max(price_at(scan_down(slots_.size() - 1)).raw_value(),
+                                                   price.raw_value()));
+    return (high - low) / static_cast<uint64_t>(tick_) < max_ticks_;
+}
+
+PriceLevel* PriceLadder::find(Price price) {
+    size_t index = index_of(price);
+    if (index == NPOS || !is_occupied(index)) {
+        return nullptr;
+    }
+    return &slots_[index];
+}
+
+const PriceLevel* PriceLadder::find(Price price) const {
+    size_t index = index_of(price);
+    if (index == NPOS || !is_occupied(index)) {
+        return nullptr;
+    }
+    return &slots_[index];
+}
+
+PriceLevel* PriceLadder::find_or_create(Price price) {
+    if (!accepts(price)) {
+        return nullptr; // Not representable on this ladder
+    }
+
+    size_t index = index_of(price);
+    if (index == NPOS) {
+        // Price drifted out of the window
+        recenter(price);
+        index = index_of(price);
+    }
+
+    if (!is_occupied(index)) {
+        set_occupied(index);
+        ++count_;
+
+        // Update best price tracking
+        if (best_ == NPOS ||
+            (side_ == Side::BUY ? index > best_ : index < best_)) {
+            best_ = index;
+        }
+    }
+
+    return &slots_[index];
+}
+
+void PriceLadder::erase(Price price) {
+    size_t index = index_of(price);
+    if (index == NPOS || !is_occupied(index)) {
+        return;
+    }
+
+    // Reset the slot to an empty level
+    slots_[index] = PriceLevel(price);
+    clear_occupied(index);
+    --count_;
+
+    // Find the new best level if we removed the current one
+    if (index == best_) {
+        best_ = count_ == 0 ? NPOS : next_occupied(index);
+    }
+}
+
+PriceLevel* PriceLadder::best() {
+    return best_ == NPOS ? nullptr : &slots_[best_];
+}
+
+const PriceLevel* PriceLadder::best() const {
+    return best_ == NPOS ? nullptr : &slots_[best_];
+}
+
+const PriceLevel* PriceLadder::next(Price price) const {
+    if (count_ == 0) {
+        return nullptr;
+    }
+
+    // Clamp prices outside the window so the scan still starts at the right
+    // place; an offset beyond int64 saturates, which clamps the same way
+    int64_t offset;
+    if (!offset_of(price.raw_value(), base_, offset)) {
+        offset = price.raw_value() < base_ ? std::numeric_limits<int64_t>::min()
+                                           : std::numeric_limits<int64_t>::max();
+    }
+    int64_t last = static_cast<int64_t>(slots_.size()) - 1;
+    size_t index;
+    if (side_ == Side::BUY) {
+        // Next lower price
+        if (offset <= 0) {
+            return nullptr;
+        }
+        int64_t from = (offset - 1) / tick_;
+        index = scan_down(static_cast<size_t>(std::min(from, last)));
+    } else {
+        // Next higher price
+        if (offset < 0) {
+            index = scan_up(0);
+        } else {
+            int64_t from = offset / tick_ + 1;
+            if (from > last) {
+                return nullptr;
+            }
+            index = scan_up(static_cast<size_t>(from));
+        }
+    }
+
+    return index == NPOS ? nullptr : &slots_[index];
+}
+
+void PriceLadder::clear() {
+    for (size_t i = best_; i != NPOS; i = next_occupied(i)) {
+        slots_[i] = PriceLevel(price_at(i));
+    }
+    std::fill(occupied_.begin(), occupied_.end(), 0);
+    count_ = 0;
+    best_ = NPOS;
+}
+
+size_t PriceLadder::index_of(Price price) const {
+    int64_t offset;
+    if (!offset_of(price.raw_value(), base_, offset) || offset < 0 || offset % tick_ != 0) {
+        return NPOS;
+    }
+
+    size_t index = static_cast<size_t>(offset / tick_);
+    return index < slots_.size() ? index : NPOS;
+}
+
+void PriceLadder::recenter(Price price) {
+    // Only called for prices accepts() passed, so raw +/- reach_ is representable
+    int64_t raw = price.raw_value();
+
+    if (count_ == 0) {
+        // Nothing to move, just put the price in the middle of the window
+        int64_t half = static_cast<int64_t>(slots_.size() / 2);
+        rebuild(raw - half * tick_, slots_.size());
+        return;
+    }
+
+    // Occupied range, extended to include the new price
+    size_t low_index = scan_up(0);
+    size_t high_index = scan_down(slots_.size() - 1);
+    int64_t low = std::min(price_at(low_index).raw_value(), raw);
+    int64_t high = std::max(price_at(high_index).raw_value(), raw);
+    size_t span = static_cast<size_t>((high - low) / tick_) + 1;
+
+    // Grow until the span fits with room to spare on both sides, up to the
+    // cap (accepts() has already checked that the span itself fits)
+    size_t capacity = slots_.size();
+    while (span * 2 > capacity && capacity < max_ticks_) {
+        capacity = std::min(capacity * 2, max_ticks_);
+    }
+
+    int64_t margin = static_cast<int64_t>((capacity - span) / 2);
+    rebuild(low - margin * tick_, capacity);
+}
+
+void PriceLadder::rebuild(int64_t new_base, size_t new_capacity) {
+    std::vector<PriceLevel> slots;
+    slots.reserve(new_capacity);
+    for (size_t i = 0; i < new_capacity; ++i) {
+        slots.emplace_back(Price(new_base + static_cast<int64_t>(i) * tick_));
+    }
+
+    std::vector<uint64_t> occupied(new_capacity / 64, 0);
+    size_t best = NPOS;
+
+    // Move the occupied levels into their new slots
+    for (size_t i = best_; i != NPOS; i = next_occupied(i)) {
+        size_t index = static_cast<size_t>((price_at(i).raw_value() - new_base) / tick_);
+        slots[index] = std::move(slots_[i]);
+        occupied[index >> 6] |= uint64_t(1) << (index & 63);
+        if (best == NPOS) {
+            best = index; // Iteration starts at the best level
+        }
+    }
+
+    slots_ = std::move(slots);
+    occupied_ = std::move(occupied);
+    base_ = new_base;
+    best_ = best;
+}
+
+size_t PriceLadder::scan_up(size_t from) const {
+    if (from >= slots_.size()) {
+        return NPOS;
+    }
+
+    size_t word = from >> 6;
+    uint64_t bits = occupied_[word] & (~uint64_t(0) << (from & 63));
+    while (true) {
+        if (bits != 0) {
+            return (word << 6) + static_cast<size_t>(std::countr_zero(bits));
+        }
+        if (++word == occupied_.size()) {
+            return NPOS;
+        }
+        bits = occupied_[word];
+    }
+}
+
+size_t PriceLadder::scan_down(size_t from) const {
+    if (from >= slots_.size()) {
+        from = slots_.size() - 1;
+    }
+
+    size_t word = from >> 6;
+    unsigned shift = 63 - static_cast<unsigned>(from & 63);
+    uint64_t bits = occupied_[word] & (~uint64_t(0) >> shift);
+    while (true) {
+        if (bits != 0) {
+            return (word << 6) + 63 - static_cast<size_t>(std::countl_zero(bits));
+        }
+        if (word == 0) {
+            return NPOS;
+        }
+        bits = occupied_[--word];
+    }
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -6,144 +6,245 @@ namespace trading_engine {
 namespace orderbook {
 
 PriceLevel::PriceLevel(Price price)
-    : price_(price), total_quantity_(Quantity::ZERO) {
+    : price_(price), total_quantity_(Quantity::ZERO), tail_(nullptr), order_count_(0) {
+}
+
+PriceLevel::~PriceLevel() {
+    release_all();
+}
+
+PriceLevel::PriceLevel(PriceLevel&& other) noexcept
+    : price_(other.price_),
+      total_quantity_(other.total_quantity_),
+      head_(std::move(other.head_)),
+      tail_(other.tail_),
+      order_count_(other.order_count_),
+      pegged_count_(other.pegged_count_) {
+    other.tail_ = nullptr;
+    other.order_count_ = 0;
+    other.pegged_count_ = 0;
+    other.total_quantity_ = Quantity::ZERO;
+    adopt_orders();
+}
+
+PriceLevel& PriceLevel::operator=(PriceLevel&& other) noexcept {
+    if (this != &other) {
+        release_all();
+
+        price_ = other.price_;
+        total_quantity_ = other.total_quantity_;
+        head_ = std::move(other.head_);
+        tail_ = other.tail_;
+        order_count_ = other.order_count_;
+        pegged_count_ = other.pegged_count_;
+
+        other.tail_ = nullptr;
+        other.order_count_ = 0;
+        other.pegged_count_ = 0;
+        other.total_quantity_ = Quantity::ZERO;
+        adopt_orders();
+    }
+    return *this;
 }
 
 void PriceLevel::add_order(OrderPtr order) {
-    if (!order || order->price() != price_) {
-        return; // Invalid order or price mismatch
+    if (!order || order->price() != price_ || order->is_resting()) {
+        return; // Invalid order, price mismatch or already queued
     }
-    
-    // Add to FIFO queue
-    orders_.push_back(order);
-    
-    // Store iterator for quick lookup
-    order_map_[order->id()] = std::prev(orders_.end());
-    
+
     // Update total quantity
     total_quantity_ = total_quantity_ + order->remaining_quantity();
+
+    // Link at the back of the FIFO queue
+    link_back(std::move(order));
 }
 
 bool PriceLevel::remove_order(OrderId order_id) {
-    auto it = order_map_.find(order_id);
-    if (it == order_map_.end()) {
+    Order* order = find(order_id);
+    if (!order) {
         return false; // Order not found
     }
-    
+
+    return remove_order(*order);
+}
+
+bool PriceLevel::remove_order(Order& order) {
+    if (order.level_ != this) {
+        return false; // Not queued here
+    }
+
     // Update total quantity
-    OrderPtr order = *(it->second);
-    total_quantity_ = total_quantity_ - order->remaining_quantity();
-    
-    // Remove from FIFO queue and map
-    orders_.erase(it->second);
-    order_map_.erase(it);
-    
+    total_quantity_ = total_quantity_ - order.remaining_quantity();
+
+    // Unlink from the FIFO queue
+    unlink(order);
+
     return true;
 }
 
 bool PriceLevel::modify_order_quantity(OrderId order_id, Quantity new_quantity) {
-    auto it = order_map_.find(order_id);
-    if (it == order_map_.end()) {
+    Order* order = find(order_id);
+    if (!order) {
         return false; // Order not found
     }
-    
-    OrderPtr order = *(it->second);
-    
+
+    return modify_order_quantity(*order, new_quantity);
+}
+
+bool PriceLevel::modify_order_quantity(Order& order, Quantity new_quantity) {
+    if (order.level_ != this) {
+        return false; // Not queued here
+    }
+
     // Calculate the difference in quantity
-    Quantity old_remaining = order->remaining_quantity();
-    
+    Quantity old_remaining = order.remaining_quantity();
+
     // Ensure new quantity isn't less than already executed
-    if (new_quantity < order->executed_quantity()) {
+    if (new_quantity < order.executed_quantity()) {
         return false; // Invalid quantity change
     }
-    
+
     // Update the order
-    order->set_quantity(new_quantity);
-    
+    order.set_quantity(new_quantity);
+
     // Update total quantity for this level
-    Quantity new_remaining = order->remaining_quantity();
+    Quantity new_remaining = order.remaining_quantity();
     total_quantity_ = total_quantity_ - old_remaining + new_remaining;
-    
+
     return true;
 }
 
-OrderPtr PriceLevel::get_first_order() const {
-    if (orders_.empty()) {
-        return nullptr;
+bool PriceLevel::requeue_order(Order& order) {
+    if (order.level_ != this) {
+        return false; // Not queued here
+    }
+    if (tail_ == &order) {
+        return true; // Already last
     }
-    return orders_.front();
+
+    // Relink the same node at the back; the total is unchanged
+    link_back(unlink(order));
+
+    return true;
+}
+
+OrderPtr PriceLevel::get_first_order() const {
+    return head_;
 }
 
 OrderPtr PriceLevel::get_order(OrderId order_id) const {
-    auto it = order_map_.find(order_id);
-    if (it == order_map_.end()) {
+    Order* order = find(order_id);
+    if (!order) {
         return nullptr;  // Order not found
     }
-    return *(it->second);
+
+    // The owning reference lives in the previous node (or the head)
+    return order->prev_ ? order->prev_->next_ : head_;
 }
 
 std::vector<std::pair<OrderPtr, Quantity>> PriceLevel::execute_quantity(Quantity quantity) {
     std::vector<std::pair<OrderPtr, Quantity>> executed_orders;
     
-    if (orders_.empty() || quantity <= Quantity::ZERO) {
+    if (!head_ || quantity <= Quantity::ZERO) {
         return executed_orders;
     }
     
-    Quantity remaining_qty = quantity;
-    
-    // Process orders FIFO until we've executed the requested quantity
-    // or run out of orders at this level
-    while (!orders_.empty() && remaining_qty > Quantity::ZERO) {
-        OrderPtr order = orders_.front();
-        
-        // Determine how much of this order to execute
-        Quantity order_remaining = order->remaining_quantity();
-        Quantity exec_qty = (remaining_qty < order_remaining) ? remaining_qty : order_remaining;
-        
-        if (exec_qty > Quantity::ZERO) {
-            // Execute the order
-            order->execute(exec_qty);
-            
-            // Add to executed orders list
-            executed_orders.push_back(std::make_pair(order, exec_qty));
-            
-            // Update total quantity at this level
-            total_quantity_ = total_quantity_ - exec_qty;
-            
-            // Update remaining qty to execute
-            remaining_qty = remaining_qty - exec_qty;
-        }
-        
-        // If order is fully executed, remove it
-        if (order->is_filled()) {
-            order_map_.erase(order->id());
-            orders_.pop_front();
-        }
-    }
+    // Add each fill to the executed orders list
+    execute_quantity(quantity, current_timestamp(), [&](const OrderPtr& order, Quantity exec_qty) {
+        executed_orders.emplace_back(order, exec_qty);
+    });
     
     return executed_orders;
 }
 
 std::vector<OrderPtr> PriceLevel::get_all_orders() const {
     std::vector<OrderPtr> result;
-    result.reserve(orders_.size());
-    
+    result.reserve(order_count_);
+
     // Copy all orders preserving FIFO order
-    for (const auto& order : orders_) {
-        result.push_back(order);
+    for (const OrderPtr* link = &head_; *link; link = &(*link)->next_) {
+        result.push_back(*link);
     }
-    
+
     return result;
 }
 
 std::string PriceLevel::to_string() const {
     std::stringstream ss;
     ss << "PriceLevel[price=" << price_.to_string()
-       << ", orders=" << orders_.size()
+       << ", orders=" << order_count_
        << ", quantity=" << total_quantity_.to_string()
        << "]";
     return ss.str();
 }
 
+Order* PriceLevel::find(OrderId order_id) const {
+    for (Order* order = head_.get(); order; order = order->next_.get()) {
+        if (order->id() == order_id) {
+            return order;
+        }
+    }
+    return nullptr;
+}
+
+void PriceLevel::link_back(OrderPtr order) {
+    Order* node = order.get();
+    node->level_ = this;
+    node->prev_ = tail_;
+    if (tail_) {
+        tail_->next_ = std::move(order);
+    } else {
+        head_ = std::move(order);
+    }
+    tail_ = node;
+    ++order_count_;
+    if (node->is_pegged()) {
+        ++pegged_count_;
+    }
+}
+
+OrderPtr PriceLevel::unlink(Order& order) {
+    Order* prev = order.prev_;
+    OrderPtr& link = prev ? prev->next_ : head_;
+
+    // Take the level's reference and splice the successor into its place
+    OrderPtr self = std::move(link);
+    link = std::move(order.next_);
+    if (link) {
+        link->prev_ = prev;
+    } else {
+        tail_ = prev;
+    }
+
+    order.prev_ = nullptr;
+    order.level_ = nullptr;
+    --order_count_;
+    if (order.is_pegged()) {
+        --pegged_count_;
+    }
+
+    return self;
+}
+
+void PriceLevel::release_all() {
+    // Detach one node at a time so a long queue doesn't recurse in ~Order
+    while (head_) {
+        OrderPtr next = std::move(head_->next_);
+        head_->prev_ = nullptr;
+        head_->level_ = nullptr;
+        head_ = std::move(next);
+    }
+    tail_ = nullptr;
+    order_count_ = 0;
+    pegged_count_ = 0;
+    total_quantity_ = Quantity::ZERO;
+}
+
+void PriceLevel::adopt_orders() {
+    for (Order* order = head_.get(); order; order = order->next_.get()) {
+        order->level_ = this;
+    }
+}
+
 } // namespace orderbook
-} // namespace trading_engine 
\ No newline at end of file
+} // namespace trading_engine
@@ -0,0 +1,89 @@
+#include "orderbook/risk_gate.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+RiskGate::RiskGate(size_t accounts, size_t symbols)
+    : limits_(accounts),
+      reference_prices_(symbols),
+      positions_(accounts, symbols) {
+}
+
+bool RiskGate::set_limits(OwnerId owner, const RiskLimits& limits) {
+    if (owner >= limits_.size()) {
+        return false;
+    }
+    limits_[owner] = limits;
+    return true;
+}
+
+void RiskGate::set_reference_price(SymbolId symbol_id, Price price) {
+    if (symbol_id < reference_prices_.size()) {
+        reference_prices_[symbol_id] = price;
+    }
+}
+
+RiskCheck RiskGate::check(const Order& order, Price price, Quantity quantity, Quantity counted,
+                          const SymbolInfo& info) const {
+    const OwnerId owner = order.owner_id();
+    const SymbolId symbol_id = order.symbol_id();
+    const Position* position = positions_.find(owner, symbol_id);
+    if (!position) {
+        return RiskCheck::UNKNOWN_ACCOUNT;
+    }
+    const RiskLimits& limits = limits_[owner];
+    const Price reference = reference_prices_[symbol_id];
+
+    if (quantity > limits.max_order_quantity) {
+        return RiskCheck::ORDER_QUANTITY;
+    }
+
+    const OrderType type = order.type();
+    const bool has_limit = type == OrderType::LIMIT || type == OrderType::STOP_LIMIT;
+    if (has_limit && !info.within_band(price, reference)) {
+        return RiskCheck::PRICE_BAND;
+    }
+
+    Price value_price = has_limit ? price : (type == OrderType::STOP ? order.stop_price() : reference);
+    const bool notional_limited = limits.max_order_notional != std::numeric_limits<int64_t>::max();
+    if (notional_limited && value_price.raw_value() <= 0) {
+        return RiskCheck::NO_REFERENCE; // Valued at zero it would pass any notional limit
+    }
+    if (notional(value_price, quantity) > limits.max_order_notional) {
+        return RiskCheck::ORDER_NOTIONAL;
+    }
+
+    // The position if this order and the account's other open orders on its
+    // side all filled; only orders that grow it beyond the limit are refused
+    const bool buy = order.side() == Side::BUY;
+    int64_t held = position->net.raw_value();
+    int64_t open = ((buy ? position->open_buy : position->open_sell) - counted +
+                    (quantity - order.executed_quantity())).raw_value();
+    int64_t after = held + (buy ? open : -open);
+    int64_t after_abs = after < 0 ? -after : after;
+    if (after_abs > limits.max_position.raw_value() && after_abs > (held < 0 ? -held : held)) {
+        return RiskCheck::POSITION_LIMIT;
+    }
+
+    return RiskCheck::PASSED;
+}
+
+void RiskGate::on_fill(SymbolId symbol_id, const Order& maker, const Order& taker, Price price, Quantity quantity) {
+    positions_.on_fill(maker.owner_id(), symbol_id, maker.side(), price, quantity);
+    positions_.on_fill(taker.owner_id(), symbol_id, taker.side(), price, quantity);
+    positions_.release_open(maker.owner_id(), symbol_id, maker.side(), quantity);
+    positions_.release_open(taker.owner_id(), symbol_id, taker.side(), quantity);
+    set_reference_price(symbol_id, price);
+}
+
+void RiskGate::on_amend(SymbolId symbol_id, const Order& order, Quantity old_remaining) {
+    Quantity new_remaining = order.remaining_quantity();
+    if (new_remaining > old_remaining) {
+        positions_.add_open(order.owner_id(), symbol_id, order.side(), new_remaining - old_remaining);
+    } else {
+        positions_.release_open(order.owner_id(), symbol_id, order.side(), old_remaining - new_remaining);
+    }
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,30 @@
+#include "orderbook/snapshot.hpp"
+#include "orderbook/order_book.hpp"
+#include "core/mapped_file.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+bool save_snapshot(const OrderBook& book, const std::string& path, uint64_t journal_sequence) {
+    core::MappedFile file;
+    if (!file.open_write(path, book.snapshot_size())) {
+        return false;
+    }
+
+    if (!book.write_snapshot(std::span<std::byte>(file.data(), file.size()), journal_sequence)) {
+        return false;
+    }
+    return file.sync();
+}
+
+bool load_snapshot(OrderBook& book, const std::string& path, uint64_t* journal_sequence) {
+    core::MappedFile file;
+    if (!file.open_read(path)) {
+        return false;
+    }
+
+    return book.restore_snapshot(std::span<const std::byte>(file.data(), file.size()), journal_sequence);
+}
+
+} // namespace orderbook
+} // namespace trading_engine
@@ -0,0 +1,65 @@
+#include "orderbook/stop_book.hpp"
+
+namespace trading_engine {
+namespace orderbook {
+
+void StopBook::add(const Order& order) {
+    if (order.side() == Side::BUY) {
+        buy_stops_.emplace(order.stop_price(), order.id());
+    } else {
+        sell_stops_.emplace(order.stop_price(), order.id());
+    }
+}
+
+bool StopBook::remove(const Order& order) {
+    return order.side() == Side::BUY ? erase(buy_stops_, order) : erase(sell_stops_, order);
+}
+
+OrderId StopBook::pop_triggered(Price last_trade) {
+    if (!buy_stops_.empty() && buy_stops_.begin()->first <= last_trade) {
+        OrderId id = buy_stops_.begin()->second;
+        buy_stops_.erase(buy_stops_.begin());
+        return id;
+    }
+    if (!sell_stops_.empty() && sell_stops_.begin()->first >= last_trade) {
+        OrderId id = sell_stops_.begin()->second;
+        sell_stops_.erase(sell_stops_.begin());
+        return id;
+    }
+    return INVALID_ORDER_ID;
+}
+
+void StopBook::clear() {
+    buy_stops_.clear();
+    sell_stops_.clear();
+}
+
+std::optional<Price> StopBook::next_buy_trigger() const {
+    if (buy_stops_.empty()) {
+        return std::nullopt;
+    }
+    return buy_stops_.begin()->first;
+}
+
+std::optional<Price> StopBook::next_sell_trigger() const {
+    if (sell_stops_.empty()) {
+        return std::nullopt;
+    }
+    return sell_stops_.begin()->first;
+}
+
+template <typename Map>
+bool StopBook::erase(Map& stops, const Order& order) {
+    // Only the stops sharing the order's stop price are walked
+    auto [first, last] = stops.equal_range(order.stop_price());
+    for (auto it = first; it != last; ++it) {
+        if (it->second == order.id()) {
+            stops.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace orderbook
+} // namespace trading_engine
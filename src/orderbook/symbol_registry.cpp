@@ -0,0 +1,154 @@
+#include "orderbook/symbol_registry.hpp"
+#include <functional>
+
+namespace trading_engine {
+namespace orderbook {
+
+namespace {
+
+const Symbol EMPTY_SYMBOL;
+
+size_t name_hash(std::string_view name) {
+    return std::hash<std::string_view>{}(name);
+}
+
+} // namespace
+
+SymbolRegistry::NameIndex::NameIndex(size_t capacity)
+    : mask(capacity - 1),
+      slots(std::make_unique<std::atomic<SymbolId>[]>(capacity)) {
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(INVALID_SYMBOL_ID, std::memory_order_relaxed);
+    }
+}
+
+SymbolRegistry::SymbolRegistry()
+    : size_(0) {
+    indexes_.push_back(std::make_unique<NameIndex>(INITIAL_INDEX_CAPACITY));
+    index_.store(indexes_.back().get(), std::memory_order_release);
+}
+
+SymbolRegistry::~SymbolRegistry() = default;
+
+SymbolId SymbolRegistry::intern(std::string_view name) {
+    // Known names never lock
+    SymbolId id = lookup(name);
+    if (id != INVALID_SYMBOL_ID) {
+        return id;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    id = lookup(name);
+    if (id != INVALID_SYMBOL_ID) {
+        return id; // Registered by another thread meanwhile
+    }
+    
+    SymbolInfo info;
+    info.name = Symbol(name);
+    return append(info);
+}
+
+SymbolId SymbolRegistry::register_symbol(const SymbolInfo& info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    SymbolId id = lookup(info.name);
+    if (id != INVALID_SYMBOL_ID) {
+        // Keep the stored name (lock-free lookups read it) and refresh the rest
+        SymbolInfo& existing = entry(id);
+        existing.tick_size = info.tick_size;
+        existing.lot_size = info.lot_size;
+        existing.min_price = info.min_price;
+        existing.max_price = info.max_price;
+        existing.price_band_bps = info.price_band_bps;
+        return id;
+    }
+    
+    return append(info);
+}
+
+SymbolId SymbolRegistry::find(std::string_view name) const {
+    return lookup(name);
+}
+
+const SymbolInfo* SymbolRegistry::info(SymbolId id) const {
+    if (id >= size()) {
+        return nullptr;
+    }
+    return &entry(id);
+}
+
+const Symbol& SymbolRegistry::name(SymbolId id) const {
+    if (id >= size()) {
+        return EMPTY_SYMBOL;
+    }
+    return entry(id).name;
+}
+
+SymbolRegistry& SymbolRegistry::global() {
+    static SymbolRegistry instance;
+    return instance;
+}
+
+SymbolId SymbolRegistry::append(const SymbolInfo& info) {
+    size_t id = size_.load(std::memory_order_relaxed);
+    if (id >= MAX_SYMBOLS) {
+        return INVALID_SYMBOL_ID; // Registry full
+    }
+    
+    // Allocate the chunk on first use; entries never move afterwards
+    auto& chunk = chunks_[id / CHUNK_SIZE];
+    if (!chunk) {
+        chunk = std::make_unique<SymbolInfo[]>(CHUNK_SIZE);
+    }
+    
+    chunk[id % CHUNK_SIZE] = info;
+    
+    // Publish the entry to lock-free readers, by id and then by name
+    size_.store(id + 1, std::memory_order_release);
+    index(static_cast<SymbolId>(id));
+    return static_cast<SymbolId>(id);
+}
+
+SymbolId SymbolRegistry::lookup(std::string_view name) const {
+    const NameIndex* table = index_.load(std::memory_order_acquire);
+    for (size_t slot = name_hash(name) & table->mask;; slot = (slot + 1) & table->mask) {
+        SymbolId id = table->slots[slot].load(std::memory_order_acquire);
+        if (id == INVALID_SYMBOL_ID) {
+            return INVALID_SYMBOL_ID;
+        }
+        if (entry(id).name == name) {
+            return id;
+        }
+    }
+}
+
+void SymbolRegistry::index(SymbolId id) {
+    const NameIndex* current = indexes_.back().get();
+    size_t capacity = current->mask + 1;
+    
+    // Keep the table at most half full, so probes stay short and always end
+    if ((static_cast<size_t>(id) + 1) * 2 > capacity) {
+        auto grown = std::make_unique<NameIndex>(capacity * 2);
+        for (SymbolId existing = 0; existing < id; ++existing) {
+            size_t slot = name_hash(entry(existing).name) & grown->mask;
+            while (grown->slots[slot].load(std::memory_order_relaxed) != INVALID_SYMBOL_ID) {
+                slot = (slot + 1) & grown->mask;
+            }
+            grown->slots[slot].store(existing, std::memory_order_relaxed);
+        }
+        
+        // Readers still probing the old table finish there; it is never freed early
+        indexes_.push_back(std::move(grown));
+        current = indexes_.back().get();
+        index_.store(current, std::memory_order_release);
+    }
+    
+    size_t slot = name_hash(entry(id).name) & current->mask;
+    while (current->slots[slot].load(std::memory_order_relaxed) != INVALID_SYMBOL_ID) {
+        slot = (slot + 1) & current->mask;
+    }
+    current->slots[slot].store(id, std::memory_order_release);
+}
+
+} // namespace orderbook
+} // namespace trading_engine
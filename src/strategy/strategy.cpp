@@ -0,0 +1,51 @@
+#include "strategy/strategy.hpp"
+
+namespace trading_engine {
+namespace strategy {
+
+void Strategy::subscribe(SymbolId symbol_id) {
+    if (symbol_id == orderbook::INVALID_SYMBOL_ID || is_subscribed(symbol_id)) {
+        return;
+    }
+    if (symbol_id >= subscriptions_.size()) {
+        subscriptions_.resize(symbol_id + 1, false);
+    }
+    subscriptions_[symbol_id] = true;
+    subscribed_.push_back(symbol_id);
+}
+
+OrderId Strategy::send_order(SymbolId symbol_id, Side side, OrderType type, Quantity quantity, Price price,
+                             TimeInForce tif) {
+    if (!order_ring_) {
+        return orderbook::INVALID_ORDER_ID;
+    }
+
+    // The id is only used up if the order is actually queued
+    OrderId order_id = (order_id_block_ << ORDER_ID_BITS) | (next_order_ + 1);
+    if (!send(OrderCommand::new_order(symbol_id, order_id, side, type, quantity, price, tif, owner_))) {
+        return orderbook::INVALID_ORDER_ID;
+    }
+    ++next_order_;
+    return order_id;
+}
+
+bool Strategy::send_cancel(SymbolId symbol_id, OrderId order_id) {
+    return send(OrderCommand::cancel(symbol_id, order_id));
+}
+
+bool Strategy::send_modify(SymbolId symbol_id, OrderId order_id,
+                           std::optional<Price> new_price, std::optional<Quantity> new_quantity) {
+    return send(OrderCommand::modify(symbol_id, order_id, new_price, new_quantity));
+}
+
+bool Strategy::send(const OrderCommand& command) {
+    if (!order_ring_ || !order_ring_->try_push(command)) {
+        ++orders_refused_;
+        return false;
+    }
+    ++orders_sent_;
+    return true;
+}
+
+} // namespace strategy
+} // namespace trading_engine
@@ -0,0 +1,302 @@
+#include "strategy/strategy_runner.hpp"
+#include "core/logger.hpp"
+#include "core/thread_affinity.hpp"
+#include <algorithm>
+
+namespace trading_engine {
+namespace strategy {
+
+using orderbook::MarketDataEventType;
+
+StrategyRunner::StrategyRunner(MatchingEngine& engine, const StrategyRunnerConfig& config)
+    : engine_(engine),
+      config_(config),
+      running_(false),
+      forwarding_(false) {
+    for (size_t worker = 0; worker < engine_.worker_count(); ++worker) {
+        if (const MarketDataBus* bus = engine_.market_data_bus(worker)) {
+            buses_.push_back(bus);
+        }
+    }
+    if (buses_.empty()) {
+        TE_LOG_WARN("StrategyRunner: engine has no market-data buses, strategies only get ticks");
+    }
+}
+
+StrategyRunner::~StrategyRunner() {
+    stop();
+}
+
+bool StrategyRunner::add_strategy(Strategy& strategy) {
+    if (is_running() || strategy.order_ring_) {
+        return false;
+    }
+
+    auto session = std::make_unique<Session>(strategy, config_.order_ring_capacity);
+    for (const MarketDataBus* bus : buses_) {
+        session->cursors.push_back(bus->subscribe());
+    }
+    for (SymbolId symbol_id : strategy.subscribed_symbols()) {
+        if (symbol_id >= session->books.size()) {
+            session->books.resize(symbol_id + 1);
+        }
+        session->books[symbol_id] = std::make_unique<BookMirror>();
+        session->books[symbol_id]->top.symbol_id = symbol_id;
+    }
+
+    // Block 0 is never used, so ids of other senders stay distinguishable
+    strategy.order_ring_ = &session->orders;
+    strategy.order_id_block_ = sessions_.size() + 1;
+    sessions_.push_back(std::move(session));
+    return true;
+}
+
+bool StrategyRunner::start() {
+    if (is_running()) {
+        return false;
+    }
+
+    running_.store(true, std::memory_order_release);
+    forwarding_.store(true, std::memory_order_release);
+    order_entry_thread_ = std::thread(&StrategyRunner::run_order_entry, this);
+    for (size_t i = 0; i < sessions_.size(); ++i) {
+        sessions_[i]->thread = std::thread(&StrategyRunner::run_strategy, this, i);
+    }
+
+    TE_LOG_INFO("StrategyRunner started: %zu strategies", sessions_.size());
+    return true;
+}
+
+void StrategyRunner::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // Strategies may still send orders from on_stop(), so they go first
+    for (auto& session : sessions_) {
+        if (session->thread.joinable()) {
+            session->thread.join();
+        }
+    }
+    forwarding_.store(false, std::memory_order_release);
+    if (order_entry_thread_.joinable()) {
+        order_entry_thread_.join();
+    }
+}
+
+size_t StrategyRunner::poll(size_t index) {
+    if (is_running() || index >= sessions_.size()) {
+        return 0;
+    }
+    return poll_session(*sessions_[index]);
+}
+
+size_t StrategyRunner::forward() {
+    if (is_running()) {
+        return 0;
+    }
+    return forward_orders();
+}
+
+uint64_t StrategyRunner::events_lost(size_t index) const {
+    if (index >= sessions_.size()) {
+        return 0;
+    }
+    uint64_t lost = 0;
+    for (const auto& cursor : sessions_[index]->cursors) {
+        lost += cursor.lost() + cursor.overruns();
+    }
+    return lost;
+}
+
+void StrategyRunner::run_strategy(size_t index) {
+    Session& session = *sessions_[index];
+
+    if (index < config_.strategy_cpus.size() && !core::pin_current_thread(config_.strategy_cpus[index])) {
+        TE_LOG_WARN("StrategyRunner strategy %zu could not be pinned to CPU %d",
+                    index, config_.strategy_cpus[index]);
+    }
+
+    session.strategy->on_start();
+    while (running_.load(std::memory_order_acquire)) {
+        if (poll_session(session) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    session.strategy->on_stop();
+}
+
+void StrategyRunner::run_order_entry() {
+    if (config_.order_entry_cpu >= 0 && !core::pin_current_thread(config_.order_entry_cpu)) {
+        TE_LOG_WARN("StrategyRunner order entry could not be pinned to CPU %d", config_.order_entry_cpu);
+    }
+
+    while (true) {
+        size_t forwarded = forward_orders();
+        if (forwarded > 0) {
+            continue;
+        }
+
+        // Exit once the strategies are done and their last orders are out (or can't go out)
+        if (!forwarding_.load(std::memory_order_acquire)) {
+            bool drained = std::all_of(sessions_.begin(), sessions_.end(),
+                                       [](const auto& session) { return session->orders.empty(); });
+            if (drained || !engine_.is_running()) {
+                break;
+            }
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+size_t StrategyRunner::poll_session(Session& session) {
+    // Buses exist for every worker or none, so cursor i reads worker i
+    size_t events = 0;
+    for (size_t worker = 0; worker < session.cursors.size(); ++worker) {
+        MarketDataBus::Cursor& cursor = session.cursors[worker];
+        uint64_t missed = cursor.lost() + cursor.overruns();
+        events += cursor.poll([&](const MarketDataEvent& event, uint64_t) {
+            if (cursor.lost() + cursor.overruns() != missed) {
+                missed = cursor.lost() + cursor.overruns();
+                reset_books(session, worker); // Events before this one are gone
+            }
+            apply(session, event);
+        }, config_.poll_batch);
+        if (cursor.lost() + cursor.overruns() != missed) {
+            reset_books(session, worker);
+        }
+    }
+
+    // One update per changed symbol, with the state after the whole batch
+    for (SymbolId symbol_id : session.dirty) {
+        BookMirror& book = *session.books[symbol_id];
+        TopOfBook& top = book.top;
+        top.bid_price = book.bids.empty() ? Price() : book.bids.begin()->first;
+        top.bid_quantity = book.bids.empty() ? Quantity::ZERO : book.bids.begin()->second;
+        top.ask_price = book.asks.empty() ? Price() : book.asks.begin()->first;
+        top.ask_quantity = book.asks.empty() ? Quantity::ZERO : book.asks.begin()->second;
+        session.strategy->on_book_update(top);
+        top.updates = 0;
+        book.dirty = false;
+    }
+    session.dirty.clear();
+
+    if (config_.tick_interval_ns > 0) {
+        Timestamp now = orderbook::current_timestamp();
+        if (now >= session.next_tick) {
+            session.strategy->on_tick(now);
+            session.next_tick = now + config_.tick_interval_ns;
+        }
+    }
+    return events;
+}
+
+void StrategyRunner::apply(Session& session, const MarketDataEvent& event) {
+    if (event.type == MarketDataEventType::TRADE) {
+        const Strategy& strategy = *session.strategy;
+        if (strategy.owns_order(event.order_id)) {
+            report_fill(session, event, event.order_id, event.match_id, event.side, true);
+        }
+        if (strategy.owns_order(event.match_id)) {
+            Side taker_side = event.side == Side::BUY ? Side::SELL : Side::BUY;
+            report_fill(session, event, event.match_id, event.order_id, taker_side, false);
+        }
+    }
+
+    if (event.symbol_id >= session.books.size() || !session.books[event.symbol_id]) {
+        return; // Not subscribed
+    }
+    BookMirror& book = *session.books[event.symbol_id];
+
+    switch (event.type) {
+        case MarketDataEventType::LEVEL_CHANGED:
+            // The book never crosses, so levels a new one crosses are stale (left by a reset)
+            if (event.side == Side::BUY) {
+                if (event.quantity.is_zero()) {
+                    book.bids.erase(event.price);
+                } else {
+                    book.bids.insert_or_assign(event.price, event.quantity);
+                    book.asks.erase(book.asks.begin(), book.asks.upper_bound(event.price));
+                }
+            } else {
+                if (event.quantity.is_zero()) {
+                    book.asks.erase(event.price);
+                } else {
+                    book.asks.insert_or_assign(event.price, event.quantity);
+                    book.bids.erase(book.bids.begin(), book.bids.upper_bound(event.price));
+                }
+            }
+            break;
+        case MarketDataEventType::TRADE:
+            book.top.last_trade_price = event.price;
+            book.top.last_trade_quantity = event.quantity;
+            break;
+        default:
+            return; // Order-level events are summed up by the level events that follow
+    }
+
+    book.top.timestamp = event.timestamp;
+    book.top.sequence = event.sequence;
+    ++book.top.updates;
+    if (!book.dirty) {
+        book.dirty = true;
+        session.dirty.push_back(event.symbol_id);
+    }
+}
+
+void StrategyRunner::reset_books(Session& session, size_t worker) {
+    TE_LOG_WARN("StrategyRunner: %s fell a bus window behind, its books on worker %zu start over",
+                session.strategy->name().c_str(), worker);
+    for (SymbolId symbol_id : session.strategy->subscribed_symbols()) {
+        if (engine_.worker_for(symbol_id) != worker) {
+            continue;
+        }
+        BookMirror& book = *session.books[symbol_id];
+        book.bids.clear();
+        book.asks.clear();
+        book.top.incomplete = true;
+        if (!book.dirty) {
+            book.dirty = true;
+            session.dirty.push_back(symbol_id);
+        }
+    }
+}
+
+void StrategyRunner::report_fill(Session& session, const MarketDataEvent& event, OrderId order_id,
+                                 OrderId contra_order_id, Side side, bool maker) {
+    Fill fill;
+    fill.symbol_id = event.symbol_id;
+    fill.order_id = order_id;
+    fill.contra_order_id = contra_order_id;
+    fill.side = side;
+    fill.price = event.price;
+    fill.quantity = event.quantity;
+    fill.timestamp = event.timestamp;
+    fill.maker = maker;
+    session.strategy->on_order_fill(fill);
+}
+
+size_t StrategyRunner::forward_orders() {
+    size_t forwarded = 0;
+    for (auto& session : sessions_) {
+        while (OrderCommand* command = session->orders.front()) {
+            if (!engine_.submit(*command)) {
+                if (engine_.book(command->symbol_id)) {
+                    break; // Engine queue full: retry on the next pass
+                }
+                orders_rejected_.fetch_add(1, std::memory_order_relaxed); // Unknown symbol
+            } else {
+                ++forwarded;
+            }
+            session->orders.pop();
+        }
+    }
+    if (forwarded > 0) {
+        orders_forwarded_.fetch_add(forwarded, std::memory_order_relaxed);
+    }
+    return forwarded;
+}
+
+} // namespace strategy
+} // namespace trading_engine
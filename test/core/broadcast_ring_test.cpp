@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "core/broadcast_ring.hpp"
+
+using namespace trading_engine::core;
+
+TEST(BroadcastRingTest, EveryCursorSeesEveryValue) {
+    BroadcastRing<uint64_t> ring(16);
+    EXPECT_EQ(ring.capacity(), 16);
+    EXPECT_EQ(ring.window(), 12);
+
+    auto first = ring.subscribe();
+    auto second = ring.subscribe();
+    for (uint64_t i = 0; i < 10; ++i) {
+        ring.publish(i * 10);
+    }
+    EXPECT_EQ(ring.published(), 10);
+    EXPECT_EQ(first.lag(), 10);
+
+    // Reading with one cursor leaves the others where they were
+    std::vector<uint64_t> seen;
+    EXPECT_EQ(first.poll([&](const uint64_t& value, uint64_t sequence) {
+        EXPECT_EQ(value, sequence * 10);
+        seen.push_back(value);
+    }, 4), 4);
+    EXPECT_EQ(first.sequence(), 4);
+    EXPECT_EQ(first.poll([&](const uint64_t& value, uint64_t) { seen.push_back(value); }), 6);
+    EXPECT_EQ(second.poll([](const uint64_t&, uint64_t) {}), 10);
+    EXPECT_EQ(seen.size(), 10);
+    EXPECT_EQ(seen.back(), 90);
+    EXPECT_EQ(first.lag(), 0);
+    EXPECT_EQ(first.poll([](const uint64_t&, uint64_t) {}), 0);
+
+    // Late subscribers start at the head, or at the oldest value still readable
+    auto late = ring.subscribe();
+    EXPECT_EQ(late.sequence(), 10);
+    EXPECT_EQ(ring.subscribe_from_oldest().sequence(), 0);
+    ring.publish(100);
+    uint64_t value = 0;
+    EXPECT_EQ(late.poll([&](const uint64_t& v, uint64_t) { value = v; }), 1);
+    EXPECT_EQ(value, 100);
+}
+
+TEST(BroadcastRingTest, SlowCursorSkipsLappedValues) {
+    BroadcastRing<uint64_t> ring(16);
+    auto slow = ring.subscribe();
+    auto fast = ring.subscribe();
+
+    // The producer never waits, however far behind a reader is
+    for (uint64_t i = 0; i < 40; ++i) {
+        ring.publish(i);
+        fast.poll([](const uint64_t&, uint64_t) {});
+    }
+    EXPECT_EQ(fast.lost(), 0);
+    EXPECT_EQ(slow.lag(), 40);
+
+    // Only the readable window survives; the gap is counted as lost
+    std::vector<uint64_t> seen;
+    slow.poll([&](const uint64_t& value, uint64_t sequence) {
+        EXPECT_EQ(value, sequence);
+        seen.push_back(value);
+    });
+    EXPECT_EQ(slow.lost(), 40 - ring.window());
+    ASSERT_EQ(seen.size(), ring.window());
+    EXPECT_EQ(seen.front(), 40 - ring.window());
+    EXPECT_EQ(seen.back(), 39);
+    EXPECT_EQ(slow.overruns(), 0);
+}
+
+TEST(BroadcastRingTest, ReaderThreads) {
+    // Fewer values than the window, so no reader can be lapped
+    constexpr uint64_t COUNT = 30000;
+    constexpr size_t READERS = 3;
+    BroadcastRing<uint64_t> ring(1 << 16);
+
+    std::vector<BroadcastRing<uint64_t>::Cursor> cursors;
+    for (size_t i = 0; i < READERS; ++i) {
+        cursors.push_back(ring.subscribe());
+    }
+
+    std::vector<uint64_t> sums(READERS, 0);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < READERS; ++i) {
+        readers.emplace_back([&, i] {
+            auto& cursor = cursors[i];
+            while (cursor.sequence() < COUNT) {
+                cursor.poll([&](const uint64_t& value, uint64_t sequence) {
+                    EXPECT_EQ(value, sequence);
+                    sums[i] += value;
+                });
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        ring.publish(i);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (size_t i = 0; i < READERS; ++i) {
+        EXPECT_EQ(sums[i], COUNT * (COUNT - 1) / 2);
+        EXPECT_EQ(cursors[i].lost(), 0);
+        EXPECT_EQ(cursors[i].overruns(), 0);
+    }
+}
+
+// The deliberate seqlock race below is the thing under test; TSan reports it
+#if !defined(__SANITIZE_THREAD__)
+TEST(BroadcastRingTest, LappedCopiesAreNeverHandedOut) {
+    struct Wide {
+        uint64_t words[8];
+    };
+    BroadcastRing<Wide> ring(4);
+    auto cursor = ring.subscribe();
+
+    constexpr uint64_t COUNT = 200000;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            ring.publish_with([&](Wide& value) {
+                for (uint64_t& word : value.words) {
+                    word = i;
+                }
+            });
+        }
+    });
+
+    // A reader this slow on a ring this small is lapped all the time, yet
+    // every value it is given is whole and matches its sequence
+    uint64_t bad = 0;
+    uint64_t seen = 0;
+    while (cursor.sequence() < COUNT) {
+        cursor.poll([&](const Wide& value, uint64_t sequence) {
+            for (uint64_t word : value.words) {
+                bad += word != sequence;
+            }
+            ++seen;
+        });
+    }
+    producer.join();
+
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(seen + cursor.lost() + cursor.overruns(), COUNT);
+}
+#endif
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "core/latency_histogram.hpp"
+
+using namespace trading_engine::core;
+
+TEST(LatencyHistogramTest, BucketsBoundRelativeError) {
+    for (uint64_t value : {0ULL, 1ULL, 63ULL, 64ULL, 65ULL, 1000ULL, 123456ULL, 987654321ULL, (1ULL << 39) + 7}) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), value);
+        EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), value);
+
+        double width = static_cast<double>(LatencyHistogram::bucket_upper_bound(index) -
+                                           LatencyHistogram::bucket_lower_bound(index));
+        EXPECT_LE(width, static_cast<double>(value) / LatencyHistogram::SUB_BUCKET_COUNT);
+    }
+
+    // Out-of-range values land in the last bucket
+    EXPECT_EQ(LatencyHistogram::bucket_index(1ULL << 50), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (int64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value);
+    }
+
+    HistogramSnapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100000u);
+    EXPECT_EQ(snapshot.min, 1u);
+    EXPECT_EQ(snapshot.max, 100000u);
+    EXPECT_NEAR(snapshot.mean(), 50000.5, 0.01);
+
+    for (double p : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        double expected = p / 100.0 * 100000.0;
+        EXPECT_NEAR(static_cast<double>(snapshot.percentile(p)), expected, expected / 50.0) << "p" << p;
+    }
+    EXPECT_EQ(snapshot.percentile(100.0), 100000u);
+}
+
+TEST(LatencyHistogramTest, SnapshotsMerge) {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 99; ++i) {
+        fast.record(100);
+    }
+    slow.record(1000000);
+
+    HistogramSnapshot merged = fast.snapshot();
+    merged.merge(slow.snapshot());
+    EXPECT_EQ(merged.count, 100u);
+    EXPECT_EQ(merged.max, 1000000u);
+    EXPECT_LE(merged.percentile(99.0), 101u);
+    EXPECT_EQ(merged.percentile(99.99), 1000000u);
+
+    fast.reset();
+    EXPECT_EQ(fast.snapshot().count, 0u);
+    EXPECT_EQ(fast.snapshot().percentile(50.0), 0u);
+}
+
+TEST(LatencyProbeTest, MergesPerThreadShards) {
+    LatencyProbe probe("test.threads");
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&probe, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                probe.record(1000 * (t + 1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    HistogramSnapshot snapshot = probe.snapshot();
+    EXPECT_EQ(snapshot.count, static_cast<uint64_t>(THREADS * PER_THREAD));
+    EXPECT_EQ(snapshot.min, 1000u);
+    EXPECT_EQ(snapshot.max, 4000u);
+}
+
+TEST(LatencyProbeTest, ExitedThreadsGiveTheirSlotsBack) {
+    LatencyProbe probe("test.churn");
+    const uint64_t shared_before = LatencyProbe::shared_slots();
+
+    // Far more threads than slots over time, but never many at once
+    constexpr size_t ROUNDS = LatencyProbe::MAX_THREADS * 3;
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        std::thread([&probe] { probe.record(500); }).join();
+    }
+
+    EXPECT_EQ(LatencyProbe::shared_slots(), shared_before);
+    EXPECT_EQ(probe.snapshot().count, ROUNDS);
+}
+
+TEST(LatencyProbeTest, ScopedLatencyRecordsIntoRegistry) {
+    LatencyProbe& probe = latency_probe("test.scoped");
+    EXPECT_EQ(&probe, &latency_probe("test.scoped"));
+
+    {
+        ScopedLatency scope(probe);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    HistogramSnapshot snapshot = probe.snapshot();
+    EXPECT_EQ(snapshot.count, 1u);
+    EXPECT_GE(snapshot.max, 1000000u);
+
+    bool listed = false;
+    for (LatencyProbe* registered : latency_probes()) {
+        listed = listed || registered == &probe;
+    }
+    EXPECT_TRUE(listed);
+    EXPECT_NE(snapshot.to_string().find("count=1"), std::string::npos);
+}
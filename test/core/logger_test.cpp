@@ -147,4 +147,114 @@ TEST(LoggerGlobalTest, GlobalLoggerInstance) {
     
     // No explicit verification, just ensure the code compiles and runs
     SUCCEED();
-} 
\ No newline at end of file
+} 
+TEST(DeferredLogTest, FormatsStoredArguments) {
+    static constexpr LogSite site{LogLevel::WARN, "id=%zu px=%.2f name=%s short=%.3s hex=%#x pct=%% w=%5d|"};
+    
+    DeferredLogEntry entry;
+    entry.site = &site;
+    entry.timestamp_ns = 0;
+    entry.thread_id = 7;
+    std::string temporary = "AAPL";
+    entry.push(size_t{42});
+    entry.push(101.256);
+    entry.push(temporary.c_str());
+    entry.push(std::string_view("abcdef"));
+    entry.push(255u);
+    entry.push(12);
+    
+    // The copied string outlives the original
+    temporary = "XXXX";
+    
+    char line[256];
+    size_t length = format_deferred_entry(entry, line, sizeof(line));
+    std::string text(line, length);
+    EXPECT_NE(text.find("[WARN ] [7] "), std::string::npos) << text;
+    EXPECT_NE(text.find("id=42 px=101.26 name=AAPL short=abc hex=0xff pct=% w=   12|"), std::string::npos) << text;
+}
+
+TEST(DeferredLogTest, TruncatesIntoSmallBuffers) {
+    static constexpr LogSite site{LogLevel::INFO, "value=%d and more text"};
+    
+    DeferredLogEntry entry;
+    entry.site = &site;
+    entry.push(123456);
+    
+    char line[16];
+    size_t length = format_deferred_entry(entry, line, sizeof(line));
+    EXPECT_EQ(length, sizeof(line) - 1);
+    EXPECT_EQ(line[length], '\0');
+}
+
+TEST_F(LoggerTest, DeferredLoggingToFile) {
+    static constexpr LogSite site{LogLevel::INFO, "Deferred %s #%d"};
+    static constexpr LogSite filtered{LogLevel::DEBUG, "Filtered %d"};
+    
+    {
+        Logger logger(LogLevel::INFO);
+        logger.set_file_output(test_log_file);
+        logger.log_deferred(site, std::string("message"), 1);
+        logger.log_deferred(filtered, 2);
+        EXPECT_EQ(logger.dropped_count(), 0);
+        
+        // Let the flush thread park, then check a write still wakes it
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        logger.log_deferred(site, "after park", 2);
+    }
+    
+    std::ifstream log_file(test_log_file);
+    std::string contents((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(contents.find("Deferred message #1"), std::string::npos);
+    EXPECT_NE(contents.find("Deferred after park #2"), std::string::npos);
+    EXPECT_EQ(contents.find("Filtered"), std::string::npos);
+}
+
+TEST_F(LoggerTest, KeepsOneThreadsLinesInOrder) {
+    static constexpr LogSite site{LogLevel::INFO, "line %d"};
+    constexpr int LINES = 200;
+    
+    // Alternate the text and deferred paths; the flush thread may read either ring first
+    {
+        Logger logger(LogLevel::INFO);
+        logger.set_file_output(test_log_file);
+        for (int i = 0; i < LINES; ++i) {
+            if (i % 3 == 0) {
+                logger.info("line %d", i);
+            } else {
+                logger.log_deferred(site, i);
+            }
+        }
+    }
+    
+    std::ifstream log_file(test_log_file);
+    std::string line;
+    int expected = 0;
+    while (std::getline(log_file, line)) {
+        size_t at = line.find("line ");
+        ASSERT_NE(at, std::string::npos) << line;
+        EXPECT_EQ(std::stoi(line.substr(at + 5)), expected) << line;
+        ++expected;
+    }
+    EXPECT_EQ(expected, LINES);
+}
+
+TEST(LoggerGlobalTest, ArgumentsEvaluatedOnlyWhenEnabled) {
+    Logger& global = global_logger();
+    global.set_min_level(LogLevel::INFO);
+    
+    int calls = 0;
+    auto expensive = [&calls]() { return ++calls; };
+    
+    // Below the runtime level: the argument never runs
+    TE_LOG_DEBUG("value %d", expensive());
+    EXPECT_EQ(calls, 0);
+    EXPECT_FALSE(TE_LOG_ENABLED(LogLevel::DEBUG));
+    
+    // Enabled at runtime: runs only if the level is also compiled in
+    global.set_min_level(LogLevel::TRACE);
+    TE_LOG_DEBUG("value %d", expensive());
+    EXPECT_EQ(calls, COMPILED_LOG_LEVEL <= LogLevel::DEBUG ? 1 : 0);
+    EXPECT_EQ(TE_LOG_ENABLED(LogLevel::DEBUG), COMPILED_LOG_LEVEL <= LogLevel::DEBUG);
+    
+    global.set_min_level(LogLevel::INFO);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "core/mapped_file.hpp"
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace trading_engine::core;
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("mapped_file_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove(path_);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+    
+    std::string path_;
+};
+
+TEST_F(MappedFileTest, WriteThenRead) {
+    {
+        MappedFile file;
+        ASSERT_TRUE(file.open_write(path_, 4096));
+        EXPECT_EQ(file.size(), 4096);
+        
+        // New files start zero-filled
+        EXPECT_EQ(file.data()[100], std::byte{0});
+        std::memcpy(file.data(), "journal", 7);
+        EXPECT_TRUE(file.sync());
+    }
+    
+    MappedFile file;
+    ASSERT_TRUE(file.open_read(path_));
+    EXPECT_EQ(file.size(), 4096);
+    EXPECT_EQ(std::memcmp(file.data(), "journal", 7), 0);
+}
+
+TEST_F(MappedFileTest, MoveTransfersMapping) {
+    MappedFile file;
+    ASSERT_TRUE(file.open_write(path_, 128));
+    
+    MappedFile moved(std::move(file));
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(moved.is_open());
+    EXPECT_EQ(moved.path(), path_);
+    
+    moved.close();
+    EXPECT_FALSE(moved.is_open());
+}
+
+TEST_F(MappedFileTest, FailuresLeaveFileClosed) {
+    MappedFile file;
+    EXPECT_FALSE(file.open_read(path_));
+    EXPECT_FALSE(file.open_write(path_, 0));
+    EXPECT_FALSE(file.is_open());
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "core/ring_buffer.hpp"
+
+using namespace trading_engine::core;
+
+TEST(RingBufferTest, CapacityIsPowerOfTwo) {
+    SPSCRingBuffer<int> ring(100);
+    EXPECT_EQ(ring.capacity(), 128);
+    EXPECT_TRUE(ring.empty());
+    
+    EXPECT_EQ(next_power_of_two(0), 1);
+    EXPECT_EQ(next_power_of_two(64), 64);
+    EXPECT_EQ(next_power_of_two(65), 128);
+}
+
+TEST(RingBufferTest, FifoUntilFull) {
+    SPSCRingBuffer<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+    EXPECT_EQ(ring.size(), 4);
+    
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+    
+    // Indices wrap around the mask
+    EXPECT_TRUE(ring.try_push(42));
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 42);
+}
+
+TEST(RingBufferTest, ProducerConsumerThreads) {
+    constexpr int COUNT = 100000;
+    SPSCRingBuffer<int> ring(256);
+    
+    std::thread producer([&]() {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    int expected = 0;
+    int value = 0;
+    while (expected < COUNT) {
+        if (ring.try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+    }
+    
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBufferTest, BatchPushPop) {
+    SPSCRingBuffer<int> ring(8);
+    std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    
+    // Only what fits is queued
+    EXPECT_EQ(ring.try_push_batch(values), 8);
+    EXPECT_EQ(ring.try_push_batch(values), 0);
+    
+    std::vector<int> out(5);
+    EXPECT_EQ(ring.try_pop_batch(out), 5);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(ring.try_pop_batch(out), 3);
+    EXPECT_EQ(out[2], 8);
+    EXPECT_EQ(ring.try_pop_batch(out), 0);
+}
+
+TEST(RingBufferTest, InPlaceAccess) {
+    SPSCRingBuffer<std::vector<int>> ring(2);
+    EXPECT_TRUE(ring.try_push_with([](std::vector<int>& slot) { slot.assign(3, 7); }));
+    
+    std::vector<int>* front = ring.front();
+    ASSERT_NE(front, nullptr);
+    EXPECT_EQ(front->size(), 3);
+    ring.pop();
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(MPSCRingBufferTest, FifoUntilFull) {
+    MPSCRingBuffer<int> ring(4);
+    EXPECT_EQ(ring.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+    
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MPSCRingBufferTest, BatchPushPop) {
+    MPSCRingBuffer<int> ring(8);
+    std::vector<int> values = {1, 2, 3, 4, 5, 6};
+    
+    EXPECT_TRUE(ring.try_push(0));
+    EXPECT_EQ(ring.try_push_batch(values), 6);
+    EXPECT_EQ(ring.try_push_batch(values), 1);
+    
+    std::vector<int> out(16);
+    EXPECT_EQ(ring.try_pop_batch(out), 8);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[6], 6);
+    EXPECT_EQ(out[7], 1);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(MPSCRingBufferTest, ManyProducers) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+    MPSCRingBuffer<int> ring(128);
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                // Encode the producer so per-producer order can be checked
+                int value = p * PER_PRODUCER + i;
+                while (!ring.try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    std::vector<int> last(PRODUCERS, -1);
+    int received = 0;
+    int value = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (ring.try_pop(value)) {
+            int producer = value / PER_PRODUCER;
+            ASSERT_GT(value, last[producer]);
+            last[producer] = value;
+            ++received;
+        }
+    }
+    
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ring.empty());
+}
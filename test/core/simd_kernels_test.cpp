@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "core/simd_kernels.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace trading_engine::core;
+
+TEST(SimdKernelsTest, MatchScalarReference) {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int64_t> quantity_dist(0, 1'000'000);
+    std::uniform_int_distribution<int64_t> price_dist(-5'000'000, 5'000'000);
+
+    // Every length up to a few vectors, so each tail path runs
+    for (size_t count = 0; count <= 37; ++count) {
+        std::vector<int64_t> quantities(count);
+        std::vector<int64_t> prices(count);
+        for (size_t i = 0; i < count; ++i) {
+            quantities[i] = quantity_dist(rng);
+            prices[i] = price_dist(rng);
+        }
+
+        int64_t total = 0;
+        int64_t dot = 0;
+        for (size_t i = 0; i < count; ++i) {
+            total += quantities[i];
+            dot += prices[i] * quantities[i];
+        }
+        EXPECT_EQ(simd::sum(quantities.data(), count), total) << count;
+        EXPECT_EQ(simd::dot(prices.data(), quantities.data(), count), dot) << count;
+
+        // Targets on, just past and between the running totals
+        int64_t running = 0;
+        for (size_t i = 0; i < count; ++i) {
+            running += quantities[i];
+            for (int64_t target : {running, running + 1, running - quantities[i] / 2}) {
+                int64_t before = -1;
+                size_t index = simd::prefix_search(quantities.data(), count, target, before);
+                size_t expected = 0;
+                int64_t expected_before = 0;
+                while (expected < count && expected_before + quantities[expected] < target) {
+                    expected_before += quantities[expected++];
+                }
+                ASSERT_EQ(index, expected) << count << " " << target;
+                ASSERT_EQ(before, expected_before) << count << " " << target;
+            }
+        }
+
+        std::vector<int64_t> ascending = prices;
+        std::sort(ascending.begin(), ascending.end());
+        std::vector<int64_t> descending(ascending.rbegin(), ascending.rend());
+        for (int64_t limit : {int64_t{-6'000'000}, int64_t{0}, int64_t{6'000'000},
+                              count ? ascending[count / 2] : int64_t{0}}) {
+            size_t up = std::upper_bound(ascending.begin(), ascending.end(), limit) - ascending.begin();
+            size_t down = std::upper_bound(descending.begin(), descending.end(), limit, std::greater<>()) -
+                          descending.begin();
+            EXPECT_EQ(simd::count_within(ascending.data(), count, limit, false), up);
+            EXPECT_EQ(simd::count_within(descending.data(), count, limit, true), down);
+        }
+    }
+}
+
+TEST(SimdKernelsTest, ReportsItsInstructionSet) {
+    std::string isa = simd::active_isa();
+    EXPECT_TRUE(isa == "avx2" || isa == "neon" || isa == "scalar") << isa;
+    int64_t before = 7;
+    EXPECT_EQ(simd::prefix_search(nullptr, 0, 5, before), 0);
+    EXPECT_EQ(before, 0);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "core/thread_affinity.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using namespace trading_engine::core;
+
+TEST(ThreadAffinityTest, HardwareThreadCount) {
+    EXPECT_GE(hardware_thread_count(), 1);
+}
+
+TEST(ThreadAffinityTest, RejectsInvalidCpu) {
+    EXPECT_FALSE(pin_current_thread(-1));
+}
+
+#if defined(__linux__)
+TEST(ThreadAffinityTest, PinToCurrentCpu) {
+    bool pinned = false;
+    int cpu = -1;
+    std::thread worker([&]() {
+        // Use a CPU we are known to be allowed on
+        int current = sched_getcpu();
+        pinned = pin_current_thread(current);
+        cpu = sched_getcpu();
+        if (pinned && cpu != current) {
+            pinned = false;
+        }
+    });
+    worker.join();
+    EXPECT_TRUE(pinned);
+}
+#endif
+
+#if defined(__linux__)
+TEST(ThreadAffinityTest, ScopedPinRestoresAffinity) {
+    std::thread worker([]() {
+        std::vector<int> before = current_thread_cpus();
+        ASSERT_FALSE(before.empty());
+        {
+            ScopedThreadPin pin(before.front());
+            EXPECT_TRUE(pin.pinned());
+            EXPECT_EQ(current_thread_cpus(), std::vector<int>{before.front()});
+        }
+        EXPECT_EQ(current_thread_cpus(), before);
+
+        ScopedThreadPin unpinned(-1);
+        EXPECT_FALSE(unpinned.pinned());
+    });
+    worker.join();
+}
+#endif
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 #include "core/timer.hpp"
 
 using namespace trading_engine::core;
@@ -71,4 +72,75 @@ TEST(TimerTest, Timestamp) {
     EXPECT_EQ(timestamp[13], ':');
     EXPECT_EQ(timestamp[16], ':');
     EXPECT_EQ(timestamp[19], '.');
-} 
\ No newline at end of file
+} 
+TEST(TscClockTest, TracksSystemClock) {
+    if (!TscClock::is_available()) {
+        GTEST_SKIP() << "No invariant TSC on this machine";
+    }
+    ASSERT_TRUE(TscClock::calibrate(std::chrono::milliseconds(5)));
+    EXPECT_TRUE(TscClock::is_calibrated());
+    EXPECT_GT(TscClock::cycles_per_ns(), 0.0);
+
+    // Within a millisecond of the system clock right after calibration
+    int64_t tsc = TscClock::now_ns();
+    int64_t system = Timer::system_now_ns();
+    EXPECT_LT(std::abs(tsc - system), 1000000);
+}
+
+TEST(TscClockTest, MonotonicAcrossRecalibration) {
+    if (!TscClock::is_available()) {
+        GTEST_SKIP() << "No invariant TSC on this machine";
+    }
+    ASSERT_TRUE(TscClock::calibrate(std::chrono::milliseconds(5)));
+
+    int64_t previous = TscClock::now_ns();
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        TscClock::recalibrate();
+        int64_t current = TscClock::now_ns();
+        EXPECT_GT(current, previous);
+        previous = current;
+    }
+}
+
+TEST(TscClockTest, BackgroundRecalibration) {
+    if (!TscClock::is_available()) {
+        GTEST_SKIP() << "No invariant TSC on this machine";
+    }
+    ASSERT_TRUE(TscClock::calibrate(std::chrono::milliseconds(5)));
+
+    // Runs without any logger or caller-driven hook
+    uint64_t before = TscClock::recalibration_count();
+    ASSERT_TRUE(TscClock::start_recalibration(std::chrono::milliseconds(1)));
+    EXPECT_TRUE(TscClock::is_recalibrating());
+    for (int i = 0; i < 1000 && TscClock::recalibration_count() < before + 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(TscClock::recalibration_count(), before + 3);
+    EXPECT_LT(std::abs(TscClock::now_ns() - Timer::system_now_ns()), 1000000);
+
+    TscClock::stop_recalibration();
+    EXPECT_FALSE(TscClock::is_recalibrating());
+    uint64_t stopped = TscClock::recalibration_count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(TscClock::recalibration_count(), stopped);
+}
+
+TEST(TscClockTest, SelectableClockSource) {
+    EXPECT_EQ(clock_source(), ClockSource::SYSTEM);
+    if (!set_clock_source(ClockSource::TSC)) {
+        EXPECT_EQ(clock_source(), ClockSource::SYSTEM);
+        GTEST_SKIP() << "No invariant TSC on this machine";
+    }
+    EXPECT_EQ(clock_source(), ClockSource::TSC);
+    EXPECT_TRUE(TscClock::is_recalibrating());
+
+    Timer timer;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GE(timer.elapsed_ms(), 10);
+    EXPECT_LT(std::abs(Timer::now_ns() - Timer::system_now_ns()), 1000000);
+
+    EXPECT_TRUE(set_clock_source(ClockSource::SYSTEM));
+    EXPECT_EQ(clock_source(), ClockSource::SYSTEM);
+    EXPECT_FALSE(TscClock::is_recalibrating());
+}
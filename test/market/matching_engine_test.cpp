@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include "market/matching_engine.hpp"
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::market;
+using namespace trading_engine::orderbook;
+
+TEST(MatchingEngineTest, UsesRegistryIds) {
+    MatchingEngine engine;
+    
+    SymbolId aapl = engine.add_symbol("AAPL");
+    SymbolId msft = engine.add_symbol("MSFT");
+    EXPECT_NE(aapl, INVALID_SYMBOL_ID);
+    EXPECT_NE(aapl, msft);
+    EXPECT_EQ(engine.add_symbol("AAPL"), aapl);
+    EXPECT_EQ(engine.symbol_count(), 2);
+    EXPECT_EQ(SymbolRegistry::global().find("AAPL"), aapl);
+    
+    EXPECT_EQ(engine.find_symbol("MSFT"), msft);
+    EXPECT_EQ(engine.find_symbol("GOOG_NOT_TRADED"), INVALID_SYMBOL_ID);
+    
+    ASSERT_NE(engine.book(msft), nullptr);
+    EXPECT_EQ(engine.book(msft)->symbol(), "MSFT");
+    EXPECT_EQ(engine.book(msft)->symbol_id(), msft);
+    EXPECT_EQ(engine.book(INVALID_SYMBOL_ID), nullptr);
+}
+
+TEST(MatchingEngineTest, ShardsSymbolsAcrossWorkers) {
+    MatchingEngineConfig config;
+    config.worker_count = 3;
+    MatchingEngine engine(config);
+    
+    EXPECT_EQ(engine.worker_count(), 3);
+    EXPECT_EQ(engine.worker_for(0), 0);
+    EXPECT_EQ(engine.worker_for(4), 1);
+    EXPECT_EQ(engine.worker_for(5), 2);
+}
+
+TEST(MatchingEngineTest, ExecuteWhileStopped) {
+    MatchingEngine engine;
+    SymbolId aapl = engine.add_symbol("AAPL");
+    
+    MatchBuffer fills;
+    EXPECT_TRUE(engine.execute(OrderCommand::new_order(aapl, 1, Side::SELL, OrderType::LIMIT,
+                                                       Quantity(10.0), Price(100.0)), fills));
+    EXPECT_TRUE(engine.execute(OrderCommand::new_order(aapl, 2, Side::BUY, OrderType::LIMIT,
+                                                       Quantity(4.0), Price(100.0)), fills));
+    ASSERT_EQ(fills.size(), 1);
+    EXPECT_EQ(fills[0].maker_order_id, 1);
+    EXPECT_EQ(fills[0].match_quantity, Quantity(4.0));
+    
+    EXPECT_TRUE(engine.execute(OrderCommand::modify(aapl, 1, std::nullopt, Quantity(8.0)), fills));
+    EXPECT_EQ(engine.book(aapl)->get_quantity_at_level(Price(100.0), Side::SELL), Quantity(4.0));
+    
+    EXPECT_TRUE(engine.execute(OrderCommand::cancel(aapl, 1), fills));
+    EXPECT_EQ(engine.book(aapl)->ask_level_count(), 0);
+    
+    // Unknown symbol
+    EXPECT_FALSE(engine.execute(OrderCommand::cancel(INVALID_SYMBOL_ID, 1), fills));
+}
+
+TEST(MatchingEngineTest, ExecuteKeepsStopAndPegPrices) {
+    MatchingEngine engine;
+    SymbolId aapl = engine.add_symbol("AAPL");
+    MatchBuffer fills;
+    
+    EXPECT_TRUE(engine.execute(OrderCommand::new_order(aapl, 1, Side::BUY, OrderType::LIMIT,
+                                                       Quantity(5.0), Price(99.0)), fills));
+    EXPECT_TRUE(engine.execute(OrderCommand::new_order(aapl, 2, Side::SELL, OrderType::LIMIT,
+                                                       Quantity(5.0), Price(101.0)), fills));
+    
+    // A sell stop at 95 waits for a trade at or below it
+    EXPECT_TRUE(engine.execute(OrderCommand::new_stop(aapl, 3, Side::SELL, Quantity(1.0), Price(95.0)), fills));
+    OrderBook* book = engine.book(aapl);
+    ASSERT_EQ(book->stop_order_count(), 1);
+    ASSERT_NE(book->get_order(3), nullptr);
+    EXPECT_EQ(book->get_order(3)->stop_price(), Price(95.0));
+    
+    // A bid pegged one below the primary best bid rests at 98
+    EXPECT_TRUE(engine.execute(OrderCommand::new_pegged(aapl, 4, Side::BUY, OrderType::PEG_PRIMARY,
+                                                        Quantity(2.0), Price(-1.0)), fills));
+    EXPECT_EQ(book->get_quantity_at_level(Price(98.0), Side::BUY), Quantity(2.0));
+    EXPECT_TRUE(fills.empty());
+}
+
+TEST(MatchingEngineTest, WorkersMatchTheirOwnBooks) {
+    MatchingEngineConfig config;
+    config.worker_count = 2;
+    config.queue_capacity = 1024;
+    MatchingEngine engine(config);
+    
+    std::vector<SymbolId> ids;
+    for (const char* symbol : {"AAPL", "MSFT", "GOOG", "AMZN"}) {
+        ids.push_back(engine.add_symbol(symbol));
+    }
+    
+    std::mutex mutex;
+    std::vector<std::pair<SymbolId, OrderMatch>> fills;
+    engine.set_match_handler([&](SymbolId id, const OrderMatch& match) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fills.emplace_back(id, match);
+    });
+    
+    ASSERT_TRUE(engine.start());
+    EXPECT_TRUE(engine.is_running());
+    EXPECT_EQ(engine.add_symbol("TSLA"), INVALID_SYMBOL_ID);
+    
+    // One resting ask and one crossing bid per symbol
+    OrderId next_id = 1;
+    for (SymbolId id : ids) {
+        while (!engine.submit(OrderCommand::new_order(id, next_id, Side::SELL, OrderType::LIMIT,
+                                                      Quantity(5.0), Price(50.0)))) {
+        }
+        ++next_id;
+        while (!engine.submit(OrderCommand::new_order(id, next_id, Side::BUY, OrderType::LIMIT,
+                                                      Quantity(2.0), Price(50.0)))) {
+        }
+        ++next_id;
+    }
+    
+    engine.stop();
+    EXPECT_FALSE(engine.is_running());
+    EXPECT_EQ(engine.processed_count(0) + engine.processed_count(1), 8);
+    
+    ASSERT_EQ(fills.size(), 4);
+    for (SymbolId id : ids) {
+        EXPECT_EQ(engine.book(id)->get_total_ask_quantity(), Quantity(3.0));
+    }
+}
+
+TEST(MatchingEngineTest, SubmitRejectsUnknownSymbol) {
+    MatchingEngine engine;
+    SymbolId aapl = engine.add_symbol("AAPL");
+    SymbolId other = SymbolRegistry::global().intern("NOT_IN_ENGINE");
+    
+    EXPECT_FALSE(engine.submit(OrderCommand::cancel(other, 1)));
+    EXPECT_FALSE(engine.submit(OrderCommand::cancel(INVALID_SYMBOL_ID, 1)));
+    EXPECT_TRUE(engine.submit(OrderCommand::cancel(aapl, 1)));
+}
+
+TEST(MatchingEngineTest, ConcurrentGateways) {
+    MatchingEngineConfig config;
+    config.worker_count = 2;
+    config.queue_capacity = 256;
+    MatchingEngine engine(config);
+    
+    SymbolId ids[2] = {engine.add_symbol("GW_A"), engine.add_symbol("GW_B")};
+    ASSERT_TRUE(engine.start());
+    
+    // Several producer threads feed the same worker queues
+    constexpr int GATEWAYS = 3;
+    constexpr int ORDERS = 500;
+    std::vector<std::thread> gateways;
+    for (int g = 0; g < GATEWAYS; ++g) {
+        gateways.emplace_back([&, g]() {
+            for (int i = 0; i < ORDERS; ++i) {
+                OrderId id = static_cast<OrderId>(g * ORDERS + i + 1);
+                auto command = OrderCommand::new_order(ids[i % 2], id, Side::BUY, OrderType::LIMIT,
+                                                       Quantity(1.0), Price(10.0 + g));
+                while (!engine.submit(command)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& gateway : gateways) {
+        gateway.join();
+    }
+    
+    engine.stop();
+    EXPECT_EQ(engine.processed_count(0) + engine.processed_count(1), GATEWAYS * ORDERS);
+    EXPECT_EQ(engine.book(ids[0])->order_count() + engine.book(ids[1])->order_count(),
+              static_cast<size_t>(GATEWAYS * ORDERS));
+}
+
+TEST(MatchingEngineTest, SubmitBatchStopsAtWorkerBoundary) {
+    MatchingEngineConfig config;
+    config.worker_count = 2;
+    MatchingEngine engine(config);
+    
+    SymbolId a = engine.add_symbol("BATCH_A");
+    SymbolId b = engine.add_symbol("BATCH_B");
+    ASSERT_NE(engine.worker_for(a), engine.worker_for(b));
+    
+    std::vector<OrderCommand> commands = {
+        OrderCommand::new_order(a, 1, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(10.0)),
+        OrderCommand::new_order(a, 2, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(10.0)),
+        OrderCommand::new_order(b, 3, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(10.0)),
+    };
+    EXPECT_EQ(engine.submit_batch(commands), 2);
+    EXPECT_EQ(engine.submit_batch(std::span<const OrderCommand>(commands).subspan(2)), 1);
+    
+    ASSERT_TRUE(engine.start());
+    engine.stop();
+    EXPECT_EQ(engine.book(a)->order_count(), 2);
+    EXPECT_EQ(engine.book(b)->order_count(), 1);
+}
+
+TEST(MatchingEngineTest, WorkersPublishOntoTheirBus) {
+    MatchingEngineConfig config;
+    config.worker_count = 2;
+    config.queue_capacity = 1024;
+    config.market_data_bus_capacity = 1024;
+    MatchingEngine engine(config);
+    
+    SymbolId id = engine.add_symbol("NVDA");
+    const MarketDataBus* bus = engine.market_data_bus_for(id);
+    ASSERT_NE(bus, nullptr);
+    EXPECT_EQ(bus, engine.market_data_bus(engine.worker_for(id)));
+    EXPECT_EQ(engine.market_data_bus(2), nullptr);
+    
+    // Two readers follow the same bus from their own threads
+    std::atomic<bool> done{false};
+    std::vector<std::vector<MarketDataEvent>> seen(2);
+    std::vector<std::thread> readers;
+    for (auto& events : seen) {
+        readers.emplace_back([&, cursor = bus->subscribe()]() mutable {
+            auto read = [&](const MarketDataEvent& event, uint64_t) { events.push_back(event); };
+            while (!done.load(std::memory_order_acquire)) {
+                cursor.poll(read);
+            }
+            cursor.poll(read);
+            EXPECT_EQ(cursor.lost(), 0);
+        });
+    }
+    
+    ASSERT_TRUE(engine.start());
+    while (!engine.submit(OrderCommand::new_order(id, 1, Side::SELL, OrderType::LIMIT,
+                                                  Quantity(5.0), Price(50.0)))) {
+    }
+    while (!engine.submit(OrderCommand::new_order(id, 2, Side::BUY, OrderType::LIMIT,
+                                                  Quantity(2.0), Price(50.0)))) {
+    }
+    engine.stop();
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    // Every reader got the whole stream, in the book's own sequence
+    EXPECT_EQ(bus->published(), engine.book(id)->market_data_sequence());
+    for (const auto& events : seen) {
+        ASSERT_EQ(events.size(), bus->published());
+        bool traded = false;
+        for (size_t i = 0; i < events.size(); ++i) {
+            EXPECT_EQ(events[i].sequence, i + 1);
+            EXPECT_EQ(events[i].symbol_id, id);
+            traded |= events[i].type == MarketDataEventType::TRADE;
+        }
+        EXPECT_TRUE(traded);
+    }
+    
+    // Buses are off unless configured
+    MatchingEngine quiet;
+    EXPECT_EQ(quiet.market_data_bus_for(quiet.add_symbol("NVDA")), nullptr);
+}
+
+TEST(MatchingEngineTest, WorkersServeSnapshotRequests) {
+    MatchingEngineConfig config;
+    config.queue_capacity = 1024;
+    config.market_data_bus_capacity = 1024;
+    MatchingEngine engine(config);
+    SymbolId id = engine.add_symbol("SNAP");
+    
+    struct Image {
+        SymbolId symbol_id;
+        std::vector<std::byte> bytes;
+        uint64_t sequence;
+    };
+    std::mutex mutex;
+    std::vector<Image> images;
+    engine.set_snapshot_handler([&](SymbolId symbol_id, std::span<const std::byte> image, uint64_t sequence) {
+        std::lock_guard<std::mutex> lock(mutex);
+        images.push_back({symbol_id, std::vector<std::byte>(image.begin(), image.end()), sequence});
+    });
+    
+    // The image falls between the commands queued before and after the request
+    ASSERT_TRUE(engine.start());
+    ASSERT_TRUE(engine.submit(OrderCommand::new_order(id, 1, Side::SELL, OrderType::LIMIT,
+                                                      Quantity(5.0), Price(50.0))));
+    ASSERT_TRUE(engine.request_snapshot(id));
+    ASSERT_TRUE(engine.submit(OrderCommand::new_order(id, 2, Side::BUY, OrderType::LIMIT,
+                                                      Quantity(2.0), Price(49.0))));
+    EXPECT_FALSE(engine.request_snapshot(INVALID_SYMBOL_ID));
+    engine.stop();
+    
+    ASSERT_EQ(images.size(), 1);
+    EXPECT_EQ(images[0].symbol_id, id);
+    OrderBook restored(id);
+    uint64_t sequence = 0;
+    ASSERT_TRUE(restored.restore_snapshot(images[0].bytes, &sequence));
+    EXPECT_EQ(sequence, images[0].sequence);
+    EXPECT_EQ(restored.order_count(), 1);
+    EXPECT_EQ(restored.best_ask(), Price(50.0));
+    EXPECT_LT(images[0].sequence, engine.book(id)->market_data_sequence());
+    EXPECT_EQ(engine.book(id)->order_count(), 2);
+    
+    // Served on the calling thread while stopped
+    MatchBuffer fills;
+    ASSERT_TRUE(engine.execute(OrderCommand::snapshot(id), fills));
+    ASSERT_EQ(images.size(), 2);
+    EXPECT_EQ(images[1].sequence, engine.book(id)->market_data_sequence());
+}
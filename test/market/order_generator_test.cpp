@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "market/order_generator.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include <vector>
+
+using namespace trading_engine::market;
+using namespace trading_engine::orderbook;
+
+namespace {
+
+OrderGeneratorConfig generator_config() {
+    OrderGeneratorConfig config;
+    config.seed = 42;
+    config.symbols = {SymbolRegistry::global().intern("GENA"), SymbolRegistry::global().intern("GENB")};
+    config.mid_price = Price(50.0);
+    config.tick_size = Price(0.05);
+    config.rate = 1000.0;
+    config.poisson_arrivals = false;
+    return config;
+}
+
+} // namespace
+
+TEST(OrderGeneratorTest, SameSeedSameFlow) {
+    OrderGenerator first(generator_config());
+    OrderGenerator second(generator_config());
+    std::vector<OrderCommand> a(5000);
+    std::vector<OrderCommand> b(5000);
+    ASSERT_EQ(first.generate(a), a.size());
+    ASSERT_EQ(second.generate(b), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].type, b[i].type) << i;
+        ASSERT_EQ(a[i].order_id, b[i].order_id) << i;
+        ASSERT_EQ(a[i].price, b[i].price) << i;
+        ASSERT_EQ(a[i].quantity, b[i].quantity) << i;
+    }
+
+    // reset() replays the seed; another seed gives other flow
+    first.reset();
+    const JournalRecord* record = first.next();
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->sequence, 1);
+    EXPECT_EQ(record->command.order_id, a[0].order_id);
+
+    OrderGeneratorConfig other = generator_config();
+    other.seed = 43;
+    OrderGenerator third(other);
+    std::vector<OrderCommand> c(a.size());
+    third.generate(c);
+    size_t same_prices = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        same_prices += a[i].price == c[i].price;
+    }
+    EXPECT_LT(same_prices, a.size());
+}
+
+TEST(OrderGeneratorTest, RespectsTheConfiguredShape) {
+    OrderGeneratorConfig config = generator_config();
+    config.max_price_ticks = 10;
+    config.min_lots = 2;
+    config.max_lots = 4;
+    config.mid_walk_probability = 0.0;
+    config.cross_probability = 0.0;
+    config.max_live_orders = 500;
+    OrderGenerator generator(config);
+
+    uint64_t news = 0;
+    uint64_t cancels = 0;
+    Timestamp last = -1;
+    for (int i = 0; i < 20000; ++i) {
+        const JournalRecord* record = generator.next();
+        ASSERT_NE(record, nullptr);
+
+        // Evenly spaced at 1000 per second
+        EXPECT_EQ(record->timestamp, static_cast<Timestamp>(i) * 1'000'000);
+        EXPECT_GT(record->timestamp, last);
+        last = record->timestamp;
+
+        const OrderCommand& command = record->command;
+        if (command.type == CommandType::CANCEL) {
+            ++cancels;
+            continue;
+        }
+        if (command.type != CommandType::NEW) {
+            continue;
+        }
+        ++news;
+        EXPECT_GE(command.quantity, Quantity(2.0));
+        EXPECT_LE(command.quantity, Quantity(4.0));
+        if (command.order_type != OrderType::LIMIT) {
+            continue;
+        }
+
+        // On the grid, behind the mid and no more than 10 ticks from it
+        int64_t ticks = (command.price.raw_value() - Price(50.0).raw_value()) / Price(0.05).raw_value();
+        EXPECT_EQ(command.price.raw_value() % Price(0.05).raw_value(), 0);
+        if (command.side == Side::BUY) {
+            EXPECT_TRUE(ticks <= -1 && ticks >= -10) << ticks;
+        } else {
+            EXPECT_TRUE(ticks >= 1 && ticks <= 10) << ticks;
+        }
+    }
+    EXPECT_GT(news, cancels);
+    EXPECT_GT(cancels, 0);
+    EXPECT_LE(generator.live_orders(), config.max_live_orders);
+}
+
+TEST(OrderGeneratorTest, WarmsUpAndSweeps) {
+    OrderGeneratorConfig config = generator_config();
+    config.max_lots = 2;
+    config.mid_walk_probability = 0.0;
+    config.cross_probability = 0.5;
+    config.cancel_probability = 0.2;
+    config.modify_probability = 0.4;
+    config.reprice_probability = 1.0;
+    config.market_probability = 0.4;
+    config.market_size_multiplier = 50;
+    config.warmup_orders = 100;
+    OrderGenerator generator(config);
+
+    // The warm-up only rests orders behind the mid
+    std::vector<OrderCommand> warmup(config.warmup_orders);
+    ASSERT_EQ(generator.generate(warmup), warmup.size());
+    for (const OrderCommand& command : warmup) {
+        ASSERT_EQ(command.type, CommandType::NEW);
+        ASSERT_EQ(command.order_type, OrderType::LIMIT);
+        EXPECT_EQ(command.side == Side::BUY, command.price < Price(50.0));
+    }
+    EXPECT_EQ(generator.live_orders(), warmup.size());
+
+    // Then modifies move prices and market orders are sweep sized
+    std::vector<OrderCommand> flow(2000);
+    ASSERT_EQ(generator.generate(flow), flow.size());
+    uint64_t repriced = 0;
+    uint64_t sweeps = 0;
+    for (const OrderCommand& command : flow) {
+        if (command.type == CommandType::MODIFY) {
+            ASSERT_TRUE(command.new_price().has_value());
+            ++repriced;
+        } else if (command.type == CommandType::NEW && command.order_type == OrderType::MARKET) {
+            EXPECT_GE(command.quantity, Quantity(50.0));
+            ++sweeps;
+        }
+    }
+    EXPECT_GT(repriced, 0);
+    EXPECT_GT(sweeps, 0);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "market/order_generator.hpp"
+#include "market/replay.hpp"
+#include "market/replay_driver.hpp"
+#include "orderbook/symbol_registry.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace trading_engine::market;
+using namespace trading_engine::orderbook;
+
+class ReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = (std::filesystem::temp_directory_path() /
+                      ("replay_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string write_csv(const std::string& contents) const {
+        std::string path = directory_ + "/flow.csv";
+        std::ofstream(path) << contents;
+        return path;
+    }
+
+    std::string directory_;
+};
+
+TEST_F(ReplayTest, ParsesFixedPointWithoutDoubles) {
+    int64_t raw = 0;
+    ASSERT_TRUE(parse_fixed_point("101.25", raw));
+    EXPECT_EQ(raw, Price(101.25).raw_value());
+    ASSERT_TRUE(parse_fixed_point("-0.0001", raw));
+    EXPECT_EQ(raw, -1);
+    ASSERT_TRUE(parse_fixed_point("7", raw));
+    EXPECT_EQ(raw, 70000);
+    ASSERT_TRUE(parse_fixed_point(".5", raw));
+    EXPECT_EQ(raw, 5000);
+    ASSERT_TRUE(parse_fixed_point("1.23455", raw));   // Rounded half away from zero
+    EXPECT_EQ(raw, 12346);
+    ASSERT_TRUE(parse_fixed_point("-1.23455", raw));
+    EXPECT_EQ(raw, -12346);
+    ASSERT_TRUE(parse_fixed_point("1.234549", raw));
+    EXPECT_EQ(raw, 12345);
+
+    EXPECT_FALSE(parse_fixed_point("", raw));
+    EXPECT_FALSE(parse_fixed_point(".", raw));
+    EXPECT_FALSE(parse_fixed_point("1.2.3", raw));
+    EXPECT_FALSE(parse_fixed_point("12a", raw));
+    EXPECT_FALSE(parse_fixed_point("99999999999999999999", raw));
+}
+
+TEST_F(ReplayTest, ReadsCsvAndConvertsToJournal) {
+    SymbolId symbol_id = SymbolRegistry::global().intern("RPLY");
+    std::string path = write_csv(
+        "timestamp_ns,action,symbol,order_id,side,type,price,quantity,tif\n"
+        "# resting liquidity\n"
+        "1000,N,RPLY,1,S,L,101.5,10,GTC\n"
+        "2000,N,RPLY,2,B,L,99.25,5\r\n"
+        "\n"
+        "3000,N,NOSUCH,3,B,L,99,5\n"
+        "4000,M,RPLY,2,,,,3\n"
+        "5000,N,RPLY,4,B,M,,4,IOC\n"
+        "6000,X,RPLY,5\n"
+        "7000,C,RPLY,1");
+
+    CsvReplaySource source(path);
+    ASSERT_TRUE(source.is_open());
+    const JournalRecord* record = source.next();
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->timestamp, 1000);
+    EXPECT_EQ(record->command.symbol_id, symbol_id);
+    EXPECT_EQ(record->command.side, Side::SELL);
+    EXPECT_EQ(record->command.price, Price(101.5));
+    EXPECT_EQ(record->command.quantity, Quantity(10.0));
+
+    ASSERT_NE(record = source.next(), nullptr);
+    EXPECT_EQ(record->command.order_id, 2);
+    EXPECT_EQ(record->command.time_in_force, TimeInForce::GTC);
+
+    ASSERT_NE(record = source.next(), nullptr);
+    EXPECT_EQ(record->command.type, CommandType::MODIFY);
+    EXPECT_FALSE(record->command.new_price());
+    EXPECT_EQ(record->command.new_quantity(), Quantity(3.0));
+
+    ASSERT_NE(record = source.next(), nullptr);
+    EXPECT_EQ(record->command.order_type, OrderType::MARKET);
+    EXPECT_EQ(record->command.time_in_force, TimeInForce::IOC);
+
+    ASSERT_NE(record = source.next(), nullptr);
+    EXPECT_EQ(record->command.type, CommandType::CANCEL);
+    EXPECT_EQ(record->timestamp, 7000);
+    EXPECT_EQ(source.next(), nullptr);
+    EXPECT_EQ(source.errors(), 2);
+    EXPECT_EQ(source.first_error_line(), 6);
+
+    // The journal form replays the same commands
+    JournalConfig journal;
+    journal.directory = directory_ + "/journal";
+    uint64_t errors = 0;
+    EXPECT_EQ(convert_csv_to_journal(path, journal, &errors), 5);
+    EXPECT_EQ(errors, 2);
+
+    JournalReplaySource binary(journal.directory);
+    CsvReplaySource csv(path);
+    while (const JournalRecord* expected = csv.next()) {
+        const JournalRecord* actual = binary.next();
+        ASSERT_NE(actual, nullptr);
+        EXPECT_EQ(actual->timestamp, expected->timestamp);
+        EXPECT_EQ(actual->command.type, expected->command.type);
+        EXPECT_EQ(actual->command.order_id, expected->command.order_id);
+        EXPECT_EQ(actual->command.quantity, expected->command.quantity);
+    }
+    EXPECT_EQ(binary.next(), nullptr);
+}
+
+TEST_F(ReplayTest, DrivesStoppedEngineReproducibly) {
+    OrderGeneratorConfig generator_config;
+    generator_config.seed = 7;
+
+    auto run_once = [&](ReplayStats& stats) {
+        MatchingEngine engine;
+        generator_config.symbols = {engine.add_symbol("DRVA"), engine.add_symbol("DRVB")};
+        OrderGenerator generator(generator_config);
+        ReplayConfig config;
+        config.max_records = 20000;
+        ReplayDriver driver(engine, config);
+        stats = driver.run(generator);
+        return engine.book(generator_config.symbols[0])->to_string();
+    };
+
+    ReplayStats first;
+    ReplayStats second;
+    std::string first_book = run_once(first);
+    std::string second_book = run_once(second);
+    EXPECT_EQ(first.records, 20000);
+    EXPECT_EQ(first.applied, 20000);
+    EXPECT_GT(first.fills, 0);
+    EXPECT_EQ(first.fills, second.fills);
+    EXPECT_EQ(first_book, second_book);
+}
+
+TEST_F(ReplayTest, PacesToTheRecordedClock) {
+    MatchingEngineConfig engine_config;
+    engine_config.queue_capacity = 1024;
+    MatchingEngine engine(engine_config);
+    SymbolId symbol_id = engine.add_symbol("PACE");
+    ASSERT_TRUE(engine.start());
+
+    // 200 records over 20 ms, replayed at double speed
+    OrderGeneratorConfig generator_config;
+    generator_config.symbols = {symbol_id};
+    generator_config.rate = 10000.0;
+    generator_config.poisson_arrivals = false;
+    OrderGenerator generator(generator_config);
+
+    ReplayConfig config;
+    config.pacing = ReplayPacing::WALL_CLOCK;
+    config.speed = 2.0;
+    config.max_records = 201;
+    ReplayDriver driver(engine, config);
+    ReplayStats stats = driver.run(generator);
+    engine.stop();
+
+    EXPECT_EQ(stats.applied, 201);
+    EXPECT_GE(stats.elapsed_ns, 10'000'000);
+    EXPECT_LT(stats.elapsed_ns, 500'000'000);
+    EXPECT_EQ(engine.processed_count(0), 201);
+}
@@ -0,0 +1,325 @@
+#include <gtest/gtest.h>
+#include "network/market_data_publisher.hpp"
+#include "test_client.hpp"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::market;
+using namespace trading_engine::network;
+using namespace trading_engine::network::testing;
+using namespace trading_engine::orderbook;
+
+namespace {
+
+// Unicast stand-in for a multicast subscriber
+class FeedReceiver {
+public:
+    FeedReceiver() {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        set_receive_timeout(fd_);
+        sockaddr_in address = loopback(0);
+        ::bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+    }
+    ~FeedReceiver() { ::close(fd_); }
+
+    uint16_t port() const { return port_; }
+
+    // Receive one packet's events (false on timeout)
+    bool receive(PacketHeader& header, std::vector<MarketDataEvent>& events) {
+        char buffer[65536];
+        ssize_t size = ::recv(fd_, buffer, sizeof(buffer), 0);
+        if (size < static_cast<ssize_t>(sizeof(PacketHeader))) {
+            return false;
+        }
+        std::memcpy(&header, buffer, sizeof(header));
+        if (static_cast<size_t>(size) != packet_size(header.event_count)) {
+            return false;
+        }
+        events.resize(header.event_count);
+        std::memcpy(events.data(), buffer + sizeof(header), header.event_count * sizeof(MarketDataEvent));
+        return true;
+    }
+
+private:
+    int fd_ = -1;
+    uint16_t port_ = 0;
+};
+
+OrderCommand limit(SymbolId symbol_id, OrderId id, Side side, double quantity, double price) {
+    return OrderCommand::new_order(symbol_id, id, side, OrderType::LIMIT, Quantity(quantity), Price(price));
+}
+
+} // namespace
+
+TEST(MarketDataPublisherTest, PacksEventsIntoSequencedPackets) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("FEED");
+
+    FeedReceiver receiver;
+    MarketDataPublisherConfig config;
+    config.group_address = "127.0.0.1";
+    config.group_port = receiver.port();
+    config.max_packet_size = packet_size(8) + 10;
+    MarketDataPublisher publisher(engine, config);
+    EXPECT_EQ(publisher.events_per_packet(), 8);
+    ASSERT_TRUE(publisher.start());
+    ASSERT_TRUE(engine.start());
+
+    // Each order adds an order and changes a level
+    constexpr int ORDERS = 300;
+    for (int i = 0; i < ORDERS; ++i) {
+        ASSERT_TRUE(engine.submit(limit(symbol_id, static_cast<OrderId>(i + 1), Side::BUY, 1.0,
+                                        100.0 - static_cast<double>(i % 50) / 100.0)));
+    }
+
+    uint64_t expected_packet = 1;
+    uint64_t expected_event = 1;
+    PacketHeader header;
+    std::vector<MarketDataEvent> events;
+    while (expected_event <= 2 * ORDERS) {
+        ASSERT_TRUE(receiver.receive(header, events));
+        EXPECT_EQ(header.sequence, expected_packet++);
+        EXPECT_GE(header.event_count, 1);
+        EXPECT_LE(header.event_count, 8);
+        for (const MarketDataEvent& event : events) {
+            EXPECT_EQ(event.sequence, expected_event++);
+            EXPECT_EQ(event.symbol_id, symbol_id);
+        }
+    }
+
+    engine.stop();
+    publisher.stop();
+    EXPECT_EQ(publisher.events_sent(), 2u * ORDERS);
+    EXPECT_EQ(publisher.packets_sent(), expected_packet - 1);
+    EXPECT_LT(publisher.packets_sent(), publisher.events_sent());
+    EXPECT_EQ(publisher.events_lost(), 0);
+}
+
+TEST(MarketDataPublisherTest, ServesSnapshotsAndRetransmits) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("FEED");
+
+    // Resting before the publisher starts: the shadow book is seeded with it
+    MatchBuffer fills;
+    ASSERT_TRUE(engine.execute(limit(symbol_id, 1, Side::SELL, 5.0, 101.0), fills));
+
+    FeedReceiver receiver;
+    MarketDataPublisherConfig config;
+    config.group_address = "127.0.0.1";
+    config.group_port = receiver.port();
+    MarketDataPublisher publisher(engine, config);
+    ASSERT_TRUE(publisher.start());
+    ASSERT_TRUE(engine.start());
+
+    ASSERT_TRUE(engine.submit(limit(symbol_id, 2, Side::BUY, 3.0, 99.0)));
+    ASSERT_TRUE(engine.submit(limit(symbol_id, 3, Side::BUY, 2.0, 101.0)));   // Trades against 1
+    ASSERT_TRUE(engine.submit(OrderCommand::modify(symbol_id, 2, std::nullopt, Quantity(1.0))));
+    ASSERT_TRUE(engine.submit(limit(symbol_id, 4, Side::SELL, 1.0, 102.0)));
+
+    // Wait until the feed shows the last order
+    PacketHeader header;
+    std::vector<MarketDataEvent> events;
+    uint64_t last_packet = 0;
+    bool seen_last = false;
+    while (!seen_last) {
+        ASSERT_TRUE(receiver.receive(header, events));
+        last_packet = header.sequence;
+        for (const MarketDataEvent& event : events) {
+            seen_last |= event.type == MarketDataEventType::ORDER_ADDED && event.order_id == 4;
+        }
+    }
+
+    TestClient client(publisher.recovery_port());
+    ASSERT_TRUE(client.connected());
+
+    SnapshotRequestMessage request;
+    request.symbol_id = symbol_id;
+    client.send(request);
+    SnapshotMessage reply;
+    ASSERT_TRUE(client.receive_bytes(&reply, sizeof(reply)));
+    ASSERT_EQ(reply.header.type, MessageType::SNAPSHOT);
+    ASSERT_EQ(reply.status, RecoveryStatus::OK);
+    std::vector<std::byte> image(reply.image_size);
+    ASSERT_TRUE(client.receive_bytes(image.data(), image.size()));
+
+    OrderBook restored(symbol_id);
+    uint64_t image_sequence = 0;
+    ASSERT_TRUE(restored.restore_snapshot(image, &image_sequence));
+    EXPECT_EQ(image_sequence, reply.last_event_sequence);
+    EXPECT_EQ(restored.order_count(), 3);
+    EXPECT_EQ(restored.get_quantity_at_level(Price(101.0), Side::SELL), Quantity(3.0));
+    EXPECT_EQ(restored.get_quantity_at_level(Price(99.0), Side::BUY), Quantity(1.0));
+    EXPECT_EQ(restored.best_ask(), Price(101.0));
+    const uint64_t snapshot_sequence = reply.last_event_sequence;
+
+    // Unknown symbols are refused
+    request.symbol_id = INVALID_SYMBOL_ID;
+    client.send(request);
+    ASSERT_TRUE(client.receive_bytes(&reply, sizeof(reply)));
+    EXPECT_EQ(reply.status, RecoveryStatus::UNKNOWN_SYMBOL);
+    EXPECT_EQ(reply.image_size, 0);
+
+    // Packets are resent as they went out
+    RetransmitRequestMessage retransmit;
+    retransmit.first_packet = 1;
+    retransmit.count = 1000;   // More than exist: clamped to what was sent
+    client.send(retransmit);
+    RetransmitMessage resent;
+    ASSERT_TRUE(client.receive_bytes(&resent, sizeof(resent)));
+    ASSERT_EQ(resent.status, RecoveryStatus::OK);
+    EXPECT_EQ(resent.first_packet, 1);
+    EXPECT_EQ(resent.count, last_packet);
+    uint64_t last_event = 0;
+    for (uint32_t i = 0; i < resent.count; ++i) {
+        ASSERT_TRUE(client.receive_bytes(&header, sizeof(header)));
+        EXPECT_EQ(header.sequence, resent.first_packet + i);
+        events.resize(header.event_count);
+        ASSERT_TRUE(client.receive_bytes(events.data(), events.size() * sizeof(MarketDataEvent)));
+        last_event = events.back().sequence;
+    }
+    EXPECT_EQ(last_event, snapshot_sequence);
+
+    retransmit.first_packet = last_packet + 1;
+    retransmit.count = 1;
+    client.send(retransmit);
+    ASSERT_TRUE(client.receive_bytes(&resent, sizeof(resent)));
+    EXPECT_EQ(resent.status, RecoveryStatus::NOT_AVAILABLE);
+    EXPECT_EQ(resent.count, 0);
+
+    engine.stop();
+    publisher.stop();
+    EXPECT_EQ(engine.book(symbol_id)->market_data_sequence(), snapshot_sequence);
+    EXPECT_EQ(engine.book(symbol_id)->order_count(), restored.order_count());
+    EXPECT_EQ(publisher.snapshots_served(), 1);
+    EXPECT_EQ(publisher.retransmits_served(), 1);
+}
+
+TEST(MarketDataPublisherTest, ReseedsShadowBooksAfterAnOverrun) {
+    MatchingEngineConfig engine_options = engine_config();
+    engine_options.market_data_bus_capacity = 16;
+    MatchingEngine engine(engine_options);
+    SymbolId symbol_id = engine.add_symbol("FEED");
+
+    FeedReceiver receiver;
+    MarketDataPublisherConfig config;
+    config.group_address = "127.0.0.1";
+    config.group_port = receiver.port();
+    config.poll_timeout_ms = 200;
+    MarketDataPublisher publisher(engine, config);
+    ASSERT_TRUE(publisher.start());
+    ASSERT_TRUE(engine.start());
+
+    // A burst while the publisher sleeps overruns the tiny bus
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    constexpr int ORDERS = 2000;
+    for (int i = 0; i < ORDERS; ++i) {
+        ASSERT_TRUE(engine.submit(limit(symbol_id, static_cast<OrderId>(i + 1), Side::BUY, 1.0,
+                                        100.0 - static_cast<double>(i % 50) / 100.0)));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.events_lost() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GT(publisher.events_lost(), 0);
+
+    // Answered STALE until the shadow is re-seeded from the live book
+    TestClient client(publisher.recovery_port());
+    ASSERT_TRUE(client.connected());
+    SnapshotRequestMessage request;
+    request.symbol_id = symbol_id;
+    SnapshotMessage reply;
+    std::vector<std::byte> image;
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do {
+        client.send(request);
+        ASSERT_TRUE(client.receive_bytes(&reply, sizeof(reply)));
+        if (reply.status == RecoveryStatus::STALE) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    } while (reply.status == RecoveryStatus::STALE && std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(reply.status, RecoveryStatus::OK);
+    image.resize(reply.image_size);
+    ASSERT_TRUE(client.receive_bytes(image.data(), image.size()));
+
+    engine.stop();
+    publisher.stop();
+
+    OrderBook restored(symbol_id);
+    uint64_t image_sequence = 0;
+    ASSERT_TRUE(restored.restore_snapshot(image, &image_sequence));
+    const OrderBook& live = *engine.book(symbol_id);
+    EXPECT_EQ(image_sequence, live.market_data_sequence());
+    EXPECT_EQ(restored.order_count(), live.order_count());
+    EXPECT_EQ(restored.get_total_bid_quantity(), live.get_total_bid_quantity());
+    EXPECT_EQ(restored.best_bid(), live.best_bid());
+}
+
+TEST(MarketDataPublisherTest, DropsRecoverySessionsThatStopReading) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("FEED");
+
+    FeedReceiver receiver;
+    MarketDataPublisherConfig config;
+    config.group_address = "127.0.0.1";
+    config.group_port = receiver.port();
+    config.max_session_send_bytes = 256 * 1024;
+    MarketDataPublisher publisher(engine, config);
+    ASSERT_TRUE(publisher.start());
+    ASSERT_TRUE(engine.start());
+
+    constexpr int ORDERS = 300;
+    for (int i = 0; i < ORDERS; ++i) {
+        ASSERT_TRUE(engine.submit(limit(symbol_id, static_cast<OrderId>(i + 1), Side::BUY, 1.0,
+                                        100.0 - static_cast<double>(i % 50) / 100.0)));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.events_sent() < 2u * ORDERS && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(publisher.events_sent(), 2u * ORDERS);
+
+    // Ask for the whole feed again and again without reading the answers:
+    // far more than the socket buffers and the queue cap together
+    TestClient client(publisher.recovery_port());
+    ASSERT_TRUE(client.connected());
+    RetransmitRequestMessage retransmit;
+    retransmit.first_packet = 1;
+    retransmit.count = 1000;
+    for (int i = 0; i < 2000 && publisher.sessions_dropped() == 0; ++i) {
+        client.send(retransmit);
+    }
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.sessions_dropped() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(publisher.sessions_dropped(), 1);
+
+    // The channel still serves everyone else
+    TestClient other(publisher.recovery_port());
+    ASSERT_TRUE(other.connected());
+    SnapshotRequestMessage request;
+    request.symbol_id = symbol_id;
+    other.send(request);
+    SnapshotMessage reply;
+    ASSERT_TRUE(other.receive_bytes(&reply, sizeof(reply)));
+    EXPECT_EQ(reply.status, RecoveryStatus::OK);
+
+    engine.stop();
+    publisher.stop();
+}
+
+TEST(MarketDataPublisherTest, RefusesToStartBehindARunningEngine) {
+    MatchingEngine engine(engine_config());
+    engine.add_symbol("FEED");
+    ASSERT_TRUE(engine.start());
+    MarketDataPublisherConfig config;
+    config.group_address = "127.0.0.1";
+    MarketDataPublisher publisher(engine, config);
+    EXPECT_FALSE(publisher.start());
+    engine.stop();
+}
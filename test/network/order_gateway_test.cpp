@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "network/order_gateway.hpp"
+#include "test_client.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::market;
+using namespace trading_engine::network;
+using namespace trading_engine::network::testing;
+using namespace trading_engine::orderbook;
+
+namespace {
+
+NewOrderMessage new_order(SymbolId symbol_id, uint64_t client_id, Side side, double quantity, double price) {
+    NewOrderMessage message;
+    message.symbol_id = symbol_id;
+    message.client_order_id = client_id;
+    message.side = side;
+    message.quantity = Quantity(quantity).raw_value();
+    message.price = Price(price).raw_value();
+    return message;
+}
+
+} // namespace
+
+TEST(OrderGatewayTest, AcksAndRoutesFills) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("GWAY");
+    ASSERT_TRUE(engine.start());
+
+    OrderGateway gateway(engine);
+    ASSERT_TRUE(gateway.start());
+    ASSERT_NE(gateway.port(), 0);
+
+    TestClient seller(gateway.port());
+    TestClient buyer(gateway.port());
+    ASSERT_TRUE(seller.connected());
+    ASSERT_TRUE(buyer.connected());
+
+    // Both clients use the same client id; the gateway keeps them apart
+    seller.send(new_order(symbol_id, 1, Side::SELL, 5.0, 10.0));
+    AckMessage ack;
+    ASSERT_TRUE(seller.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::ACCEPTED);
+    EXPECT_EQ(ack.client_order_id, 1);
+    OrderId seller_order = ack.order_id;
+
+    buyer.send(new_order(symbol_id, 1, Side::BUY, 2.0, 10.0));
+    ASSERT_TRUE(buyer.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::ACCEPTED);
+    EXPECT_NE(ack.order_id, seller_order);
+
+    FillMessage fill;
+    ASSERT_TRUE(seller.receive(fill));
+    EXPECT_EQ(fill.client_order_id, 1);
+    EXPECT_EQ(fill.side, Side::SELL);
+    EXPECT_EQ(fill.maker, 1);
+    EXPECT_EQ(fill.quantity, Quantity(2.0).raw_value());
+    EXPECT_EQ(fill.price, Price(10.0).raw_value());
+    ASSERT_TRUE(buyer.receive(fill));
+    EXPECT_EQ(fill.side, Side::BUY);
+    EXPECT_EQ(fill.maker, 0);
+
+    // Refusals are acked with the reason
+    buyer.send(new_order(INVALID_SYMBOL_ID, 2, Side::BUY, 1.0, 10.0));
+    ASSERT_TRUE(buyer.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::UNKNOWN_SYMBOL);
+    buyer.send(new_order(symbol_id, 0, Side::BUY, 1.0, 10.0));
+    ASSERT_TRUE(buyer.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::BAD_ORDER_ID);
+    buyer.send(new_order(symbol_id, 3, Side::BUY, 0.0, 10.0));
+    ASSERT_TRUE(buyer.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::MALFORMED);
+    NewOrderMessage unpriced = new_order(symbol_id, 4, Side::BUY, 1.0, 10.0);
+    unpriced.price = Price::MIN_VALUE.raw_value();
+    buyer.send(unpriced);
+    ASSERT_TRUE(buyer.receive(ack));
+    EXPECT_EQ(ack.status, AckStatus::MALFORMED);
+
+    // Cancelling through the gateway reaches the engine
+    CancelMessage cancel;
+    cancel.symbol_id = symbol_id;
+    cancel.client_order_id = 1;
+    seller.send(cancel);
+    ASSERT_TRUE(seller.receive(ack));
+    EXPECT_EQ(ack.acked_type, MessageType::CANCEL);
+    EXPECT_EQ(ack.status, AckStatus::ACCEPTED);
+
+    gateway.stop();
+    engine.stop();
+    EXPECT_EQ(engine.book(symbol_id)->order_count(), 0);
+    EXPECT_EQ(gateway.commands_queued(), 3);
+    EXPECT_EQ(gateway.events_lost(), 0);
+}
+
+TEST(OrderGatewayTest, CountsEventsItMissed) {
+    MatchingEngineConfig options = engine_config();
+    options.market_data_bus_capacity = 8;
+    MatchingEngine engine(options);
+    SymbolId symbol_id = engine.add_symbol("GWAY");
+    ASSERT_TRUE(engine.start());
+
+    OrderGatewayConfig config;
+    config.poll_timeout_ms = 200;
+    OrderGateway gateway(engine, config);
+    ASSERT_TRUE(gateway.start());
+
+    // A burst while the gateway sleeps laps the tiny bus
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (OrderId id = 1; id <= 200; ++id) {
+        ASSERT_TRUE(engine.submit(OrderCommand::new_order(symbol_id, id, Side::BUY, OrderType::LIMIT,
+                                                          Quantity(1.0), Price(10.0))));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (gateway.events_lost() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(gateway.events_lost(), 0);
+
+    gateway.stop();
+    engine.stop();
+}
+
+TEST(OrderGatewayTest, ReusedClientIdCannotStrandAnOrder) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("GWDUP");
+    ASSERT_TRUE(engine.start());
+    OrderGateway gateway(engine);
+    ASSERT_TRUE(gateway.start());
+    TestClient client(gateway.port());
+    ASSERT_TRUE(client.connected());
+
+    // The second order under id 1 is queued but refused by the book
+    AckMessage ack;
+    client.send(new_order(symbol_id, 1, Side::SELL, 1.0, 10.0));
+    ASSERT_TRUE(client.receive(ack));
+    client.send(new_order(symbol_id, 1, Side::SELL, 1.0, 11.0));
+    ASSERT_TRUE(client.receive(ack));
+    CancelMessage cancel;
+    cancel.symbol_id = symbol_id;
+    cancel.client_order_id = 1;
+    client.send(cancel);
+    ASSERT_TRUE(client.receive(ack));
+
+    gateway.stop();
+    engine.stop();
+    EXPECT_EQ(engine.book(symbol_id)->ask_level_count(), 0);
+    EXPECT_EQ(engine.book(symbol_id)->order_count(), 0);
+}
+
+TEST(OrderGatewayTest, BatchesRepliesAndDropsBrokenStreams) {
+    MatchingEngine engine(engine_config());
+    SymbolId symbol_id = engine.add_symbol("GWAY");
+    ASSERT_TRUE(engine.start());
+    OrderGateway gateway(engine);
+    ASSERT_TRUE(gateway.start());
+
+    // Many orders in one segment, the last one split across two sends
+    constexpr int COUNT = 200;
+    std::vector<NewOrderMessage> orders;
+    for (int i = 0; i < COUNT; ++i) {
+        orders.push_back(new_order(symbol_id, static_cast<uint64_t>(i + 1), Side::BUY, 1.0,
+                                   1.0 + static_cast<double>(i) / 100.0));
+    }
+    TestClient client(gateway.port());
+    ASSERT_TRUE(client.connected());
+    const char* bytes = reinterpret_cast<const char*>(orders.data());
+    size_t total = orders.size() * sizeof(NewOrderMessage);
+    client.send_bytes(bytes, total - 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    client.send_bytes(bytes + total - 10, 10);
+
+    for (int i = 0; i < COUNT; ++i) {
+        AckMessage ack;
+        ASSERT_TRUE(client.receive(ack)) << i;
+        EXPECT_EQ(ack.client_order_id, static_cast<uint64_t>(i + 1));
+        EXPECT_EQ(ack.status, AckStatus::ACCEPTED);
+    }
+    EXPECT_EQ(gateway.messages_received(), COUNT);
+    EXPECT_EQ(gateway.messages_sent(), COUNT);
+    EXPECT_LT(gateway.write_calls(), gateway.messages_sent());
+
+    // A header no message can have ends the session
+    TestClient broken(gateway.port());
+    ASSERT_TRUE(broken.connected());
+    MessageHeader header{1, MessageType::NEW_ORDER};
+    broken.send(header);
+    EXPECT_TRUE(broken.closed());
+
+    gateway.stop();
+    engine.stop();
+    EXPECT_EQ(engine.book(symbol_id)->order_count(), static_cast<size_t>(COUNT));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "network/protocol.hpp"
+#include <cstring>
+#include <vector>
+
+using namespace trading_engine::network;
+using namespace trading_engine::orderbook;
+
+TEST(ProtocolTest, FramesCompleteMessagesOnly) {
+    NewOrderMessage order;
+    order.symbol_id = 3;
+    order.client_order_id = 77;
+    order.price = Price(101.5).raw_value();
+    order.quantity = Quantity(2.0).raw_value();
+    order.side = Side::SELL;
+
+    // Two messages back to back, the second cut short
+    std::vector<char> buffer(sizeof(order) + sizeof(CancelMessage));
+    std::memcpy(buffer.data(), &order, sizeof(order));
+    CancelMessage cancel;
+    cancel.client_order_id = 77;
+    std::memcpy(buffer.data() + sizeof(order), &cancel, sizeof(cancel));
+
+    auto header = peek_message(buffer.data(), buffer.size());
+    ASSERT_TRUE(header);
+    EXPECT_EQ(header->type, MessageType::NEW_ORDER);
+    EXPECT_EQ(header->length, sizeof(NewOrderMessage));
+    EXPECT_FALSE(peek_message(buffer.data(), sizeof(order) - 1));
+    EXPECT_FALSE(peek_message(buffer.data() + sizeof(order), sizeof(cancel) - 1));
+    auto second = peek_message(buffer.data() + sizeof(order), sizeof(cancel));
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->type, MessageType::CANCEL);
+
+    // A length that can't be right breaks the framing
+    MessageHeader broken{2, MessageType::NEW_ORDER};
+    std::memcpy(buffer.data(), &broken, sizeof(broken));
+    header = peek_message(buffer.data(), buffer.size());
+    ASSERT_TRUE(header);
+    EXPECT_EQ(header->length, 0);
+}
+
+TEST(ProtocolTest, ConvertsToEngineCommands) {
+    NewOrderMessage order;
+    order.symbol_id = 3;
+    order.client_order_id = 77;
+    order.price = Price(101.5).raw_value();
+    order.quantity = Quantity(2.0).raw_value();
+    order.side = Side::SELL;
+    order.time_in_force = TimeInForce::IOC;
+
+    auto command = to_command(read_message<NewOrderMessage>(reinterpret_cast<const char*>(&order)), 1234);
+    ASSERT_TRUE(command);
+    EXPECT_EQ(command->type, CommandType::NEW);
+    EXPECT_EQ(command->order_id, 1234);
+    EXPECT_EQ(command->symbol_id, 3);
+    EXPECT_EQ(command->side, Side::SELL);
+    EXPECT_EQ(command->price, Price(101.5));
+    EXPECT_EQ(command->quantity, Quantity(2.0));
+    EXPECT_EQ(command->time_in_force, TimeInForce::IOC);
+
+    // Out-of-range fields are refused
+    NewOrderMessage bad = order;
+    bad.side = static_cast<Side>(7);
+    EXPECT_FALSE(to_command(bad, 1));
+    bad = order;
+    bad.order_type = OrderType::CANCEL;
+    EXPECT_FALSE(to_command(bad, 1));
+    bad = order;
+    bad.quantity = 0;
+    EXPECT_FALSE(to_command(bad, 1));
+    for (int64_t price : {int64_t{0}, int64_t{-1}, Price::MIN_VALUE.raw_value()}) {
+        bad = order;
+        bad.price = price;
+        EXPECT_FALSE(to_command(bad, 1));
+        bad.order_type = OrderType::STOP;   // No limit price, but the stop price must be positive
+        bad.aux_price = price;
+        EXPECT_FALSE(to_command(bad, 1));
+    }
+
+    // Market orders carry no price
+    bad = order;
+    bad.order_type = OrderType::MARKET;
+    bad.price = 0;
+    EXPECT_TRUE(to_command(bad, 1));
+
+    ModifyMessage modify;
+    modify.symbol_id = 3;
+    modify.quantity = Quantity(1.0).raw_value();
+    modify.modify_flags = OrderCommand::MODIFY_QUANTITY;
+    command = to_command(modify, 1234);
+    ASSERT_TRUE(command);
+    EXPECT_EQ(command->type, CommandType::MODIFY);
+    EXPECT_FALSE(command->new_price());
+    EXPECT_EQ(command->new_quantity(), Quantity(1.0));
+    modify.modify_flags = 0;
+    EXPECT_FALSE(to_command(modify, 1234));
+    modify.modify_flags = OrderCommand::MODIFY_PRICE;
+    modify.price = Price::MIN_VALUE.raw_value();
+    EXPECT_FALSE(to_command(modify, 1234));
+}
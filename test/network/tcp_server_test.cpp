@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "network/tcp_server.hpp"
+#include "test_client.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::network;
+using namespace trading_engine::network::testing;
+
+namespace {
+
+// Echoes every message back and remembers which connection sent it
+class EchoHandler : public TcpHandler {
+public:
+    explicit EchoHandler(TcpServer& server) : server_(server) {}
+
+    bool on_message(TcpConnection& connection, const MessageHeader& header, const char* data) override {
+        indices.push_back(connection.index);
+        return server_.queue(connection, data, header.length);
+    }
+
+    std::vector<size_t> indices;
+
+private:
+    TcpServer& server_;
+};
+
+// Poll until `done` holds or a second passes
+template <typename Predicate>
+bool poll_until(TcpServer& server, TcpHandler& handler, Predicate done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        server.poll(1, handler);
+        server.flush_pending();
+    }
+    return true;
+}
+
+CancelMessage cancel(uint64_t client_id) {
+    CancelMessage message;
+    message.client_order_id = client_id;
+    return message;
+}
+
+} // namespace
+
+TEST(TcpServerTest, FramesSplitMessages) {
+    TcpServer server(TcpServerConfig{}, "TcpServerTest");
+    ASSERT_TRUE(server.open());
+    ASSERT_NE(server.port(), 0);
+    EchoHandler handler(server);
+
+    TestClient client(server.port());
+    ASSERT_TRUE(client.connected());
+
+    // Two messages arriving in three pieces, the first cut mid-header
+    CancelMessage messages[2] = {cancel(1), cancel(2)};
+    const char* bytes = reinterpret_cast<const char*>(messages);
+    client.send_bytes(bytes, 3);
+    ASSERT_TRUE(poll_until(server, handler, [&] { return server.connection_count() == 1; }));
+    client.send_bytes(bytes + 3, sizeof(CancelMessage));
+    client.send_bytes(bytes + 3 + sizeof(CancelMessage), sizeof(CancelMessage) - 3);
+    ASSERT_TRUE(poll_until(server, handler, [&] { return handler.indices.size() == 2; }));
+
+    CancelMessage echoed[2];
+    ASSERT_TRUE(client.receive_bytes(echoed, sizeof(echoed)));
+    EXPECT_EQ(echoed[0].client_order_id, 1);
+    EXPECT_EQ(echoed[1].client_order_id, 2);
+    EXPECT_EQ(server.messages_sent(), 2);
+}
+
+TEST(TcpServerTest, ReusesIndicesOnlyWhenAsked) {
+    for (bool reuse : {true, false}) {
+        TcpServerConfig config;
+        config.reuse_indices = reuse;
+        TcpServer server(config, "TcpServerTest");
+        ASSERT_TRUE(server.open());
+        EchoHandler handler(server);
+
+        {
+            TestClient first(server.port());
+            CancelMessage message = cancel(1);
+            first.send_bytes(&message, sizeof(message));
+            ASSERT_TRUE(poll_until(server, handler, [&] { return handler.indices.size() == 1; }));
+        }
+        ASSERT_TRUE(poll_until(server, handler, [&] { return server.connection_count() == 0; }));
+
+        TestClient second(server.port());
+        CancelMessage message = cancel(2);
+        second.send_bytes(&message, sizeof(message));
+        ASSERT_TRUE(poll_until(server, handler, [&] { return handler.indices.size() == 2; }));
+        EXPECT_EQ(handler.indices[1], reuse ? 0u : 1u);
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "market/matching_engine.hpp"
+#include "network/protocol.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace trading_engine {
+namespace network {
+namespace testing {
+
+// Loopback address for `port`
+inline sockaddr_in loopback(uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    return address;
+}
+
+// Make blocking receives on `fd` give up after five seconds
+inline void set_receive_timeout(int fd) {
+    timeval timeout{5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+/**
+ * TestClient - blocking TCP client for the gateway, publisher and server tests
+ *
+ * Sends use MSG_NOSIGNAL, since the server under test may already have
+ * dropped the connection; receives time out after five seconds.
+ */
+class TestClient {
+public:
+    explicit TestClient(uint16_t port) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        set_receive_timeout(fd_);
+        sockaddr_in address = loopback(port);
+        connected_ = ::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    }
+    ~TestClient() { close(); }
+
+    TestClient(const TestClient&) = delete;
+    TestClient& operator=(const TestClient&) = delete;
+
+    bool connected() const { return connected_; }
+
+    template <typename T>
+    void send(const T& message) { send_bytes(&message, sizeof(message)); }
+    void send_bytes(const void* data, size_t size) { ::send(fd_, data, size, MSG_NOSIGNAL); }
+
+    // Read exactly `size` bytes (false on timeout or close)
+    bool receive_bytes(void* data, size_t size) {
+        char* bytes = static_cast<char*>(data);
+        size_t got = 0;
+        while (got < size) {
+            ssize_t count = ::recv(fd_, bytes + got, size - got, 0);
+            if (count <= 0) {
+                return false;
+            }
+            got += static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    // Read exactly one message of type T (false on timeout or another type)
+    template <typename T>
+    bool receive(T& message) {
+        char buffer[sizeof(T)];
+        if (!receive_bytes(buffer, sizeof(buffer))) {
+            return false;
+        }
+        std::memcpy(&message, buffer, sizeof(T));
+        return message.header.type == T{}.header.type;
+    }
+
+    // True once the server has closed the connection
+    bool closed() {
+        char byte;
+        return ::recv(fd_, &byte, 1, 0) == 0;
+    }
+
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+private:
+    int fd_ = -1;
+    bool connected_ = false;
+};
+
+// Engine with market-data buses, as the gateway and publisher need
+inline market::MatchingEngineConfig engine_config() {
+    market::MatchingEngineConfig config;
+    config.queue_capacity = 4096;
+    config.market_data_bus_capacity = 8192;
+    return config;
+}
+
+} // namespace testing
+} // namespace network
+} // namespace trading_engine
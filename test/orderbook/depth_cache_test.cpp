@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include "orderbook/depth_cache.hpp"
+#include "orderbook/book_side.hpp"
+#include "orderbook/order_book.hpp"
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace trading_engine::orderbook;
+
+TEST(DepthCacheTest, KeepsPriorityOrder) {
+    DepthCache depth(3);
+    
+    depth.update_level(Side::BUY, Price(99.0), Quantity(1.0), 1);
+    depth.update_level(Side::BUY, Price(101.0), Quantity(2.0), 1);
+    depth.update_level(Side::BUY, Price(100.0), Quantity(3.0), 2);
+    depth.update_level(Side::SELL, Price(103.0), Quantity(4.0), 1);
+    depth.update_level(Side::SELL, Price(102.0), Quantity(5.0), 1);
+    
+    ASSERT_EQ(depth.bids().size(), 3);
+    EXPECT_EQ(depth.bids()[0].price, Price(101.0));
+    EXPECT_EQ(depth.bids()[1].price, Price(100.0));
+    EXPECT_EQ(depth.bids()[1].order_count, 2);
+    EXPECT_EQ(depth.bids()[2].price, Price(99.0));
+    
+    ASSERT_EQ(depth.asks().size(), 2);
+    EXPECT_EQ(depth.asks()[0].price, Price(102.0));
+    EXPECT_EQ(depth.asks()[1].quantity, Quantity(4.0));
+}
+
+TEST(DepthCacheTest, FullSideDropsWorstLevel) {
+    DepthCache depth(2);
+    
+    depth.update_level(Side::SELL, Price(10.0), Quantity(1.0), 1);
+    depth.update_level(Side::SELL, Price(11.0), Quantity(1.0), 1);
+    
+    // Worse than everything cached: no change, no new sequence
+    uint64_t sequence = depth.sequence();
+    depth.update_level(Side::SELL, Price(12.0), Quantity(1.0), 1);
+    EXPECT_EQ(depth.sequence(), sequence);
+    
+    // Better than the worst: pushes it out
+    depth.update_level(Side::SELL, Price(9.0), Quantity(1.0), 1);
+    EXPECT_GT(depth.sequence(), sequence);
+    ASSERT_EQ(depth.asks().size(), 2);
+    EXPECT_EQ(depth.asks()[0].price, Price(9.0));
+    EXPECT_EQ(depth.asks()[1].price, Price(10.0));
+}
+
+TEST(DepthCacheTest, RemoveRefillsFromBook) {
+    BookSide side(Side::BUY);
+    for (double price : {100.0, 99.0, 98.0}) {
+        auto order = std::make_shared<Order>(static_cast<OrderId>(price), "AAPL", Side::BUY,
+                                             OrderType::LIMIT, Quantity(1.0), Price(price));
+        side.find_or_create(Price(price))->add_order(order);
+    }
+    
+    DepthCache depth(2);
+    depth.rebuild(side);
+    ASSERT_EQ(depth.bids().size(), 2);
+    
+    // The best level goes; 98 moves up into the last slot
+    side.erase(Price(100.0));
+    depth.remove_level(Side::BUY, Price(100.0), side);
+    ASSERT_EQ(depth.bids().size(), 2);
+    EXPECT_EQ(depth.bids()[0].price, Price(99.0));
+    EXPECT_EQ(depth.bids()[1].price, Price(98.0));
+}
+
+TEST(DepthCacheTest, BookDepthView) {
+    OrderBookConfig config;
+    config.depth_levels = 2;
+    OrderBook book("AAPL", config);
+    
+    auto bids = book.bid_depth();
+    EXPECT_TRUE(bids.empty());
+    
+    book.add_order(std::make_shared<Order>(1, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(5.0), Price(100.0)));
+    book.add_order(std::make_shared<Order>(2, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(3.0), Price(100.0)));
+    book.add_order(std::make_shared<Order>(3, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(2.0), Price(99.0)));
+    book.add_order(std::make_shared<Order>(4, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(98.0)));
+    
+    // The view tracks the book without being fetched again
+    ASSERT_EQ(book.bid_depth().size(), 2);
+    EXPECT_EQ(book.bid_depth()[0].quantity, Quantity(8.0));
+    EXPECT_EQ(book.bid_depth()[0].order_count, 2);
+    EXPECT_EQ(bids.data(), book.bid_depth().data());
+    
+    // A taker clears the top level and part of the next
+    uint64_t sequence = book.depth_sequence();
+    book.add_order(std::make_shared<Order>(5, "AAPL", Side::SELL, OrderType::MARKET, Quantity(9.0), Price(0.0)));
+    EXPECT_GT(book.depth_sequence(), sequence);
+    
+    ASSERT_EQ(book.bid_depth().size(), 2);
+    EXPECT_EQ(book.bid_depth()[0].price, Price(99.0));
+    EXPECT_EQ(book.bid_depth()[0].quantity, Quantity(1.0));
+    EXPECT_EQ(book.bid_depth()[1].price, Price(98.0));
+}
+
+TEST(DepthCacheTest, MatchesFullRebuildUnderRandomFlow) {
+    OrderBookConfig config;
+    config.depth_levels = 5;
+    OrderBook book("AAPL", config);
+    
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> side_dist(0, 1);
+    std::uniform_int_distribution<int> price_dist(95, 105);
+    std::uniform_int_distribution<int> qty_dist(1, 10);
+    std::uniform_int_distribution<int> action_dist(0, 9);
+    
+    for (OrderId id = 1; id <= 2000; ++id) {
+        if (action_dist(rng) < 3 && id > 10) {
+            book.cancel_order(id - 10);
+            continue;
+        }
+        Side side = side_dist(rng) ? Side::BUY : Side::SELL;
+        book.add_order(std::make_shared<Order>(id, "AAPL", side, OrderType::LIMIT,
+                                               Quantity(static_cast<double>(qty_dist(rng))),
+                                               Price(static_cast<double>(price_dist(rng)))));
+        
+        auto bids = book.get_bids();
+        auto asks = book.get_asks();
+        ASSERT_EQ(book.bid_depth().size(), std::min<size_t>(bids.size(), 5));
+        ASSERT_EQ(book.ask_depth().size(), std::min<size_t>(asks.size(), 5));
+        
+        auto bid = bids.begin();
+        for (const DepthLevel& level : book.bid_depth()) {
+            ASSERT_EQ(level.price, bid->first);
+            ASSERT_EQ(level.quantity, bid->second);
+            ++bid;
+        }
+        auto ask = asks.begin();
+        for (const DepthLevel& level : book.ask_depth()) {
+            ASSERT_EQ(level.price, ask->first);
+            ASSERT_EQ(level.quantity, ask->second);
+            ++ask;
+        }
+    }
+}
+
+TEST(DepthCacheTest, ColumnsMirrorLevels) {
+    DepthCache depth(3);
+    BookSide bids(Side::BUY);
+    depth.update_level(Side::BUY, Price(100.0), Quantity(5.0), 1);
+    depth.update_level(Side::BUY, Price(102.0), Quantity(1.0), 1);
+    depth.update_level(Side::BUY, Price(101.0), Quantity(2.0), 1);
+    depth.update_level(Side::BUY, Price(100.0), Quantity(4.0), 2);
+    depth.remove_level(Side::BUY, Price(101.0), bids);
+    
+    ASSERT_EQ(depth.prices(Side::BUY).size(), 2);
+    ASSERT_EQ(depth.quantities(Side::BUY).size(), 2);
+    for (size_t i = 0; i < depth.bids().size(); ++i) {
+        EXPECT_EQ(depth.prices(Side::BUY)[i], depth.bids()[i].price.raw_value());
+        EXPECT_EQ(depth.quantities(Side::BUY)[i], depth.bids()[i].quantity.raw_value());
+    }
+    EXPECT_TRUE(depth.prices(Side::SELL).empty());
+    EXPECT_FALSE(depth.is_full(Side::BUY));
+}
+
+TEST(DepthCacheTest, SweepCostAndDepthWithin) {
+    OrderBookConfig config;
+    config.depth_levels = 2;   // Small, so queries also run past the cache
+    OrderBook book("AAPL", config);
+    book.add_order(std::make_shared<Order>(1, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(2.0), Price(100.0)));
+    book.add_order(std::make_shared<Order>(2, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(3.0), Price(101.0)));
+    book.add_order(std::make_shared<Order>(3, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(103.0)));
+    book.add_order(std::make_shared<Order>(4, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(4.0), Price(99.0)));
+    
+    // 2 @ 100 + 3 @ 101 + 1 @ 103 = 606, 6 above buying all 6 at 100
+    SweepCost cost = book.sweep_cost(Side::BUY, Quantity(6.0));
+    EXPECT_TRUE(cost.complete);
+    EXPECT_EQ(cost.filled, Quantity(6.0));
+    EXPECT_EQ(cost.notional, Price(606.0).raw_value());
+    EXPECT_EQ(cost.impact, Price(6.0).raw_value());
+    EXPECT_EQ(cost.average_price, Price(101.0));
+    EXPECT_EQ(cost.worst_price, Price(103.0));
+    EXPECT_EQ(cost.levels, 3);
+    
+    // Inside the first level, and more than the side holds
+    cost = book.sweep_cost(Side::BUY, Quantity(1.0));
+    EXPECT_EQ(cost.notional, Price(100.0).raw_value());
+    EXPECT_EQ(cost.impact, 0);
+    EXPECT_EQ(cost.levels, 1);
+    cost = book.sweep_cost(Side::BUY, Quantity(20.0));
+    EXPECT_FALSE(cost.complete);
+    EXPECT_EQ(cost.filled, Quantity(10.0));
+    
+    // Selling takes the bids; impact is measured the other way
+    cost = book.sweep_cost(Side::SELL, Quantity(4.0));
+    EXPECT_TRUE(cost.complete);
+    EXPECT_EQ(cost.notional, Price(396.0).raw_value());
+    EXPECT_EQ(cost.impact, 0);
+    
+    // The default tick is one raw unit, so spell the distances out in ticks
+    const uint32_t one_dollar = static_cast<uint32_t>(Price(1.0).raw_value());
+    EXPECT_EQ(book.depth_within(Side::SELL, 0), Quantity(2.0));
+    EXPECT_EQ(book.depth_within(Side::SELL, one_dollar), Quantity(5.0));
+    EXPECT_EQ(book.depth_within(Side::SELL, 3 * one_dollar), Quantity(10.0));
+    EXPECT_EQ(book.depth_within(Side::BUY, 3 * one_dollar), Quantity(4.0));
+    
+    book.clear();
+    EXPECT_EQ(book.depth_within(Side::SELL, one_dollar), Quantity::ZERO);
+    EXPECT_EQ(book.sweep_cost(Side::BUY, Quantity(1.0)).filled, Quantity::ZERO);
+}
+
+TEST(DepthCacheTest, QueriesMatchBookWalkUnderRandomFlow) {
+    OrderBookConfig config;
+    config.use_price_ladder = true;
+    config.tick_size = Price(0.01);
+    config.depth_levels = 8;
+    OrderBook book("AAPL", config);
+    
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> ticks_dist(-40, 40);
+    std::uniform_int_distribution<int> qty_dist(1, 20);
+    for (OrderId id = 1; id <= 3000; ++id) {
+        Side side = ticks_dist(rng) < 0 ? Side::BUY : Side::SELL;
+        int offset = std::abs(ticks_dist(rng)) + 1;
+        Price price(Price(100.0).raw_value() + (side == Side::BUY ? -offset : offset) * Price(0.01).raw_value());
+        book.add_order(std::make_shared<Order>(id, "AAPL", side, OrderType::LIMIT,
+                                               Quantity(static_cast<double>(qty_dist(rng))), price));
+        if (id % 4 == 0) {
+            book.cancel_order(id - 3);
+        }
+        if (id % 50 != 0) {
+            continue;
+        }
+        
+        // Naive answers from the full level maps
+        auto asks = book.get_asks();
+        int64_t wanted = Quantity(static_cast<double>(qty_dist(rng) * 5)).raw_value();
+        int64_t taken = 0;
+        __extension__ using wide = __int128;
+        wide paid = 0;
+        for (const auto& [level_price, quantity] : asks) {
+            int64_t part = std::min(quantity.raw_value(), wanted - taken);
+            paid += static_cast<wide>(level_price.raw_value()) * part;
+            taken += part;
+            if (taken == wanted) {
+                break;
+            }
+        }
+        SweepCost cost = book.sweep_cost(Side::BUY, Quantity(wanted));
+        ASSERT_EQ(cost.filled.raw_value(), taken);
+        ASSERT_EQ(cost.notional, static_cast<int64_t>(paid / Quantity::SCALE_FACTOR));
+        
+        auto bids = book.get_bids();
+        for (uint32_t ticks : {0u, 3u, 12u, 100u}) {
+            int64_t total = 0;
+            if (!bids.empty()) {
+                Price limit(bids.begin()->first.raw_value() - static_cast<int64_t>(ticks) * Price(0.01).raw_value());
+                for (const auto& [level_price, quantity] : bids) {
+                    if (level_price < limit) {
+                        break;
+                    }
+                    total += quantity.raw_value();
+                }
+            }
+            ASSERT_EQ(book.depth_within(Side::BUY, ticks).raw_value(), total) << ticks;
+        }
+    }
+}
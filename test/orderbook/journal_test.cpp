@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "orderbook/journal.hpp"
+#include "orderbook/order_book.hpp"
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+class JournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = (std::filesystem::temp_directory_path() /
+                      ("journal_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(directory_);
+        symbol_id_ = SymbolRegistry::global().intern("JRNL");
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+    
+    JournalConfig config(size_t records_per_segment) const {
+        JournalConfig config;
+        config.directory = directory_;
+        config.records_per_segment = records_per_segment;
+        return config;
+    }
+    
+    std::string directory_;
+    SymbolId symbol_id_ = INVALID_SYMBOL_ID;
+};
+
+TEST_F(JournalTest, AppendAndReadAcrossSegments) {
+    {
+        Journal journal(config(4));
+        ASSERT_TRUE(journal.open());
+        for (OrderId id = 1; id <= 10; ++id) {
+            auto command = OrderCommand::new_order(symbol_id_, id, Side::BUY, OrderType::LIMIT,
+                                                   Quantity(1.0), Price(100.0));
+            EXPECT_EQ(journal.append(command, static_cast<Timestamp>(id * 10)), id);
+        }
+        EXPECT_EQ(journal.segment_index(), 2);
+    }
+    
+    EXPECT_EQ(Journal::list_segments(directory_).size(), 3);
+    
+    JournalReader reader(directory_);
+    OrderId expected = 1;
+    while (const JournalRecord* record = reader.next()) {
+        EXPECT_EQ(record->sequence, expected);
+        EXPECT_EQ(record->timestamp, static_cast<Timestamp>(expected * 10));
+        EXPECT_EQ(record->command.order_id, expected);
+        ++expected;
+    }
+    EXPECT_EQ(reader.records_read(), 10);
+}
+
+TEST_F(JournalTest, ReopenResumesAfterLastRecord) {
+    {
+        Journal journal(config(8));
+        ASSERT_TRUE(journal.open());
+        journal.append(OrderCommand::cancel(symbol_id_, 1));
+        journal.append(OrderCommand::cancel(symbol_id_, 2));
+    }
+    
+    // Segment size comes from the existing file, not the new config
+    Journal journal(config(64));
+    ASSERT_TRUE(journal.open());
+    EXPECT_EQ(journal.last_sequence(), 2);
+    EXPECT_EQ(journal.append(OrderCommand::cancel(symbol_id_, 3)), 3);
+    journal.close();
+    
+    JournalReader reader(directory_);
+    while (reader.next()) {
+    }
+    EXPECT_EQ(reader.records_read(), 3);
+}
+
+TEST_F(JournalTest, ReplayIsDeterministic) {
+    OrderBook live(symbol_id_);
+    MatchBuffer live_fills(4096);
+    
+    {
+        Journal journal(config(256));
+        ASSERT_TRUE(journal.open());
+        
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> price_dist(95, 105);
+        std::uniform_int_distribution<int> qty_dist(1, 10);
+        std::uniform_int_distribution<int> action_dist(0, 9);
+        
+        for (OrderId id = 1; id <= 1000; ++id) {
+            OrderCommand command;
+            int action = action_dist(rng);
+            if (action < 2 && id > 5) {
+                command = OrderCommand::cancel(symbol_id_, id - 5);
+            } else if (action < 3 && id > 5) {
+                command = OrderCommand::modify(symbol_id_, id - 3, Price(static_cast<double>(price_dist(rng))),
+                                               std::nullopt);
+            } else {
+                Side side = action % 2 ? Side::BUY : Side::SELL;
+                command = OrderCommand::new_order(symbol_id_, id, side, OrderType::LIMIT,
+                                                  Quantity(static_cast<double>(qty_dist(rng))),
+                                                  Price(static_cast<double>(price_dist(rng))));
+            }
+            
+            // Write ahead, then apply at the journaled time
+            Timestamp now = current_timestamp();
+            ASSERT_NE(journal.append(command, now), 0);
+            live.apply(command, now, live_fills);
+        }
+    }
+    
+    OrderBook recovered(symbol_id_);
+    MatchBuffer replay_fills(4096);
+    JournalReader reader(directory_);
+    EXPECT_EQ(replay_journal(reader, recovered, replay_fills), 1000);
+    
+    ASSERT_EQ(replay_fills.size(), live_fills.size());
+    for (size_t i = 0; i < live_fills.size(); ++i) {
+        EXPECT_EQ(replay_fills[i].maker_order_id, live_fills[i].maker_order_id);
+        EXPECT_EQ(replay_fills[i].taker_order_id, live_fills[i].taker_order_id);
+        EXPECT_EQ(replay_fills[i].match_price, live_fills[i].match_price);
+        EXPECT_EQ(replay_fills[i].match_quantity, live_fills[i].match_quantity);
+        EXPECT_EQ(replay_fills[i].timestamp, live_fills[i].timestamp);
+    }
+    EXPECT_EQ(recovered.get_bids(), live.get_bids());
+    EXPECT_EQ(recovered.get_asks(), live.get_asks());
+    EXPECT_EQ(recovered.order_count(), live.order_count());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "orderbook/market_data.hpp"
+#include "orderbook/order_book.hpp"
+#include <memory>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+class MarketDataTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        book_.set_market_data_ring(&ring_);
+    }
+    
+    OrderPtr limit(OrderId id, Side side, double qty, double price) {
+        return std::make_shared<Order>(id, "AAPL", side, OrderType::LIMIT, Quantity(qty), Price(price));
+    }
+    
+    std::vector<MarketDataEvent> drain() {
+        std::vector<MarketDataEvent> events;
+        MarketDataEvent event;
+        while (ring_.try_pop(event)) {
+            events.push_back(event);
+        }
+        return events;
+    }
+    
+    MarketDataRing ring_{64};
+    OrderBook book_{"AAPL"};
+};
+
+TEST_F(MarketDataTest, AddAndCancel) {
+    book_.add_order(limit(1, Side::BUY, 10.0, 100.0));
+    book_.cancel_order(1);
+    
+    auto events = drain();
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events[0].type, MarketDataEventType::ORDER_ADDED);
+    EXPECT_EQ(events[0].order_id, 1);
+    EXPECT_EQ(events[0].side, Side::BUY);
+    EXPECT_EQ(events[0].price, Price(100.0));
+    EXPECT_EQ(events[0].quantity, Quantity(10.0));
+    EXPECT_EQ(events[0].symbol_id, book_.symbol_id());
+    EXPECT_EQ(events[1].type, MarketDataEventType::LEVEL_CHANGED);
+    EXPECT_EQ(events[1].quantity, Quantity(10.0));
+    EXPECT_EQ(events[2].type, MarketDataEventType::ORDER_DELETED);
+    EXPECT_EQ(events[3].type, MarketDataEventType::LEVEL_CHANGED);
+    EXPECT_EQ(events[3].quantity, Quantity::ZERO);
+    
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].sequence, i + 1);
+    }
+}
+
+TEST_F(MarketDataTest, TradeAndReduce) {
+    book_.add_order(limit(1, Side::SELL, 10.0, 101.0));
+    book_.add_order(limit(2, Side::BUY, 4.0, 101.0));
+    book_.modify_order(1, std::nullopt, Quantity(8.0));
+    
+    auto events = drain();
+    ASSERT_EQ(events.size(), 6);
+    
+    // Taker 2 fills against maker 1; the taker never rests
+    EXPECT_EQ(events[2].type, MarketDataEventType::TRADE);
+    EXPECT_EQ(events[2].order_id, 1);
+    EXPECT_EQ(events[2].match_id, 2);
+    EXPECT_EQ(events[2].side, Side::SELL);
+    EXPECT_EQ(events[2].quantity, Quantity(4.0));
+    EXPECT_EQ(events[3].type, MarketDataEventType::LEVEL_CHANGED);
+    EXPECT_EQ(events[3].quantity, Quantity(6.0));
+    
+    // Quantity 10 -> 8 with 4 executed removes 2 from the resting remainder
+    EXPECT_EQ(events[4].type, MarketDataEventType::ORDER_REDUCED);
+    EXPECT_EQ(events[4].quantity, Quantity(2.0));
+    EXPECT_EQ(events[5].quantity, Quantity(4.0));
+}
+
+TEST_F(MarketDataTest, FullRingCountsDrops) {
+    MarketDataRing small(2);
+    book_.set_market_data_ring(&small);
+    
+    book_.add_order(limit(1, Side::BUY, 1.0, 100.0));
+    book_.add_order(limit(2, Side::BUY, 1.0, 99.0));
+    
+    EXPECT_EQ(book_.market_data_sequence(), 4);
+    EXPECT_EQ(book_.market_data_dropped(), 2);
+    
+    MarketDataEvent event;
+    ASSERT_TRUE(small.try_pop(event));
+    EXPECT_EQ(event.sequence, 1);
+    
+    // Detached books stop publishing
+    book_.set_market_data_ring(nullptr);
+    book_.cancel_order(1);
+    EXPECT_EQ(book_.market_data_sequence(), 4);
+}
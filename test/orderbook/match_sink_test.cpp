@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "orderbook/match_sink.hpp"
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+TEST(MatchSinkTest, BufferCollectsMatches) {
+    MatchBuffer buffer(8);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_GE(buffer.capacity(), 8);
+    
+    buffer.on_match(OrderMatch(1, 2, Price(100.0), Quantity(5.0)));
+    buffer.on_match(OrderMatch(3, 2, Price(101.0), Quantity(1.0)));
+    
+    ASSERT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer[0].maker_order_id, 1);
+    EXPECT_EQ(buffer[1].match_price, Price(101.0));
+    EXPECT_EQ(buffer.matches().size(), 2);
+    
+    Quantity total = Quantity::ZERO;
+    for (const OrderMatch& match : buffer) {
+        total = total + match.match_quantity;
+    }
+    EXPECT_EQ(total, Quantity(6.0));
+}
+
+TEST(MatchSinkTest, ClearKeepsCapacity) {
+    MatchBuffer buffer(4);
+    for (int i = 0; i < 4; ++i) {
+        buffer.on_match(OrderMatch(i, 100, Price(100.0), Quantity(1.0)));
+    }
+    size_t capacity = buffer.capacity();
+    
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST(MatchSinkTest, CallbackSink) {
+    std::vector<OrderId> makers;
+    auto sink = make_match_sink([&](const OrderMatch& match) { makers.push_back(match.maker_order_id); });
+    
+    MatchSink& base = sink;
+    base.on_match(OrderMatch(7, 1, Price(100.0), Quantity(1.0)));
+    base.on_match(OrderMatch(8, 1, Price(100.0), Quantity(1.0)));
+    
+    EXPECT_EQ(makers, (std::vector<OrderId>{7, 8}));
+}
+
+TEST(MatchSinkTest, ToString) {
+    OrderMatch match(1, 2, Price(100.5), Quantity(3.0));
+    std::string str = match.to_string();
+    EXPECT_NE(str.find("maker=1"), std::string::npos);
+    EXPECT_NE(str.find("taker=2"), std::string::npos);
+    EXPECT_NE(str.find("price=100.5000"), std::string::npos);
+}
@@ -354,7 +354,7 @@ TEST_F(OrderBookTest, MatchMarketOrders) {
     // Send a market buy order
     auto matches = order_book_->add_order(market_buy_); // Buy 10 @ market
     
-    EXPECT_EQ(matches.size(), 2);
+    ASSERT_EQ(matches.size(), 2);
     
     // First match against sell_order1_
     EXPECT_EQ(matches[0].maker_order_id, sell_order1_->id());
@@ -375,25 +375,42 @@ TEST_F(OrderBookTest, MatchMarketOrders) {
     // Send a market sell order
     matches = order_book_->add_order(market_sell_); // Sell 10 @ market
     
-    EXPECT_EQ(matches.size(), 2);
-    
-    // First match against buy_order1_
+    // buy_order1_ alone covers it, so buy_order2_ is never reached
+    ASSERT_EQ(matches.size(), 1);
     EXPECT_EQ(matches[0].maker_order_id, buy_order1_->id());
     EXPECT_EQ(matches[0].taker_order_id, market_sell_->id());
     EXPECT_EQ(matches[0].match_price.to_double(), 100.0);
     EXPECT_EQ(matches[0].match_quantity.to_double(), 10.0);
     
-    // Second match against buy_order2_
-    EXPECT_EQ(matches[1].maker_order_id, buy_order2_->id());
-    EXPECT_EQ(matches[1].taker_order_id, market_sell_->id());
-    EXPECT_EQ(matches[1].match_price.to_double(), 99.0);
-    EXPECT_EQ(matches[1].match_quantity.to_double(), 0.0);
-    
     EXPECT_EQ(buy_order1_->status(), OrderStatus::FILLED);
-    EXPECT_EQ(buy_order2_->status(), OrderStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(buy_order2_->status(), OrderStatus::ACCEPTED);
+    EXPECT_EQ(buy_order2_->remaining_quantity().to_double(), 5.0);
     EXPECT_EQ(market_sell_->status(), OrderStatus::FILLED);
 }
 
+TEST_F(OrderBookTest, RejectsLiveOrderId) {
+    order_book_->add_order(sell_order1_); // Sell 8 @ 102.0
+    
+    // Same id at another price, resting or as a stop: the first order keeps the id
+    auto reused = std::make_shared<Order>(sell_order1_->id(), "AAPL", Side::SELL, OrderType::LIMIT,
+                                          Quantity(1.0), Price(105.0));
+    order_book_->add_order(reused);
+    EXPECT_EQ(reused->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(order_book_->get_order(sell_order1_->id()), sell_order1_);
+    EXPECT_EQ(order_book_->ask_level_count(), 1);
+    
+    // Cancelling the id removes the original, leaving nothing stranded
+    EXPECT_TRUE(order_book_->cancel_order(sell_order1_->id()));
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    EXPECT_EQ(order_book_->order_count(), 0);
+    
+    // Once gone, the id can be used again
+    auto again = std::make_shared<Order>(sell_order1_->id(), "AAPL", Side::SELL, OrderType::LIMIT,
+                                         Quantity(1.0), Price(105.0));
+    order_book_->add_order(again);
+    EXPECT_EQ(order_book_->get_order(sell_order1_->id()), again);
+}
+
 TEST_F(OrderBookTest, IOCOrders) {
     // Add some limit orders
     order_book_->add_order(buy_order1_);  // Buy 10 @ 100.0
@@ -513,4 +530,592 @@ TEST_F(OrderBookTest, ToString) {
     EXPECT_NE(book_str.find("best_bid=100.0000"), std::string::npos);
     EXPECT_NE(book_str.find("best_ask=102.0000"), std::string::npos);
     EXPECT_NE(book_str.find("spread=2.0000"), std::string::npos);
-} 
\ No newline at end of file
+} 
+class LadderOrderBookTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Ladder with a 0.01 tick and a deliberately small window
+        OrderBookConfig config;
+        config.use_price_ladder = true;
+        config.tick_size = Price(0.01);
+        config.ladder_ticks = 64;
+        order_book_ = std::make_shared<OrderBook>("AAPL", config);
+    }
+    
+    OrderPtr make_order(OrderId id, Side side, double qty, double price,
+                        OrderType type = OrderType::LIMIT) {
+        return std::make_shared<Order>(id, "AAPL", side, type, Quantity(qty), Price(price));
+    }
+    
+    OrderBookPtr order_book_;
+};
+
+TEST_F(LadderOrderBookTest, AddAndQuery) {
+    order_book_->add_order(make_order(1, Side::BUY, 10.0, 100.0));
+    order_book_->add_order(make_order(2, Side::BUY, 5.0, 99.99));
+    order_book_->add_order(make_order(3, Side::SELL, 8.0, 100.02));
+    order_book_->add_order(make_order(4, Side::SELL, 6.0, 100.05));
+    
+    EXPECT_TRUE(order_book_->config().use_price_ladder);
+    EXPECT_EQ(order_book_->bid_level_count(), 2);
+    EXPECT_EQ(order_book_->ask_level_count(), 2);
+    EXPECT_EQ(order_book_->best_bid().value(), Price(100.0));
+    EXPECT_EQ(order_book_->best_ask().value(), Price(100.02));
+    EXPECT_EQ(order_book_->get_quantity_at_level(Price(99.99), Side::BUY), Quantity(5.0));
+    
+    auto bid_prices = order_book_->get_bid_prices();
+    ASSERT_EQ(bid_prices.size(), 2);
+    EXPECT_EQ(bid_prices[0], Price(100.0));
+    EXPECT_EQ(bid_prices[1], Price(99.99));
+    
+    auto asks = order_book_->get_asks();
+    EXPECT_EQ(asks.size(), 2);
+    EXPECT_EQ(asks[Price(100.05)], Quantity(6.0));
+}
+
+TEST_F(LadderOrderBookTest, RejectsPriceOutsideMaxWindow) {
+    // Default one-raw-unit tick, where an uncapped window would need a slot
+    // per raw unit between the two prices
+    OrderBookConfig config;
+    config.use_price_ladder = true;
+    config.ladder_max_ticks = 1 << 16;
+    OrderBook book("AAPL", config);
+    
+    book.add_order(make_order(1, Side::SELL, 1.0, 100.0));
+    auto far = make_order(2, Side::SELL, 1.0, 1000000.0);
+    book.add_order(far);
+    EXPECT_EQ(far->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.ask_level_count(), 1);
+    
+    // Amends are held to the same window
+    book.modify_order(1, Price(1000000.0), Quantity(1.0));
+    EXPECT_EQ(book.best_ask().value(), Price(100.0));
+    
+    // Prices within the cap still rest
+    auto near = make_order(3, Side::SELL, 1.0, 105.0);
+    book.add_order(near);
+    EXPECT_NE(near->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.ask_level_count(), 2);
+}
+
+TEST_F(LadderOrderBookTest, RejectsPricesAtTheEndsOfTheRange) {
+    // One-raw-unit tick: every price is on the grid, so only the range check
+    // stands between these and the window arithmetic
+    OrderBookConfig config;
+    config.use_price_ladder = true;
+    OrderBook book("AAPL", config);
+    book.add_order(make_order(1, Side::BUY, 1.0, 100.0));
+    
+    OrderId next_id = 2;
+    for (Price extreme : {Price::MIN_VALUE, Price::MAX_VALUE, Price(Price::MIN_VALUE.raw_value() + 1),
+                          Price(Price::MAX_VALUE.raw_value() - 1)}) {
+        for (Side side : {Side::BUY, Side::SELL}) {
+            auto order = std::make_shared<Order>(next_id++, "AAPL", side, OrderType::LIMIT, Quantity(1.0), extreme);
+            book.add_order(order);
+            EXPECT_EQ(order->status(), OrderStatus::REJECTED);
+        }
+    }
+    EXPECT_EQ(book.order_count(), 1);
+    EXPECT_EQ(book.best_bid().value(), Price(100.0));
+    EXPECT_FALSE(book.best_ask().has_value());
+    
+    // An empty ladder refuses them too
+    OrderBook empty("AAPL", config);
+    auto order = std::make_shared<Order>(next_id++, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(1.0),
+                                         Price::MAX_VALUE);
+    empty.add_order(order);
+    EXPECT_EQ(order->status(), OrderStatus::REJECTED);
+}
+
+TEST_F(LadderOrderBookTest, RejectsOffTickPrice) {
+    auto order = make_order(1, Side::BUY, 10.0, 100.005);
+    
+    auto matches = order_book_->add_order(order);
+    
+    EXPECT_TRUE(matches.empty());
+    EXPECT_EQ(order->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(order_book_->order_count(), 0);
+    EXPECT_EQ(order_book_->bid_level_count(), 0);
+}
+
+TEST_F(LadderOrderBookTest, SweepAcrossLevels) {
+    order_book_->add_order(make_order(1, Side::SELL, 2.0, 100.01));
+    order_book_->add_order(make_order(2, Side::SELL, 3.0, 100.02));
+    order_book_->add_order(make_order(3, Side::SELL, 4.0, 100.04));
+    
+    // Buy limit crosses the first two levels only
+    auto matches = order_book_->add_order(make_order(10, Side::BUY, 6.0, 100.03));
+    
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(matches[0].maker_order_id, 1);
+    EXPECT_EQ(matches[0].match_price, Price(100.01));
+    EXPECT_EQ(matches[1].maker_order_id, 2);
+    EXPECT_EQ(matches[1].match_quantity, Quantity(3.0));
+    
+    // Remainder rests at the limit price
+    EXPECT_EQ(order_book_->best_bid().value(), Price(100.03));
+    EXPECT_EQ(order_book_->get_quantity_at_level(Price(100.03), Side::BUY), Quantity(1.0));
+    EXPECT_EQ(order_book_->best_ask().value(), Price(100.04));
+    EXPECT_EQ(order_book_->ask_level_count(), 1);
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(4.0));
+    
+    // Market sell takes out the resting bid
+    matches = order_book_->add_order(make_order(11, Side::SELL, 1.0, 0.0, OrderType::MARKET));
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0].maker_order_id, 10);
+    EXPECT_FALSE(order_book_->best_bid().has_value());
+}
+
+TEST_F(LadderOrderBookTest, RecenterOnPriceDrift) {
+    order_book_->add_order(make_order(1, Side::BUY, 1.0, 100.0));
+    order_book_->add_order(make_order(2, Side::BUY, 1.0, 90.0));
+    order_book_->add_order(make_order(3, Side::BUY, 1.0, 110.0));
+    
+    EXPECT_EQ(order_book_->bid_level_count(), 3);
+    EXPECT_EQ(order_book_->best_bid().value(), Price(110.0));
+    
+    // Cancelling after the window moved still finds the order
+    EXPECT_TRUE(order_book_->cancel_order(1));
+    EXPECT_TRUE(order_book_->cancel_order(3));
+    EXPECT_EQ(order_book_->best_bid().value(), Price(90.0));
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(1.0));
+}
+
+TEST_F(OrderBookTest, AddOrderIntoSink) {
+    order_book_->add_order(sell_order1_);
+    order_book_->add_order(sell_order2_);
+    
+    // Sweep both ask levels, fills arrive in price-time order
+    std::vector<OrderMatch> fills;
+    auto sink = make_match_sink([&](const OrderMatch& match) { fills.push_back(match); });
+    
+    auto sweep = std::make_shared<Order>(4001, "AAPL", Side::BUY, OrderType::LIMIT,
+                                         Quantity(10.0), Price(103.0));
+    order_book_->add_order(sweep, sink);
+    
+    ASSERT_EQ(fills.size(), 2);
+    EXPECT_EQ(fills[0].maker_order_id, 2001);
+    EXPECT_EQ(fills[0].match_price, Price(102.0));
+    EXPECT_EQ(fills[0].match_quantity, Quantity(8.0));
+    EXPECT_EQ(fills[1].maker_order_id, 2002);
+    EXPECT_EQ(fills[1].match_price, Price(103.0));
+    EXPECT_EQ(fills[1].match_quantity, Quantity(2.0));
+    EXPECT_TRUE(sweep->is_filled());
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(4.0));
+}
+
+TEST_F(OrderBookTest, MatchBufferIsReused) {
+    MatchBuffer buffer(4);
+    size_t capacity = buffer.capacity();
+    
+    for (OrderId id = 1; id <= 50; ++id) {
+        auto maker = std::make_shared<Order>(id, "AAPL", Side::SELL, OrderType::LIMIT,
+                                             Quantity(1.0), Price(102.0));
+        order_book_->add_order(maker, buffer);
+        EXPECT_TRUE(buffer.empty());
+        
+        auto taker = std::make_shared<Order>(id + 1000, "AAPL", Side::BUY, OrderType::LIMIT,
+                                             Quantity(1.0), Price(102.0));
+        buffer.clear();
+        order_book_->add_order(taker, buffer);
+        ASSERT_EQ(buffer.size(), 1);
+        EXPECT_EQ(buffer[0].maker_order_id, id);
+        EXPECT_EQ(buffer[0].taker_order_id, id + 1000);
+        buffer.clear();
+    }
+    
+    // Clearing between calls keeps the original storage
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST_F(OrderBookTest, FOKIntoSinkReportsNothingWhenUnfilled) {
+    order_book_->add_order(sell_order1_);
+    
+    MatchBuffer buffer;
+    auto fok = std::make_shared<Order>(4002, "AAPL", Side::BUY, OrderType::LIMIT,
+                                       Quantity(20.0), Price(102.0), TimeInForce::FOK);
+    order_book_->add_order(fok, buffer);
+    
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(fok->status(), OrderStatus::CANCELLED);
+}
+
+TEST_F(OrderBookTest, CanFillProbe) {
+    order_book_->add_order(sell_order1_); // Sell 8 @ 102.0
+    order_book_->add_order(sell_order2_); // Sell 6 @ 103.0
+    
+    EXPECT_TRUE(order_book_->can_fill(Side::BUY, Quantity(8.0), Price(102.0)));
+    EXPECT_FALSE(order_book_->can_fill(Side::BUY, Quantity(9.0), Price(102.0)));
+    EXPECT_TRUE(order_book_->can_fill(Side::BUY, Quantity(14.0), Price(103.0)));
+    EXPECT_TRUE(order_book_->can_fill(Side::BUY, Quantity(14.0), std::nullopt));
+    EXPECT_FALSE(order_book_->can_fill(Side::BUY, Quantity(15.0), std::nullopt));
+    EXPECT_FALSE(order_book_->can_fill(Side::SELL, Quantity(1.0), std::nullopt));
+    
+    // The probe never changes the book
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(14.0));
+    EXPECT_EQ(sell_order1_->executed_quantity(), Quantity::ZERO);
+}
+
+TEST_F(OrderBookTest, RejectedFOKLeavesMakersUntouched) {
+    order_book_->add_order(sell_order1_); // Sell 8 @ 102.0
+    order_book_->add_order(sell_order2_); // Sell 6 @ 103.0
+    
+    auto fok = std::make_shared<Order>(4003, "AAPL", Side::BUY, OrderType::LIMIT,
+                                       Quantity(15.0), Price(103.0), TimeInForce::FOK);
+    auto matches = order_book_->add_order(fok);
+    
+    EXPECT_TRUE(matches.empty());
+    EXPECT_EQ(fok->status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(order_book_->ask_level_count(), 2);
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(14.0));
+    EXPECT_EQ(sell_order1_->executed_quantity(), Quantity::ZERO);
+    EXPECT_EQ(sell_order1_->status(), OrderStatus::ACCEPTED);
+    
+    // A FOK that fits sweeps across both levels
+    auto fok2 = std::make_shared<Order>(4004, "AAPL", Side::BUY, OrderType::LIMIT,
+                                        Quantity(12.0), Price(103.0), TimeInForce::FOK);
+    matches = order_book_->add_order(fok2);
+    
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(matches[1].match_quantity, Quantity(4.0));
+    EXPECT_EQ(fok2->status(), OrderStatus::FILLED);
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(2.0));
+}
+
+TEST(SymbolLimitsOrderBookTest, RejectsOutsideReferenceData) {
+    SymbolInfo info;
+    info.name = "LIMITS";
+    info.tick_size = Price(0.05);
+    info.lot_size = Quantity(10.0);
+    info.min_price = Price(1.0);
+    info.max_price = Price(100.0);
+    SymbolId id = SymbolRegistry::global().register_symbol(info);
+    
+    OrderBook book(id);
+    EXPECT_EQ(book.symbol(), "LIMITS");
+    EXPECT_EQ(book.symbol_info().lot_size, Quantity(10.0));
+    
+    auto off_tick = std::make_shared<Order>(1, id, Side::BUY, OrderType::LIMIT, Quantity(10.0), Price(50.02));
+    auto off_lot = std::make_shared<Order>(2, id, Side::BUY, OrderType::LIMIT, Quantity(15.0), Price(50.0));
+    auto out_of_band = std::make_shared<Order>(3, id, Side::BUY, OrderType::LIMIT, Quantity(10.0), Price(150.0));
+    auto good = std::make_shared<Order>(4, id, Side::BUY, OrderType::LIMIT, Quantity(20.0), Price(50.05));
+    
+    book.add_order(off_tick);
+    book.add_order(off_lot);
+    book.add_order(out_of_band);
+    book.add_order(good);
+    
+    EXPECT_EQ(off_tick->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(off_lot->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(out_of_band->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(good->status(), OrderStatus::ACCEPTED);
+    EXPECT_EQ(book.order_count(), 1);
+}
+
+TEST_F(OrderBookTest, SubmitBatch) {
+    SymbolId id = order_book_->symbol_id();
+    std::vector<OrderCommand> commands = {
+        OrderCommand::new_order(id, 5001, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(101.0)),
+        OrderCommand::new_order(id, 5002, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(102.0)),
+        OrderCommand::new_order(id + 1, 5003, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(100.0)),
+        OrderCommand::new_order(id, 5004, Side::BUY, OrderType::LIMIT, Quantity(12.0), Price(102.0),
+                                TimeInForce::GTC, 7),
+        OrderCommand::cancel(id, 5002),
+    };
+    
+    MatchBuffer fills;
+    EXPECT_EQ(order_book_->submit_batch(commands, fills), 4);
+    
+    // The buy sweeps both asks and rests the rest; every fill carries the batch's single event time
+    ASSERT_EQ(fills.size(), 2);
+    EXPECT_EQ(fills[0].maker_order_id, 5001);
+    EXPECT_EQ(fills[1].maker_order_id, 5002);
+    EXPECT_EQ(fills[0].timestamp, fills[1].timestamp);
+    
+    // The cancel found 5002 already filled; the other symbol's command was skipped
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    EXPECT_EQ(order_book_->get_order(5003), nullptr);
+    
+    OrderPtr buy = order_book_->get_order(5004);
+    ASSERT_NE(buy, nullptr);
+    EXPECT_EQ(buy->owner_id(), 7);
+    EXPECT_EQ(buy->executed_quantity(), Quantity(10.0));
+    EXPECT_EQ(buy->timestamp(), fills[0].timestamp);
+}
+
+TEST_F(OrderBookTest, CancelAllBySide) {
+    order_book_->add_order(buy_order1_);
+    order_book_->add_order(buy_order2_);
+    order_book_->add_order(sell_order1_);
+    
+    EXPECT_EQ(order_book_->cancel_all({Side::BUY, {}, {}, {}}), 2);
+    
+    EXPECT_EQ(order_book_->bid_level_count(), 0);
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity::ZERO);
+    EXPECT_EQ(buy_order1_->status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(order_book_->get_order(1001), nullptr);
+    EXPECT_EQ(order_book_->ask_level_count(), 1);
+    
+    // An empty filter sweeps whatever is left
+    EXPECT_EQ(order_book_->cancel_all(), 1);
+    EXPECT_EQ(order_book_->order_count(), 0);
+}
+
+TEST_F(OrderBookTest, CancelAllPriceRange) {
+    order_book_->add_order(buy_order1_);
+    order_book_->add_order(buy_order2_);
+    order_book_->add_order(buy_order3_);
+    
+    CancelFilter filter;
+    filter.min_price = Price(98.5);
+    filter.max_price = Price(100.0);
+    EXPECT_EQ(order_book_->cancel_all(filter), 2);
+    
+    EXPECT_EQ(order_book_->get_bid_prices(), std::vector<Price>{Price(98.0)});
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(7.0));
+    EXPECT_EQ(buy_order3_->status(), OrderStatus::ACCEPTED);
+}
+
+TEST_F(OrderBookTest, CancelAllByOwner) {
+    auto mine = std::make_shared<Order>(6001, "AAPL", Side::SELL, OrderType::LIMIT,
+                                        Quantity(3.0), Price(102.0));
+    mine->set_owner(42);
+    order_book_->add_order(sell_order1_);
+    order_book_->add_order(mine);
+    order_book_->add_order(sell_order2_);
+    
+    CancelFilter filter;
+    filter.owner = 42;
+    EXPECT_EQ(order_book_->cancel_all(filter), 1);
+    
+    // Other owners' orders at the same level keep their place
+    EXPECT_EQ(mine->status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(order_book_->get_quantity_at_level(Price(102.0), Side::SELL), Quantity(8.0));
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity(14.0));
+    EXPECT_EQ(order_book_->ask_level_count(), 2);
+}
+
+TEST_F(OrderBookTest, FilledMakersLeaveTheBook) {
+    // Orders created through commands come from the book's pool
+    SymbolId symbol = order_book_->symbol_id();
+    MatchBuffer fills;
+    
+    std::weak_ptr<Order> first_maker;
+    for (OrderId id = 1; id <= 1000; ++id) {
+        order_book_->apply(OrderCommand::new_order(symbol, 2 * id, Side::SELL, OrderType::LIMIT,
+                                                   Quantity(1.0), Price(102.0)), id, fills);
+        if (id == 1) {
+            first_maker = order_book_->get_order(2);
+        }
+        order_book_->apply(OrderCommand::new_order(symbol, 2 * id + 1, Side::BUY, OrderType::LIMIT,
+                                                   Quantity(1.0), Price(102.0)), id, fills);
+    }
+    
+    EXPECT_EQ(fills.size(), 1000);
+    EXPECT_EQ(order_book_->order_count(), 0);
+    EXPECT_EQ(order_book_->get_order(2), nullptr);
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    
+    // Nothing keeps the filled orders alive; once the weak reference (which
+    // shares the pooled block with the control block) goes, so is the storage
+    EXPECT_TRUE(first_maker.expired());
+    first_maker.reset();
+    EXPECT_EQ(order_book_->order_pool().in_use(), 0);
+    
+    // A partially filled maker stays live
+    order_book_->apply(OrderCommand::new_order(symbol, 5000, Side::SELL, OrderType::LIMIT,
+                                               Quantity(5.0), Price(102.0)), 2000, fills);
+    order_book_->apply(OrderCommand::new_order(symbol, 5001, Side::BUY, OrderType::LIMIT,
+                                               Quantity(2.0), Price(102.0)), 2001, fills);
+    EXPECT_EQ(order_book_->order_count(), 1);
+    ASSERT_NE(order_book_->get_order(5000), nullptr);
+    EXPECT_EQ(order_book_->get_order(5000)->status(), OrderStatus::PARTIALLY_FILLED);
+}
+
+TEST_F(OrderBookTest, ModifyFastPaths) {
+    // Two buys queued at 100: 1001 (10) ahead of 1004 (3)
+    auto behind = std::make_shared<Order>(1004, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(3.0), Price(100.0));
+    order_book_->add_order(buy_order1_);
+    order_book_->add_order(behind);
+    order_book_->add_order(sell_order1_);  // Sell 8 @ 102
+    
+    // Decrease keeps priority
+    order_book_->modify_order(1001, std::nullopt, Quantity(9.0));
+    EXPECT_EQ(order_book_->get_orders_at_level(Price(100.0), Side::BUY).front(), buy_order1_);
+    
+    // Same-price increase re-queues behind 1004 in the same level, same object
+    order_book_->modify_order(1001, std::nullopt, Quantity(11.0));
+    auto queue = order_book_->get_orders_at_level(Price(100.0), Side::BUY);
+    ASSERT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue[0], behind);
+    EXPECT_EQ(queue[1], buy_order1_);
+    EXPECT_EQ(order_book_->get_order(1001), buy_order1_);
+    EXPECT_EQ(order_book_->get_quantity_at_level(Price(100.0), Side::BUY), Quantity(14.0));
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(14.0));
+    
+    // A non-crossing price change moves the same object to the new level
+    auto matches = order_book_->modify_order(1001, Price(101.0), std::nullopt);
+    EXPECT_TRUE(matches.empty());
+    EXPECT_EQ(order_book_->get_order(1001), buy_order1_);
+    EXPECT_EQ(buy_order1_->price(), Price(101.0));
+    EXPECT_EQ(order_book_->bid_level_count(), 2);
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(14.0));
+    
+    // Amending to the current values changes nothing
+    Timestamp queued_at = buy_order1_->timestamp();
+    order_book_->modify_order(1001, Price(101.0), Quantity(11.0));
+    EXPECT_EQ(buy_order1_->timestamp(), queued_at);
+    EXPECT_TRUE(buy_order1_->is_resting());
+}
+
+TEST_F(OrderBookTest, ModifyPartiallyFilledOrder) {
+    order_book_->add_order(sell_order1_);  // Sell 8 @ 102
+    auto taker = std::make_shared<Order>(1004, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(3.0), Price(102.0));
+    order_book_->add_order(taker);
+    ASSERT_EQ(sell_order1_->executed_quantity(), Quantity(3.0));
+    
+    // Re-pricing through the bids trades only the remaining 5
+    order_book_->add_order(buy_order1_);  // Buy 10 @ 100
+    auto matches = order_book_->modify_order(sell_order1_->id(), Price(100.0), std::nullopt);
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0].match_quantity, Quantity(5.0));
+    EXPECT_EQ(sell_order1_->status(), OrderStatus::FILLED);
+    EXPECT_EQ(order_book_->get_order(sell_order1_->id()), nullptr);
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(5.0));
+    
+    // Reducing to the executed quantity cancels what is left
+    auto partial = std::make_shared<Order>(1005, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(8.0), Price(100.0));
+    order_book_->add_order(partial);  // Fills 5 against the remaining bid
+    ASSERT_EQ(partial->executed_quantity(), Quantity(5.0));
+    order_book_->modify_order(1005, std::nullopt, Quantity(5.0));
+    EXPECT_EQ(partial->status(), OrderStatus::CANCELLED);
+    EXPECT_FALSE(partial->is_resting());
+    EXPECT_EQ(order_book_->order_count(), 0);
+    EXPECT_EQ(order_book_->get_total_ask_quantity(), Quantity::ZERO);
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    
+    // Below the executed quantity is refused
+    EXPECT_TRUE(order_book_->modify_order(1005, std::nullopt, Quantity(1.0)).empty());
+}
+
+TEST_F(OrderBookTest, StopOrdersTriggerOnLastTrade) {
+    SymbolId symbol = order_book_->symbol_id();
+    MatchBuffer fills;
+    auto apply = [&](const OrderCommand& command) { order_book_->apply(command, 1, fills); };
+    
+    apply(OrderCommand::new_order(symbol, 1, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(101.0)));
+    apply(OrderCommand::new_order(symbol, 2, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(103.0)));
+    
+    // Nothing has traded yet, so both stops wait off the book
+    apply(OrderCommand::new_stop(symbol, 10, Side::BUY, Quantity(3.0), Price(101.0)));
+    apply(OrderCommand::new_stop(symbol, 11, Side::BUY, Quantity(4.0), Price(102.0), Price(103.0)));
+    EXPECT_EQ(order_book_->stop_order_count(), 2);
+    EXPECT_EQ(order_book_->pending_order_count(), 2);
+    EXPECT_EQ(order_book_->order_count(), 2);
+    ASSERT_NE(order_book_->get_order(10), nullptr);
+    EXPECT_EQ(order_book_->get_order(10)->status(), OrderStatus::ACCEPTED);
+    
+    // A trade at 101 fires the 101 stop as a market order
+    apply(OrderCommand::new_order(symbol, 20, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(101.0)));
+    ASSERT_EQ(fills.size(), 2);
+    EXPECT_EQ(fills[1].taker_order_id, 10);
+    EXPECT_EQ(fills[1].match_quantity, Quantity(3.0));
+    EXPECT_EQ(order_book_->last_trade_price(), Price(101.0));
+    EXPECT_EQ(order_book_->stop_order_count(), 1);
+    
+    // Trading through 102 fires the stop-limit, which lifts the 103 offer
+    apply(OrderCommand::new_order(symbol, 21, Side::BUY, OrderType::LIMIT, Quantity(2.0), Price(103.0)));
+    ASSERT_EQ(fills.size(), 5);
+    EXPECT_EQ(fills[4].taker_order_id, 11);
+    EXPECT_EQ(fills[4].match_price, Price(103.0));
+    EXPECT_EQ(fills[4].match_quantity, Quantity(4.0));
+    EXPECT_EQ(order_book_->stop_order_count(), 0);
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    
+    // A stop already reached on arrival fires at once; a pending one can be cancelled
+    apply(OrderCommand::new_stop(symbol, 12, Side::BUY, Quantity(1.0), Price(103.0), Price(104.0)));
+    EXPECT_EQ(order_book_->stop_order_count(), 0);
+    EXPECT_EQ(order_book_->best_bid(), Price(104.0));
+    apply(OrderCommand::new_stop(symbol, 13, Side::SELL, Quantity(1.0), Price(90.0)));
+    EXPECT_TRUE(order_book_->cancel_order(13));
+    EXPECT_EQ(order_book_->get_order(13), nullptr);
+    EXPECT_EQ(order_book_->pending_order_count(), 0);
+}
+
+TEST_F(OrderBookTest, StopOrdersCascade) {
+    SymbolId symbol = order_book_->symbol_id();
+    MatchBuffer fills;
+    auto apply = [&](const OrderCommand& command) { order_book_->apply(command, 1, fills); };
+    
+    // Bids stepping down, and sell stops that each trade into the next level
+    apply(OrderCommand::new_order(symbol, 1, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(100.0)));
+    apply(OrderCommand::new_order(symbol, 2, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(99.0)));
+    apply(OrderCommand::new_order(symbol, 3, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(98.0)));
+    apply(OrderCommand::new_stop(symbol, 10, Side::SELL, Quantity(1.0), Price(100.0)));
+    apply(OrderCommand::new_stop(symbol, 11, Side::SELL, Quantity(1.0), Price(99.0)));
+    apply(OrderCommand::new_stop(symbol, 12, Side::SELL, Quantity(1.0), Price(97.0)));
+    
+    // One trade at 100 runs the 100 stop, whose fill at 99 runs the next
+    apply(OrderCommand::new_order(symbol, 20, Side::SELL, OrderType::MARKET, Quantity(1.0), Price()));
+    ASSERT_EQ(fills.size(), 3);
+    EXPECT_EQ(fills[1].taker_order_id, 10);
+    EXPECT_EQ(fills[2].taker_order_id, 11);
+    EXPECT_EQ(order_book_->last_trade_price(), Price(98.0));
+    EXPECT_EQ(order_book_->stop_order_count(), 1);
+    EXPECT_EQ(order_book_->bid_level_count(), 0);
+}
+
+TEST_F(OrderBookTest, PeggedOrdersFollowTheBook) {
+    SymbolId symbol = order_book_->symbol_id();
+    MatchBuffer fills;
+    auto apply = [&](const OrderCommand& command) { order_book_->apply(command, 1, fills); };
+    
+    apply(OrderCommand::new_order(symbol, 1, Side::BUY, OrderType::LIMIT, Quantity(5.0), Price(100.0)));
+    apply(OrderCommand::new_order(symbol, 2, Side::SELL, OrderType::LIMIT, Quantity(5.0), Price(102.0)));
+    
+    // Mid peg at 101, primary pegs on their own side's best (plus offset)
+    apply(OrderCommand::new_pegged(symbol, 10, Side::BUY, OrderType::PEG_MID, Quantity(2.0)));
+    apply(OrderCommand::new_pegged(symbol, 11, Side::SELL, OrderType::PEG_PRIMARY, Quantity(2.0)));
+    apply(OrderCommand::new_pegged(symbol, 12, Side::BUY, OrderType::PEG_PRIMARY, Quantity(2.0), Price(-1.0)));
+    EXPECT_EQ(order_book_->get_order(10)->price(), Price(101.0));
+    EXPECT_EQ(order_book_->get_order(11)->price(), Price(102.0));
+    EXPECT_EQ(order_book_->get_order(12)->price(), Price(99.0));
+    EXPECT_EQ(order_book_->get_orders_at_level(Price(102.0), Side::SELL).back()->id(), 11);
+    
+    // Pegs are displayed but don't move their own reference: the mid peg
+    // is the best bid, yet the midpoint still comes from 100 and 102
+    EXPECT_EQ(order_book_->best_bid(), Price(101.0));
+    EXPECT_EQ(order_book_->get_order(10)->price(), Price(101.0));
+    
+    // A better unpegged bid moves every group following the bid
+    apply(OrderCommand::new_order(symbol, 3, Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(100.5)));
+    EXPECT_EQ(order_book_->get_order(10)->price(), Price(101.25));
+    EXPECT_EQ(order_book_->get_order(12)->price(), Price(99.5));
+    EXPECT_EQ(order_book_->get_order(11)->price(), Price(102.0));
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(10.0));
+    
+    // Without an unpegged offer the mid and sell pegs park off the book...
+    apply(OrderCommand::cancel(symbol, 2));
+    EXPECT_EQ(order_book_->pending_order_count(), 2);
+    EXPECT_EQ(order_book_->ask_level_count(), 0);
+    EXPECT_FALSE(order_book_->get_order(10)->is_resting());
+    EXPECT_EQ(order_book_->get_total_bid_quantity(), Quantity(8.0));
+    
+    // ...and come back once there is one
+    apply(OrderCommand::new_order(symbol, 4, Side::SELL, OrderType::LIMIT, Quantity(4.0), Price(101.5)));
+    EXPECT_EQ(order_book_->pending_order_count(), 0);
+    EXPECT_EQ(order_book_->get_order(10)->price(), Price(101.0));
+    EXPECT_EQ(order_book_->get_order(11)->price(), Price(101.5));
+    
+    // Pegs trade like any resting order
+    apply(OrderCommand::new_order(symbol, 5, Side::SELL, OrderType::MARKET, Quantity(1.0), Price()));
+    ASSERT_FALSE(fills.empty());
+    EXPECT_EQ(fills[fills.size() - 1].maker_order_id, 10);
+    EXPECT_EQ(order_book_->get_order(10)->remaining_quantity(), Quantity(1.0));
+    
+    // Quantity amends work; a peg's price can't be set directly
+    order_book_->modify_order(12, Price(95.0), std::nullopt);
+    EXPECT_EQ(order_book_->get_order(12)->price(), Price(99.5));
+    EXPECT_TRUE(order_book_->cancel_order(12));
+    EXPECT_EQ(order_book_->get_order(12), nullptr);
+}
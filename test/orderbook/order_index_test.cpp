@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "orderbook/order_index.hpp"
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+namespace {
+
+OrderPtr make_order(OrderId id) {
+    return std::make_shared<Order>(id, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(100.0));
+}
+
+} // namespace
+
+TEST(OrderIndexTest, InsertFindErase) {
+    OrderIndex index(16);
+    EXPECT_TRUE(index.empty());
+    EXPECT_GE(index.capacity(), 16);
+
+    OrderPtr order = make_order(42);
+    EXPECT_TRUE(index.insert_or_assign(42, order));
+    EXPECT_EQ(index.size(), 1);
+    ASSERT_NE(index.find(42), nullptr);
+    EXPECT_EQ(*index.find(42), order);
+    EXPECT_EQ(index.find(43), nullptr);
+
+    // Assigning an existing id replaces the order
+    OrderPtr replacement = make_order(42);
+    EXPECT_FALSE(index.insert_or_assign(42, replacement));
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(*index.find(42), replacement);
+
+    EXPECT_TRUE(index.erase(42));
+    EXPECT_FALSE(index.erase(42));
+    EXPECT_EQ(index.find(42), nullptr);
+    EXPECT_TRUE(index.empty());
+
+    // The invalid id is never stored
+    EXPECT_FALSE(index.insert_or_assign(INVALID_ORDER_ID, order));
+    EXPECT_EQ(index.find(INVALID_ORDER_ID), nullptr);
+}
+
+TEST(OrderIndexTest, EraseShiftsCollidingEntriesBack) {
+    OrderIndex index(8);
+    const OrderId slots = static_cast<OrderId>(index.slot_count());
+
+    // Three ids sharing a home slot, plus one homed right after it
+    std::vector<OrderId> ids = {5, 5 + slots, 5 + 2 * slots, 6};
+    for (OrderId id : ids) {
+        ASSERT_TRUE(index.insert_or_assign(id, make_order(id)));
+    }
+
+    // Removing the head of the run must keep every other id reachable
+    EXPECT_TRUE(index.erase(5));
+    for (OrderId id : {5 + slots, 5 + 2 * slots, OrderId{6}}) {
+        ASSERT_NE(index.find(id), nullptr) << id;
+        EXPECT_EQ((*index.find(id))->id(), id);
+    }
+
+    EXPECT_TRUE(index.erase(5 + slots));
+    EXPECT_NE(index.find(5 + 2 * slots), nullptr);
+    EXPECT_NE(index.find(6), nullptr);
+    EXPECT_EQ(index.size(), 2);
+}
+
+TEST(OrderIndexTest, SizedFromCapacityWithoutGrowth) {
+    OrderIndex index(1000);
+    for (OrderId id = 1; id <= 1000; ++id) {
+        index.insert_or_assign(id, make_order(id));
+    }
+    EXPECT_EQ(index.growth_count(), 0);
+
+    // Going past the configured capacity still works, and is counted
+    for (OrderId id = 1001; id <= 5000; ++id) {
+        index.insert_or_assign(id, make_order(id));
+    }
+    EXPECT_GT(index.growth_count(), 0);
+    EXPECT_EQ(index.size(), 5000);
+    for (OrderId id = 1; id <= 5000; ++id) {
+        ASSERT_NE(index.find(id), nullptr) << id;
+    }
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.find(1), nullptr);
+}
+
+TEST(OrderIndexTest, MatchesReferenceMapUnderChurn) {
+    OrderIndex index(256);
+    std::unordered_map<OrderId, OrderPtr> reference;
+    std::mt19937_64 rng(7);
+
+    // Sliding window of live ids with random cancels, like an order stream
+    OrderId next_id = 1;
+    for (int step = 0; step < 100000; ++step) {
+        if (reference.empty() || rng() % 100 < 55) {
+            OrderId id = next_id++;
+            OrderPtr order = make_order(id);
+            index.insert_or_assign(id, order);
+            reference.emplace(id, order);
+        } else {
+            OrderId id = next_id - 1 - static_cast<OrderId>(rng() % std::min<OrderId>(next_id - 1, 600));
+            EXPECT_EQ(index.erase(id), reference.erase(id) == 1);
+        }
+    }
+
+    EXPECT_EQ(index.size(), reference.size());
+    for (const auto& [id, order] : reference) {
+        ASSERT_NE(index.find(id), nullptr) << id;
+        EXPECT_EQ(*index.find(id), order);
+    }
+
+    size_t visited = 0;
+    index.for_each([&](OrderId id, const OrderPtr& order) {
+        EXPECT_EQ(reference.at(id), order);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "orderbook/order_pool.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+TEST(OrderPoolTest, CreateFromSlab) {
+    OrderPool pool(4);
+    
+    EXPECT_EQ(pool.capacity(), 4);
+    EXPECT_EQ(pool.in_use(), 0);
+    EXPECT_GE(pool.block_size(), sizeof(Order));
+    
+    OrderPtr order = pool.create(1001, "AAPL", Side::BUY, OrderType::LIMIT,
+                                 Quantity(10.0), Price(100.0));
+    
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(order->id(), 1001);
+    EXPECT_EQ(order->symbol(), "AAPL");
+    EXPECT_EQ(order->price().to_double(), 100.0);
+    EXPECT_EQ(pool.in_use(), 1);
+    EXPECT_EQ(pool.available(), 3);
+    EXPECT_EQ(pool.heap_fallbacks(), 0);
+    
+    // Releasing the last reference returns the block
+    order.reset();
+    EXPECT_EQ(pool.in_use(), 0);
+}
+
+TEST(OrderPoolTest, BlocksAreReused) {
+    OrderPool pool(2);
+    
+    OrderPtr first = pool.create(1, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(1.0));
+    Order* address = first.get();
+    first.reset();
+    
+    OrderPtr second = pool.create(2, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(1.0));
+    EXPECT_EQ(second.get(), address);
+}
+
+TEST(OrderPoolTest, HeapFallbackWhenExhausted) {
+    OrderPool pool(2);
+    
+    std::vector<OrderPtr> orders;
+    for (OrderId id = 1; id <= 3; ++id) {
+        orders.push_back(pool.create(id, "AAPL", Side::SELL, OrderType::LIMIT,
+                                     Quantity(1.0), Price(1.0)));
+    }
+    
+    EXPECT_EQ(pool.in_use(), 2);
+    EXPECT_EQ(pool.heap_fallbacks(), 1);
+    EXPECT_EQ(orders[2]->id(), 3);
+    
+    orders.clear();
+    EXPECT_EQ(pool.in_use(), 0);
+}
+
+TEST(OrderPoolTest, OrdersOutliveThePool) {
+    OrderPtr order;
+    {
+        OrderPool pool(1);
+        order = pool.create(7, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(2.0), Price(3.0));
+    }
+    
+    // The slab stays alive until the last order is released
+    EXPECT_EQ(order->id(), 7);
+    EXPECT_EQ(order->quantity().to_double(), 2.0);
+    order.reset();
+}
+
+TEST(OrderPoolTest, ReleaseFromAnotherThread) {
+    OrderPool pool(64);
+    
+    std::vector<OrderPtr> orders;
+    for (OrderId id = 1; id <= 64; ++id) {
+        orders.push_back(pool.create(id, "AAPL", Side::BUY, OrderType::LIMIT,
+                                     Quantity(1.0), Price(1.0)));
+    }
+    EXPECT_EQ(pool.available(), 0);
+    
+    std::thread releaser([&orders]() { orders.clear(); });
+    releaser.join();
+    
+    EXPECT_EQ(pool.in_use(), 0);
+    EXPECT_EQ(pool.available(), 64);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "orderbook/order.hpp"
+#include <cstring>
 #include <memory>
 
 using namespace trading_engine::orderbook;
@@ -188,4 +189,59 @@ TEST_F(OrderTest, ToString) {
     EXPECT_NE(order_str.find("price=150.2500"), std::string::npos);
     EXPECT_NE(order_str.find("tif=GTC"), std::string::npos);
     EXPECT_NE(order_str.find("status=NEW"), std::string::npos);
-} 
\ No newline at end of file
+}
+
+TEST(OrderRecordTest, PackedFlags) {
+    OrderRecord record;
+    record.flags = OrderRecord::pack_flags(Side::SELL, OrderType::MARKET, TimeInForce::FOK,
+                                           OrderStatus::PARTIALLY_FILLED);
+    
+    EXPECT_EQ(record.side(), Side::SELL);
+    EXPECT_EQ(record.type(), OrderType::MARKET);
+    EXPECT_EQ(record.time_in_force(), TimeInForce::FOK);
+    EXPECT_EQ(record.status(), OrderStatus::PARTIALLY_FILLED);
+    
+    // Changing the status leaves the other fields alone
+    record.set_status(OrderStatus::REPLACED);
+    EXPECT_EQ(record.status(), OrderStatus::REPLACED);
+    EXPECT_EQ(record.side(), Side::SELL);
+    EXPECT_EQ(record.type(), OrderType::MARKET);
+    EXPECT_EQ(record.time_in_force(), TimeInForce::FOK);
+}
+
+TEST_F(OrderTest, RecordRoundTrip) {
+    order_->set_status(OrderStatus::ACCEPTED);
+    order_->execute(Quantity(4.0));
+    
+    // Records can be copied as raw bytes
+    OrderRecord copy;
+    std::memcpy(&copy, &order_->record(), sizeof(OrderRecord));
+    
+    Order restored(copy);
+    EXPECT_EQ(restored.id(), 1001);
+    EXPECT_EQ(restored.symbol(), "AAPL");
+    EXPECT_EQ(restored.side(), Side::BUY);
+    EXPECT_EQ(restored.price(), Price(150.25));
+    EXPECT_EQ(restored.quantity(), Quantity(10.0));
+    EXPECT_EQ(restored.executed_quantity(), Quantity(4.0));
+    EXPECT_EQ(restored.status(), OrderStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(restored.timestamp(), order_->timestamp());
+    EXPECT_FALSE(restored.is_resting());
+}
+
+TEST_F(OrderTest, OwnerAndEventTime) {
+    EXPECT_EQ(order_->owner_id(), NO_OWNER);
+    
+    Order order(2001, order_->symbol_id(), Side::SELL, OrderType::LIMIT,
+                Quantity(5.0), Price(10.0), TimeInForce::IOC, 9, 12345);
+    EXPECT_EQ(order.owner_id(), 9);
+    EXPECT_EQ(order.timestamp(), 12345);
+    EXPECT_EQ(order.last_update(), 12345);
+    
+    // Mutators stamp the time they are given
+    order.execute(Quantity(2.0), 20000);
+    EXPECT_EQ(order.last_update(), 20000);
+    order.cancel(30000);
+    EXPECT_EQ(order.status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(order.last_update(), 30000);
+}
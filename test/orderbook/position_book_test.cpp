@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "orderbook/position_book.hpp"
+
+using namespace trading_engine::orderbook;
+
+namespace {
+
+// Raw price units for an amount of currency
+int64_t amount(double value) {
+    return Price(value).raw_value();
+}
+
+} // namespace
+
+TEST(PositionBookTest, NotionalStaysInFixedPoint) {
+    EXPECT_EQ(notional(Price(100.0), Quantity(10.0)), amount(1000.0));
+    EXPECT_EQ(notional(Price(0.0001), Quantity(2.5)), Price(int64_t{2}).raw_value());
+    EXPECT_EQ(notional(Price(100.0), Quantity(-3.0)), amount(-300.0));
+
+    // Products beyond 64 bits still come out exact
+    EXPECT_EQ(notional(Price(1000000.0), Quantity(10000000.0)), amount(10000000000000.0));
+}
+
+TEST(PositionBookTest, AverageCostAndRealizedPnl) {
+    Position position;
+    position.apply_fill(Side::BUY, Price(100.0), Quantity(10.0));
+    position.apply_fill(Side::BUY, Price(110.0), Quantity(10.0));
+    EXPECT_EQ(position.net, Quantity(20.0));
+    EXPECT_EQ(position.average_price(), Price(105.0));
+    EXPECT_EQ(position.unrealized_pnl(Price(106.0)), amount(20.0));
+
+    // Closing realises against the average cost
+    position.apply_fill(Side::SELL, Price(120.0), Quantity(15.0));
+    EXPECT_EQ(position.net, Quantity(5.0));
+    EXPECT_EQ(position.realized_pnl, amount(225.0));
+    EXPECT_EQ(position.average_price(), Price(105.0));
+
+    // Selling through flat closes the rest and opens a short at the fill price
+    position.apply_fill(Side::SELL, Price(100.0), Quantity(10.0));
+    EXPECT_EQ(position.net, Quantity(-5.0));
+    EXPECT_EQ(position.realized_pnl, amount(200.0));
+    EXPECT_EQ(position.average_price(), Price(100.0));
+    EXPECT_EQ(position.unrealized_pnl(Price(90.0)), amount(50.0));
+
+    position.apply_fill(Side::BUY, Price(90.0), Quantity(5.0));
+    EXPECT_TRUE(position.is_flat());
+    EXPECT_EQ(position.cost, 0);
+    EXPECT_EQ(position.realized_pnl, amount(250.0));
+    EXPECT_EQ(position.bought, Quantity(25.0));
+    EXPECT_EQ(position.sold, Quantity(25.0));
+    EXPECT_EQ(position.fill_count, 5);
+}
+
+TEST(PositionBookTest, FlatArrayPerAccountAndSymbol) {
+    PositionBook book(3, 4);
+    EXPECT_EQ(book.account_count(), 3);
+    EXPECT_EQ(book.symbol_count(), 4);
+
+    EXPECT_TRUE(book.on_fill(1, 0, Side::BUY, Price(10.0), Quantity(2.0)));
+    EXPECT_TRUE(book.on_fill(1, 3, Side::SELL, Price(50.0), Quantity(1.0)));
+    EXPECT_TRUE(book.on_fill(1, 0, Side::SELL, Price(12.0), Quantity(2.0)));
+    EXPECT_TRUE(book.on_fill(1, 3, Side::BUY, Price(45.0), Quantity(1.0)));
+    EXPECT_TRUE(book.on_fill(2, 0, Side::BUY, Price(10.0), Quantity(2.0)));
+    EXPECT_EQ(book.realized_pnl(1), amount(9.0));
+    EXPECT_EQ(book.realized_pnl(2), 0);
+    EXPECT_EQ(book.find(2, 0)->net, Quantity(2.0));
+    EXPECT_TRUE(book.find(2, 1)->is_flat());
+
+    // Out of range accounts and symbols are refused
+    EXPECT_FALSE(book.on_fill(3, 0, Side::BUY, Price(10.0), Quantity(1.0)));
+    EXPECT_FALSE(book.on_fill(0, 4, Side::BUY, Price(10.0), Quantity(1.0)));
+    EXPECT_EQ(book.find(3, 0), nullptr);
+
+    book.clear();
+    EXPECT_EQ(book.realized_pnl(1), 0);
+    EXPECT_TRUE(book.find(2, 0)->is_flat());
+}
+
+TEST(PositionBookTest, OpenQuantityPerSide) {
+    PositionBook book(2, 2);
+    EXPECT_TRUE(book.add_open(1, 0, Side::BUY, Quantity(5.0)));
+    EXPECT_TRUE(book.add_open(1, 0, Side::SELL, Quantity(2.0)));
+    EXPECT_TRUE(book.add_open(1, 1, Side::BUY, Quantity(7.0)));
+    EXPECT_TRUE(book.release_open(1, 0, Side::BUY, Quantity(3.0)));
+    EXPECT_EQ(book.find(1, 0)->open_buy, Quantity(2.0));
+    EXPECT_EQ(book.find(1, 0)->open_sell, Quantity(2.0));
+
+    // Releases stop at zero; clearing a symbol leaves the others alone
+    EXPECT_TRUE(book.release_open(1, 0, Side::SELL, Quantity(9.0)));
+    EXPECT_EQ(book.find(1, 0)->open_sell, Quantity::ZERO);
+    book.clear_open(0);
+    EXPECT_EQ(book.find(1, 0)->open_buy, Quantity::ZERO);
+    EXPECT_EQ(book.find(1, 1)->open_buy, Quantity(7.0));
+    EXPECT_FALSE(book.add_open(2, 0, Side::BUY, Quantity(1.0)));
+}
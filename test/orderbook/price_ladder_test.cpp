@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "orderbook/price_ladder.hpp"
+#include <memory>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+class PriceLadderTest : public ::testing::Test {
+protected:
+    // Ladders with a tick of 0.01 and a small window so recentering is easy to trigger
+    PriceLadder bids_{Side::BUY, Price(0.01), 64};
+    PriceLadder asks_{Side::SELL, Price(0.01), 64};
+
+    static std::vector<Price> prices(const PriceLadder& ladder) {
+        std::vector<Price> result;
+        ladder.for_each_level([&](const PriceLevel& level) {
+            result.push_back(level.price());
+            return true;
+        });
+        return result;
+    }
+};
+
+TEST_F(PriceLadderTest, Constructor) {
+    EXPECT_TRUE(bids_.empty());
+    EXPECT_EQ(bids_.level_count(), 0);
+    EXPECT_EQ(bids_.capacity(), 64);
+    EXPECT_EQ(bids_.tick_size(), Price(0.01));
+    EXPECT_EQ(bids_.best(), nullptr);
+}
+
+TEST_F(PriceLadderTest, OnTick) {
+    EXPECT_TRUE(bids_.is_on_tick(Price(100.0)));
+    EXPECT_TRUE(bids_.is_on_tick(Price(100.01)));
+    EXPECT_FALSE(bids_.is_on_tick(Price(100.005)));
+
+    // Off-tick prices are not stored
+    EXPECT_EQ(bids_.find_or_create(Price(100.005)), nullptr);
+    EXPECT_TRUE(bids_.empty());
+}
+
+TEST_F(PriceLadderTest, BestTracking) {
+    bids_.find_or_create(Price(100.0));
+    bids_.find_or_create(Price(100.05));
+    bids_.find_or_create(Price(99.98));
+
+    asks_.find_or_create(Price(100.1));
+    asks_.find_or_create(Price(100.08));
+    asks_.find_or_create(Price(100.2));
+
+    EXPECT_EQ(bids_.level_count(), 3);
+    EXPECT_EQ(asks_.level_count(), 3);
+    EXPECT_EQ(bids_.best()->price(), Price(100.05));
+    EXPECT_EQ(asks_.best()->price(), Price(100.08));
+
+    // Removing the best moves to the next level in priority order
+    bids_.erase(Price(100.05));
+    asks_.erase(Price(100.08));
+
+    EXPECT_EQ(bids_.best()->price(), Price(100.0));
+    EXPECT_EQ(asks_.best()->price(), Price(100.1));
+
+    // Removing a non-best level leaves the best unchanged
+    bids_.erase(Price(99.98));
+    EXPECT_EQ(bids_.best()->price(), Price(100.0));
+    EXPECT_EQ(bids_.level_count(), 1);
+}
+
+TEST_F(PriceLadderTest, PriorityOrder) {
+    for (double p : {100.03, 99.99, 100.01, 100.0}) {
+        bids_.find_or_create(Price(p));
+        asks_.find_or_create(Price(p));
+    }
+
+    std::vector<Price> expected_bids = {Price(100.03), Price(100.01), Price(100.0), Price(99.99)};
+    std::vector<Price> expected_asks = {Price(99.99), Price(100.0), Price(100.01), Price(100.03)};
+
+    EXPECT_EQ(prices(bids_), expected_bids);
+    EXPECT_EQ(prices(asks_), expected_asks);
+
+    // Next level after a given price
+    EXPECT_EQ(bids_.next(Price(100.03))->price(), Price(100.01));
+    EXPECT_EQ(bids_.next(Price(100.02))->price(), Price(100.01));
+    EXPECT_EQ(bids_.next(Price(99.99)), nullptr);
+    EXPECT_EQ(asks_.next(Price(99.99))->price(), Price(100.0));
+    EXPECT_EQ(asks_.next(Price(100.02))->price(), Price(100.03));
+    EXPECT_EQ(asks_.next(Price(100.03)), nullptr);
+}
+
+TEST_F(PriceLadderTest, FindAndErase) {
+    PriceLevel* level = asks_.find_or_create(Price(50.0));
+    ASSERT_NE(level, nullptr);
+    EXPECT_EQ(level->price(), Price(50.0));
+
+    // Same price returns the same level
+    EXPECT_EQ(asks_.find_or_create(Price(50.0)), level);
+    EXPECT_EQ(asks_.find(Price(50.0)), level);
+    EXPECT_EQ(asks_.find(Price(50.01)), nullptr);
+
+    asks_.erase(Price(50.0));
+    EXPECT_EQ(asks_.find(Price(50.0)), nullptr);
+    EXPECT_TRUE(asks_.empty());
+    EXPECT_EQ(asks_.best(), nullptr);
+}
+
+TEST_F(PriceLadderTest, RecenterKeepsLevels) {
+    auto order = std::make_shared<Order>(
+        1, "AAPL", Side::SELL, OrderType::LIMIT, Quantity(3.0), Price(100.0));
+    asks_.find_or_create(Price(100.0))->add_order(order);
+
+    // Far outside the initial 64-tick window
+    asks_.find_or_create(Price(101.0));
+    asks_.find_or_create(Price(99.0));
+
+    EXPECT_GE(asks_.capacity(), 201);
+    EXPECT_EQ(asks_.level_count(), 3);
+    EXPECT_EQ(asks_.best()->price(), Price(99.0));
+
+    // The moved level keeps its orders
+    PriceLevel* level = asks_.find(Price(100.0));
+    ASSERT_NE(level, nullptr);
+    EXPECT_EQ(level->order_count(), 1);
+    EXPECT_EQ(level->total_quantity(), Quantity(3.0));
+    EXPECT_EQ(level->get_first_order(), order);
+
+    std::vector<Price> expected = {Price(99.0), Price(100.0), Price(101.0)};
+    EXPECT_EQ(prices(asks_), expected);
+}
+
+TEST_F(PriceLadderTest, WindowIsCapped) {
+    PriceLadder asks(Side::SELL, Price(0.01), 64, 256);
+    EXPECT_EQ(asks.max_capacity(), 256);
+    ASSERT_NE(asks.find_or_create(Price(100.0)), nullptr);
+
+    // 2.55 away is 256 ticks including both ends; 2.56 would be 257
+    EXPECT_TRUE(asks.accepts(Price(102.55)));
+    EXPECT_FALSE(asks.accepts(Price(102.56)));
+    EXPECT_FALSE(asks.accepts(Price(97.44)));
+    EXPECT_EQ(asks.find_or_create(Price(1000000.0)), nullptr);
+    ASSERT_NE(asks.find_or_create(Price(102.55)), nullptr);
+    EXPECT_LE(asks.capacity(), 256);
+    EXPECT_EQ(asks.level_count(), 2);
+
+    // Once the far level is gone the window can move again
+    asks.erase(Price(100.0));
+    EXPECT_TRUE(asks.accepts(Price(104.0)));
+    EXPECT_FALSE(asks.accepts(Price(100.0) - Price(0.01)));
+}
+
+TEST_F(PriceLadderTest, Clear) {
+    bids_.find_or_create(Price(10.0));
+    bids_.find_or_create(Price(10.01));
+
+    bids_.clear();
+
+    EXPECT_TRUE(bids_.empty());
+    EXPECT_EQ(bids_.best(), nullptr);
+    EXPECT_EQ(bids_.find(Price(10.0)), nullptr);
+    EXPECT_TRUE(prices(bids_).empty());
+}
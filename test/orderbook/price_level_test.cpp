@@ -163,8 +163,8 @@ TEST_F(PriceLevelTest, ModifyOrderQuantity) {
     EXPECT_FALSE(modified);
     EXPECT_EQ(price_level_->total_quantity().to_double(), 7.0);
     
-    // Partially execute the order
-    order1_->execute(Quantity(2.0));
+    // Partially execute the order through the level so its total follows
+    price_level_->execute_quantity(Quantity(2.0));
     
     // Try to set quantity below executed amount (should fail)
     modified = price_level_->modify_order_quantity(order1_->id(), Quantity(1.0));
@@ -277,4 +277,98 @@ TEST_F(PriceLevelTest, ToString) {
     EXPECT_NE(level_str.find("PriceLevel[price=100.0000"), std::string::npos);
     EXPECT_NE(level_str.find("orders=2"), std::string::npos);
     EXPECT_NE(level_str.find("quantity=15.0000"), std::string::npos);
-} 
\ No newline at end of file
+} 
+TEST_F(PriceLevelTest, IntrusiveLinks) {
+    price_level_->add_order(order1_);
+    price_level_->add_order(order2_);
+    
+    // Orders point back at the level they rest in
+    EXPECT_EQ(order1_->level(), price_level_.get());
+    EXPECT_TRUE(order2_->is_resting());
+    EXPECT_FALSE(order3_->is_resting());
+    
+    // An order can only be queued once
+    price_level_->add_order(order1_);
+    EXPECT_EQ(price_level_->order_count(), 2);
+    
+    // O(1) removal by reference
+    EXPECT_TRUE(price_level_->remove_order(*order1_));
+    EXPECT_FALSE(order1_->is_resting());
+    EXPECT_FALSE(price_level_->remove_order(*order1_));
+    EXPECT_EQ(price_level_->get_first_order(), order2_);
+    EXPECT_EQ(price_level_->total_quantity().to_double(), 5.0);
+    
+    // O(1) quantity change by reference
+    EXPECT_TRUE(price_level_->modify_order_quantity(*order2_, Quantity(3.0)));
+    EXPECT_EQ(price_level_->total_quantity().to_double(), 3.0);
+    EXPECT_FALSE(price_level_->modify_order_quantity(*order3_, Quantity(3.0)));
+}
+
+TEST_F(PriceLevelTest, RemoveTailThenAppend) {
+    price_level_->add_order(order1_);
+    price_level_->add_order(order2_);
+    
+    price_level_->remove_order(*order2_);
+    price_level_->add_order(order3_);
+    
+    std::vector<OrderPtr> orders = price_level_->get_all_orders();
+    ASSERT_EQ(orders.size(), 2);
+    EXPECT_EQ(orders[0], order1_);
+    EXPECT_EQ(orders[1], order3_);
+    EXPECT_EQ(price_level_->get_order(1003), order3_);
+}
+
+TEST_F(PriceLevelTest, MoveRepointsOrders) {
+    price_level_->add_order(order1_);
+    price_level_->add_order(order2_);
+    
+    PriceLevel moved(std::move(*price_level_));
+    
+    EXPECT_EQ(moved.order_count(), 2);
+    EXPECT_EQ(moved.total_quantity().to_double(), 15.0);
+    EXPECT_EQ(order1_->level(), &moved);
+    EXPECT_EQ(order2_->level(), &moved);
+    EXPECT_TRUE(price_level_->is_empty());
+    
+    // Destroying a level releases its orders
+    moved = PriceLevel(Price(100.0));
+    EXPECT_FALSE(order1_->is_resting());
+    EXPECT_EQ(order1_.use_count(), 1);
+}
+
+TEST_F(PriceLevelTest, LongQueueRelease) {
+    // Releasing a long queue must not recurse through the links
+    {
+        PriceLevel level(Price(100.0));
+        for (OrderId id = 1; id <= 200000; ++id) {
+            level.add_order(std::make_shared<Order>(
+                id, "AAPL", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(100.0)));
+        }
+        EXPECT_EQ(level.order_count(), 200000);
+    }
+    SUCCEED();
+}
+
+TEST_F(PriceLevelTest, RequeueMovesToBack) {
+    price_level_->add_order(order1_);
+    price_level_->add_order(order2_);
+    price_level_->add_order(order3_);
+    Quantity total = price_level_->total_quantity();
+    
+    // The head goes behind the others; count and total are unchanged
+    EXPECT_TRUE(price_level_->requeue_order(*order1_));
+    std::vector<OrderPtr> orders = price_level_->get_all_orders();
+    ASSERT_EQ(orders.size(), 3);
+    EXPECT_EQ(orders[0], order2_);
+    EXPECT_EQ(orders[1], order3_);
+    EXPECT_EQ(orders[2], order1_);
+    EXPECT_EQ(price_level_->order_count(), 3);
+    EXPECT_EQ(price_level_->total_quantity(), total);
+    
+    // Requeueing the tail is a no-op; unqueued orders are refused
+    EXPECT_TRUE(price_level_->requeue_order(*order1_));
+    EXPECT_EQ(price_level_->get_all_orders().back(), order1_);
+    price_level_->remove_order(*order3_);
+    EXPECT_FALSE(price_level_->requeue_order(*order3_));
+    EXPECT_EQ(price_level_->get_first_order(), order2_);
+}
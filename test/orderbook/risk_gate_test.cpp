@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include "orderbook/order_book.hpp"
+#include "orderbook/risk_gate.hpp"
+#include <memory>
+
+using namespace trading_engine::orderbook;
+
+namespace {
+
+constexpr OwnerId ALICE = 1;
+constexpr OwnerId BOB = 2;
+
+OrderPtr order(OrderId id, SymbolId symbol_id, Side side, OrderType type, double quantity, double price,
+               OwnerId owner) {
+    return std::make_shared<Order>(id, symbol_id, side, type, Quantity(quantity), Price(price),
+                                   TimeInForce::GTC, owner, 0);
+}
+
+SymbolId banded_symbol() {
+    SymbolInfo info;
+    info.name = "RISK";
+    info.price_band_bps = 500; // 5%
+    return SymbolRegistry::global().register_symbol(info);
+}
+
+} // namespace
+
+TEST(RiskGateTest, ChecksEachLimit) {
+    const SymbolId symbol_id = banded_symbol();
+    const SymbolInfo& info = *SymbolRegistry::global().info(symbol_id);
+    RiskGate gate(3, symbol_id + 1);
+
+    RiskLimits limits;
+    limits.max_order_quantity = Quantity(100.0);
+    limits.max_order_notional = Price(5000.0).raw_value();
+    limits.max_position = Quantity(150.0);
+    ASSERT_TRUE(gate.set_limits(ALICE, limits));
+    EXPECT_FALSE(gate.set_limits(3, limits));
+
+    auto check = [&](Side side, OrderType type, double quantity, double price, OwnerId owner = ALICE) {
+        return gate.check(*order(1, symbol_id, side, type, quantity, price, owner), info);
+    };
+
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 40.0, 100.0), RiskCheck::PASSED);
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 101.0, 1.0), RiskCheck::ORDER_QUANTITY);
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 60.0, 100.0), RiskCheck::ORDER_NOTIONAL);
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 1.0, 1.0, 7), RiskCheck::UNKNOWN_ACCOUNT);
+
+    // The band only applies once there is a reference price, and until then
+    // orders without a price can't be valued
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 1.0, 200.0), RiskCheck::PASSED);
+    EXPECT_EQ(check(Side::BUY, OrderType::MARKET, 1.0, 0.0), RiskCheck::NO_REFERENCE);
+    EXPECT_EQ(check(Side::BUY, OrderType::MARKET, 1.0, 0.0, BOB), RiskCheck::PASSED);
+    gate.set_reference_price(symbol_id, Price(100.0));
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 1.0, 105.0), RiskCheck::PASSED);
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 1.0, 105.01), RiskCheck::PRICE_BAND);
+    EXPECT_EQ(check(Side::SELL, OrderType::LIMIT, 1.0, 94.99), RiskCheck::PRICE_BAND);
+
+    // Market orders are valued at the reference price
+    EXPECT_EQ(check(Side::BUY, OrderType::MARKET, 50.0, 0.0), RiskCheck::PASSED);
+    EXPECT_EQ(check(Side::BUY, OrderType::MARKET, 51.0, 0.0), RiskCheck::ORDER_NOTIONAL);
+
+    // Position limit counts the order as if it filled; reducing orders always pass
+    gate.positions().on_fill(ALICE, symbol_id, Side::BUY, Price(100.0), Quantity(120.0));
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 30.0, 100.0), RiskCheck::PASSED);
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 31.0, 100.0), RiskCheck::POSITION_LIMIT);
+    gate.positions().on_fill(ALICE, symbol_id, Side::BUY, Price(100.0), Quantity(40.0));
+    EXPECT_EQ(check(Side::SELL, OrderType::LIMIT, 20.0, 100.0), RiskCheck::PASSED);
+
+    // Accounts without limits are unlimited
+    EXPECT_EQ(check(Side::BUY, OrderType::LIMIT, 1000.0, 100.0, BOB), RiskCheck::PASSED);
+}
+
+TEST(RiskGateTest, GatesTheBookAndTracksFills) {
+    const SymbolId symbol_id = banded_symbol();
+    RiskGate gate(3, symbol_id + 1);
+    RiskLimits limits;
+    limits.max_position = Quantity(10.0);
+    gate.set_limits(ALICE, limits);
+
+    OrderBook book(symbol_id);
+    book.set_risk_gate(&gate);
+    EXPECT_EQ(book.risk_gate(), &gate);
+
+    OrderPtr ask = order(1, symbol_id, Side::SELL, OrderType::LIMIT, 20.0, 100.0, BOB);
+    book.add_order(ask);
+    OrderPtr too_big = order(2, symbol_id, Side::BUY, OrderType::LIMIT, 11.0, 100.0, ALICE);
+    EXPECT_TRUE(book.add_order(too_big).empty());
+    EXPECT_EQ(too_big->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.get_quantity_at_level(Price(100.0), Side::SELL), Quantity(20.0));
+
+    // Fills move both owners' positions and the reference price
+    OrderPtr bid = order(3, symbol_id, Side::BUY, OrderType::LIMIT, 8.0, 100.0, ALICE);
+    EXPECT_EQ(book.add_order(bid).size(), 1);
+    EXPECT_EQ(gate.positions().find(ALICE, symbol_id)->net, Quantity(8.0));
+    EXPECT_EQ(gate.positions().find(BOB, symbol_id)->net, Quantity(-8.0));
+    EXPECT_EQ(gate.reference_price(symbol_id), Price(100.0));
+
+    // Now 3 more would breach the limit, and a fat-fingered price is refused
+    EXPECT_EQ(book.add_order(order(4, symbol_id, Side::BUY, OrderType::LIMIT, 3.0, 100.0, ALICE)).size(), 0);
+    EXPECT_EQ(book.get_order(4), nullptr);
+    OrderPtr fat_finger = order(5, symbol_id, Side::SELL, OrderType::LIMIT, 1.0, 80.0, BOB);
+    book.add_order(fat_finger);
+    EXPECT_EQ(fat_finger->status(), OrderStatus::REJECTED);
+
+    book.add_order(order(6, symbol_id, Side::SELL, OrderType::LIMIT, 4.0, 104.0, ALICE));
+    EXPECT_NE(book.get_order(6), nullptr);
+
+    // Detached, the book takes anything again
+    book.set_risk_gate(nullptr);
+    book.add_order(order(7, symbol_id, Side::BUY, OrderType::LIMIT, 11.0, 50.0, ALICE));
+    EXPECT_NE(book.get_order(7), nullptr);
+}
+
+TEST(RiskGateTest, GatesAmends) {
+    const SymbolId symbol_id = banded_symbol();
+    RiskGate gate(3, symbol_id + 1);
+    RiskLimits limits;
+    limits.max_order_quantity = Quantity(10.0);
+    limits.max_order_notional = Price(1000.0).raw_value();
+    limits.max_position = Quantity(12.0);
+    gate.set_limits(ALICE, limits);
+    gate.set_reference_price(symbol_id, Price(100.0));
+
+    OrderBook book(symbol_id);
+    book.set_risk_gate(&gate);
+    OrderPtr bid = order(1, symbol_id, Side::BUY, OrderType::LIMIT, 5.0, 99.0, ALICE);
+    book.add_order(bid);
+    ASSERT_NE(book.get_order(1), nullptr);
+
+    // A new order for 500 is refused, and so is growing a resting 5-lot to it
+    EXPECT_EQ(gate.check(*order(2, symbol_id, Side::BUY, OrderType::LIMIT, 500.0, 99.0, ALICE),
+                         book.symbol_info()), RiskCheck::ORDER_QUANTITY);
+    book.modify_order(1, std::nullopt, Quantity(500.0));
+    EXPECT_EQ(bid->quantity(), Quantity(5.0));
+    EXPECT_EQ(book.get_quantity_at_level(Price(99.0), Side::BUY), Quantity(5.0));
+
+    // Out of the 5% band, and a price that takes the notional past 1000
+    book.modify_order(1, Price(94.0), std::nullopt);
+    EXPECT_EQ(bid->price(), Price(99.0));
+    book.modify_order(1, Price(104.0), Quantity(10.0));
+    EXPECT_EQ(bid->price(), Price(99.0));
+    EXPECT_EQ(bid->quantity(), Quantity(5.0));
+
+    // Within every limit the amend goes through
+    book.modify_order(1, Price(100.0), Quantity(10.0));
+    EXPECT_EQ(bid->price(), Price(100.0));
+    EXPECT_EQ(bid->quantity(), Quantity(10.0));
+
+    // Filled size sits in the position: 4 held plus 9 open would pass 12
+    gate.positions().on_fill(ALICE, symbol_id, Side::BUY, Price(100.0), Quantity(4.0));
+    book.modify_order(1, Price(101.0), Quantity(9.0));
+    EXPECT_EQ(bid->price(), Price(100.0));
+    book.modify_order(1, Price(101.0), Quantity(8.0));
+    EXPECT_EQ(bid->price(), Price(101.0));
+
+    // Reductions at the same price are never checked
+    book.modify_order(1, std::nullopt, Quantity(2.0));
+    EXPECT_EQ(bid->quantity(), Quantity(2.0));
+}
+
+TEST(RiskGateTest, PositionLimitCountsOpenOrders) {
+    const SymbolId symbol_id = banded_symbol();
+    RiskGate gate(3, symbol_id + 1);
+    RiskLimits limits;
+    limits.max_position = Quantity(10.0);
+    gate.set_limits(ALICE, limits);
+
+    OrderBook book(symbol_id);
+    book.set_risk_gate(&gate);
+    const Position& alice = *gate.positions().find(ALICE, symbol_id);
+
+    // Each bid passes alone, but not once the ones resting already add up
+    book.add_order(order(1, symbol_id, Side::BUY, OrderType::LIMIT, 4.0, 99.0, ALICE));
+    book.add_order(order(2, symbol_id, Side::BUY, OrderType::LIMIT, 4.0, 98.0, ALICE));
+    OrderPtr third = order(3, symbol_id, Side::BUY, OrderType::LIMIT, 4.0, 97.0, ALICE);
+    book.add_order(third);
+    EXPECT_EQ(third->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(alice.open_buy, Quantity(8.0));
+
+    // Offers are exposure the other way and don't eat into the bid side
+    book.add_order(order(4, symbol_id, Side::SELL, OrderType::LIMIT, 10.0, 105.0, ALICE));
+    EXPECT_NE(book.get_order(4), nullptr);
+    EXPECT_EQ(alice.open_sell, Quantity(10.0));
+
+    // A fill moves size from open to held; the total stays the same
+    book.add_order(order(5, symbol_id, Side::SELL, OrderType::LIMIT, 3.0, 99.0, BOB));
+    EXPECT_EQ(alice.net, Quantity(3.0));
+    EXPECT_EQ(alice.open_buy, Quantity(5.0));
+    book.add_order(order(6, symbol_id, Side::BUY, OrderType::LIMIT, 3.0, 97.0, ALICE));
+    EXPECT_EQ(book.get_order(6), nullptr);
+
+    // A cancel, an amend down and an unfilled IOC all give room back
+    book.cancel_order(2);
+    EXPECT_EQ(alice.open_buy, Quantity(1.0));
+    book.modify_order(1, std::nullopt, Quantity(3.5));
+    EXPECT_EQ(alice.open_buy, Quantity(0.5));
+    book.add_order(std::make_shared<Order>(7, symbol_id, Side::BUY, OrderType::LIMIT, Quantity(6.0), Price(90.0),
+                                           TimeInForce::IOC, ALICE, 0));
+    EXPECT_EQ(alice.open_buy, Quantity(0.5));
+    book.add_order(order(8, symbol_id, Side::BUY, OrderType::LIMIT, 6.5, 96.0, ALICE));
+    EXPECT_NE(book.get_order(8), nullptr);
+    EXPECT_EQ(alice.open_buy, Quantity(7.0));
+
+    book.cancel_all(CancelFilter{});
+    EXPECT_EQ(alice.open_buy, Quantity::ZERO);
+    EXPECT_EQ(alice.open_sell, Quantity::ZERO);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "orderbook/snapshot.hpp"
+#include "orderbook/journal.hpp"
+#include "orderbook/order_book.hpp"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = (std::filesystem::temp_directory_path() /
+                      ("snapshot_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        
+        book_.add_order(limit(1, Side::BUY, 10.0, 100.0));
+        book_.add_order(limit(2, Side::BUY, 5.0, 100.0));
+        book_.add_order(limit(3, Side::BUY, 7.0, 99.0));
+        book_.add_order(limit(4, Side::SELL, 8.0, 102.0));
+        book_.add_order(limit(5, Side::SELL, 3.0, 101.0));
+        
+        // Leave one maker partially filled
+        book_.add_order(limit(6, Side::SELL, 4.0, 100.0));
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+    
+    static OrderPtr limit(OrderId id, Side side, double qty, double price) {
+        return std::make_shared<Order>(id, "SNAP", side, OrderType::LIMIT, Quantity(qty), Price(price));
+    }
+    
+    std::string directory_;
+    OrderBook book_{"SNAP"};
+};
+
+TEST_F(SnapshotTest, RoundTripKeepsLevelsAndQueues) {
+    std::vector<std::byte> image(book_.snapshot_size());
+    ASSERT_TRUE(book_.write_snapshot(image, 42));
+    
+    OrderBook restored("SNAP");
+    uint64_t sequence = 0;
+    ASSERT_TRUE(restored.restore_snapshot(image, &sequence));
+    EXPECT_EQ(sequence, 42);
+    
+    EXPECT_EQ(restored.get_bids(), book_.get_bids());
+    EXPECT_EQ(restored.get_asks(), book_.get_asks());
+    EXPECT_EQ(restored.get_total_bid_quantity(), Quantity(18.0));
+    EXPECT_EQ(restored.get_total_ask_quantity(), Quantity(11.0));
+    
+    // FIFO order and partial fills survive
+    auto queue = restored.get_orders_at_level(Price(100.0), Side::BUY);
+    ASSERT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue[0]->id(), 1);
+    EXPECT_EQ(queue[0]->executed_quantity(), Quantity(4.0));
+    EXPECT_EQ(queue[1]->id(), 2);
+    
+    // Depth is rebuilt, and the restored book matches normally
+    ASSERT_EQ(restored.bid_depth().size(), 2);
+    EXPECT_EQ(restored.bid_depth()[0].quantity, Quantity(11.0));
+    auto matches = restored.add_order(limit(7, Side::SELL, 6.0, 100.0));
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(matches[0].maker_order_id, 1);
+}
+
+TEST_F(SnapshotTest, RejectsDamagedImages) {
+    std::vector<std::byte> image(book_.snapshot_size());
+    ASSERT_TRUE(book_.write_snapshot(image));
+    
+    std::vector<std::byte> small(image.size() - 1);
+    EXPECT_FALSE(book_.write_snapshot(small));
+    
+    OrderBook restored("SNAP");
+    restored.add_order(limit(99, Side::BUY, 1.0, 50.0));
+    std::vector<std::byte> truncated(image.begin(), image.end() - 8);
+    EXPECT_FALSE(restored.restore_snapshot(truncated));
+    EXPECT_EQ(restored.order_count(), 0);
+    EXPECT_EQ(restored.bid_level_count(), 0);
+    
+    // Images only load into the book for the same symbol
+    OrderBook other("OTHER");
+    EXPECT_FALSE(other.restore_snapshot(image));
+}
+
+TEST_F(SnapshotTest, SnapshotPlusJournalTail) {
+    JournalConfig config;
+    config.directory = directory_ + "/journal";
+    Journal journal(config);
+    ASSERT_TRUE(journal.open());
+    
+    std::string path = directory_ + "/book.snap";
+    ASSERT_TRUE(save_snapshot(book_, path, journal.last_sequence()));
+    
+    // Commands after the checkpoint go to the journal and the live book
+    MatchBuffer fills;
+    SymbolId id = book_.symbol_id();
+    for (const OrderCommand& command : {OrderCommand::cancel(id, 3),
+                                        OrderCommand::new_order(id, 8, Side::BUY, OrderType::LIMIT,
+                                                                Quantity(2.0), Price(101.0))}) {
+        Timestamp now = current_timestamp();
+        journal.append(command, now);
+        book_.apply(command, now, fills);
+    }
+    journal.close();
+    
+    OrderBook recovered("SNAP");
+    uint64_t sequence = 0;
+    ASSERT_TRUE(load_snapshot(recovered, path, &sequence));
+    
+    MatchBuffer replayed;
+    JournalReader reader(config.directory);
+    while (const JournalRecord* record = reader.next()) {
+        if (record->sequence > sequence) {
+            recovered.apply(record->command, record->timestamp, replayed);
+        }
+    }
+    
+    EXPECT_EQ(recovered.get_bids(), book_.get_bids());
+    EXPECT_EQ(recovered.get_asks(), book_.get_asks());
+    ASSERT_EQ(replayed.size(), 1);
+    EXPECT_EQ(replayed[0].timestamp, fills[0].timestamp);
+}
+
+TEST_F(SnapshotTest, RoundTripKeepsStopsAndPegs) {
+    MatchBuffer fills;
+    SymbolId symbol = book_.symbol_id();
+    book_.apply(OrderCommand::new_stop(symbol, 20, Side::SELL, Quantity(1.0), Price(95.0)), 1, fills);
+    book_.apply(OrderCommand::new_stop(symbol, 21, Side::BUY, Quantity(2.0), Price(105.0), Price(106.0)), 1, fills);
+    book_.apply(OrderCommand::new_pegged(symbol, 22, Side::BUY, OrderType::PEG_MID, Quantity(1.0)), 1, fills);
+    ASSERT_EQ(book_.stop_order_count(), 2);
+    ASSERT_EQ(book_.get_order(22)->price(), Price(100.5));
+    
+    std::vector<std::byte> image(book_.snapshot_size());
+    ASSERT_TRUE(book_.write_snapshot(image));
+    OrderBook restored("SNAP");
+    ASSERT_TRUE(restored.restore_snapshot(image));
+    
+    EXPECT_EQ(restored.stop_order_count(), 2);
+    EXPECT_EQ(restored.pending_order_count(), 2);
+    EXPECT_EQ(restored.last_trade_price(), Price(100.0));
+    ASSERT_NE(restored.get_order(21), nullptr);
+    EXPECT_EQ(restored.get_order(21)->stop_price(), Price(105.0));
+    EXPECT_EQ(restored.get_order(21)->type(), OrderType::STOP_LIMIT);
+    
+    // The restored peg still follows the book
+    restored.apply(OrderCommand::cancel(symbol, 5), 2, fills);
+    EXPECT_EQ(restored.get_order(22)->price(), Price(101.0));
+}
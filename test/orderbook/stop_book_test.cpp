@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "orderbook/stop_book.hpp"
+#include <memory>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+namespace {
+
+OrderPtr stop(OrderId id, Side side, double stop_price) {
+    auto order = std::make_shared<Order>(id, "STOP", side, OrderType::STOP, Quantity(1.0), Price());
+    order->set_stop_price(Price(stop_price));
+    return order;
+}
+
+} // namespace
+
+TEST(StopBookTest, TriggersInPriceThenArrivalOrder) {
+    StopBook book;
+    std::vector<OrderPtr> orders = {
+        stop(1, Side::BUY, 102.0), stop(2, Side::BUY, 101.0), stop(3, Side::BUY, 101.0),
+        stop(4, Side::SELL, 98.0), stop(5, Side::SELL, 99.0),
+    };
+    for (const auto& order : orders) {
+        book.add(*order);
+    }
+    EXPECT_EQ(book.size(), 5);
+    EXPECT_EQ(book.next_buy_trigger(), Price(101.0));
+    EXPECT_EQ(book.next_sell_trigger(), Price(99.0));
+    
+    // A trade between the fronts triggers nothing
+    EXPECT_EQ(book.pop_triggered(Price(100.0)), INVALID_ORDER_ID);
+    
+    // Buy stops at or below the trade fire lowest first, ties in arrival order
+    EXPECT_EQ(book.pop_triggered(Price(101.5)), 2);
+    EXPECT_EQ(book.pop_triggered(Price(101.5)), 3);
+    EXPECT_EQ(book.pop_triggered(Price(101.5)), INVALID_ORDER_ID);
+    
+    // Sell stops at or above the trade fire highest first
+    EXPECT_EQ(book.pop_triggered(Price(98.0)), 5);
+    EXPECT_EQ(book.pop_triggered(Price(98.0)), 4);
+    EXPECT_EQ(book.size(), 1);
+}
+
+TEST(StopBookTest, RemoveByOrder) {
+    StopBook book;
+    OrderPtr first = stop(1, Side::SELL, 95.0);
+    OrderPtr second = stop(2, Side::SELL, 95.0);
+    book.add(*first);
+    book.add(*second);
+    
+    EXPECT_TRUE(book.remove(*first));
+    EXPECT_FALSE(book.remove(*first));
+    EXPECT_EQ(book.pop_triggered(Price(90.0)), 2);
+    EXPECT_TRUE(book.empty());
+    EXPECT_FALSE(book.next_sell_trigger().has_value());
+}
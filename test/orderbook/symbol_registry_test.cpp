@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "orderbook/symbol_registry.hpp"
+#include "orderbook/order.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::orderbook;
+
+namespace {
+
+std::string make_name(const char* prefix, size_t index) {
+    std::string name(prefix);
+    name += std::to_string(index);
+    return name;
+}
+
+} // namespace
+
+TEST(SymbolRegistryTest, InternIsStable) {
+    SymbolRegistry registry;
+    
+    SymbolId aapl = registry.intern("AAPL");
+    SymbolId msft = registry.intern("MSFT");
+    EXPECT_EQ(aapl, 0u);
+    EXPECT_EQ(msft, 1u);
+    EXPECT_EQ(registry.intern("AAPL"), aapl);
+    EXPECT_EQ(registry.size(), 2);
+    
+    EXPECT_EQ(registry.find("MSFT"), msft);
+    EXPECT_EQ(registry.find("GOOG"), INVALID_SYMBOL_ID);
+    EXPECT_EQ(registry.name(aapl), "AAPL");
+    EXPECT_EQ(registry.name(INVALID_SYMBOL_ID), "");
+    EXPECT_EQ(registry.info(42), nullptr);
+}
+
+TEST(SymbolRegistryTest, ReferenceData) {
+    SymbolRegistry registry;
+    
+    SymbolInfo info;
+    info.name = "ES";
+    info.tick_size = Price(0.25);
+    info.lot_size = Quantity(1.0);
+    info.min_price = Price(1000.0);
+    info.max_price = Price(9000.0);
+    SymbolId es = registry.register_symbol(info);
+    
+    const SymbolInfo* stored = registry.info(es);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->tick_size, Price(0.25));
+    EXPECT_TRUE(stored->accepts_price(Price(4500.25)));
+    EXPECT_FALSE(stored->accepts_price(Price(4500.10)));
+    EXPECT_FALSE(stored->accepts_price(Price(9000.25)));
+    EXPECT_TRUE(stored->accepts_quantity(Quantity(3.0)));
+    EXPECT_FALSE(stored->accepts_quantity(Quantity(2.5)));
+    
+    // Re-registering updates the data but keeps the id
+    info.max_price = Price(10000.0);
+    EXPECT_EQ(registry.register_symbol(info), es);
+    EXPECT_TRUE(registry.info(es)->accepts_price(Price(9000.25)));
+}
+
+TEST(SymbolRegistryTest, DefaultsAcceptEverything) {
+    SymbolRegistry registry;
+    const SymbolInfo* info = registry.info(registry.intern("ANY"));
+    ASSERT_NE(info, nullptr);
+    EXPECT_TRUE(info->accepts_price(Price(123.4567)));
+    EXPECT_TRUE(info->accepts_quantity(Quantity(0.0001)));
+}
+
+TEST(SymbolRegistryTest, ManySymbolsAcrossChunks) {
+    SymbolRegistry registry;
+    const size_t count = SymbolRegistry::CHUNK_SIZE * 2 + 5;
+    
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(registry.intern(make_name("SYM", i)), i);
+    }
+    
+    // Names stay valid as the registry grows
+    EXPECT_EQ(registry.name(3), "SYM3");
+    EXPECT_EQ(registry.name(static_cast<SymbolId>(count - 1)), make_name("SYM", count - 1));
+    EXPECT_EQ(registry.find("SYM1500"), 1500u);
+}
+
+TEST(SymbolRegistryTest, ConcurrentIntern) {
+    SymbolRegistry registry;
+    std::vector<std::thread> threads;
+    std::vector<SymbolId> ids(4);
+    
+    for (size_t t = 0; t < ids.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < 100; ++i) {
+                registry.intern(make_name("S", i));
+            }
+            ids[t] = registry.intern("S50");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(registry.size(), 100);
+    for (SymbolId id : ids) {
+        EXPECT_EQ(id, ids[0]);
+    }
+}
+
+TEST(SymbolRegistryTest, FindsNamesWhileTheIndexGrows) {
+    SymbolRegistry registry;
+    const size_t count = 4096;
+    std::atomic<size_t> interned{0};
+    std::atomic<bool> mismatch{false};
+    
+    // A reader resolves every name published so far as the writer keeps adding
+    std::thread reader([&]() {
+        while (interned.load(std::memory_order_acquire) < count) {
+            size_t known = interned.load(std::memory_order_acquire);
+            for (size_t i = 0; i < known; i += 7) {
+                if (registry.find(make_name("G", i)) != i) {
+                    mismatch.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    for (size_t i = 0; i < count; ++i) {
+        registry.intern(make_name("G", i));
+        interned.store(i + 1, std::memory_order_release);
+    }
+    reader.join();
+    
+    EXPECT_FALSE(mismatch.load());
+    EXPECT_EQ(registry.find("G4095"), 4095u);
+    EXPECT_EQ(registry.find("G4096"), INVALID_SYMBOL_ID);
+}
+
+TEST(SymbolRegistryTest, OrdersStoreOnlyTheId) {
+    Order order(1, "REGTEST", Side::BUY, OrderType::LIMIT, Quantity(1.0), Price(10.0));
+    
+    SymbolId id = SymbolRegistry::global().find("REGTEST");
+    EXPECT_EQ(order.symbol_id(), id);
+    EXPECT_EQ(order.symbol(), "REGTEST");
+    
+    Order by_id(2, id, Side::SELL, OrderType::LIMIT, Quantity(1.0), Price(10.0));
+    EXPECT_EQ(by_id.symbol(), "REGTEST");
+}
@@ -29,8 +29,9 @@ TEST(PriceTest, BasicOperations) {
     Price p6 = p3 * 2;
     EXPECT_DOUBLE_EQ(p6.to_double(), 2.469);
     
+    // Division truncates to the 4 stored decimals
     Price p7 = p3 / 2;
-    EXPECT_DOUBLE_EQ(p7.to_double(), 0.61725);
+    EXPECT_DOUBLE_EQ(p7.to_double(), 0.6172);
     
     // Test comparison operators
     EXPECT_TRUE(p3 == Price(1.2345));
@@ -98,8 +99,9 @@ TEST(QuantityTest, BasicOperations) {
     Quantity q6 = q3 * 2;
     EXPECT_DOUBLE_EQ(q6.to_double(), 2.469);
     
+    // Division truncates to the 4 stored decimals
     Quantity q7 = q3 / 2;
-    EXPECT_DOUBLE_EQ(q7.to_double(), 0.61725);
+    EXPECT_DOUBLE_EQ(q7.to_double(), 0.6172);
     
     // Test comparison operators
     EXPECT_TRUE(q3 == Quantity(1.2345));
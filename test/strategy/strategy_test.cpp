@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "strategy/strategy_runner.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace trading_engine::market;
+using namespace trading_engine::orderbook;
+using namespace trading_engine::strategy;
+
+namespace {
+
+MatchingEngineConfig bus_config() {
+    MatchingEngineConfig config;
+    config.queue_capacity = 1024;
+    config.market_data_bus_capacity = 4096;
+    return config;
+}
+
+// Records every callback; optionally lifts the first offer it sees
+class RecordingStrategy : public Strategy {
+public:
+    explicit RecordingStrategy(std::string name) : Strategy(std::move(name)) {}
+
+    void on_start() override { started = true; }
+    void on_book_update(const TopOfBook& top) override {
+        tops.push_back(top);
+        if (lift_offer && top.has_ask() && lifted == INVALID_ORDER_ID) {
+            lifted = send_order(top.symbol_id, Side::BUY, OrderType::LIMIT, Quantity(1.0), top.ask_price,
+                                TimeInForce::IOC);
+        }
+    }
+    void on_order_fill(const Fill& fill) override {
+        fills.push_back(fill);
+        fill_count.fetch_add(1, std::memory_order_release);
+    }
+    void on_tick(Timestamp) override { ticks.fetch_add(1, std::memory_order_release); }
+    void on_stop() override { stopped = true; }
+
+    // Send a resting order from outside the hooks (only while the runner is stopped)
+    OrderId quote(SymbolId symbol_id, Side side, Price price) {
+        return send_order(symbol_id, side, OrderType::LIMIT, Quantity(5.0), price);
+    }
+
+    bool lift_offer = false;
+    OrderId lifted = INVALID_ORDER_ID;
+    std::vector<TopOfBook> tops;
+    std::vector<Fill> fills;
+    std::atomic<int> fill_count{0};
+    std::atomic<int> ticks{0};
+    bool started = false;
+    bool stopped = false;
+};
+
+} // namespace
+
+TEST(StrategyRunnerTest, CoalescesBookUpdates) {
+    MatchingEngine engine(bus_config());
+    SymbolId tsla = engine.add_symbol("TSLA");
+    SymbolId meta = engine.add_symbol("META");
+
+    RecordingStrategy strategy("watcher");
+    strategy.subscribe(tsla);
+    StrategyRunner runner(engine);
+    ASSERT_TRUE(runner.add_strategy(strategy));
+    EXPECT_FALSE(runner.add_strategy(strategy));
+
+    // Five bid changes and one change on a symbol the strategy doesn't follow
+    MatchBuffer fills;
+    for (OrderId id = 1; id <= 5; ++id) {
+        engine.execute(OrderCommand::new_order(tsla, id, Side::BUY, OrderType::LIMIT, Quantity(1.0),
+                                               Price(100.0 + static_cast<double>(id))), fills);
+    }
+    engine.execute(OrderCommand::new_order(meta, 6, Side::SELL, OrderType::LIMIT, Quantity(1.0),
+                                           Price(300.0)), fills);
+
+    EXPECT_GT(runner.poll(0), 0);
+    ASSERT_EQ(strategy.tops.size(), 1);
+    EXPECT_EQ(strategy.tops[0].symbol_id, tsla);
+    EXPECT_EQ(strategy.tops[0].updates, 5);
+    EXPECT_EQ(strategy.tops[0].bid_price, Price(105.0));
+    EXPECT_EQ(strategy.tops[0].bid_quantity, Quantity(1.0));
+    EXPECT_FALSE(strategy.tops[0].has_ask());
+
+    // Nothing new, nothing delivered; a cancel of the best bid exposes the next one
+    EXPECT_EQ(runner.poll(0), 0);
+    EXPECT_EQ(strategy.tops.size(), 1);
+    engine.execute(OrderCommand::cancel(tsla, 5), fills);
+    runner.poll(0);
+    ASSERT_EQ(strategy.tops.size(), 2);
+    EXPECT_EQ(strategy.tops[1].bid_price, Price(104.0));
+    EXPECT_EQ(strategy.tops[1].updates, 1);
+    EXPECT_EQ(runner.events_lost(0), 0);
+}
+
+TEST(StrategyRunnerTest, ClearsMirrorsThatLostEvents) {
+    MatchingEngineConfig config = bus_config();
+    config.market_data_bus_capacity = 16;
+    MatchingEngine engine(config);
+    SymbolId nvda = engine.add_symbol("NVDA");
+
+    RecordingStrategy strategy("watcher");
+    strategy.subscribe(nvda);
+    StrategyRunner runner(engine);
+    ASSERT_TRUE(runner.add_strategy(strategy));
+
+    MatchBuffer fills;
+    engine.execute(OrderCommand::new_order(nvda, 1, Side::BUY, OrderType::LIMIT, Quantity(1.0),
+                                           Price(100.0)), fills);
+    runner.poll(0);
+    ASSERT_EQ(strategy.tops.size(), 1);
+    EXPECT_FALSE(strategy.tops[0].incomplete);
+
+    // Far more events than the bus holds, then a better bid
+    for (OrderId id = 2; id < 40; ++id) {
+        engine.execute(OrderCommand::new_order(nvda, id, Side::SELL, OrderType::LIMIT, Quantity(1.0),
+                                               Price(200.0)), fills);
+        engine.execute(OrderCommand::cancel(nvda, id), fills);
+    }
+    engine.execute(OrderCommand::new_order(nvda, 40, Side::BUY, OrderType::LIMIT, Quantity(2.0),
+                                           Price(99.0)), fills);
+    while (runner.poll(0) > 0) {
+    }
+
+    // Only levels that changed after the gap are known; the 100 bid is not one of them
+    EXPECT_GT(runner.events_lost(0), 0);
+    ASSERT_GE(strategy.tops.size(), 2);
+    const TopOfBook& top = strategy.tops.back();
+    EXPECT_TRUE(top.incomplete);
+    EXPECT_EQ(top.bid_price, Price(99.0));
+    EXPECT_EQ(top.bid_quantity, Quantity(2.0));
+    EXPECT_FALSE(top.has_ask());
+}
+
+TEST(StrategyRunnerTest, OrdersAndFillsRoundTrip) {
+    MatchingEngine engine(bus_config());
+    SymbolId amd = engine.add_symbol("AMD");
+
+    RecordingStrategy maker("maker");
+    RecordingStrategy taker("taker");
+    taker.lift_offer = true;
+    taker.subscribe(amd);
+    StrategyRunner runner(engine);
+    ASSERT_TRUE(runner.add_strategy(maker));
+    ASSERT_TRUE(runner.add_strategy(taker));
+
+    // Each strategy gets its own id block
+    OrderId quote_id = maker.quote(amd, Side::SELL, Price(20.0));
+    ASSERT_NE(quote_id, INVALID_ORDER_ID);
+    EXPECT_TRUE(maker.owns_order(quote_id));
+    EXPECT_FALSE(taker.owns_order(quote_id));
+    EXPECT_EQ(runner.forward(), 1);
+
+    MatchBuffer fills;
+    engine.execute(OrderCommand::new_order(amd, 1, Side::SELL, OrderType::LIMIT, Quantity(5.0),
+                                           Price(21.0)), fills);
+    ASSERT_TRUE(engine.start());
+    while (engine.processed_count(0) < 1) {
+        std::this_thread::yield();
+    }
+    engine.stop();
+
+    // The taker reacts to the offer; its order goes out through the runner
+    runner.poll(1);
+    ASSERT_NE(taker.lifted, INVALID_ORDER_ID);
+    EXPECT_EQ(runner.forward(), 1);
+    ASSERT_TRUE(engine.start());
+    while (engine.processed_count(0) < 2) {
+        std::this_thread::yield();
+    }
+    engine.stop();
+
+    runner.poll(0);
+    runner.poll(1);
+    ASSERT_EQ(maker.fills.size(), 1);
+    EXPECT_EQ(maker.fills[0].order_id, quote_id);
+    EXPECT_EQ(maker.fills[0].contra_order_id, taker.lifted);
+    EXPECT_EQ(maker.fills[0].side, Side::SELL);
+    EXPECT_TRUE(maker.fills[0].maker);
+    ASSERT_EQ(taker.fills.size(), 1);
+    EXPECT_EQ(taker.fills[0].side, Side::BUY);
+    EXPECT_EQ(taker.fills[0].price, Price(20.0));
+    EXPECT_EQ(taker.fills[0].quantity, Quantity(1.0));
+    EXPECT_FALSE(taker.fills[0].maker);
+    EXPECT_EQ(taker.tops.back().last_trade_price, Price(20.0));
+
+    // Orders for symbols the engine doesn't trade are dropped
+    EXPECT_TRUE(maker.quote(INVALID_SYMBOL_ID, Side::BUY, Price(1.0)) != INVALID_ORDER_ID);
+    EXPECT_EQ(runner.forward(), 0);
+    EXPECT_EQ(runner.orders_rejected(), 1);
+    EXPECT_EQ(runner.orders_forwarded(), 2);
+}
+
+TEST(StrategyRunnerTest, StrategiesRunOnTheirOwnThreads) {
+    MatchingEngine engine(bus_config());
+    SymbolId intc = engine.add_symbol("INTC");
+
+    RecordingStrategy maker("maker");
+    RecordingStrategy taker("taker");
+    RecordingStrategy late("late");
+    taker.lift_offer = true;
+    taker.subscribe(intc);
+
+    StrategyRunnerConfig config;
+    config.tick_interval_ns = 100000;
+    StrategyRunner runner(engine, config);
+    ASSERT_TRUE(runner.add_strategy(maker));
+    ASSERT_TRUE(runner.add_strategy(taker));
+    maker.quote(intc, Side::SELL, Price(30.0));
+
+    ASSERT_TRUE(engine.start());
+    ASSERT_TRUE(runner.start());
+    EXPECT_FALSE(runner.add_strategy(late));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((maker.fill_count.load(std::memory_order_acquire) < 1 ||
+            taker.fill_count.load(std::memory_order_acquire) < 1 ||
+            taker.ticks.load(std::memory_order_acquire) < 2) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    runner.stop();
+    engine.stop();
+
+    EXPECT_TRUE(maker.started && maker.stopped);
+    EXPECT_TRUE(taker.started && taker.stopped);
+    EXPECT_EQ(maker.fill_count.load(), 1);
+    EXPECT_EQ(taker.fill_count.load(), 1);
+    EXPECT_GE(taker.ticks.load(), 2);
+    EXPECT_EQ(engine.book(intc)->get_total_ask_quantity(), Quantity(4.0));
+}